@@ -5828,6 +5828,40 @@ var authCommandsLib = {
             db.runCommand({stopRecordingTraffic: 1});
           },
         },
+        {
+          testname: "startProfiling",
+          command: {startProfiling: 1},
+          testcases: [
+              // The sampling profiler is not available on every platform
+              {runOnDb: adminDbName, roles: roles_hostManager, expectFail: true},
+          ],
+          teardown: (db, response) => {
+              if (response.ok) {
+                  assert.commandWorked(db.runCommand({stopProfiling: 1}));
+              }
+          }
+        },
+        {
+          testname: "stopProfiling",
+          command: {stopProfiling: 1},
+          testcases: [
+              {runOnDb: adminDbName, roles: roles_hostManager, expectFail: true},
+          ],
+          setup: function(db) {
+              db.runCommand({stopProfiling: 1});
+              db.runCommand({startProfiling: 1});
+          },
+          teardown: function(db) {
+            db.runCommand({stopProfiling: 1});
+          },
+        },
+        {
+          testname: "getProfile",
+          command: {getProfile: 1},
+          testcases: [
+              {runOnDb: adminDbName, roles: roles_monitoring},
+          ],
+        },
         {
           testname: "clearJumboFlag",
           command: {clearJumboFlag: "test.x"},
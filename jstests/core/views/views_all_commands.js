@@ -316,6 +316,7 @@ let viewsCommandTests = {
         }
     },
     getParameter: {skip: isUnrelated},
+    getProfile: {skip: isUnrelated},
     getShardMap: {skip: isUnrelated},
     getShardVersion: {
         command: {getShardVersion: "test.view"},
@@ -545,8 +546,10 @@ let viewsCommandTests = {
         expectFailure: true,
     },
     stageDebug: {skip: isAnInternalCommand},
+    startProfiling: {skip: isUnrelated},
     startRecordingTraffic: {skip: isUnrelated},
     startSession: {skip: isAnInternalCommand},
+    stopProfiling: {skip: isUnrelated},
     stopRecordingTraffic: {skip: isUnrelated},
     testDeprecation: {skip: isAnInternalCommand},
     testDeprecationInVersion2: {skip: isAnInternalCommand},
@@ -0,0 +1,66 @@
+/**
+ * Tests that the cache usage of collections and indexes is sampled and reported by $collStats
+ * cacheStats and in diagnostic data.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/ftdc.js");
+
+const conn = MongoRunner.runMongod({setParameter: {collectionCacheStatsSampleIntervalSecs: 1}});
+const admin = conn.getDB("admin");
+const coll = conn.getDB("test").collection_cache_stats;
+
+assert.commandWorked(coll.createIndex({a: 1}));
+for (let i = 0; i < 100; ++i) {
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+}
+
+// The option takes no arguments.
+assert.commandFailedWithCode(
+    coll.runCommand(
+        {aggregate: coll.getName(), pipeline: [{$collStats: {cacheStats: 1}}], cursor: {}}),
+    5986705);
+assert.commandFailedWithCode(
+    coll.runCommand(
+        {aggregate: coll.getName(), pipeline: [{$collStats: {cacheStats: {a: 1}}}], cursor: {}}),
+    5986705);
+
+function getCacheStats() {
+    return coll.aggregate([{$collStats: {cacheStats: {}}}]).next().cacheStats;
+}
+
+assert.soon(() => {
+    const stats = getCacheStats();
+    return stats.hasOwnProperty("collection") && stats.collection.bytesInCache > 0 &&
+        stats.hasOwnProperty("indexes") && stats.indexes.hasOwnProperty("_id_") &&
+        stats.indexes.hasOwnProperty("a_1");
+}, () => tojson(getCacheStats()));
+
+const stats = getCacheStats();
+assert.eq(stats.bytesInCache,
+          stats.collection.bytesInCache + stats.indexes._id_.bytesInCache +
+              stats.indexes.a_1.bytesInCache,
+          tojson(stats));
+for (let field of ["bytesReadIntoCache",
+                   "pagesReadIntoCache",
+                   "unmodifiedPagesEvicted",
+                   "modifiedPagesEvicted"]) {
+    assert(stats.collection.hasOwnProperty(field), tojson(stats));
+    assert(stats.collection.recent.hasOwnProperty(field), tojson(stats));
+}
+
+// Diagnostic data reports the collections using the most cache without naming them.
+assert.soon(() => {
+    const data = verifyGetDiagnosticData(admin);
+    return data.hasOwnProperty("collectionCache") && data.collectionCache.trackedCollections > 0;
+});
+const summary = verifyGetDiagnosticData(admin).collectionCache;
+assert.eq(summary.topCollections.length, 10, tojson(summary));
+assert.gt(summary.topCollections[0].bytesInCache, 0, tojson(summary));
+assert(!tojson(summary).includes(coll.getName()), tojson(summary));
+
+MongoRunner.stopMongod(conn);
+}());
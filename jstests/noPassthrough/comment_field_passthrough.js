@@ -17,9 +17,16 @@ load("jstests/auth/lib/commands_lib.js");  // Provides an exhaustive list of com
 
 const tests = authCommandsLib.tests;
 
-// The following commands require additional start up configuration and hence need to be skipped.
-const blacklistedTests =
-    ["startRecordingTraffic", "stopRecordingTraffic", "addShardToZone", "removeShardFromZone"];
+// The following commands require additional start up configuration or platform support and hence
+// need to be skipped.
+const blacklistedTests = [
+    "startRecordingTraffic",
+    "stopRecordingTraffic",
+    "startProfiling",
+    "stopProfiling",
+    "addShardToZone",
+    "removeShardFromZone"
+];
 
 function runTests(tests, conn, impls) {
     const firstDb = conn.getDB(firstDbName);
@@ -0,0 +1,69 @@
+// Tests the query shape statistics store and the $queryStats aggregation stage.
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const admin = conn.getDB("admin");
+const coll = conn.getDB("test").query_stats_store;
+
+// The store is disabled by default.
+assert.commandFailedWithCode(
+    admin.runCommand({aggregate: 1, pipeline: [{$queryStats: {}}], cursor: {}}),
+    ErrorCodes.CommandNotSupported);
+
+assert.commandWorked(admin.runCommand({setParameter: 1, queryStatsStoreSizeBytes: 1024 * 1024}));
+
+// The stage only runs collectionless on the admin database, and takes no options.
+assert.commandFailedWithCode(
+    coll.runCommand({aggregate: coll.getName(), pipeline: [{$queryStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    admin.runCommand({aggregate: 1, pipeline: [{$queryStats: {foo: 1}}], cursor: {}}),
+    ErrorCodes.BadValue);
+
+for (let i = 0; i < 10; ++i) {
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+}
+
+// Two finds differing only in their constants share a shape. The getMores of the second one are
+// counted against it too.
+assert.eq(coll.find({a: {$gte: 3}}).itcount(), 7);
+assert.eq(coll.find({a: {$gte: 5}}).batchSize(2).itcount(), 5);
+assert.eq(coll.find({a: "x"}, {_id: 0}).itcount(), 0);
+
+// Other commands with the same filter, and aggregates, get shapes of their own.
+assert.eq(coll.count({a: {$gte: 3}}), 7);
+assert.eq(coll.aggregate([{$match: {a: {$gte: 3}}}, {$group: {_id: "$a"}}]).itcount(), 7);
+assert.eq(coll.aggregate([{$group: {_id: "$a"}}]).itcount(), 10);
+assert.eq(coll.aggregate([{$group: {_id: "$_id"}}]).itcount(), 10);
+
+const stats = admin.aggregate([{$queryStats: {}}, {$match: {ns: coll.getFullName()}}]).toArray();
+assert.eq(stats.length, 6, tojson(stats));
+
+const findShape = (queryShape) => {
+    const entry = stats.find((entry) => friendlyEqual(entry.queryShape, queryShape));
+    assert(entry, tojson(stats));
+    return entry;
+};
+
+const rangeShape = findShape({command: "find", filter: {a: {$gte: "?number"}}});
+assert.eq(rangeShape.executionCount, 2, tojson(rangeShape));
+assert.eq(rangeShape.getMoreCount, 2, tojson(rangeShape));
+assert.eq(rangeShape.nreturned, 12, tojson(rangeShape));
+assert.eq(rangeShape.docsExamined, 20, tojson(rangeShape));
+assert.eq(rangeShape.lastPlanSummary, "COLLSCAN", tojson(rangeShape));
+assert.gt(rangeShape.bytesReturned, 0, tojson(rangeShape));
+assert.gt(rangeShape.latencyHistogram.length, 0, tojson(rangeShape));
+
+assert.eq(findShape({command: "count", filter: {a: {$gte: "?number"}}}).executionCount, 1);
+assert.eq(findShape({
+              command: "aggregate",
+              pipeline: [{$match: {a: {$gte: "?number"}}}, {$group: {_id: "$a"}}]
+          }).executionCount,
+          1);
+assert.eq(findShape({command: "aggregate", pipeline: [{$group: {_id: "$a"}}]}).executionCount, 1);
+assert.eq(findShape({command: "aggregate", pipeline: [{$group: {_id: "$_id"}}]}).executionCount,
+          1);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,63 @@
+// Tests for the sampling CPU profiler commands.
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const admin = conn.getDB("admin");
+
+assert(!admin.serverStatus().cpuProfile.running);
+
+// The profiler commands may only be run against the admin database.
+const test = conn.getDB("test");
+for (let cmd of [{startProfiling: 1}, {stopProfiling: 1}, {getProfile: 1}]) {
+    assert.commandFailedWithCode(test.runCommand(cmd), ErrorCodes.Unauthorized);
+}
+
+assert.commandFailedWithCode(admin.runCommand({stopProfiling: 1}), ErrorCodes.BadValue);
+
+let res = admin.runCommand({startProfiling: 1, frequencyHz: 99});
+if (!res.ok) {
+    // Backtraces can only be taken from a signal handler on some platforms
+    assert.commandFailedWithCode(res, ErrorCodes.IllegalOperation);
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+assert.commandFailedWithCode(admin.runCommand({startProfiling: 1}), ErrorCodes.BadValue);
+assert(admin.serverStatus().cpuProfile.running);
+
+// Burn some CPU so there is something to sample
+const coll = conn.getDB("test").sampling_profiler;
+for (let i = 0; i < 20; ++i) {
+    assert.commandWorked(coll.insert({_id: i, x: "a".repeat(1000)}));
+}
+assert.soon(() => {
+    coll.find({$where: "sleep(1) || this.x.length > 0"}).itcount();
+    return admin.serverStatus().cpuProfile.samples > 0;
+});
+
+assert.commandWorked(admin.runCommand({stopProfiling: 1}));
+
+const summary = admin.serverStatus().cpuProfile;
+assert(!summary.running, tojson(summary));
+
+res = assert.commandWorked(admin.runCommand({getProfile: 1, limit: 5}));
+assert(!res.running, tojson(res));
+assert.eq(res.frequencyHz, 99, tojson(res));
+assert.gt(res.samples, 0, tojson(res));
+assert.gt(res.stacks.length, 0, tojson(res));
+assert.lte(res.stacks.length, 5, tojson(res));
+for (let i = 0; i < res.stacks.length; ++i) {
+    const stack = res.stacks[i];
+    assert.eq(typeof stack.role, "string", tojson(stack));
+    assert.eq(typeof stack.stack, "string", tojson(stack));
+    if (i > 0) {
+        assert.lte(stack.samples, res.stacks[i - 1].samples, tojson(res));
+    }
+}
+
+assert.commandFailedWithCode(admin.runCommand({startProfiling: 1, frequencyHz: 0}),
+                             ErrorCodes.BadValue);
+
+MongoRunner.stopMongod(conn);
+})();
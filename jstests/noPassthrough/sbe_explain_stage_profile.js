@@ -0,0 +1,49 @@
+// Tests the per-stage CPU profile reported by explain for slot based execution engine plans.
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryEnableSlotBasedExecutionEngine: true}});
+const db = conn.getDB("test");
+const coll = db.sbe_explain_stage_profile;
+
+for (let i = 0; i < 100; ++i) {
+    assert.commandWorked(coll.insert({_id: i, a: i % 10}));
+}
+
+function checkFoldedStacks(stacks) {
+    assert(Array.isArray(stacks), tojson(stacks));
+    stacks.forEach((line) => assert(/^\S+(;\S+)* \d+$/.test(line), line));
+}
+
+let explain = coll.find({a: {$gte: 5}}).explain("executionStats");
+let execStats = explain.executionStats;
+assert.gte(execStats.executionStages.cpuNanosInclusive,
+           execStats.executionStages.cpuNanosExclusive,
+           tojson(execStats));
+assert(!execStats.executionStages.hasOwnProperty("instructionsInclusive"), tojson(execStats));
+checkFoldedStacks(execStats.stageProfile.cpuNanos);
+
+// Like in the classic engine, the time estimates are wall clock time.
+assert.gte(execStats.executionStages.executionTimeMillisEstimate, 0, tojson(execStats));
+assert.gte(execStats.executionTimeMillisEstimate, 0, tojson(execStats));
+
+// Hardware counters are only reported when the platform lets us read them.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExplainSBEHardwareCounters: true}));
+explain = coll.find({a: {$gte: 5}}).explain("executionStats");
+execStats = explain.executionStats;
+if (execStats.stageProfile.hasOwnProperty("instructions")) {
+    checkFoldedStacks(execStats.stageProfile.instructions);
+    checkFoldedStacks(execStats.stageProfile.cacheMisses);
+    assert.gte(execStats.executionStages.instructionsInclusive, 0, tojson(execStats));
+}
+
+// The classic engine does not report a stage profile.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryEnableSlotBasedExecutionEngine: false}));
+explain = coll.find({a: {$gte: 5}}).explain("executionStats");
+assert(!explain.executionStats.hasOwnProperty("stageProfile"), tojson(explain));
+
+MongoRunner.stopMongod(conn);
+}());
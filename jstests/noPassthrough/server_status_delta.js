@@ -0,0 +1,35 @@
+// Tests the delta mode of serverStatus.
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const admin = conn.getDB("admin");
+
+// Without a token, or with one the server no longer knows, the full document is returned along
+// with a token to request the next delta against.
+const full = assert.commandWorked(admin.runCommand({serverStatus: 1, delta: true}));
+assert.eq(full.isDelta, false, tojson(full));
+assert(full.hasOwnProperty("deltaToken"), tojson(full));
+assert(full.hasOwnProperty("host"), tojson(full));
+
+const unknown = assert.commandWorked(
+    admin.runCommand({serverStatus: 1, delta: true, deltaToken: NumberLong(1000000)}));
+assert.eq(unknown.isDelta, false, tojson(unknown));
+assert(unknown.hasOwnProperty("host"), tojson(unknown));
+
+// A delta only carries the fields which changed since the referenced document.
+const delta = assert.commandWorked(
+    admin.runCommand({serverStatus: 1, delta: true, deltaToken: full.deltaToken}));
+assert.eq(delta.isDelta, true, tojson(delta));
+assert.neq(delta.deltaToken, full.deltaToken, tojson(delta));
+assert(!delta.hasOwnProperty("host"), tojson(delta));
+assert(!delta.hasOwnProperty("pid"), tojson(delta));
+assert.lt(Object.bsonsize(delta), Object.bsonsize(full), tojson(delta));
+
+// Requests without delta are unaffected.
+const plain = assert.commandWorked(admin.runCommand({serverStatus: 1}));
+assert(!plain.hasOwnProperty("deltaToken"), tojson(plain));
+assert(plain.hasOwnProperty("host"), tojson(plain));
+
+MongoRunner.stopMongod(conn);
+}());
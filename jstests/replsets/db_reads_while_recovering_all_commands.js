@@ -178,6 +178,7 @@ const allCommands = {
         expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary
     },
     getParameter: {skip: isNotAUserDataRead},
+    getProfile: {skip: isNotAUserDataRead},
     getShardMap: {skip: isNotAUserDataRead},
     getShardVersion: {skip: isPrimaryOnly},
     getnonce: {skip: isNotAUserDataRead},
@@ -290,8 +291,10 @@ const allCommands = {
     splitChunk: {skip: isPrimaryOnly},
     splitVector: {skip: isPrimaryOnly},
     stageDebug: {skip: isPrimaryOnly},
+    startProfiling: {skip: isNotAUserDataRead},
     startRecordingTraffic: {skip: isNotAUserDataRead},
     startSession: {skip: isNotAUserDataRead},
+    stopProfiling: {skip: isNotAUserDataRead},
     stopRecordingTraffic: {skip: isNotAUserDataRead},
     testDeprecation: {skip: isNotAUserDataRead},
     testDeprecationInVersion2: {skip: isNotAUserDataRead},
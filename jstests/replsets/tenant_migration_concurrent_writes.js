@@ -747,6 +747,7 @@ const testCases = {
     getLog: {skip: isNotRunOnUserDatabase},
     getMore: {skip: isNotWriteCommand},
     getParameter: {skip: isNotRunOnUserDatabase},
+    getProfile: {skip: isNotRunOnUserDatabase},
     getShardMap: {skip: isNotRunOnUserDatabase},
     getShardVersion: {skip: isNotRunOnUserDatabase},
     getnonce: {skip: isNotRunOnUserDatabase},
@@ -879,8 +880,10 @@ const testCases = {
     splitChunk: {skip: isNotRunOnUserDatabase},
     splitVector: {skip: isNotRunOnUserDatabase},
     stageDebug: {skip: isNotRunOnUserDatabase},
+    startProfiling: {skip: isNotRunOnUserDatabase},
     startRecordingTraffic: {skip: isNotRunOnUserDatabase},
     startSession: {skip: isNotRunOnUserDatabase},
+    stopProfiling: {skip: isNotRunOnUserDatabase},
     stopRecordingTraffic: {skip: isNotRunOnUserDatabase},
     top: {skip: isNotRunOnUserDatabase},
     update: {
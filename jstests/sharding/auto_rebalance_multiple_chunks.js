@@ -0,0 +1,53 @@
+/**
+ * Tests that the balancer moves several contiguous chunks in a single migration when
+ * balancerMaxChunksPerMigration allows it, and splits them back at their original bounds.
+ */
+
+(function() {
+'use strict';
+
+var st = new ShardingTest(
+    {shards: 2, other: {configOptions: {setParameter: {balancerMaxChunksPerMigration: 4}}}});
+var config = st.s0.getDB('config');
+
+const collName = 'TestDB.TestColl';
+
+assert.commandWorked(st.s0.adminCommand({enableSharding: 'TestDB'}));
+st.ensurePrimaryShard('TestDB', st.shard0.shardName);
+assert.commandWorked(st.s0.adminCommand({shardCollection: collName, key: {Key: 1}}));
+
+var coll = st.s0.getCollection(collName);
+for (var i = 0; i < 80; i++) {
+    assert.commandWorked(coll.insert({Key: i, Value: 'Test value ' + i}));
+}
+
+// Create 8 chunks, all of them on st.shard0.shardName
+for (var i = 10; i < 80; i += 10) {
+    assert.commandWorked(st.splitAt(collName, {Key: i}));
+}
+
+assert.eq(8, config.chunks.find({ns: collName, shard: st.shard0.shardName}).itcount());
+
+function countMoves() {
+    return config.changelog.find({what: 'moveChunk.start', ns: collName}).itcount();
+}
+
+const initialMoves = countMoves();
+
+st.startBalancer();
+assert.soon(() => config.chunks.find({ns: collName, shard: st.shard1.shardName}).itcount() == 4);
+st.stopBalancer();
+
+// The first 4 chunks were moved in one migration and kept their bounds.
+assert.eq(1, countMoves() - initialMoves);
+assert.eq(4, config.chunks.find({ns: collName, shard: st.shard0.shardName}).itcount());
+assert.eq(8, config.chunks.find({ns: collName}).itcount());
+for (var i = 10; i < 40; i += 10) {
+    assert.eq(st.shard1.shardName, config.chunks.findOne({ns: collName, min: {Key: i}}).shard);
+}
+
+assert.eq(80, coll.find().itcount());
+assert.eq(0, config.changelog.find({what: 'moveChunk.error'}).itcount());
+
+st.stop();
+})();
@@ -513,6 +513,10 @@ let MongosAPIParametersUtil = (function() {
             commandName: "getParameter",
             skip: "executes locally on mongos (not sent to any remote node)"
         },
+        {
+            commandName: "getProfile",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "getShardMap",
             skip: "executes locally on mongos (not sent to any remote node)"
@@ -1140,6 +1144,10 @@ let MongosAPIParametersUtil = (function() {
                 })
             }
         },
+        {
+            commandName: "startProfiling",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "startRecordingTraffic",
             skip: "executes locally on mongos (not sent to any remote node)"
@@ -1148,6 +1156,10 @@ let MongosAPIParametersUtil = (function() {
             commandName: "startSession",
             skip: "executes locally on mongos (not sent to any remote node)"
         },
+        {
+            commandName: "stopProfiling",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "stopRecordingTraffic",
             skip: "executes locally on mongos (not sent to any remote node)"
@@ -0,0 +1,44 @@
+/**
+ * Tests that a migration fails if the recipient already owns a document with the same _id as one
+ * of the chunk, whether or not the donor streams the chunk from the shard key index.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2});
+const dbName = "test";
+const ns = dbName + ".user";
+const testDB = st.s.getDB(dbName);
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {x: 1}}));
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {x: 0}}));
+assert.commandWorked(st.s.adminCommand(
+    {moveChunk: ns, find: {x: 0}, to: st.shard1.shardName, _waitForDelete: true}));
+
+// _id is only unique within a shard, so both documents can be inserted through mongos.
+assert.commandWorked(testDB.user.insert({_id: 1, x: -1}));
+assert.commandWorked(testDB.user.insert({_id: 1, x: 1}));
+for (let i = 2; i < 10; ++i) {
+    assert.commandWorked(testDB.user.insert({_id: i, x: -i}));
+}
+
+for (let streamFromShardKeyIndex of [false, true]) {
+    assert.commandWorked(st.rs0.getPrimary().adminCommand(
+        {setParameter: 1, migrationClonerStreamFromShardKeyIndex: streamFromShardKeyIndex}));
+
+    assert.commandFailed(
+        st.s.adminCommand({moveChunk: ns, find: {x: -1}, to: st.shard1.shardName}));
+
+    // The chunk and its documents stay on the donor.
+    assert.eq(st.rs0.getPrimary().getDB(dbName).user.find({x: {$lt: 0}}).itcount(), 9);
+    assert.eq(st.rs1.getPrimary().getDB(dbName).user.find({x: {$gte: 0}}).itcount(), 1);
+    assert.eq(testDB.user.find().itcount(), 10);
+
+    // Wait for the recipient to delete what it cloned before the next attempt.
+    assert.soon(() => st.rs1.getPrimary().getDB(dbName).user.find({x: {$lt: 0}}).itcount() == 0);
+}
+
+st.stop();
+})();
@@ -403,6 +403,7 @@ let testCases = {
     getLog: {skip: "does not accept read or write concern"},
     getMore: {skip: "does not accept read or write concern"},
     getParameter: {skip: "does not accept read or write concern"},
+    getProfile: {skip: "does not accept read or write concern"},
     getShardMap: {skip: "internal command"},
     getShardVersion: {skip: "internal command"},
     getnonce: {skip: "does not accept read or write concern"},
@@ -611,8 +612,10 @@ let testCases = {
     splitChunk: {skip: "does not accept read or write concern"},
     splitVector: {skip: "internal command"},
     stageDebug: {skip: "does not accept read or write concern"},
+    startProfiling: {skip: "does not accept read or write concern"},
     startRecordingTraffic: {skip: "does not accept read or write concern"},
     startSession: {skip: "does not accept read or write concern"},
+    stopProfiling: {skip: "does not accept read or write concern"},
     stopRecordingTraffic: {skip: "does not accept read or write concern"},
     testDeprecation: {skip: "does not accept read or write concern"},
     testDeprecationInVersion2: {skip: "does not accept read or write concern"},
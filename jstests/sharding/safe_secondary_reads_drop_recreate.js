@@ -182,6 +182,7 @@ let testCases = {
     getLog: {skip: "does not return user data"},
     getMore: {skip: "shard version already established"},
     getParameter: {skip: "does not return user data"},
+    getProfile: {skip: "does not return user data"},
     getShardMap: {skip: "does not return user data"},
     getShardVersion: {skip: "primary only"},
     getnonce: {skip: "does not return user data"},
@@ -296,8 +297,10 @@ let testCases = {
     splitChunk: {skip: "primary only"},
     splitVector: {skip: "primary only"},
     stageDebug: {skip: "primary only"},
+    startProfiling: {skip: "does not return user data"},
     startRecordingTraffic: {skip: "does not return user data"},
     startSession: {skip: "does not return user data"},
+    stopProfiling: {skip: "does not return user data"},
     stopRecordingTraffic: {skip: "does not return user data"},
     testDeprecation: {skip: "does not return user data"},
     testDeprecationInVersion2: {skip: "does not return user data"},
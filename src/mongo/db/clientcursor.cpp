@@ -50,6 +50,7 @@
 #include "mongo/db/cursor_server_params.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/util/background.h"
@@ -100,6 +101,7 @@ ClientCursor::ClientCursor(ClientCursorParams params,
       _lastUseDate(now),
       _createdDate(now),
       _planSummary(_exec->getPlanExplainer().getPlanSummary()),
+      _queryStatsEntry(QueryStatsStore::getEntry(operationUsingCursor)),
       _opKey(operationUsingCursor->getOperationKey()) {
     invariant(_exec);
     invariant(_operationUsingCursor);
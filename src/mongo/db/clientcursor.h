@@ -45,6 +45,7 @@
 namespace mongo {
 
 class CursorManager;
+class QueryStatsEntry;
 class RecoveryUnit;
 
 /**
@@ -249,6 +250,14 @@ public:
         return StringData(_planSummary);
     }
 
+    /**
+     * Returns the query stats store entry of the query which created this cursor, so that getMores
+     * can be attributed to it. Null if the query was not tracked.
+     */
+    const std::shared_ptr<QueryStatsEntry>& getQueryStatsEntry() const {
+        return _queryStatsEntry;
+    }
+
     /**
      * Returns a generic cursor containing diagnostics about this cursor.
      * The caller must either have this cursor pinned or hold a mutex from the cursor manager.
@@ -417,6 +426,9 @@ private:
     // A string with the plan summary of the cursor's query.
     std::string _planSummary;
 
+    // The query stats store entry of the originating query, if any.
+    std::shared_ptr<QueryStatsEntry> _queryStatsEntry;
+
     // Commit point at the time the last batch was returned. This is only used by internal exhaust
     // oplog fetching. Also see lastKnownCommittedOpTime in GetMoreRequest.
     boost::optional<repl::OpTime> _lastKnownCommittedOpTime;
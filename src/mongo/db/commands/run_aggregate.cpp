@@ -66,6 +66,7 @@
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/read_concern_args.h"
@@ -673,6 +674,8 @@ Status runAggregate(OperationContext* opCtx,
         invariant(collatorToUse);
         expCtx = makeExpressionContext(opCtx, request, std::move(*collatorToUse), uuid);
 
+        QueryStatsStore::get(opCtx).registerPipelineShape(opCtx, nss, request.getPipeline());
+
         auto pipeline = Pipeline::parse(request.getPipeline(), expCtx);
 
         // Check that the view's collation matches the collation of any views involved in the
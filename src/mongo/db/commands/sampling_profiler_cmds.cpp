@@ -0,0 +1,167 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_manager.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/sampling_profiler.h"
+#include "mongo/db/sampling_profiler_gen.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace {
+
+void checkAuthorizedFor(OperationContext* opCtx, ActionType action) {
+    uassert(ErrorCodes::Unauthorized,
+            "Unauthorized",
+            AuthorizationSession::get(opCtx->getClient())
+                ->isAuthorizedForPrivilege(
+                    Privilege{ResourcePattern::forClusterResource(), action}));
+}
+
+class StartProfilingCommand final : public TypedCommand<StartProfilingCommand> {
+public:
+    using Request = StartProfiling;
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        void typedRun(OperationContext* opCtx) {
+            SamplingProfiler::get().start(request());
+            LOGV2(5986701,
+                  "Started the sampling CPU profiler",
+                  "frequencyHz"_attr = request().getFrequencyHz(),
+                  "maxStacks"_attr = request().getMaxStacks());
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            checkAuthorizedFor(opCtx, ActionType::setParameter);
+        }
+
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+    };
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+} startProfilingCommand;
+
+class StopProfilingCommand final : public TypedCommand<StopProfilingCommand> {
+public:
+    using Request = StopProfiling;
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        void typedRun(OperationContext* opCtx) {
+            SamplingProfiler::get().stop();
+            LOGV2(5986702, "Stopped the sampling CPU profiler");
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            checkAuthorizedFor(opCtx, ActionType::setParameter);
+        }
+
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+    };
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+} stopProfilingCommand;
+
+class GetProfileCommand final : public TypedCommand<GetProfileCommand> {
+public:
+    using Request = GetProfile;
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        SamplingProfiler::Profile typedRun(OperationContext* opCtx) {
+            uassert(ErrorCodes::BadValue, "limit must not be negative", request().getLimit() >= 0);
+            return SamplingProfiler::get().getProfile(request().getLimit());
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            checkAuthorizedFor(opCtx, ActionType::serverStatus);
+        }
+
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+    };
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+} getProfileCommand;
+
+}  // namespace
+}  // namespace mongo
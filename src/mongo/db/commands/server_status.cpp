@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <deque>
+
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/server_status.h"
@@ -38,6 +40,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/net/http_client.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/version.h"
@@ -51,6 +54,16 @@ using std::stringstream;
 
 namespace {
 constexpr auto kTimingSection = "timing"_sd;
+constexpr auto kDeltaField = "delta"_sd;
+constexpr auto kDeltaTokenField = "deltaToken"_sd;
+constexpr auto kIsDeltaField = "isDelta"_sd;
+
+// Set by FTDC, which then generates every section afresh and is the only caller to update the
+// cached output of sections with an update interval.
+constexpr auto kRefreshCachedSectionsField = "refreshCachedSections"_sd;
+
+// The number of previous responses kept for clients to request deltas against.
+constexpr size_t kMaxDeltaBases = 16;
 }  // namespace
 
 class CmdServerStatus : public BasicCommand {
@@ -79,15 +92,21 @@ public:
     bool run(OperationContext* opCtx,
              const string& dbname,
              const BSONObj& cmdObj,
-             BSONObjBuilder& result) {
+             BSONObjBuilder& commandResult) {
         _runCalled = true;
 
+        // In delta mode the full document is built aside, to be compared with an earlier one.
+        const bool deltaMode = cmdObj[kDeltaField].trueValue();
+        BSONObjBuilder fullResult;
+        BSONObjBuilder& result = deltaMode ? fullResult : commandResult;
+
         const auto service = opCtx->getServiceContext();
         const auto clock = service->getFastClockSource();
         const auto runStart = clock->now();
         BSONObjBuilder timeBuilder(256);
 
         const auto authSession = AuthorizationSession::get(Client::getCurrent());
+        const bool refreshCachedSections = cmdObj[kRefreshCachedSectionsField].trueValue();
 
         // --- basic fields that are global
 
@@ -106,8 +125,8 @@ public:
 
         // --- all sections
 
-        for (SectionMap::const_iterator i = _sections.begin(); i != _sections.end(); ++i) {
-            ServerStatusSection* section = i->second;
+        for (auto&& [sectionName, entry] : _sections) {
+            ServerStatusSection* section = entry.section;
 
             std::vector<Privilege> requiredPrivileges;
             section->addRequiredPrivileges(&requiredPrivileges);
@@ -124,7 +143,7 @@ public:
                 continue;
             }
 
-            section->appendSection(opCtx, elem, &result);
+            appendSection(opCtx, &entry, elem, refreshCachedSections, &result);
             timeBuilder.appendNumber(
                 static_cast<string>(str::stream() << "after " << section->getSectionName()),
                 durationCount<Milliseconds>(clock->now() - runStart));
@@ -161,6 +180,10 @@ public:
             }
         }
 
+        if (deltaMode) {
+            appendDelta(cmdObj[kDeltaTokenField], fullResult.obj(), &commandResult);
+        }
+
         return true;
     }
 
@@ -168,15 +191,102 @@ public:
         // Disallow adding a section named "timing" as it is reserved for the server status command.
         dassert(section->getSectionName() != kTimingSection);
         verify(!_runCalled);
-        _sections[section->getSectionName()] = section;
+        _sections[section->getSectionName()].section = section;
     }
 
 private:
+    struct SectionEntry {
+        ServerStatusSection* section = nullptr;
+
+        // The last output of a section with a positive update interval.
+        CachedServerStatusSection cache;
+    };
+
+    /**
+     * Appends the output of the given section. If the section declares an update interval, its
+     * cached output is reused while recent enough, unless 'refreshCache' is set, in which case the
+     * section is generated and the cache updated with the result.
+     */
+    void appendSection(OperationContext* opCtx,
+                       SectionEntry* entry,
+                       const BSONElement& configElement,
+                       bool refreshCache,
+                       BSONObjBuilder* result) {
+        const auto updateInterval = entry->section->updateInterval();
+        if (updateInterval <= Milliseconds(0)) {
+            entry->section->appendSection(opCtx, configElement, result);
+            return;
+        }
+
+        BSONObjBuilder configBuilder;
+        if (configElement) {
+            configBuilder.appendAs(configElement, "");
+        }
+        auto config = configBuilder.obj();
+
+        const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+        if (!refreshCache) {
+            if (auto cached = entry->cache.get(config, now, updateInterval)) {
+                result->appendElements(*cached);
+            } else {
+                entry->section->appendSection(opCtx, configElement, result);
+            }
+            return;
+        }
+
+        BSONObjBuilder sectionBuilder;
+        entry->section->appendSection(opCtx, configElement, &sectionBuilder);
+        auto sectionObj = sectionBuilder.obj();
+        result->appendElements(sectionObj);
+        entry->cache.set(std::move(config), now, std::move(sectionObj));
+    }
+
+    /**
+     * Remembers 'full' under a new delta token, and appends to 'result' either the fields which
+     * changed since the response identified by 'tokenElement', or all of 'full' if that response
+     * is not known (anymore).
+     */
+    void appendDelta(const BSONElement& tokenElement, BSONObj full, BSONObjBuilder* result) {
+        BSONObj base;
+        long long token;
+        {
+            stdx::lock_guard<Latch> lk(_deltaMutex);
+            if (tokenElement.isNumber()) {
+                auto it = std::find_if(_deltaBases.begin(),
+                                       _deltaBases.end(),
+                                       [&](const auto& entry) {
+                                           return entry.first == tokenElement.safeNumberLong();
+                                       });
+                if (it != _deltaBases.end()) {
+                    base = it->second;
+                }
+            }
+
+            token = _nextDeltaToken++;
+            _deltaBases.emplace_back(token, full);
+            if (_deltaBases.size() > kMaxDeltaBases) {
+                _deltaBases.pop_front();
+            }
+        }
+
+        result->append(kDeltaTokenField, token);
+        result->append(kIsDeltaField, !base.isEmpty());
+        if (base.isEmpty()) {
+            result->appendElements(full);
+        } else {
+            appendChangedFields(full, base, result);
+        }
+    }
+
     const Date_t _started;
     bool _runCalled;
 
-    typedef map<string, ServerStatusSection*> SectionMap;
-    SectionMap _sections;
+    map<string, SectionEntry> _sections;
+
+    // Recent full responses of delta mode requests, oldest first, keyed by their delta token.
+    Mutex _deltaMutex = MONGO_MAKE_LATCH("CmdServerStatus::_deltaMutex");
+    long long _nextDeltaToken = 1;
+    std::deque<std::pair<long long, BSONObj>> _deltaBases;
 };
 
 namespace {
@@ -70,6 +70,17 @@ public:
      */
     virtual void addRequiredPrivileges(std::vector<Privilege>* out){};
 
+    /**
+     * How long the output of this section may be reused before it is generated again. Sections
+     * which are expensive to generate, or which take locks, can return a positive interval so that
+     * callers polling serverStatus more often than that reuse the output last generated for FTDC,
+     * which always generates sections afresh. Requests passing different options for the section
+     * do not share output.
+     */
+    virtual Milliseconds updateInterval() const {
+        return Milliseconds(0);
+    }
+
     /**
      * actually generate the result
      *
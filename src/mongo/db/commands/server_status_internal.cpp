@@ -83,4 +83,53 @@ void MetricTree::appendTo(BSONObjBuilder& b) const {
         bb.done();
     }
 }
+
+boost::optional<BSONObj> CachedServerStatusSection::get(const BSONObj& config,
+                                                        Date_t now,
+                                                        Milliseconds maxAge) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_generatedAt || now - *_generatedAt >= maxAge || !config.binaryEqual(_config)) {
+        return boost::none;
+    }
+    return _output;
+}
+
+void CachedServerStatusSection::set(BSONObj config, Date_t generatedAt, BSONObj output) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _config = std::move(config);
+    _generatedAt = generatedAt;
+    _output = std::move(output);
+}
+
+void appendChangedFields(const BSONObj& current, const BSONObj& base, BSONObjBuilder* out) {
+    // Fields usually come in the same order in both documents, so each one is walked alongside the
+    // other and only searched when the order differs.
+    BSONObjIterator baseIt(base);
+    for (auto&& elem : current) {
+        auto baseElem = baseIt.more() ? baseIt.next() : BSONElement();
+        if (baseElem.fieldNameStringData() != elem.fieldNameStringData()) {
+            baseElem = base[elem.fieldNameStringData()];
+        }
+
+        if (elem.type() == Object && baseElem.type() == Object) {
+            BSONObjBuilder changed;
+            appendChangedFields(elem.Obj(), baseElem.Obj(), &changed);
+            auto changedObj = changed.obj();
+            if (!changedObj.isEmpty()) {
+                out->append(elem.fieldNameStringData(), changedObj);
+            }
+        } else if (elem.type() != baseElem.type() || !elem.binaryEqualValues(baseElem)) {
+            out->append(elem);
+        }
+    }
+
+    BSONObjIterator currentIt(current);
+    for (auto&& baseElem : base) {
+        auto elem = currentIt.more() ? currentIt.next() : BSONElement();
+        if (elem.fieldNameStringData() != baseElem.fieldNameStringData() &&
+            current[baseElem.fieldNameStringData()].eoo()) {
+            out->appendNull(baseElem.fieldNameStringData());
+        }
+    }
+}
 }  // namespace mongo
@@ -29,10 +29,14 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <map>
 #include <string>
 
 #include "mongo/db/jsobj.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -52,4 +56,34 @@ private:
     std::map<std::string, MetricTree*> _subtrees;
     std::map<std::string, ServerStatusMetric*> _metrics;
 };
+
+/**
+ * The last output of a serverStatus section, along with when it was generated and the options it
+ * was generated for.
+ */
+class CachedServerStatusSection {
+public:
+    /**
+     * Returns the cached output if it was generated for the same options as 'config', less than
+     * 'maxAge' before 'now'.
+     */
+    boost::optional<BSONObj> get(const BSONObj& config, Date_t now, Milliseconds maxAge) const;
+
+    void set(BSONObj config, Date_t generatedAt, BSONObj output);
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CachedServerStatusSection::_mutex");
+    BSONObj _config;
+    boost::optional<Date_t> _generatedAt;
+    BSONObj _output;
+};
+
+/**
+ * Appends the fields of 'current' which are missing from 'base' or have a different value there,
+ * and appends the fields of 'base' which are missing from 'current' as null. Sub-documents present
+ * in both are compared field by field, and are only appended if some field in them changed. A
+ * field which was removed thus looks the same as one whose value changed to null.
+ */
+void appendChangedFields(const BSONObj& current, const BSONObj& base, BSONObjBuilder* out);
+
 }  // namespace mongo
@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/server_status_internal.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj changedFields(const BSONObj& current, const BSONObj& base) {
+    BSONObjBuilder builder;
+    appendChangedFields(current, base, &builder);
+    return builder.obj();
+}
+
+TEST(AppendChangedFieldsTest, IdenticalDocumentsHaveNoChanges) {
+    auto doc = BSON("a" << 1 << "b" << BSON("c" << 2));
+    ASSERT_BSONOBJ_EQ(changedFields(doc, doc), BSONObj());
+}
+
+TEST(AppendChangedFieldsTest, AppendsChangedAndAddedFields) {
+    auto base = BSON("a" << 1 << "b" << 2);
+    ASSERT_BSONOBJ_EQ(changedFields(BSON("a" << 1 << "b" << 3 << "c" << 4), base),
+                      BSON("b" << 3 << "c" << 4));
+}
+
+TEST(AppendChangedFieldsTest, AppendsFieldsWhoseTypeChanged) {
+    ASSERT_BSONOBJ_EQ(changedFields(BSON("a" << 1LL), BSON("a" << 1)), BSON("a" << 1LL));
+}
+
+TEST(AppendChangedFieldsTest, AppendsOnlyChangedFieldsOfSubDocuments) {
+    auto current = BSON("a" << BSON("b" << 1 << "c" << 3) << "d" << BSON("e" << 4));
+    auto base = BSON("a" << BSON("b" << 1 << "c" << 2) << "d" << BSON("e" << 4));
+    ASSERT_BSONOBJ_EQ(changedFields(current, base), BSON("a" << BSON("c" << 3)));
+}
+
+TEST(AppendChangedFieldsTest, AppendsRemovedFieldsAsNull) {
+    auto current = BSON("a" << 1 << "c" << BSON("d" << 1));
+    auto base = BSON("a" << 1 << "b" << 2 << "c" << BSON("d" << 1 << "e" << 2));
+    ASSERT_BSONOBJ_EQ(changedFields(current, base),
+                      BSON("c" << BSON("e" << BSONNULL) << "b" << BSONNULL));
+}
+
+TEST(AppendChangedFieldsTest, ComparesFieldsInDifferentOrder) {
+    ASSERT_BSONOBJ_EQ(changedFields(BSON("b" << 2 << "a" << 3), BSON("a" << 1 << "b" << 2)),
+                      BSON("a" << 3));
+}
+
+TEST(CachedServerStatusSectionTest, EmptyCacheHasNoOutput) {
+    CachedServerStatusSection cache;
+    ASSERT_FALSE(cache.get(BSONObj(), Date_t::now(), Milliseconds(500)));
+}
+
+TEST(CachedServerStatusSectionTest, OutputExpiresAfterTheInterval) {
+    CachedServerStatusSection cache;
+    const auto generatedAt = Date_t::now();
+    cache.set(BSONObj(), generatedAt, BSON("a" << 1));
+
+    auto cached = cache.get(BSONObj(), generatedAt + Milliseconds(499), Milliseconds(500));
+    ASSERT(cached);
+    ASSERT_BSONOBJ_EQ(*cached, BSON("a" << 1));
+    ASSERT_FALSE(cache.get(BSONObj(), generatedAt + Milliseconds(500), Milliseconds(500)));
+}
+
+TEST(CachedServerStatusSectionTest, OutputIsKeyedByTheSectionOptions) {
+    CachedServerStatusSection cache;
+    const auto generatedAt = Date_t::now();
+    cache.set(BSON("" << 2), generatedAt, BSON("a" << 1));
+
+    ASSERT(cache.get(BSON("" << 2), generatedAt, Milliseconds(500)));
+    ASSERT_FALSE(cache.get(BSON("" << 1), generatedAt, Milliseconds(500)));
+    ASSERT_FALSE(cache.get(BSONObj(), generatedAt, Milliseconds(500)));
+
+    // Setting output for other options replaces the earlier output.
+    cache.set(BSON("" << 1), generatedAt, BSON("a" << 2));
+    ASSERT_FALSE(cache.get(BSON("" << 2), generatedAt, Milliseconds(500)));
+    ASSERT_BSONOBJ_EQ(*cache.get(BSON("" << 1), generatedAt, Milliseconds(500)), BSON("a" << 2));
+}
+
+}  // namespace
+}  // namespace mongo
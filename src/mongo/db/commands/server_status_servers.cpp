@@ -31,6 +31,7 @@
 
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/transport/service_executor_fixed.h"
@@ -183,6 +184,22 @@ public:
             getHostFQDNs(getHostNameCached(), HostnameCanonicalizationMode::kForwardAndReverse));
     }
 } advisoryHostFQDNs;
+
+class WaitEvents final : public ServerStatusSection {
+public:
+    WaitEvents() : ServerStatusSection("waitEvents") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        WaitEventStats::appendGlobal(&builder);
+        return builder.obj();
+    }
+} waitEvents;
 }  // namespace
 
 }  // namespace mongo
@@ -0,0 +1,83 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/concurrency/admission_context.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+const auto getAdmissionContext = OperationContext::declareDecoration<AdmissionContext>();
+
+}  // namespace
+
+StatusWith<AdmissionPriority> parseAdmissionPriority(StringData priority) {
+    for (auto candidate :
+         {AdmissionPriority::kLow, AdmissionPriority::kNormal, AdmissionPriority::kHigh}) {
+        if (priority == toString(candidate)) {
+            return candidate;
+        }
+    }
+    return {ErrorCodes::BadValue,
+            str::stream() << "Invalid admission priority '" << priority
+                          << "', expected 'low', 'normal' or 'high'"};
+}
+
+AdmissionPriority parseAdmissionPriorityField(const BSONElement& elem, bool isInternalClient) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << kAdmissionPriorityFieldName << " must be a string",
+            elem.type() == String);
+    auto priority = uassertStatusOK(parseAdmissionPriority(elem.valueStringData()));
+    uassert(ErrorCodes::Unauthorized,
+            str::stream() << "Only internal clients may request " << kAdmissionPriorityFieldName
+                          << " '" << toString(AdmissionPriority::kHigh) << "'",
+            priority != AdmissionPriority::kHigh || isInternalClient);
+    return priority;
+}
+
+AdmissionContext& AdmissionContext::get(OperationContext* opCtx) {
+    return getAdmissionContext(opCtx);
+}
+
+ScopedAdmissionPriority::ScopedAdmissionPriority(OperationContext* opCtx,
+                                                 AdmissionPriority priority)
+    : _opCtx(opCtx), _originalPriority(AdmissionContext::get(opCtx).getPriority()) {
+    AdmissionContext::get(_opCtx).setPriority(priority);
+}
+
+ScopedAdmissionPriority::~ScopedAdmissionPriority() {
+    AdmissionContext::get(_opCtx).setPriority(_originalPriority);
+}
+
+}  // namespace mongo
@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/util/concurrency/admission_priority.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Parses "low", "normal" or "high".
+ */
+StatusWith<AdmissionPriority> parseAdmissionPriority(StringData priority);
+
+/**
+ * Generic command argument through which clients choose the priority of their operation.
+ */
+constexpr auto kAdmissionPriorityFieldName = "$priority"_sd;
+
+/**
+ * Parses the '$priority' command argument. Any client may lower the priority of its operations,
+ * but only internal clients may raise it above normal. Throws on invalid values.
+ */
+AdmissionPriority parseAdmissionPriorityField(const BSONElement& elem, bool isInternalClient);
+
+/**
+ * Per-operation admission control state, stored as a decoration on the OperationContext.
+ */
+class AdmissionContext {
+public:
+    static AdmissionContext& get(OperationContext* opCtx);
+
+    AdmissionPriority getPriority() const {
+        return _priority;
+    }
+
+    void setPriority(AdmissionPriority priority) {
+        _priority = priority;
+    }
+
+private:
+    AdmissionPriority _priority = AdmissionPriority::kNormal;
+};
+
+/**
+ * Sets the admission priority of an operation for the lifetime of this object, then restores the
+ * previous one.
+ */
+class ScopedAdmissionPriority {
+    ScopedAdmissionPriority(const ScopedAdmissionPriority&) = delete;
+    ScopedAdmissionPriority& operator=(const ScopedAdmissionPriority&) = delete;
+
+public:
+    ScopedAdmissionPriority(OperationContext* opCtx, AdmissionPriority priority);
+    ~ScopedAdmissionPriority();
+
+private:
+    OperationContext* const _opCtx;
+    const AdmissionPriority _originalPriority;
+};
+
+}  // namespace mongo
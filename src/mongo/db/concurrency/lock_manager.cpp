@@ -413,9 +413,13 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+// Balance scalability of intent locks against potential added cost of conflicting locks. Intent
+// requests on the global and database resources only take the mutex of their locker's partition,
+// so there should be roughly as many partitions as there are concurrently running operations for
+// these to remain uncontended. Migrating to the regular LockHead on a conflicting request only
+// visits the partitions that were actually used, so a larger value mostly costs memory. Should be
+// a power of two.
+const unsigned LockManager::_numPartitions = 128;
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
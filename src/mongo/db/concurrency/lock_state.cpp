@@ -37,9 +37,12 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
+#include "mongo/db/concurrency/admission_context.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/wait_events.h"
+#include "mongo/db/stats/wait_latency_metrics.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/compiler.h"
@@ -282,6 +285,11 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+TicketHolder* Locker::getGlobalThrottling(LockMode mode) {
+    return ticketHolders[mode];
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -359,11 +367,17 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
         if (opCtx)
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
+        // Uninterruptible waits still queue with the priority of the operation.
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return false;
+        const auto priority =
+            opCtx ? AdmissionContext::get(opCtx).getPriority() : AdmissionPriority::kNormal;
+        // Only time the wait if a ticket is not immediately available. tryAcquire() does not jump
+        // ahead of queued operations, so this does not change the order tickets are granted in.
+        if (!holder->tryAcquire()) {
+            ScopedWaitEvent ticketWait(opCtx, WaitEvent::kTicket);
+            if (!holder->waitForTicketUntil(interruptible, priority, deadline)) {
+                return false;
+            }
         }
         restoreStateOnErrorGuard.dismiss();
     }
@@ -993,6 +1007,10 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     invariant(result == LOCK_OK);
     unlockOnErrorGuard.dismiss();
     _setWaitingResource(ResourceId());
+
+    WaitLatencyMetrics::get().record(
+        WaitLatencyMetrics::WaitType::kLock,
+        Microseconds(static_cast<int64_t>(curTimeMicros64() - startOfTotalWaitTime)));
 }
 
 void LockerImpl::getFlowControlTicket(OperationContext* opCtx, LockMode lockMode) {
@@ -76,6 +76,12 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Returns the ticket holder which throttles global lock acquisitions in the given mode, or
+     * nullptr if global throttling has not been set up or does not apply to 'mode'.
+     */
+    static class TicketHolder* getGlobalThrottling(LockMode mode);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
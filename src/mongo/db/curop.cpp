@@ -50,6 +50,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -565,6 +566,17 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
             }
         }
 
+        // Storage statistics are only gathered here, for slow operations, so the storage cache
+        // wait event and histogram are limited to those.
+        if (_debug.storageStats) {
+            auto storageStats = _debug.storageStats->toBSON();
+            auto cacheWait =
+                Microseconds(storageStats["timeWaitingMicros"]["cache"].safeNumberLong());
+            if (cacheWait > Microseconds::zero()) {
+                WaitEventStats::record(opCtx, WaitEvent::kStorageCache, cacheWait);
+            }
+        }
+
         // Gets the time spent blocked on prepare conflicts.
         auto prepareConflictDurationMicros =
             PrepareConflictTracker::get(opCtx).getPrepareConflictDuration();
@@ -751,6 +763,11 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
 
     builder->append("numYields", _numYields.load());
 
+    if (auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder(builder->subobjStart("waitEvents"));
+        waitEvents.append(&waitEventsBuilder);
+    }
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -925,6 +942,12 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " storage:" << storageStats->toBSON().toString();
     }
 
+    if (auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder;
+        waitEvents.append(&waitEventsBuilder);
+        s << " waitEvents:" << waitEventsBuilder.obj().toString();
+    }
+
     if (iscommand) {
         s << " protocol:" << getProtoString(networkOp);
     }
@@ -1096,6 +1119,12 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("storage", storageStats->toBSON());
     }
 
+    if (auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder;
+        waitEvents.append(&waitEventsBuilder);
+        pAttrs->add("waitEvents", waitEventsBuilder.obj());
+    }
+
     if (operationMetrics) {
         BSONObjBuilder builder;
         operationMetrics->toBsonNonZeroFields(&builder);
@@ -1220,6 +1249,11 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("storage", storageStats->toBSON());
     }
 
+    if (auto& waitEvents = WaitEventStats::get(opCtx); !waitEvents.empty()) {
+        BSONObjBuilder waitEventsBuilder(b.subobjStart("waitEvents"));
+        waitEvents.append(&waitEventsBuilder);
+    }
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
@@ -1476,6 +1510,13 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("waitEvents", [](auto field, auto args, auto& b) {
+        if (auto& waitEvents = WaitEventStats::get(args.opCtx); !waitEvents.empty()) {
+            BSONObjBuilder waitEventsBuilder(b.subobjStart(field));
+            waitEvents.append(&waitEventsBuilder);
+        }
+    });
+
     // Don't short-circuit: call needs() for every supported field, so that at the end we can
     // uassert that no unsupported fields were requested.
     bool needsOk = needs("ok");
@@ -89,4 +89,26 @@ TEST_F(LimitSkipStageTest, LimitSkipSimpleTest) {
     ASSERT_TRUE(limit->getNext() == PlanState::IS_EOF);
 }
 
+TEST_F(LimitSkipStageTest, TimingInfoIsCollectedWhenRequested) {
+    auto ctx = makeCompileCtx();
+
+    auto limit = makeS<LimitSkipStage>(
+        makeS<CoScanStage>(kEmptyPlanNodeId), 1000, boost::none, kEmptyPlanNodeId);
+    ASSERT_FALSE(limit->getCommonStats()->cpuNanos);
+
+    limit->markShouldCollectTimingInfo(false);
+    prepareTree(ctx.get(), limit.get());
+    while (limit->getNext() == PlanState::ADVANCED) {
+    }
+
+    auto stats = limit->getStats(false /* includeDebugInfo */);
+    ASSERT_EQ(stats->children.size(), 1U);
+    ASSERT(stats->common.cpuNanos);
+    ASSERT(stats->children[0]->common.cpuNanos);
+    ASSERT_GTE(*stats->common.cpuNanos, *stats->children[0]->common.cpuNanos);
+    ASSERT(stats->common.wallNanos);
+    ASSERT_GTE(*stats->common.wallNanos, *stats->children[0]->common.wallNanos);
+    ASSERT_FALSE(stats->common.instructions);
+}
+
 }  // namespace mongo::sbe
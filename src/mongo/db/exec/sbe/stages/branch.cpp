@@ -105,7 +105,7 @@ value::SlotAccessor* BranchStage::getAccessor(CompileCtx& ctx, value::SlotId slo
     return ctx.getAccessor(slot);
 }
 
-void BranchStage::open(bool reOpen) {
+void BranchStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _specificStats.numTested++;
 
@@ -131,7 +131,7 @@ void BranchStage::open(bool reOpen) {
     }
 }
 
-PlanState BranchStage::getNext() {
+PlanState BranchStage::doGetNext() {
     if (!_activeBranch) {
         return trackPlanState(PlanState::IS_EOF);
     }
@@ -157,7 +157,7 @@ PlanState BranchStage::getNext() {
     }
 }
 
-void BranchStage::close() {
+void BranchStage::doClose() {
     _commonStats.closes++;
 
     if (_thenOpened) {
@@ -81,12 +81,12 @@ value::SlotAccessor* BSONScanStage::getAccessor(CompileCtx& ctx, value::SlotId s
     return ctx.getAccessor(slot);
 }
 
-void BSONScanStage::open(bool reOpen) {
+void BSONScanStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _bsonCurrent = _bsonBegin;
 }
 
-PlanState BSONScanStage::getNext() {
+PlanState BSONScanStage::doGetNext() {
     if (_bsonCurrent < _bsonEnd) {
         if (_recordAccessor) {
             _recordAccessor->reset(value::TypeTags::bsonObject,
@@ -128,7 +128,7 @@ PlanState BSONScanStage::getNext() {
     return trackPlanState(PlanState::IS_EOF);
 }
 
-void BSONScanStage::close() {
+void BSONScanStage::doClose() {
     _commonStats.closes++;
 }
 
@@ -67,13 +67,13 @@ value::SlotAccessor* CheckBoundsStage::getAccessor(CompileCtx& ctx, value::SlotI
     return _children[0]->getAccessor(ctx, slot);
 }
 
-void CheckBoundsStage::open(bool reOpen) {
+void CheckBoundsStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
     _isEOF = false;
 }
 
-PlanState CheckBoundsStage::getNext() {
+PlanState CheckBoundsStage::doGetNext() {
     if (_isEOF) {
         return trackPlanState(PlanState::IS_EOF);
     }
@@ -121,7 +121,7 @@ PlanState CheckBoundsStage::getNext() {
     return trackPlanState(state);
 }
 
-void CheckBoundsStage::close() {
+void CheckBoundsStage::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
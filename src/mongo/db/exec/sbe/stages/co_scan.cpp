@@ -44,11 +44,11 @@ value::SlotAccessor* CoScanStage::getAccessor(CompileCtx& ctx, value::SlotId slo
     return ctx.getAccessor(slot);
 }
 
-void CoScanStage::open(bool reOpen) {
+void CoScanStage::doOpen(bool reOpen) {
     _commonStats.opens++;
 }
 
-PlanState CoScanStage::getNext() {
+PlanState CoScanStage::doGetNext() {
     checkForInterrupt(_opCtx);
 
     // Run forever.
@@ -65,7 +65,7 @@ const SpecificStats* CoScanStage::getSpecificStats() const {
     return nullptr;
 }
 
-void CoScanStage::close() {
+void CoScanStage::doClose() {
     _commonStats.closes++;
 }
 
@@ -196,7 +196,7 @@ value::SlotAccessor* ExchangeConsumer::getAccessor(CompileCtx& ctx, value::SlotI
 
     return ctx.getAccessor(slot);
 }
-void ExchangeConsumer::open(bool reOpen) {
+void ExchangeConsumer::doOpen(bool reOpen) {
     _commonStats.opens++;
 
     if (reOpen) {
@@ -288,7 +288,7 @@ void ExchangeConsumer::open(bool reOpen) {
     }
 }
 
-PlanState ExchangeConsumer::getNext() {
+PlanState ExchangeConsumer::doGetNext() {
     if (_orderPreserving) {
         // Build a heap and return min element.
         uasserted(4822834, "ordere exchange not yet implemented");
@@ -320,7 +320,7 @@ PlanState ExchangeConsumer::getNext() {
     }
     return trackPlanState(PlanState::IS_EOF);
 }
-void ExchangeConsumer::close() {
+void ExchangeConsumer::doClose() {
     _commonStats.closes++;
 
     {
@@ -489,7 +489,7 @@ void ExchangeProducer::prepare(CompileCtx& ctx) {
 value::SlotAccessor* ExchangeProducer::getAccessor(CompileCtx& ctx, value::SlotId slot) {
     return _children[0]->getAccessor(ctx, slot);
 }
-void ExchangeProducer::open(bool reOpen) {
+void ExchangeProducer::doOpen(bool reOpen) {
     _commonStats.opens++;
     if (reOpen) {
         uasserted(4822839, "exchange producer cannot be reopened");
@@ -512,7 +512,7 @@ bool ExchangeProducer::appendData(size_t consumerId) {
     return true;
 }
 
-PlanState ExchangeProducer::getNext() {
+PlanState ExchangeProducer::doGetNext() {
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         // Push to the correct pipe.
         switch (_state->policy()) {
@@ -553,7 +553,7 @@ PlanState ExchangeProducer::getNext() {
     }
     return trackPlanState(PlanState::IS_EOF);
 }
-void ExchangeProducer::close() {
+void ExchangeProducer::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
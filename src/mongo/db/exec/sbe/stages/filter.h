@@ -69,7 +69,7 @@ public:
         return _children[0]->getAccessor(ctx, slot);
     }
 
-    void open(bool reOpen) final {
+    void doOpen(bool reOpen) final {
         _commonStats.opens++;
 
         if constexpr (IsConst) {
@@ -77,7 +77,7 @@ public:
 
             auto pass = _bytecode.runPredicate(_filterCode.get());
             if (!pass) {
-                close();
+                doClose();
                 return;
             }
         }
@@ -85,7 +85,7 @@ public:
         _childOpened = true;
     }
 
-    PlanState getNext() final {
+    PlanState doGetNext() final {
         // The constant filter evaluates the predicate in the open method.
         if constexpr (IsConst) {
             if (!_childOpened) {
@@ -117,7 +117,7 @@ public:
         return trackPlanState(state);
     }
 
-    void close() final {
+    void doClose() final {
         _commonStats.closes++;
 
         if (_childOpened) {
@@ -101,7 +101,7 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
     return ctx.getAccessor(slot);
 }
 
-void HashAggStage::open(bool reOpen) {
+void HashAggStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
@@ -139,7 +139,7 @@ void HashAggStage::open(bool reOpen) {
     _htIt = _ht.end();
 }
 
-PlanState HashAggStage::getNext() {
+PlanState HashAggStage::doGetNext() {
     if (_htIt == _ht.end()) {
         _htIt = _ht.begin();
     } else {
@@ -177,7 +177,7 @@ const SpecificStats* HashAggStage::getSpecificStats() const {
     return nullptr;
 }
 
-void HashAggStage::close() {
+void HashAggStage::doClose() {
     _commonStats.closes++;
     _ht.clear();
 }
@@ -118,7 +118,7 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
     return ctx.getAccessor(slot);
 }
 
-void HashJoinStage::open(bool reOpen) {
+void HashJoinStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
     // Insert the outer side into the hash table.
@@ -151,7 +151,7 @@ void HashJoinStage::open(bool reOpen) {
     _htItEnd = _ht.end();
 }
 
-PlanState HashJoinStage::getNext() {
+PlanState HashJoinStage::doGetNext() {
     if (_htIt != _htItEnd) {
         ++_htIt;
     }
@@ -182,7 +182,7 @@ PlanState HashJoinStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
-void HashJoinStage::close() {
+void HashJoinStage::doClose() {
     _commonStats.closes++;
     _children[1]->close();
 }
@@ -167,7 +167,7 @@ void IndexScanStage::doAttachToTrialRunTracker(TrialRunTracker* tracker) {
     _tracker = tracker;
 }
 
-void IndexScanStage::open(bool reOpen) {
+void IndexScanStage::doOpen(bool reOpen) {
     _commonStats.opens++;
 
     invariant(_opCtx);
@@ -244,7 +244,7 @@ void IndexScanStage::open(bool reOpen) {
     }
 }
 
-PlanState IndexScanStage::getNext() {
+PlanState IndexScanStage::doGetNext() {
     if (!_cursor) {
         return trackPlanState(PlanState::IS_EOF);
     }
@@ -303,7 +303,7 @@ PlanState IndexScanStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
-void IndexScanStage::close() {
+void IndexScanStage::doClose() {
     _commonStats.closes++;
 
     _cursor.reset();
@@ -60,7 +60,7 @@ value::SlotAccessor* LimitSkipStage::getAccessor(CompileCtx& ctx, value::SlotId
     return _children[0]->getAccessor(ctx, slot);
 }
 
-void LimitSkipStage::open(bool reOpen) {
+void LimitSkipStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _isEOF = false;
     _children[0]->open(reOpen);
@@ -72,14 +72,14 @@ void LimitSkipStage::open(bool reOpen) {
     }
     _current = 0;
 }
-PlanState LimitSkipStage::getNext() {
+PlanState LimitSkipStage::doGetNext() {
     if (_isEOF || (_limit && _current++ == *_limit)) {
         return trackPlanState(PlanState::IS_EOF);
     }
 
     return trackPlanState(_children[0]->getNext());
 }
-void LimitSkipStage::close() {
+void LimitSkipStage::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
@@ -87,7 +87,7 @@ value::SlotAccessor* LoopJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
     return _children[1]->getAccessor(ctx, slot);
 }
 
-void LoopJoinStage::open(bool reOpen) {
+void LoopJoinStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
     _outerGetNext = true;
@@ -102,7 +102,7 @@ void LoopJoinStage::openInner() {
     ++_specificStats.innerOpens;
 }
 
-PlanState LoopJoinStage::getNext() {
+PlanState LoopJoinStage::doGetNext() {
     if (_outerGetNext) {
         auto state = _children[0]->getNext();
         if (state != PlanState::ADVANCED) {
@@ -142,7 +142,7 @@ PlanState LoopJoinStage::getNext() {
     }
 }
 
-void LoopJoinStage::close() {
+void LoopJoinStage::doClose() {
     _commonStats.closes++;
 
     if (_reOpenInner) {
@@ -110,12 +110,12 @@ void MakeObjStage::projectField(value::Object* obj, size_t idx) {
     }
 }
 
-void MakeObjStage::open(bool reOpen) {
+void MakeObjStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 }
 
-PlanState MakeObjStage::getNext() {
+PlanState MakeObjStage::doGetNext() {
     auto state = _children[0]->getNext();
 
     if (state == PlanState::ADVANCED) {
@@ -196,7 +196,7 @@ PlanState MakeObjStage::getNext() {
     return trackPlanState(state);
 }
 
-void MakeObjStage::close() {
+void MakeObjStage::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
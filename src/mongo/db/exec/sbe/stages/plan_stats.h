@@ -60,6 +60,20 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // Thread CPU time spent inside open(), getNext() and close() of this stage, including the time
+    // spent in its children. When set to boost::none, the stage is not timed. Populated when
+    // running explain, see PlanStage::markShouldCollectTimingInfo().
+    boost::optional<long long> cpuNanos;
+
+    // Wall clock time spent over the same calls as 'cpuNanos', which explain reports as the
+    // stage's executionTimeMillisEstimate, like the classic engine does.
+    boost::optional<long long> wallNanos;
+
+    // Retired instructions and last level cache misses, accumulated over the same calls as
+    // 'cpuNanos'. Only populated when hardware counters were requested and are available.
+    boost::optional<long long> instructions;
+    boost::optional<long long> cacheMisses;
+
     size_t advances{0};
     size_t opens{0};
     size_t closes{0};
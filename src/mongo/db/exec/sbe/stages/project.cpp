@@ -68,12 +68,12 @@ value::SlotAccessor* ProjectStage::getAccessor(CompileCtx& ctx, value::SlotId sl
         return _children[0]->getAccessor(ctx, slot);
     }
 }
-void ProjectStage::open(bool reOpen) {
+void ProjectStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 }
 
-PlanState ProjectStage::getNext() {
+PlanState ProjectStage::doGetNext() {
     auto state = _children[0]->getNext();
 
     if (state == PlanState::ADVANCED) {
@@ -89,7 +89,7 @@ PlanState ProjectStage::getNext() {
     return trackPlanState(state);
 }
 
-void ProjectStage::close() {
+void ProjectStage::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
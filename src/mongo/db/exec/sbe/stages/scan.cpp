@@ -163,7 +163,7 @@ void ScanStage::doAttachToTrialRunTracker(TrialRunTracker* tracker) {
     _tracker = tracker;
 }
 
-void ScanStage::open(bool reOpen) {
+void ScanStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     invariant(_opCtx);
     if (!reOpen) {
@@ -206,7 +206,7 @@ void ScanStage::open(bool reOpen) {
     _firstGetNext = true;
 }
 
-PlanState ScanStage::getNext() {
+PlanState ScanStage::doGetNext() {
     if (!_cursor) {
         return trackPlanState(PlanState::IS_EOF);
     }
@@ -268,7 +268,7 @@ PlanState ScanStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
-void ScanStage::close() {
+void ScanStage::doClose() {
     _commonStats.closes++;
     _cursor.reset();
     _coll.reset();
@@ -460,7 +460,7 @@ void ParallelScanStage::doAttachToOperationContext(OperationContext* opCtx) {
     }
 }
 
-void ParallelScanStage::open(bool reOpen) {
+void ParallelScanStage::doOpen(bool reOpen) {
     invariant(_opCtx);
     invariant(!reOpen, "parallel scan is not restartable");
 
@@ -521,7 +521,7 @@ boost::optional<Record> ParallelScanStage::nextRange() {
     }
 }
 
-PlanState ParallelScanStage::getNext() {
+PlanState ParallelScanStage::doGetNext() {
     if (!_cursor) {
         _commonStats.isEOF = true;
         return PlanState::IS_EOF;
@@ -584,7 +584,7 @@ PlanState ParallelScanStage::getNext() {
     return PlanState::ADVANCED;
 }
 
-void ParallelScanStage::close() {
+void ParallelScanStage::doClose() {
     _cursor.reset();
     _coll.reset();
     _open = false;
@@ -155,7 +155,7 @@ void SortStage::doAttachToTrialRunTracker(TrialRunTracker* tracker) {
     _tracker = tracker;
 }
 
-void SortStage::open(bool reOpen) {
+void SortStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
@@ -201,7 +201,7 @@ void SortStage::open(bool reOpen) {
     _children[0]->close();
 }
 
-PlanState SortStage::getNext() {
+PlanState SortStage::doGetNext() {
     // When the sort spilled data to disk then read back the sorted runs.
     if (_mergeIt && _mergeIt->more()) {
         _mergeData = _mergeIt->next();
@@ -212,7 +212,7 @@ PlanState SortStage::getNext() {
     }
 }
 
-void SortStage::close() {
+void SortStage::doClose() {
     _commonStats.closes++;
     _mergeIt.reset();
     _sorter.reset();
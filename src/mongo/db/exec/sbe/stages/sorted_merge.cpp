@@ -120,7 +120,7 @@ value::SlotAccessor* SortedMergeStage::getAccessor(CompileCtx& ctx, value::SlotI
     return ctx.getAccessor(slot);
 }
 
-void SortedMergeStage::open(bool reOpen) {
+void SortedMergeStage::doOpen(bool reOpen) {
     ++_commonStats.opens;
 
     for (size_t i = 0; i < _children.size(); ++i) {
@@ -130,11 +130,11 @@ void SortedMergeStage::open(bool reOpen) {
     _merger->init();
 }
 
-PlanState SortedMergeStage::getNext() {
+PlanState SortedMergeStage::doGetNext() {
     return _merger->getNext();
 }
 
-void SortedMergeStage::close() {
+void SortedMergeStage::doClose() {
     ++_commonStats.closes;
     for (auto& child : _children) {
         child->close();
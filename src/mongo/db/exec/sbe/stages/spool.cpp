@@ -73,7 +73,7 @@ value::SlotAccessor* SpoolEagerProducerStage::getAccessor(CompileCtx& ctx, value
     return ctx.getAccessor(slot);
 }
 
-void SpoolEagerProducerStage::open(bool reOpen) {
+void SpoolEagerProducerStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
@@ -97,7 +97,7 @@ void SpoolEagerProducerStage::open(bool reOpen) {
     _bufferIt = _buffer->size();
 }
 
-PlanState SpoolEagerProducerStage::getNext() {
+PlanState SpoolEagerProducerStage::doGetNext() {
     if (_bufferIt == _buffer->size()) {
         _bufferIt = 0;
     } else {
@@ -111,7 +111,7 @@ PlanState SpoolEagerProducerStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
-void SpoolEagerProducerStage::close() {
+void SpoolEagerProducerStage::doClose() {
     _commonStats.closes++;
 }
 
@@ -207,7 +207,7 @@ value::SlotAccessor* SpoolLazyProducerStage::getAccessor(CompileCtx& ctx, value:
     return ctx.getAccessor(slot);
 }
 
-void SpoolLazyProducerStage::open(bool reOpen) {
+void SpoolLazyProducerStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
@@ -216,7 +216,7 @@ void SpoolLazyProducerStage::open(bool reOpen) {
     }
 }
 
-PlanState SpoolLazyProducerStage::getNext() {
+PlanState SpoolLazyProducerStage::doGetNext() {
     auto state = _children[0]->getNext();
 
     if (state == PlanState::ADVANCED) {
@@ -252,7 +252,7 @@ PlanState SpoolLazyProducerStage::getNext() {
     return trackPlanState(state);
 }
 
-void SpoolLazyProducerStage::close() {
+void SpoolLazyProducerStage::doClose() {
     _commonStats.closes++;
 }
 
@@ -57,9 +57,9 @@ public:
 
     void prepare(CompileCtx& ctx) final;
     value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
-    void open(bool reOpen) final;
-    PlanState getNext() final;
-    void close() final;
+    void doOpen(bool reOpen) final;
+    PlanState doGetNext() final;
+    void doClose() final;
 
     std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
     const SpecificStats* getSpecificStats() const final;
@@ -105,9 +105,9 @@ public:
 
     void prepare(CompileCtx& ctx) final;
     value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
-    void open(bool reOpen) final;
-    PlanState getNext() final;
-    void close() final;
+    void doOpen(bool reOpen) final;
+    PlanState doGetNext() final;
+    void doClose() final;
 
     std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
     const SpecificStats* getSpecificStats() const final;
@@ -180,12 +180,12 @@ public:
         return ctx.getAccessor(slot);
     }
 
-    void open(bool reOpen) {
+    void doOpen(bool reOpen) {
         _commonStats.opens++;
         _bufferIt = _buffer->size();
     }
 
-    PlanState getNext() {
+    PlanState doGetNext() {
         if constexpr (IsStack) {
             if (_bufferIt != _buffer->size()) {
                 _buffer->erase(_buffer->begin() + _bufferIt);
@@ -210,7 +210,7 @@ public:
         return trackPlanState(PlanState::ADVANCED);
     }
 
-    void close() {
+    void doClose() {
         _commonStats.closes++;
     }
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/util/debug_print.h"
+#include "mongo/db/exec/sbe/util/stage_timer.h"
 #include "mongo/db/exec/sbe/values/slot.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/scoped_timer.h"
@@ -233,6 +234,25 @@ public:
         stage->doAttachToTrialRunTracker(tracker);
     }
 
+    /**
+     * Forces this stage and all of its children to time their execution, and to also count
+     * instructions and cache misses if 'hardwareCounters' is true and the platform supports it.
+     * Must not be called after execution has started.
+     */
+    void markShouldCollectTimingInfo(bool hardwareCounters) {
+        _commonStats.cpuNanos.emplace(0);
+        _commonStats.wallNanos.emplace(0);
+        if (hardwareCounters && StageTimer::hardwareCountersAvailable()) {
+            _commonStats.instructions.emplace(0);
+            _commonStats.cacheMisses.emplace(0);
+        }
+
+        auto stage = static_cast<T*>(this);
+        for (auto&& child : stage->_children) {
+            child->markShouldCollectTimingInfo(hardwareCounters);
+        }
+    }
+
 protected:
     PlanState trackPlanState(PlanState state) {
         if (state == PlanState::IS_EOF) {
@@ -326,19 +346,28 @@ public:
      * When reOpen flag is true then the plan stage should reinitizalize already acquired resources
      * (e.g. re-hash, re-sort, re-seek, etc).
      */
-    virtual void open(bool reOpen) = 0;
+    void open(bool reOpen) {
+        StageTimer timer(&_commonStats);
+        doOpen(reOpen);
+    }
 
     /**
      * Moves to the next position. If the end is reached then return EOF otherwise ADVANCED. Callers
      * are not required to call getNext until EOF. They can stop consuming results at any time. Once
      * EOF is reached it will stay at EOF unless reopened.
      */
-    virtual PlanState getNext() = 0;
+    PlanState getNext() {
+        StageTimer timer(&_commonStats);
+        return doGetNext();
+    }
 
     /**
      * The mirror method to open(). It releases any acquired resources.
      */
-    virtual void close() = 0;
+    void close() {
+        StageTimer timer(&_commonStats);
+        doClose();
+    }
 
     virtual std::vector<DebugPrinter::Block> debugPrint() const {
         auto stats = getCommonStats();
@@ -351,6 +380,14 @@ public:
     friend class CanTrackStats<PlanStage>;
 
 protected:
+    /**
+     * Implementations of open(), getNext() and close() respectively. The public methods wrap them
+     * so that each stage can be timed individually.
+     */
+    virtual void doOpen(bool reOpen) = 0;
+    virtual PlanState doGetNext() = 0;
+    virtual void doClose() = 0;
+
     // Derived classes can optionally override these methods.
     virtual void doSaveState() {}
     virtual void doRestoreState() {}
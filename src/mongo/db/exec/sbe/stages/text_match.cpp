@@ -58,12 +58,12 @@ value::SlotAccessor* TextMatchStage::getAccessor(CompileCtx& ctx, value::SlotId
     return _children[0]->getAccessor(ctx, slot);
 }
 
-void TextMatchStage::open(bool reOpen) {
+void TextMatchStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 }
 
-PlanState TextMatchStage::getNext() {
+PlanState TextMatchStage::doGetNext() {
     auto state = _children[0]->getNext();
 
     if (state == PlanState::ADVANCED) {
@@ -86,7 +86,7 @@ PlanState TextMatchStage::getNext() {
     return trackPlanState(state);
 }
 
-void TextMatchStage::close() {
+void TextMatchStage::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
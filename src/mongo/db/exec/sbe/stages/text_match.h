@@ -63,11 +63,11 @@ public:
 
     value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
 
-    void open(bool reOpen) final;
+    void doOpen(bool reOpen) final;
 
-    PlanState getNext() final;
+    PlanState doGetNext() final;
 
-    void close() final;
+    void doClose() final;
 
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
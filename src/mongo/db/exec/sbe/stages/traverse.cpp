@@ -123,7 +123,7 @@ value::SlotAccessor* TraverseStage::getAccessor(CompileCtx& ctx, value::SlotId s
     }
 }
 
-void TraverseStage::open(bool reOpen) {
+void TraverseStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
     // Do not open the inner child as we do not have values of correlated parameters yet.
@@ -139,7 +139,7 @@ void TraverseStage::openInner(value::TypeTags tag, value::Value val) {
     _reOpenInner = true;
 }
 
-PlanState TraverseStage::getNext() {
+PlanState TraverseStage::doGetNext() {
     auto state = _children[0]->getNext();
     if (state != PlanState::ADVANCED) {
         return trackPlanState(state);
@@ -249,7 +249,7 @@ bool TraverseStage::traverse(value::SlotAccessor* inFieldAccessor,
     return earlyExit;
 }
 
-void TraverseStage::close() {
+void TraverseStage::doClose() {
     _commonStats.closes++;
 
     if (_reOpenInner) {
@@ -93,7 +93,7 @@ value::SlotAccessor* UnionStage::getAccessor(CompileCtx& ctx, value::SlotId slot
     return ctx.getAccessor(slot);
 }
 
-void UnionStage::open(bool reOpen) {
+void UnionStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     if (reOpen) {
         std::queue<UnionBranch> emptyQueue;
@@ -108,7 +108,7 @@ void UnionStage::open(bool reOpen) {
     _currentStage = _remainingBranchesToDrain.front().stage;
 }
 
-PlanState UnionStage::getNext() {
+PlanState UnionStage::doGetNext() {
     auto state = PlanState::IS_EOF;
 
     while (!_remainingBranchesToDrain.empty() && state != PlanState::ADVANCED) {
@@ -136,7 +136,7 @@ PlanState UnionStage::getNext() {
     return trackPlanState(state);
 }
 
-void UnionStage::close() {
+void UnionStage::doClose() {
     _commonStats.closes++;
     _currentStage = nullptr;
     while (!_remainingBranchesToDrain.empty()) {
@@ -55,12 +55,12 @@ value::SlotAccessor* UniqueStage::getAccessor(CompileCtx& ctx, value::SlotId slo
     return _children[0]->getAccessor(ctx, slot);
 }
 
-void UniqueStage::open(bool reOpen) {
+void UniqueStage::doOpen(bool reOpen) {
     ++_commonStats.opens;
     _children[0]->open(reOpen);
 }
 
-PlanState UniqueStage::getNext() {
+PlanState UniqueStage::doGetNext() {
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
         size_t idx = 0;
@@ -83,7 +83,7 @@ PlanState UniqueStage::getNext() {
     return PlanState::IS_EOF;
 }
 
-void UniqueStage::close() {
+void UniqueStage::doClose() {
     _children[0]->close();
 }
 
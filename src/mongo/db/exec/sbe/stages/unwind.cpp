@@ -86,7 +86,7 @@ value::SlotAccessor* UnwindStage::getAccessor(CompileCtx& ctx, value::SlotId slo
     return _children[0]->getAccessor(ctx, slot);
 }
 
-void UnwindStage::open(bool reOpen) {
+void UnwindStage::doOpen(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
@@ -94,7 +94,7 @@ void UnwindStage::open(bool reOpen) {
     _inArray = false;
 }
 
-PlanState UnwindStage::getNext() {
+PlanState UnwindStage::doGetNext() {
     if (!_inArray) {
         do {
             auto state = _children[0]->getNext();
@@ -150,7 +150,7 @@ PlanState UnwindStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
-void UnwindStage::close() {
+void UnwindStage::doClose() {
     _commonStats.closes++;
     _children[0]->close();
 }
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/util/stage_timer.h"
+
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/stdx/chrono.h"
+#include "mongo/util/duration.h"
+
+namespace mongo::sbe {
+namespace {
+
+long long steadyClockNanos() {
+    return durationCount<Nanoseconds>(stdx::chrono::steady_clock::now().time_since_epoch());
+}
+
+long long threadCpuNanos() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return ts.tv_sec * 1000 * 1000 * 1000LL + ts.tv_nsec;
+    }
+#endif
+    // Without a per-thread CPU clock, fall back to wall time.
+    return steadyClockNanos();
+}
+
+#if defined(__linux__)
+/**
+ * A group of per-thread hardware counters, so that both are read with a single read(2). Opened
+ * the first time a thread needs them and kept open until the thread exits.
+ */
+class ThreadHardwareCounters {
+public:
+    ThreadHardwareCounters() {
+        _leaderFd = openCounter(PERF_COUNT_HW_INSTRUCTIONS, -1);
+        if (_leaderFd < 0) {
+            return;
+        }
+        _memberFd = openCounter(PERF_COUNT_HW_CACHE_MISSES, _leaderFd);
+        if (_memberFd < 0) {
+            ::close(_leaderFd);
+            _leaderFd = -1;
+        }
+    }
+
+    ~ThreadHardwareCounters() {
+        if (_leaderFd >= 0) {
+            ::close(_memberFd);
+            ::close(_leaderFd);
+        }
+    }
+
+    static ThreadHardwareCounters& get() {
+        thread_local ThreadHardwareCounters counters;
+        return counters;
+    }
+
+    bool isOpen() const {
+        return _leaderFd >= 0;
+    }
+
+    bool read(long long* instructions, long long* cacheMisses) const {
+        if (!isOpen()) {
+            return false;
+        }
+
+        // The layout of a PERF_FORMAT_GROUP read: the number of counters, then their values.
+        struct {
+            uint64_t nr;
+            uint64_t values[2];
+        } group;
+        if (::read(_leaderFd, &group, sizeof(group)) != sizeof(group) || group.nr != 2) {
+            return false;
+        }
+        *instructions = group.values[0];
+        *cacheMisses = group.values[1];
+        return true;
+    }
+
+private:
+    static int openCounter(uint64_t config, int groupFd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // Count for the calling thread, on whichever CPU it runs.
+        return syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+    }
+
+    int _leaderFd = -1;
+    int _memberFd = -1;
+};
+#endif
+
+}  // namespace
+
+bool StageTimer::hardwareCountersAvailable() {
+#if defined(__linux__)
+    return ThreadHardwareCounters::get().isOpen();
+#else
+    return false;
+#endif
+}
+
+StageTimer::Counters StageTimer::read(bool withHardwareCounters) {
+    Counters counters;
+#if defined(__linux__)
+    if (withHardwareCounters) {
+        counters.hasHardwareCounters =
+            ThreadHardwareCounters::get().read(&counters.instructions, &counters.cacheMisses);
+    }
+#endif
+    counters.cpuNanos = threadCpuNanos();
+    counters.wallNanos = steadyClockNanos();
+    return counters;
+}
+
+void StageTimer::stop() {
+    auto end = read(_start.hasHardwareCounters);
+
+    *_stats->wallNanos += end.wallNanos - _start.wallNanos;
+    *_stats->cpuNanos += end.cpuNanos - _start.cpuNanos;
+    if (_start.hasHardwareCounters && end.hasHardwareCounters) {
+        *_stats->instructions += end.instructions - _start.instructions;
+        *_stats->cacheMisses += end.cacheMisses - _start.cacheMisses;
+    }
+}
+
+}  // namespace mongo::sbe
@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/exec/sbe/stages/plan_stats.h"
+#include "mongo/platform/compiler.h"
+
+namespace mongo::sbe {
+
+/**
+ * Adds the wall clock and thread CPU time, and the hardware counters if the stats request them,
+ * spent in its scope to the given CommonStats. Does nothing when timing is not enabled for the
+ * stage, which is the case outside of explain, so the check is kept inline.
+ */
+class StageTimer {
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+public:
+    explicit StageTimer(CommonStats* stats) : _stats(stats->cpuNanos ? stats : nullptr) {
+        if (MONGO_unlikely(_stats)) {
+            _start = read(_stats->instructions.has_value());
+        }
+    }
+
+    ~StageTimer() {
+        if (MONGO_unlikely(_stats)) {
+            stop();
+        }
+    }
+
+    /**
+     * Returns true if instruction and cache miss counters can be read on this thread. They rely on
+     * perf_event_open(2), so are only available on Linux, and only when the kernel allows
+     * unprivileged processes to monitor themselves.
+     */
+    static bool hardwareCountersAvailable();
+
+private:
+    struct Counters {
+        long long wallNanos = 0;
+        long long cpuNanos = 0;
+        long long instructions = 0;
+        long long cacheMisses = 0;
+        bool hasHardwareCounters = false;
+    };
+
+    static Counters read(bool withHardwareCounters);
+
+    void stop();
+
+    CommonStats* const _stats;
+    Counters _start;
+};
+
+}  // namespace mongo::sbe
@@ -38,13 +38,22 @@
 namespace mongo {
 
 /**
- * Compesses and uncompresses a block of buffer using zlib.
+ * Compesses and uncompresses a block of buffer using zlib or zstd.
  */
 class BlockCompressor {
     BlockCompressor(const BlockCompressor&) = delete;
     BlockCompressor& operator=(const BlockCompressor&) = delete;
 
 public:
+    /**
+     * Block compression algorithm. The algorithm is not recorded in the compressed block, callers
+     * must use the same algorithm to uncompress as was used to compress.
+     */
+    enum class Algorithm {
+        kZlib,
+        kZstd,
+    };
+
     BlockCompressor() = default;
 
     /**
@@ -53,7 +62,8 @@ public:
      * Returns a pointer to a buffer that BlockCompressor owns.
      * The returned buffer is valid until the next call to compress or uncompress.
      */
-    StatusWith<ConstDataRange> compress(ConstDataRange source);
+    StatusWith<ConstDataRange> compress(ConstDataRange source,
+                                        Algorithm algorithm = Algorithm::kZlib);
 
     /**
      * Uncompress a buffer of data.
@@ -64,7 +74,14 @@ public:
      * Returns a pointer to a buffer that BlockCompressor owns.
      * The returned buffer is valid until the next call to compress or uncompress.
      */
-    StatusWith<ConstDataRange> uncompress(ConstDataRange source, size_t maxUncompressedLength);
+    StatusWith<ConstDataRange> uncompress(ConstDataRange source,
+                                          size_t maxUncompressedLength,
+                                          Algorithm algorithm = Algorithm::kZlib);
+
+private:
+    StatusWith<ConstDataRange> _compressZstd(ConstDataRange source);
+    StatusWith<ConstDataRange> _uncompressZstd(ConstDataRange source,
+                                               size_t maxUncompressedLength);
 
 private:
     std::vector<std::uint8_t> _buffer;
@@ -37,12 +37,31 @@
 #include "mongo/db/ftdc/varint.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/bits.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
 
 using std::swap;
 
+namespace {
+
+/**
+ * Number of significant bits in value.
+ */
+std::uint32_t bitWidth(std::uint64_t value) {
+    return 64 - countLeadingZeros64(value);
+}
+
+/**
+ * Number of bytes FTDCVarInt uses to store value.
+ */
+std::size_t varIntSize(std::uint64_t value) {
+    return value == 0 ? 1 : (bitWidth(value) + 6) / 7;
+}
+
+}  // namespace
+
 StatusWith<boost::optional<std::tuple<ConstDataRange, FTDCCompressor::CompressorState, Date_t>>>
 FTDCCompressor::addSample(const BSONObj& sample, Date_t date) {
     if (_referenceDoc.isEmpty()) {
@@ -128,7 +147,12 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
     // Append count of samples - uint32 little endian
     _uncompressedChunkBuffer.appendNum(static_cast<std::uint32_t>(_deltaCount));
 
-    if (_metricsCount != 0 && _deltaCount != 0) {
+    if (_metricsCount != 0 && _deltaCount != 0 && _formatVersion >= 2) {
+        Status s = _appendColumns();
+        if (!s.isOK()) {
+            return s;
+        }
+    } else if (_metricsCount != 0 && _deltaCount != 0) {
         // On average, we do not need all 10 bytes for every sample, worst case, we grow the buffer
         DataBuilder db(_metricsCount * _deltaCount * FTDCVarInt::kMaxSizeBytes64 / 2);
 
@@ -199,7 +223,9 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
     }
 
     auto swDest = _compressor.compress(
-        ConstDataRange(_uncompressedChunkBuffer.buf(), _uncompressedChunkBuffer.len()));
+        ConstDataRange(_uncompressedChunkBuffer.buf(), _uncompressedChunkBuffer.len()),
+        _formatVersion >= 2 ? BlockCompressor::Algorithm::kZstd
+                            : BlockCompressor::Algorithm::kZlib);
 
     // The only way for compression to fail is if the buffer size calculations are wrong
     if (!swDest.isOK()) {
@@ -218,6 +244,152 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
         _referenceDocDate);
 }
 
+Status FTDCCompressor::_appendColumns() {
+    // Worst case, a column is a tag byte plus a full width bit-packed array
+    DataBuilder db(_metricsCount * (2 + _deltaCount * sizeof(std::uint64_t)));
+
+    _column.resize(_deltaCount);
+
+    for (std::uint32_t i = 0; i < _metricsCount; i++) {
+        // Convert the deltas to zig-zag encoded delta-of-deltas, and size the candidate encodings
+        std::uint64_t prevDelta = 0;
+        std::uint64_t allBits = 0;
+        std::uint64_t restBits = 0;
+        std::size_t varIntBytes = 0;
+        std::uint32_t zeroesCount = 0;
+
+        for (std::uint32_t j = 0; j < _deltaCount; j++) {
+            std::uint64_t delta = _deltas[getArrayOffset(_maxDeltas, j, i)];
+            std::uint64_t value = zigZagEncode(static_cast<std::int64_t>(delta - prevDelta));
+            prevDelta = delta;
+
+            _column[j] = value;
+            allBits |= value;
+            if (j > 0) {
+                restBits |= value;
+            }
+
+            if (value == 0) {
+                ++zeroesCount;
+                continue;
+            }
+
+            if (zeroesCount > 0) {
+                varIntBytes += varIntSize(0) + varIntSize(zeroesCount - 1);
+                zeroesCount = 0;
+            }
+
+            varIntBytes += varIntSize(value);
+        }
+
+        if (zeroesCount > 0) {
+            varIntBytes += varIntSize(0) + varIntSize(zeroesCount - 1);
+        }
+
+        const std::uint32_t width = bitWidth(allBits);
+        const std::size_t bitPackedBytes =
+            1 + (static_cast<std::size_t>(_deltaCount) * width + 7) / 8;
+
+        if (restBits == 0) {
+            auto s1 = db.writeAndAdvance(static_cast<std::uint8_t>(ColumnEncoding::kConstant));
+            if (!s1.isOK()) {
+                return s1;
+            }
+
+            auto s2 = db.writeAndAdvance(FTDCVarInt(_column[0]));
+            if (!s2.isOK()) {
+                return s2;
+            }
+        } else if (bitPackedBytes < varIntBytes) {
+            auto s1 = db.writeAndAdvance(static_cast<std::uint8_t>(ColumnEncoding::kBitPacked));
+            if (!s1.isOK()) {
+                return s1;
+            }
+
+            auto s2 = db.writeAndAdvance(static_cast<std::uint8_t>(width));
+            if (!s2.isOK()) {
+                return s2;
+            }
+
+            std::uint8_t pending = 0;
+            std::uint32_t pendingBits = 0;
+
+            for (std::uint32_t j = 0; j < _deltaCount; j++) {
+                std::uint64_t value = _column[j];
+                std::uint32_t remaining = width;
+
+                while (remaining > 0) {
+                    std::uint32_t take = std::min(remaining, 8 - pendingBits);
+                    pending |=
+                        static_cast<std::uint8_t>((value & ((1U << take) - 1)) << pendingBits);
+                    value >>= take;
+                    remaining -= take;
+                    pendingBits += take;
+
+                    if (pendingBits == 8) {
+                        auto s3 = db.writeAndAdvance(pending);
+                        if (!s3.isOK()) {
+                            return s3;
+                        }
+
+                        pending = 0;
+                        pendingBits = 0;
+                    }
+                }
+            }
+
+            if (pendingBits > 0) {
+                auto s3 = db.writeAndAdvance(pending);
+                if (!s3.isOK()) {
+                    return s3;
+                }
+            }
+        } else {
+            auto s1 = db.writeAndAdvance(static_cast<std::uint8_t>(ColumnEncoding::kVarInt));
+            if (!s1.isOK()) {
+                return s1;
+            }
+
+            // Unlike format version 1, runs of zeros do not span columns so that each column can
+            // be decoded on its own.
+            zeroesCount = 0;
+
+            for (std::uint32_t j = 0; j <= _deltaCount; j++) {
+                if (j < _deltaCount && _column[j] == 0) {
+                    ++zeroesCount;
+                    continue;
+                }
+
+                if (zeroesCount > 0) {
+                    auto s2 = db.writeAndAdvance(FTDCVarInt(0));
+                    if (!s2.isOK()) {
+                        return s2;
+                    }
+
+                    auto s3 = db.writeAndAdvance(FTDCVarInt(zeroesCount - 1));
+                    if (!s3.isOK()) {
+                        return s3;
+                    }
+
+                    zeroesCount = 0;
+                }
+
+                if (j < _deltaCount) {
+                    auto s4 = db.writeAndAdvance(FTDCVarInt(_column[j]));
+                    if (!s4.isOK()) {
+                        return s4;
+                    }
+                }
+            }
+        }
+    }
+
+    ConstDataRange cdr = db.getCursor();
+    _uncompressedChunkBuffer.appendBuf(cdr.data(), cdr.length());
+
+    return Status::OK();
+}
+
 void FTDCCompressor::reset() {
     _metrics.clear();
     _reset(BSONObj(), Date_t());
@@ -229,6 +401,7 @@ void FTDCCompressor::_reset(const BSONObj& referenceDoc, Date_t date) {
 
     _metricsCount = _metrics.size();
     _deltaCount = 0;
+    _formatVersion = _config->formatVersion;
     _prevmetrics.clear();
     swap(_prevmetrics, _metrics);
 
@@ -56,6 +56,12 @@ namespace mongo {
  * 4. Encodes zeros in Run Length Encoded pairs of <Count, Zero>
  * 5. ZLIB compresses the final processed array
  *
+ * Format version 2 (see FTDCConfig::formatVersion) changes steps 2 through 5:
+ * 2. Each metric's deltas are stored as a column of delta-of-deltas, zig-zag encoded so that
+ *    small negative values stay small. Counters that move at a steady rate become runs of zeros.
+ * 3. Each column is stored with the smallest of the encodings in ColumnEncoding.
+ * 4. ZSTD compresses the final processed array
+ *
  * NOTE: This compression ignores non-number data, and assumes the non-number data is constant
  * across all documents in the series of documents.
  */
@@ -80,6 +86,28 @@ public:
         kCompressorFull,
     };
 
+    /**
+     * Encoding of a single metric column in format version 2. Persisted to disk as a one byte tag
+     * in front of the column.
+     */
+    enum class ColumnEncoding : std::uint8_t {
+        /**
+         * Every delta-of-delta after the first is zero. The first is stored as a VarInt.
+         */
+        kConstant = 0,
+
+        /**
+         * Each delta-of-delta is VarInt packed, runs of zeros are stored as <Zero, Count - 1>.
+         */
+        kVarInt = 1,
+
+        /**
+         * A one byte bit width followed by each delta-of-delta packed into that many bits, least
+         * significant bit first.
+         */
+        kBitPacked = 2,
+    };
+
     explicit FTDCCompressor(const FTDCConfig* config) : _config(config) {}
 
     /**
@@ -120,6 +148,13 @@ public:
         return !_referenceDoc.isEmpty();
     }
 
+    /**
+     * Format version of the chunks returned by addSample() and getCompressedSamples().
+     */
+    std::uint32_t getFormatVersion() const {
+        return _formatVersion;
+    }
+
     /**
      * Gets buffer of compressed data contained in the FTDCCompressor.
      *
@@ -144,12 +179,29 @@ public:
         return metric * sampleCount + sample;
     }
 
+    /**
+     * Map signed integers to unsigned integers so that values close to zero, positive or
+     * negative, have small encodings.
+     */
+    static std::uint64_t zigZagEncode(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    static std::int64_t zigZagDecode(std::uint64_t value) {
+        return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
 private:
     /**
      * Reset the state
      */
     void _reset(const BSONObj& referenceDoc, Date_t date);
 
+    /**
+     * Append the deltas as format version 2 columns to the uncompressed chunk buffer.
+     */
+    Status _appendColumns();
+
 private:
     // Block Compressor
     BlockCompressor _compressor;
@@ -170,6 +222,9 @@ private:
     // Number of deltas recorded
     std::uint32_t _deltaCount{0};
 
+    // Format version of the current chunk
+    std::uint32_t _formatVersion{FTDCConfig::kFormatVersionDefault};
+
     // Max deltas for the current chunk
     std::size_t _maxDeltas{0};
 
@@ -186,6 +241,9 @@ private:
     // Buffer to hold metrics
     std::vector<std::uint64_t> _metrics;
     std::vector<std::uint64_t> _prevmetrics;
+
+    // Zig-zag encoded delta-of-deltas of one column, only used by format version 2
+    std::vector<std::uint64_t> _column;
 };
 
 }  // namespace mongo
@@ -122,8 +122,10 @@ TEST_F(FTDCCompressorTest, TestStrings) {
  */
 class TestTie {
 public:
-    TestTie(FTDCValidationMode mode = FTDCValidationMode::kStrict)
-        : _compressor(&_config), _mode(mode) {}
+    TestTie(FTDCValidationMode mode = FTDCValidationMode::kStrict, std::uint32_t formatVersion = 1)
+        : _compressor(&_config), _mode(mode) {
+        _config.formatVersion = formatVersion;
+    }
 
     ~TestTie() {
         validate(boost::none);
@@ -155,13 +157,15 @@ public:
     void validate(boost::optional<ConstDataRange> cdr) {
         std::vector<BSONObj> list;
         if (cdr.is_initialized()) {
-            auto sw = _decompressor.uncompress(cdr.get());
+            auto sw = _decompressor.uncompress(cdr.get(), _config.formatVersion);
             ASSERT_TRUE(sw.isOK());
             list = sw.getValue();
         } else {
             auto swBuf = _compressor.getCompressedSamples();
             ASSERT_TRUE(swBuf.isOK());
-            auto sw = _decompressor.uncompress(std::get<0>(swBuf.getValue()));
+            ASSERT_EQ(_compressor.getFormatVersion(), _config.formatVersion);
+            auto sw =
+                _decompressor.uncompress(std::get<0>(swBuf.getValue()), _config.formatVersion);
             ASSERT_TRUE(sw.isOK());
 
             list = sw.getValue();
@@ -578,4 +582,124 @@ TEST_F(FTDCCompressorTest, TestDoubleValues) {
     });
 }
 
+// Test a full buffer in format version 2
+TEST_F(FTDCCompressorTest, TestFullFormatVersion2) {
+    for (int j = 0; j < 2; j++) {
+        TestTie c(FTDCValidationMode::kStrict, 2);
+
+        auto st = c.addSample(BSON("name"
+                                   << "joe"
+                                   << "key1" << 33 << "key2" << 42));
+        ASSERT_HAS_SPACE(st);
+
+        for (size_t i = 0; i != FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault - 2; i++) {
+            st = c.addSample(BSON("name"
+                                  << "joe"
+                                  << "key1" << static_cast<long long int>(i * j) << "key2" << 45));
+            ASSERT_HAS_SPACE(st);
+        }
+
+        st = c.addSample(BSON("name"
+                              << "joe"
+                              << "key1" << 34 << "key2" << 45));
+        ASSERT_FULL(st);
+
+        // Add Value
+        st = c.addSample(BSON("name"
+                              << "joe"
+                              << "key1" << 34 << "key2" << 45));
+        ASSERT_HAS_SPACE(st);
+    }
+}
+
+// Test each of the format version 2 column encodings
+TEST_F(FTDCCompressorTest, TestColumnEncodingsFormatVersion2) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    std::uniform_int_distribution<long long> genNoise(-8, 8);
+
+    TestTie c(FTDCValidationMode::kStrict, 2);
+
+    long long counter = 1000;
+    long long bursty = 0;
+    for (size_t i = 0; i != FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault - 1; i++) {
+        counter += 17;
+        if (i % 50 == 0) {
+            bursty += 1000000;
+        }
+
+        auto st = c.addSample(BSON("constant" << 7 << "counter" << counter << "bursty" << bursty
+                                              << "noise" << genNoise(gen) << "falling"
+                                              << -static_cast<long long>(i * i)));
+        ASSERT_HAS_SPACE(st);
+    }
+}
+
+// Test many metrics in format version 2
+TEST_F(FTDCCompressorTest, TestManyMetricsFormatVersion2) {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+
+    std::uniform_int_distribution<long long> genValues(1, std::numeric_limits<long long>::max());
+    const size_t metrics = 1000;
+
+    TestTie c(FTDCValidationMode::kStrict, 2);
+
+    auto st = c.addSample(generateSample(rd, genValues, metrics));
+    ASSERT_HAS_SPACE(st);
+
+    for (size_t i = 0; i != FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault - 2; i++) {
+        st = c.addSample(generateSample(rd, genValues, metrics));
+        ASSERT_HAS_SPACE(st);
+    }
+
+    st = c.addSample(generateSample(rd, genValues, metrics));
+    ASSERT_FULL(st);
+}
+
+// Test the extremes of 64-bit values in format version 2
+TEST_F(FTDCCompressorTest, TestDoubleValuesFormatVersion2) {
+    TestTie c(FTDCValidationMode::kStrict, 2);
+
+    auto st = c.addSample(BSON("d" << 0.0));
+    ASSERT_HAS_SPACE(st);
+    st = c.addSample(BSON("d" << std::numeric_limits<double>::max()));
+    ASSERT_HAS_SPACE(st);
+    st = c.addSample(BSON("d" << std::numeric_limits<double>::lowest()));
+    ASSERT_HAS_SPACE(st);
+    st = c.addSample(BSON("d" << -42.0));
+    ASSERT_HAS_SPACE(st);
+
+    c.setExpectedDocuments({
+        BSON("d" << 0.0),
+        BSON("d" << std::numeric_limits<long long>::max()),
+        BSON("d" << std::numeric_limits<long long>::min()),
+        BSON("d" << -42.0),
+    });
+}
+
+// Format version 1 readers must not be handed format version 2 chunks
+TEST_F(FTDCCompressorTest, TestFormatVersionMismatch) {
+    FTDCConfig config;
+    config.formatVersion = 2;
+    FTDCCompressor c(&config);
+
+    auto st = c.addSample(BSON("key" << 1), Date_t());
+    ASSERT_HAS_SPACE(st);
+    st = c.addSample(BSON("key" << 2), Date_t());
+    ASSERT_HAS_SPACE(st);
+
+    auto swBuf = c.getCompressedSamples();
+    ASSERT_OK(swBuf.getStatus());
+
+    FTDCDecompressor d;
+    ASSERT_NOT_OK(d.uncompress(std::get<0>(swBuf.getValue()), 1).getStatus());
+    ASSERT_NOT_OK(d.uncompress(std::get<0>(swBuf.getValue()), 3).getStatus());
+
+    auto swDocs = d.uncompress(std::get<0>(swBuf.getValue()), 2);
+    ASSERT_OK(swDocs.getStatus());
+    ASSERT_EQ(swDocs.getValue().size(), 2U);
+}
+
 }  // namespace mongo
@@ -47,7 +47,9 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          formatVersion(kFormatVersionDefault),
+          highFrequencyPeriod(kHighFrequencyPeriodMillisDefault) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -56,7 +58,8 @@ struct FTDCConfig {
 
     /**
      * Max Size of all FTDC files. If the total file size is > maxDirectorySizeBytes by summing up
-     * all files in the FTDC directory, the extra files are removed.
+     * all files in the FTDC directory, the extra files are removed. When high frequency samples
+     * are collected, half of it goes to their files.
      */
     std::uint64_t maxDirectorySizeBytes;
 
@@ -84,6 +87,22 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Format of the metric chunks written to disk.
+     *
+     * Version 1 is the original delta + zlib format. Version 2 stores delta-of-delta columns that
+     * are varint or bit-packed, and compresses them with zstd. Readers understand both versions.
+     */
+    std::uint32_t formatVersion;
+
+    /**
+     * Period at which to run the high frequency collectors, or zero to disable them.
+     *
+     * High frequency samples are written to their own set of files since their schema is
+     * unrelated to the periodic samples.
+     */
+    Milliseconds highFrequencyPeriod;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
@@ -94,6 +113,11 @@ struct FTDCConfig {
 
     static const std::uint32_t kMaxSamplesPerArchiveMetricChunkDefault = 300;
     static const std::uint32_t kMaxSamplesPerInterimMetricChunkDefault = 10;
+
+    static const std::uint32_t kFormatVersionDefault = 1;
+    static const std::uint32_t kFormatVersionMax = 2;
+
+    static const std::int64_t kHighFrequencyPeriodMillisDefault = 0;
 };
 
 }  // namespace mongo
@@ -50,4 +50,7 @@ extern const char kFTDCCollectEndField[];
 
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
+// Subdirectory of the FTDC directory for samples from the high frequency collectors
+constexpr StringData kFTDCHighFrequencyDirectory = "highfrequency"_sd;
+
 }  // namespace mongo
@@ -37,6 +37,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/logv2/log.h"
@@ -94,6 +95,12 @@ void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     _condvar.notify_one();
 }
 
+void FTDCController::setHighFrequencyPeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highFrequencyPeriod = millis;
+    _condvar.notify_one();
+}
+
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -129,6 +136,16 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighFrequencyCollector(
+    std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _highFrequencyCollectors.add(std::move(collector));
+    }
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -186,6 +203,30 @@ void FTDCController::stop() {
                   "error"_attr = s);
         }
     }
+
+    if (_highFrequencyMgr) {
+        auto s = _highFrequencyMgr->close();
+        if (!s.isOK()) {
+            LOGV2(5986700,
+                  "Failed to close high frequency diagnostic data capture file manager",
+                  "error"_attr = s);
+        }
+    }
+}
+
+void FTDCController::updateConfig(WithLock) {
+    _config = _configTemp;
+    _periodicConfig = _config;
+    _highFrequencyConfig = _config;
+
+    // Keep splitting the directory size once high frequency files exist, so that they are still
+    // accounted for after the high frequency collectors are turned off.
+    if ((_config.highFrequencyPeriod > Milliseconds(0) && !_highFrequencyCollectors.empty()) ||
+        _highFrequencyMgr) {
+        _highFrequencyConfig.maxDirectorySizeBytes = _config.maxDirectorySizeBytes / 2;
+        _periodicConfig.maxDirectorySizeBytes =
+            _config.maxDirectorySizeBytes - _highFrequencyConfig.maxDirectorySizeBytes;
+    }
 }
 
 void FTDCController::doLoop() noexcept {
@@ -197,7 +238,7 @@ void FTDCController::doLoop() noexcept {
     // Update config
     {
         stdx::lock_guard<Latch> lock(_mutex);
-        _config = _configTemp;
+        updateConfig(lock);
     }
 
     while (true) {
@@ -206,7 +247,17 @@ void FTDCController::doLoop() noexcept {
         auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
 
         // Get next time to run at
-        auto next_time = FTDCUtil::roundTime(now, _config.period);
+        auto next_periodic_time = FTDCUtil::roundTime(now, _config.period);
+        auto next_time = next_periodic_time;
+
+        // The high frequency collectors run on their own, usually shorter, period
+        const bool highFrequency = _config.enabled &&
+            _config.highFrequencyPeriod > Milliseconds(0) && !_highFrequencyCollectors.empty();
+        Date_t next_high_frequency_time;
+        if (highFrequency) {
+            next_high_frequency_time = FTDCUtil::roundTime(now, _config.highFrequencyPeriod);
+            next_time = std::min(next_time, next_high_frequency_time);
+        }
 
         // Wait for the next run or signal to shutdown
         {
@@ -226,7 +277,7 @@ void FTDCController::doLoop() noexcept {
             // MSVC 2013 converts wait_until(now() + 1ms) into ~ wait_for(0) which means it will
             // not wait for the condition variable to be signaled because it uses
             // GetFileSystemTime for now which has ~10 ms granularity.
-            _config = _configTemp;
+            updateConfig(lock);
 
             // if we hit a timeout on the condvar, we need to do another collection
             // if we were signalled, then we have a config update only or were asked to stop
@@ -241,22 +292,44 @@ void FTDCController::doLoop() noexcept {
             // Delay initialization of FTDCFileManager until we are sure the user has enabled
             // FTDC
             if (!_mgr) {
-                auto swMgr = FTDCFileManager::create(&_config, _path, &_rotateCollectors, client);
+                auto swMgr =
+                    FTDCFileManager::create(&_periodicConfig, _path, &_rotateCollectors, client);
 
                 _mgr = uassertStatusOK(std::move(swMgr));
             }
 
-            auto collectSample = _periodicCollectors.collect(client);
+            if (next_time == next_periodic_time) {
+                auto collectSample = _periodicCollectors.collect(client);
+
+                Status s = _mgr->writeSampleAndRotateIfNeeded(
+                    client, std::get<0>(collectSample), std::get<1>(collectSample));
+
+                uassertStatusOK(s);
+
+                // Store a reference to the most recent document from the periodic collectors
+                {
+                    stdx::lock_guard<Latch> lock(_mutex);
+                    _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                }
+            }
+
+            if (highFrequency && next_time == next_high_frequency_time) {
+                if (!_highFrequencyMgr) {
+                    auto swMgr = FTDCFileManager::create(&_highFrequencyConfig,
+                                                         _path /
+                                                             kFTDCHighFrequencyDirectory.toString(),
+                                                         &_rotateCollectors,
+                                                         client);
+
+                    _highFrequencyMgr = uassertStatusOK(std::move(swMgr));
+                }
 
-            Status s = _mgr->writeSampleAndRotateIfNeeded(
-                client, std::get<0>(collectSample), std::get<1>(collectSample));
+                auto collectSample = _highFrequencyCollectors.collect(client);
 
-            uassertStatusOK(s);
+                Status s = _highFrequencyMgr->writeSampleAndRotateIfNeeded(
+                    client, std::get<0>(collectSample), std::get<1>(collectSample));
 
-            // Store a reference to the most recent document from the periodic collectors
-            {
-                stdx::lock_guard<Latch> lock(_mutex);
-                _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                uassertStatusOK(s);
             }
         }
     }
@@ -40,6 +40,7 @@
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -99,6 +100,11 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the period for high frequency data collection, zero disables it.
+     */
+    void setHighFrequencyPeriod(Milliseconds millis);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -118,6 +124,14 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a collector to collect on the high frequency period. i.e., ticket usage
+     *
+     * These collectors should be cheap since they may run many times a second. Their samples are
+     * stored in a subdirectory so that they do not break up the compression of periodic samples.
+     */
+    void addHighFrequencyCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Start the controller.
      *
@@ -148,6 +162,12 @@ private:
      */
     void doLoop() noexcept;
 
+    /**
+     * Takes a snapshot of the settings in _configTemp and derives the file managers' settings
+     * from it.
+     */
+    void updateConfig(WithLock);
+
 private:
     /**
      * Private enum to track state.
@@ -197,6 +217,12 @@ private:
     // Config settings that are manipulated by setters via setParameter.
     FTDCConfig _configTemp;
 
+    // Copies of _config used by the periodic and the high frequency file managers. While high
+    // frequency samples are being written, the two split maxDirectorySizeBytes between them so
+    // that FTDC as a whole stays within it.
+    FTDCConfig _periodicConfig;
+    FTDCConfig _highFrequencyConfig;
+
     // Set of periodic collectors
     FTDCCollectorCollection _periodicCollectors;
 
@@ -207,9 +233,15 @@ private:
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
+    // Set of high frequency collectors
+    FTDCCollectorCollection _highFrequencyCollectors;
+
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
+    // File manager for the high frequency samples
+    std::unique_ptr<FTDCFileManager> _highFrequencyMgr;
+
     // Background collection and writing thread
     stdx::thread _thread;
 };
@@ -211,6 +211,59 @@ TEST_F(FTDCControllerTest, TestFull) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+// Test the high frequency collectors are logged to their own directory
+TEST_F(FTDCControllerTest, TestHighFrequency) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(1000 * 1000);
+    config.highFrequencyPeriod = Milliseconds(1);
+    config.formatVersion = 2;
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+    FTDCController c(dir, config);
+
+    auto c1 = std::make_unique<FTDCMetricsCollectorMock2>();
+    auto c2 = std::make_unique<FTDCMetricsCollectorMockRotate>();
+
+    auto c1Ptr = c1.get();
+    auto c2Ptr = c2.get();
+
+    c1Ptr->setSignalOnCount(100);
+
+    c.addHighFrequencyCollector(std::move(c1));
+
+    c.addOnRotateCollector(std::move(c2));
+
+    c.start();
+
+    // Wait for 100 samples to have occured
+    c1Ptr->wait();
+
+    c.stop();
+
+    auto docsHighFrequency = c1Ptr->getDocs();
+    ASSERT_GREATER_THAN_OR_EQUALS(docsHighFrequency.size(), 100UL);
+
+    // Each file manager collects the rotate collectors once when it opens its file
+    auto docsRotate = c2Ptr->getDocs();
+    ASSERT_EQUALS(docsRotate.size(), 2UL);
+
+    std::vector<BSONObj> allDocs{docsRotate[1]};
+    allDocs.insert(allDocs.end(), docsHighFrequency.begin(), docsHighFrequency.end());
+
+    auto files = scanDirectory(dir / kFTDCHighFrequencyDirectory.toString());
+
+    ASSERT_EQUALS(files.size(), 1UL);
+
+    ValidateDocumentList(files[0], allDocs, FTDCValidationMode::kStrict);
+}
+
 // Test we can start and stop the controller in quick succession, make sure it succeeds without
 // assert or fault
 TEST_F(FTDCControllerTest, TestStartStop) {
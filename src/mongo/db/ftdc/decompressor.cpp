@@ -34,15 +34,23 @@
 #include "mongo/base/data_range_cursor.h"
 #include "mongo/base/data_type_validated.h"
 #include "mongo/db/ftdc/compressor.h"
+#include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/ftdc/varint.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/rpc/object_check.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
-StatusWith<std::vector<BSONObj>> FTDCDecompressor::uncompress(ConstDataRange buf) {
+StatusWith<std::vector<BSONObj>> FTDCDecompressor::uncompress(ConstDataRange buf,
+                                                              std::uint32_t formatVersion) {
+    if (formatVersion == 0 || formatVersion > FTDCConfig::kFormatVersionMax) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Unknown metrics chunk format version " << formatVersion);
+    }
+
     ConstDataRangeCursor compressedDataRange(buf);
 
     // Read the length of the uncompressed buffer
@@ -60,7 +68,11 @@ StatusWith<std::vector<BSONObj>> FTDCDecompressor::uncompress(ConstDataRange buf
         return Status(ErrorCodes::InvalidLength, "Metrics chunk has exceeded the allowable size.");
     }
 
-    auto statusUncompress = _compressor.uncompress(compressedDataRange, uncompressedLength);
+    auto statusUncompress = _compressor.uncompress(compressedDataRange,
+                                                   uncompressedLength,
+                                                   formatVersion >= 2
+                                                       ? BlockCompressor::Algorithm::kZstd
+                                                       : BlockCompressor::Algorithm::kZlib);
 
     if (!statusUncompress.isOK()) {
         return {statusUncompress.getStatus()};
@@ -126,36 +138,43 @@ StatusWith<std::vector<BSONObj>> FTDCDecompressor::uncompress(ConstDataRange buf
     // Read the samples
     std::vector<std::uint64_t> deltas(metricsCount * sampleCount);
 
-    // decompress the deltas
-    std::uint64_t zeroesCount = 0;
-
     auto cdrc = ConstDataRangeCursor(cdc);
 
-    for (std::uint32_t i = 0; i < metricsCount; i++) {
-        for (std::uint32_t j = 0; j < sampleCount; j++) {
-            if (zeroesCount) {
-                deltas[FTDCCompressor::getArrayOffset(sampleCount, j, i)] = 0;
-                zeroesCount--;
-                continue;
-            }
+    // decompress the deltas
+    if (formatVersion >= 2) {
+        Status s = _readColumns(&cdrc, metricsCount, sampleCount, &deltas);
+        if (!s.isOK()) {
+            return s;
+        }
+    } else {
+        std::uint64_t zeroesCount = 0;
+
+        for (std::uint32_t i = 0; i < metricsCount; i++) {
+            for (std::uint32_t j = 0; j < sampleCount; j++) {
+                if (zeroesCount) {
+                    deltas[FTDCCompressor::getArrayOffset(sampleCount, j, i)] = 0;
+                    zeroesCount--;
+                    continue;
+                }
 
-            auto swDelta = cdrc.readAndAdvanceNoThrow<FTDCVarInt>();
+                auto swDelta = cdrc.readAndAdvanceNoThrow<FTDCVarInt>();
 
-            if (!swDelta.isOK()) {
-                return swDelta.getStatus();
-            }
+                if (!swDelta.isOK()) {
+                    return swDelta.getStatus();
+                }
+
+                if (swDelta.getValue() == 0) {
+                    auto swZero = cdrc.readAndAdvanceNoThrow<FTDCVarInt>();
 
-            if (swDelta.getValue() == 0) {
-                auto swZero = cdrc.readAndAdvanceNoThrow<FTDCVarInt>();
+                    if (!swZero.isOK()) {
+                        return swZero.getStatus();
+                    }
 
-                if (!swZero.isOK()) {
-                    return swZero.getStatus();
+                    zeroesCount = swZero.getValue();
                 }
 
-                zeroesCount = swZero.getValue();
+                deltas[FTDCCompressor::getArrayOffset(sampleCount, j, i)] = swDelta.getValue();
             }
-
-            deltas[FTDCCompressor::getArrayOffset(sampleCount, j, i)] = swDelta.getValue();
         }
     }
 
@@ -182,4 +201,114 @@ StatusWith<std::vector<BSONObj>> FTDCDecompressor::uncompress(ConstDataRange buf
     return {docs};
 }
 
+Status FTDCDecompressor::_readColumns(ConstDataRangeCursor* cursor,
+                                      std::uint32_t metricsCount,
+                                      std::uint32_t sampleCount,
+                                      std::vector<std::uint64_t>* deltas) {
+    for (std::uint32_t i = 0; i < metricsCount; i++) {
+        std::uint64_t* column = &(*deltas)[FTDCCompressor::getArrayOffset(sampleCount, 0, i)];
+
+        auto swEncoding = cursor->readAndAdvanceNoThrow<std::uint8_t>();
+        if (!swEncoding.isOK()) {
+            return swEncoding.getStatus();
+        }
+
+        // Read the zig-zag encoded delta-of-deltas of the column
+        switch (static_cast<FTDCCompressor::ColumnEncoding>(swEncoding.getValue())) {
+            case FTDCCompressor::ColumnEncoding::kConstant: {
+                auto swFirst = cursor->readAndAdvanceNoThrow<FTDCVarInt>();
+                if (!swFirst.isOK()) {
+                    return swFirst.getStatus();
+                }
+
+                std::fill(column, column + sampleCount, 0);
+                column[0] = swFirst.getValue();
+                break;
+            }
+            case FTDCCompressor::ColumnEncoding::kVarInt: {
+                std::uint32_t j = 0;
+                while (j < sampleCount) {
+                    auto swValue = cursor->readAndAdvanceNoThrow<FTDCVarInt>();
+                    if (!swValue.isOK()) {
+                        return swValue.getStatus();
+                    }
+
+                    if (swValue.getValue() != 0) {
+                        column[j++] = swValue.getValue();
+                        continue;
+                    }
+
+                    auto swZero = cursor->readAndAdvanceNoThrow<FTDCVarInt>();
+                    if (!swZero.isOK()) {
+                        return swZero.getStatus();
+                    }
+
+                    if (swZero.getValue() >= sampleCount - j) {
+                        return {ErrorCodes::InvalidLength,
+                                "Run of zeros exceeds the length of the metric column"};
+                    }
+
+                    std::fill(column + j, column + j + swZero.getValue() + 1, 0);
+                    j += swZero.getValue() + 1;
+                }
+                break;
+            }
+            case FTDCCompressor::ColumnEncoding::kBitPacked: {
+                auto swWidth = cursor->readAndAdvanceNoThrow<std::uint8_t>();
+                if (!swWidth.isOK()) {
+                    return swWidth.getStatus();
+                }
+
+                const std::uint32_t width = swWidth.getValue();
+                if (width > 64) {
+                    return {ErrorCodes::BadValue,
+                            str::stream() << "Invalid bit width " << width << " in metric column"};
+                }
+
+                std::uint8_t pending = 0;
+                std::uint32_t pendingBits = 0;
+
+                for (std::uint32_t j = 0; j < sampleCount; j++) {
+                    std::uint64_t value = 0;
+                    std::uint32_t filled = 0;
+
+                    while (filled < width) {
+                        if (pendingBits == 0) {
+                            auto swByte = cursor->readAndAdvanceNoThrow<std::uint8_t>();
+                            if (!swByte.isOK()) {
+                                return swByte.getStatus();
+                            }
+
+                            pending = swByte.getValue();
+                            pendingBits = 8;
+                        }
+
+                        std::uint32_t take = std::min(width - filled, pendingBits);
+                        value |= static_cast<std::uint64_t>(pending & ((1U << take) - 1)) << filled;
+                        pending >>= take;
+                        pendingBits -= take;
+                        filled += take;
+                    }
+
+                    column[j] = value;
+                }
+                break;
+            }
+            default:
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Unknown metric column encoding "
+                                      << static_cast<int>(swEncoding.getValue())};
+        }
+
+        // Turn the delta-of-deltas back into deltas
+        std::uint64_t delta = 0;
+        for (std::uint32_t j = 0; j < sampleCount; j++) {
+            delta += static_cast<std::uint64_t>(FTDCCompressor::zigZagDecode(column[j]));
+            column[j] = delta;
+        }
+    }
+
+    return Status::OK();
+}
+
 }  // namespace mongo
@@ -29,9 +29,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "mongo/base/data_range.h"
+#include "mongo/base/data_range_cursor.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/ftdc/block_compressor.h"
 #include "mongo/db/jsobj.h"
@@ -54,8 +56,20 @@ public:
      * Will fail if the chunk is corrupt or too short.
      *
      * Returns N samples where N = sample count + 1. The 1 is the reference document.
+     *
+     * formatVersion is the FTDCConfig::formatVersion the chunk was written with.
+     */
+    StatusWith<std::vector<BSONObj>> uncompress(ConstDataRange buf,
+                                                std::uint32_t formatVersion = 1);
+
+private:
+    /**
+     * Read format version 2 columns into deltas.
      */
-    StatusWith<std::vector<BSONObj>> uncompress(ConstDataRange buf);
+    static Status _readColumns(ConstDataRangeCursor* cursor,
+                               std::uint32_t metricsCount,
+                               std::uint32_t sampleCount,
+                               std::vector<std::uint64_t>* deltas);
 
 private:
     BlockCompressor _compressor;
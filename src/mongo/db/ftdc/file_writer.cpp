@@ -169,7 +169,8 @@ Status FTDCFileWriter::writeSample(const BSONObj& sample, Date_t date) {
         }
 
         BSONObj o = FTDCBSONUtil::createBSONMetricChunkDocument(std::get<0>(swBuf.getValue()),
-                                                                std::get<1>(swBuf.getValue()));
+                                                                std::get<1>(swBuf.getValue()),
+                                                                _compressor.getFormatVersion());
         return writeInterimFileBuffer({o.objdata(), static_cast<size_t>(o.objsize())});
     }
 
@@ -186,7 +187,8 @@ Status FTDCFileWriter::flush(const boost::optional<ConstDataRange>& range, Date_
             }
 
             BSONObj o = FTDCBSONUtil::createBSONMetricChunkDocument(std::get<0>(swBuf.getValue()),
-                                                                    std::get<1>(swBuf.getValue()));
+                                                                    std::get<1>(swBuf.getValue()),
+                                                                    _compressor.getFormatVersion());
             Status s = writeArchiveFileBuffer({o.objdata(), static_cast<size_t>(o.objsize())});
 
             if (!s.isOK()) {
@@ -194,7 +196,8 @@ Status FTDCFileWriter::flush(const boost::optional<ConstDataRange>& range, Date_
             }
         }
     } else {
-        BSONObj o = FTDCBSONUtil::createBSONMetricChunkDocument(range.get(), date);
+        BSONObj o = FTDCBSONUtil::createBSONMetricChunkDocument(
+            range.get(), date, _compressor.getFormatVersion());
         Status s = writeArchiveFileBuffer({o.objdata(), static_cast<size_t>(o.objsize())});
 
         if (!s.isOK()) {
@@ -145,10 +145,11 @@ TEST_F(FTDCFileTest, TestFileBasicCompress) {
  */
 class FileTestTie {
 public:
-    FileTestTie()
+    FileTestTie(std::uint32_t formatVersion = 1)
         : _tempdir("metrics_testpath"),
           _path(boost::filesystem::path(_tempdir.path()) / kTestFile),
           _writer(&_config) {
+        _config.formatVersion = formatVersion;
         deleteFileIfNeeded(_path);
 
         ASSERT_OK(_writer.open(_path));
@@ -268,6 +269,28 @@ TEST_F(FTDCFileTest, TestFull) {
     }
 }
 
+// Test a full buffer in format version 2 is read back by the file reader
+TEST_F(FTDCFileTest, TestFullFormatVersion2) {
+    for (int j = 0; j < 2; j++) {
+        FileTestTie c(2);
+
+        c.addSample(BSON("name"
+                         << "joe"
+                         << "key1" << 33 << "key2" << 42));
+
+        for (size_t i = 0; i <= FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault - 2; i++) {
+            c.addSample(BSON("name"
+                             << "joe"
+                             << "key1" << static_cast<long long int>(i * j) << "key2" << 45));
+        }
+
+        // Change the schema to flush a chunk from addSample
+        c.addSample(BSON("name"
+                         << "joe"
+                         << "key1" << 34 << "key3" << 45));
+    }
+}
+
 // Test a large documents so that we cause multiple 4kb buffers to flush on Windows.
 TEST_F(FTDCFileTest, TestLargeDocuments) {
     FileTestTie c;
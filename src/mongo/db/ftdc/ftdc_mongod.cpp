@@ -33,16 +33,85 @@
 
 #include <boost/filesystem.hpp>
 
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/stats/collection_cache_stats.h"
+#include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
 
 namespace {
+
+/**
+ * A FTDC collector for ticket usage and queueing, cheap enough to run on the high frequency period.
+ */
+class FTDCTicketCollector final : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        if (auto holder = Locker::getGlobalThrottling(MODE_IX)) {
+            BSONObjBuilder bb(builder.subobjStart("write"));
+            holder->appendStats(bb);
+        }
+
+        if (auto holder = Locker::getGlobalThrottling(MODE_IS)) {
+            BSONObjBuilder bb(builder.subobjStart("read"));
+            holder->appendStats(bb);
+        }
+    }
+
+    std::string name() const override {
+        return "concurrentTransactions";
+    }
+};
+
+/**
+ * A FTDC collector for the storage engine's cache gauges, cheap enough to run on the high frequency
+ * period.
+ */
+class FTDCStorageCacheCollector final : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+        if (storageEngine && storageEngine->getEngine()) {
+            storageEngine->getEngine()->appendCacheStats(&builder);
+        }
+    }
+
+    std::string name() const override {
+        return "storageCache";
+    }
+};
+
+class FTDCCollectionCacheCollector final : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        CollectionCacheStats::get(opCtx->getServiceContext())
+            .appendSummary(kTopCollections, &builder);
+    }
+
+    std::string name() const override {
+        return "collectionCache";
+    }
+
+private:
+    // Enough to spot collections crowding the cache without growing every sample. They are
+    // reported by rank, as namespaces do not belong in diagnostic data; $collStats names them.
+    static constexpr size_t kTopCollections = 10;
+};
+
 void registerMongoDCollectors(FTDCController* controller) {
+    // A small set of gauges that can be sampled many times a second, unlike serverStatus
+    controller->addHighFrequencyCollector(std::make_unique<FTDCTicketCollector>());
+    controller->addHighFrequencyCollector(std::make_unique<FTDCStorageCacheCollector>());
+
+    controller->addPeriodicCollector(std::make_unique<FTDCCollectionCacheCollector>());
+
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
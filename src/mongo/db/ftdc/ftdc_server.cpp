@@ -170,6 +170,21 @@ Status onUpdateFTDCPerInterimUpdate(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t potentialNewValue) {
+    if (potentialNewValue != 0 && potentialNewValue < 10) {
+        return Status(ErrorCodes::BadValue,
+                      "diagnosticDataCollectionHighFrequencyPeriodMillis must be 0 to disable high "
+                      "frequency collection, or at least 10");
+    }
+
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighFrequencyPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
                                                                        StringData name,
                                                                        StringData ns,
@@ -218,6 +233,9 @@ public:
         commandBuilder.append("defaultRWConcern", false);
         commandBuilder.append(MirrorMaestro::kServerStatusSectionName, true);
 
+        // Always sample fresh values, and let other callers reuse them for expensive sections.
+        commandBuilder.append("refreshCachedSections", true);
+
         // Exclude 'serverStatus.transactions.lastCommittedTransactions' because it triggers
         // frequent schema changes.
         commandBuilder.append("transactions", BSON("includeLastCommitted" << false));
@@ -264,6 +282,8 @@ void startFTDC(boost::filesystem::path& path,
         ftdcStartupParams.maxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk =
         ftdcStartupParams.maxSamplesPerInterimMetricChunk.load();
+    config.formatVersion = ftdcStartupParams.formatVersion.load();
+    config.highFrequencyPeriod = Milliseconds(ftdcStartupParams.highFrequencyPeriodMillis.load());
 
     ftdcDirectoryPathParameter = path;
 
@@ -111,6 +111,8 @@ struct FTDCStartupParams {
     AtomicWord<int> maxFileSizeMB;
     AtomicWord<int> maxSamplesPerArchiveMetricChunk;
     AtomicWord<int> maxSamplesPerInterimMetricChunk;
+    AtomicWord<int> formatVersion;
+    AtomicWord<int> highFrequencyPeriodMillis;
 
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
@@ -119,7 +121,9 @@ struct FTDCStartupParams {
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
           maxSamplesPerArchiveMetricChunk(FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault),
+          formatVersion(FTDCConfig::kFormatVersionDefault),
+          highFrequencyPeriodMillis(FTDCConfig::kHighFrequencyPeriodMillisDefault) {}
 };
 
 extern FTDCStartupParams ftdcStartupParams;
@@ -133,6 +137,7 @@ Status onUpdateFTDCDirectorySize(const std::int32_t value);
 Status onUpdateFTDCFileSize(const std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(const std::int32_t value);
 Status onUpdateFTDCPerInterimUpdate(const std::int32_t value);
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t value);
 
 /**
  * Server Parameter accessors
@@ -435,11 +435,15 @@ BSONObj createBSONMetadataDocument(const BSONObj& metadata, Date_t date) {
     return builder.obj();
 }
 
-BSONObj createBSONMetricChunkDocument(ConstDataRange buf, Date_t date) {
+BSONObj createBSONMetricChunkDocument(ConstDataRange buf,
+                                      Date_t date,
+                                      std::uint32_t formatVersion) {
     BSONObjBuilder builder;
 
     builder.appendDate(kFTDCIdField, date);
-    builder.appendNumber(kFTDCTypeField, static_cast<int>(FTDCType::kMetricChunk));
+    builder.appendNumber(kFTDCTypeField,
+                         static_cast<int>(formatVersion >= 2 ? FTDCType::kMetricChunkV2
+                                                             : FTDCType::kMetricChunk));
     builder.appendBinData(kFTDCDataField, buf.length(), BinDataType::BinDataGeneral, buf.data());
 
     return builder.obj();
@@ -465,6 +469,7 @@ StatusWith<FTDCType> getBSONDocumentType(const BSONObj& obj) {
     }
 
     if (static_cast<FTDCType>(value) != FTDCType::kMetricChunk &&
+        static_cast<FTDCType>(value) != FTDCType::kMetricChunkV2 &&
         static_cast<FTDCType>(value) != FTDCType::kMetadata) {
         return {ErrorCodes::BadValue,
                 str::stream() << "Field '" << std::string(kFTDCTypeField)
@@ -492,11 +497,14 @@ StatusWith<BSONObj> getBSONDocumentFromMetadataDoc(const BSONObj& obj) {
 
 StatusWith<std::vector<BSONObj>> getMetricsFromMetricDoc(const BSONObj& obj,
                                                          FTDCDecompressor* decompressor) {
-    if (kDebugBuild) {
-        auto swType = getBSONDocumentType(obj);
-        dassert(swType.isOK() && swType.getValue() == FTDCType::kMetricChunk);
+    auto swType = getBSONDocumentType(obj);
+    if (!swType.isOK()) {
+        return {swType.getStatus()};
     }
 
+    dassert(swType.getValue() == FTDCType::kMetricChunk ||
+            swType.getValue() == FTDCType::kMetricChunkV2);
+
     BSONElement element;
 
     Status status = bsonExtractTypedField(obj, kFTDCDataField, BSONType::BinData, &element);
@@ -511,7 +519,8 @@ StatusWith<std::vector<BSONObj>> getMetricsFromMetricDoc(const BSONObj& obj,
                 str::stream() << "Field " << std::string(kFTDCTypeField) << " is not a BinData."};
     }
 
-    return decompressor->uncompress({buffer, static_cast<std::size_t>(length)});
+    return decompressor->uncompress({buffer, static_cast<std::size_t>(length)},
+                                    swType.getValue() == FTDCType::kMetricChunkV2 ? 2 : 1);
 }
 
 }  // namespace FTDCBSONUtil
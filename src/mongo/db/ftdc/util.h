@@ -65,6 +65,13 @@ enum class FTDCType : std::int32_t {
      * See createBSONMetricChunkDocument
      */
     kMetricChunk = 1,
+
+    /**
+     * A metrics chunk in format version 2, see FTDCConfig::formatVersion.
+     *
+     * See createBSONMetricChunkDocument
+     */
+    kMetricChunkV2 = 2,
 };
 
 
@@ -148,8 +155,12 @@ BSONObj createBSONMetadataDocument(const BSONObj& metadata, Date_t date);
  *  "type" : 1
  *  "data" : BinData(...)
  * }
+ *
+ * The type is 2 instead of 1 for chunks in format version 2.
  */
-BSONObj createBSONMetricChunkDocument(ConstDataRange buf, Date_t now);
+BSONObj createBSONMetricChunkDocument(ConstDataRange buf,
+                                      Date_t now,
+                                      std::uint32_t formatVersion = 1);
 
 /**
  * Get the _id field of a BSON document
@@ -357,6 +357,9 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
         lv2Config.fileOpenMode = serverGlobalParams.logAppend
             ? logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend
             : logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kTruncate;
+        lv2Config.fileAsyncBufferSizeBytes =
+            static_cast<size_t>(gLogAsyncWriterBufferSizeKB) * 1024;
+        lv2Config.fileAsyncDropOnOverflow = gLogAsyncWriterDropOnOverflow;
 
         if (serverGlobalParams.logAppend && exists) {
             writeServerRestartedAfterLogConfig = true;
@@ -365,6 +368,11 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
     lv2Config.timestampFormat = serverGlobalParams.logTimestampFormat;
     Status result = lv2Manager.getGlobalDomainInternal().configure(lv2Config);
+
+    // quickExit() skips destructors, so have it write out whatever is still buffered for the log
+    // file.
+    setQuickExitFlushHook([] { logv2::LogManager::global().getGlobalDomainInternal().flush(); });
+
     if (result.isOK() && writeServerRestartedAfterLogConfig) {
         LOGV2(20698, "***** SERVER RESTARTED *****");
     }
@@ -150,6 +150,7 @@
 #include "mongo/db/session_killer.h"
 #include "mongo/db/startup_recovery.h"
 #include "mongo/db/startup_warnings_mongod.h"
+#include "mongo/db/stats/collection_cache_stats_sampler.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
 #include "mongo/db/storage/control/storage_control.h"
@@ -700,13 +701,15 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
 
     // Start up a background task to periodically check for and kill expired transactions; and a
     // background task to periodically check for and decrease cache pressure by decreasing the
-    // target size setting for the storage engine's window of available snapshots.
+    // target size setting for the storage engine's window of available snapshots. Also sample the
+    // cache usage of each collection, so that the ones filling the cache can be identified.
     //
     // Only do this on storage engines supporting snapshot reads, which hold resources we wish to
     // release periodically in order to avoid storage cache pressure build up.
     if (storageEngine->supportsReadConcernSnapshot()) {
         try {
             PeriodicThreadToAbortExpiredTransactions::get(serviceContext)->start();
+            CollectionCacheStatsSampler::get(serviceContext)->start();
         } catch (ExceptionFor<ErrorCodes::PeriodicJobIsStopped>&) {
             LOGV2_WARNING(4747501, "Not starting periodic jobs as shutdown is in progress");
             // Shutdown has already started before initialization is complete. Wait for the
@@ -1153,6 +1156,8 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         if (storageEngine->supportsReadConcernSnapshot()) {
             LOGV2(4784908, "Shutting down the PeriodicThreadToAbortExpiredTransactions");
             PeriodicThreadToAbortExpiredTransactions::get(serviceContext)->stop();
+            LOGV2(5986704, "Shutting down the CollectionCacheStatsSampler");
+            CollectionCacheStatsSampler::get(serviceContext)->stop();
         }
 
         ServiceContext::UniqueOperationContext uniqueOpCtx;
@@ -148,6 +148,9 @@ public:
     // Namespace for storing config.transactions cloner progress for resharding.
     static const NamespaceString kReshardingTxnClonerProgressNamespace;
 
+    // Namespace for storing the collection cloner's progress on each range for resharding.
+    static const NamespaceString kReshardingCollectionClonerProgressNamespace;
+
     // Namespace for storing keys for signing and validating cluster times.
     static const NamespaceString kKeysCollectionNamespace;
 
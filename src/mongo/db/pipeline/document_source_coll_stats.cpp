@@ -89,6 +89,11 @@ intrusive_ptr<DocumentSource> DocumentSourceCollStats::createFromBson(
                     str::stream() << "queryExecStats argument must be an empty object, but got "
                                   << elem,
                     elem.embeddedObject().isEmpty());
+        } else if ("cacheStats" == fieldName) {
+            uassert(5986705,
+                    str::stream() << "cacheStats argument must be an empty object, but got "
+                                  << elem,
+                    elem.type() == BSONType::Object && elem.embeddedObject().isEmpty());
         } else {
             uasserted(40168, str::stream() << "unrecognized option to $collStats: " << fieldName);
         }
@@ -150,6 +155,10 @@ DocumentSource::GetNextResult DocumentSourceCollStats::doGetNext() {
                                    "Unable to retrieve queryExecStats in $collStats stage");
     }
 
+    if (_collStatsSpec.hasField("cacheStats")) {
+        pExpCtx->mongoProcessInterface->appendCacheStats(pExpCtx->opCtx, pExpCtx->ns, &builder);
+    }
+
     return {Document(builder.obj())};
 }
 
@@ -62,6 +62,7 @@
 #include "mongo/db/s/transaction_coordinator_worker_curop_repository.h"
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/session_catalog_mongod.h"
+#include "mongo/db/stats/collection_cache_stats.h"
 #include "mongo/db/stats/fill_locker_info.h"
 #include "mongo/db/stats/storage_stats.h"
 #include "mongo/db/storage/backup_cursor_hooks.h"
@@ -230,6 +231,12 @@ Status CommonMongodProcessInterface::appendRecordCount(OperationContext* opCtx,
     return appendCollectionRecordCount(opCtx, nss, builder);
 }
 
+void CommonMongodProcessInterface::appendCacheStats(OperationContext* opCtx,
+                                                    const NamespaceString& nss,
+                                                    BSONObjBuilder* builder) const {
+    CollectionCacheStats::get(opCtx->getServiceContext()).appendCollectionStats(nss, builder);
+}
+
 Status CommonMongodProcessInterface::appendQueryExecStats(OperationContext* opCtx,
                                                           const NamespaceString& nss,
                                                           BSONObjBuilder* builder) const {
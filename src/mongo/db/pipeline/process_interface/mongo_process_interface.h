@@ -215,6 +215,14 @@ public:
                                         const NamespaceString& nss,
                                         BSONObjBuilder* builder) const = 0;
 
+    /**
+     * Appends the last sampled storage engine cache usage of collection 'nss' and its indexes to
+     * 'builder'.
+     */
+    virtual void appendCacheStats(OperationContext* opCtx,
+                                  const NamespaceString& nss,
+                                  BSONObjBuilder* builder) const = 0;
+
     /**
      * Gets the collection options for the collection given by 'nss'. Throws
      * ErrorCodes::CommandNotSupportedOnView if 'nss' describes a view. Future callers may want to
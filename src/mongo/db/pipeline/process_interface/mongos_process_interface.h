@@ -120,6 +120,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    void appendCacheStats(OperationContext* opCtx,
+                          const NamespaceString& nss,
+                          BSONObjBuilder* builder) const final {
+        MONGO_UNREACHABLE;
+    }
+
     BSONObj getCollectionOptions(OperationContext* opCtx, const NamespaceString& nss) final {
         MONGO_UNREACHABLE;
     }
@@ -116,6 +116,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    void appendCacheStats(OperationContext* opCtx,
+                          const NamespaceString& nss,
+                          BSONObjBuilder* builder) const override {
+        MONGO_UNREACHABLE;
+    }
+
     BSONObj getCollectionOptions(OperationContext* opCtx, const NamespaceString& nss) override {
         MONGO_UNREACHABLE;
     }
@@ -227,6 +227,10 @@ void generateExecutionInfo(PlanExecutor* exec,
     generateSinglePlanExecutionInfo(
         explainer.getWinningPlanStats(verbosity), totalTimeMillis, &execBob);
 
+    if (auto stageProfile = explainer.getWinningPlanStageProfile(); !stageProfile.isEmpty()) {
+        execBob.append("stageProfile", stageProfile);
+    }
+
     // Also generate exec stats for all plans, if the verbosity level is high enough. These stats
     // reflect what happened during the trial period that ranked the plans.
     if (verbosity >= ExplainOptions::Verbosity::kExecAllPlans) {
@@ -40,6 +40,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count.h"
@@ -82,6 +83,7 @@
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/query/query_settings_decoration.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
 #include "mongo/db/query/sbe_sub_planner.h"
@@ -96,6 +98,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
+#include "mongo/rpc/message.h"
 #include "mongo/scripting/engine.h"
 #include "mongo/util/str.h"
 
@@ -582,6 +585,7 @@ public:
             // to force an _id index scan plan. If an IDHACK plan was generated we return
             // immediately, otherwise we fall through and continue.
             if (auto result = buildIdHackPlan(idIndexDesc, &plannerParams)) {
+                registerQueryStatsShape(nullptr);
                 return std::move(result);
             }
         }
@@ -602,6 +606,7 @@ public:
                 canonical_query_encoder::computeHash(planCacheKey.getStableKeyStringData());
             CurOp::get(_opCtx)->debug().planCacheKey =
                 canonical_query_encoder::computeHash(planCacheKey.toString());
+            registerQueryStatsShape(&planCacheKey);
 
             // Try to look up a cached solution for the query.
             if (auto cs = CollectionQueryInfo::get(_collection)
@@ -624,9 +629,10 @@ public:
                         std::move(querySolution), plannerParams, cs->decisionWorks);
                 }
             }
+        } else {
+            registerQueryStatsShape(nullptr);
         }
 
-
         if (internalQueryPlanOrChildrenIndependently.load() &&
             SubplanStage::canUseSubplanning(*_cq)) {
             LOGV2_DEBUG(20924,
@@ -683,6 +689,43 @@ public:
     }
 
 protected:
+    /**
+     * Registers the shape of the query with the query stats store, if it is enabled. The shape is
+     * identified by the command running the query and its plan cache shape encoding, which is
+     * taken from 'planCacheKey' when the plan cache key has already been computed rather than
+     * encoded again.
+     */
+    void registerQueryStatsShape(const PlanCacheKey* planCacheKey) {
+        if (!QueryStatsStore::isEnabled()) {
+            return;
+        }
+
+        CanonicalQuery::QueryShapeString encodedShape;
+        StringData shapeKey;
+        if (planCacheKey) {
+            shapeKey = planCacheKey->getStableKeyStringData();
+        } else {
+            encodedShape = canonical_query_encoder::encode(*_cq);
+            shapeKey = encodedShape;
+        }
+
+        // Operations without a command, e.g. legacy OP_QUERY finds, fall back to their logical op.
+        auto curOp = CurOp::get(_opCtx);
+        StringData command = curOp->getCommand() ? StringData(curOp->getCommand()->getName())
+                                                 : logicalOpToString(curOp->getLogicalOp());
+
+        const auto& qr = _cq->getQueryRequest();
+        QueryStatsStore::get(_opCtx).registerShape(_opCtx,
+                                                   _cq->nss(),
+                                                   command,
+                                                   shapeKey,
+                                                   canonical_query_encoder::computeHash(shapeKey),
+                                                   _cq->getQueryObj(),
+                                                   qr.getProj(),
+                                                   qr.getSort(),
+                                                   qr.getCollation());
+    }
+
     /**
      * Creates a result instance to be returned to the caller holding the result of the
      * prepare() call.
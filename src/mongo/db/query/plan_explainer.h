@@ -104,6 +104,16 @@ public:
     virtual std::vector<PlanStatsDetails> getRejectedPlansStats(
         ExplainOptions::Verbosity verbosity) const = 0;
 
+    /**
+     * Returns a per-stage execution profile of the winning plan, or an empty object if the plan did
+     * not collect one. The profile holds, for each counter the stages collected, an array in the
+     * folded stack format understood by flame graph tools: one "root;child;stage <value>" line per
+     * stage, where the value excludes what the stage's children accounted for.
+     */
+    virtual BSONObj getWinningPlanStageProfile() const {
+        return BSONObj();
+    }
+
     /**
      * Serializes plan cache entry debug info into the provided BSONObjBuilder. The output format is
      * intended to be human readable, and useful for debugging query performance problems related to
@@ -190,6 +190,49 @@ void statsToBSON(const QuerySolutionNode* node,
     childrenBob.doneFast();
 }
 
+using StageCounter = boost::optional<long long> sbe::CommonStats::*;
+
+// The per-stage counters collected when a plan is timed, and the names they are reported under.
+const std::pair<StringData, StageCounter> kStageCounters[] = {
+    {"cpuNanos"_sd, &sbe::CommonStats::cpuNanos},
+    {"instructions"_sd, &sbe::CommonStats::instructions},
+    {"cacheMisses"_sd, &sbe::CommonStats::cacheMisses},
+};
+
+/**
+ * Returns the value of 'counter' for the given stage, minus what its children accounted for. The
+ * children of an exchange run on other threads, so the difference is clamped at zero.
+ */
+long long exclusiveCounter(const sbe::PlanStageStats* stats, StageCounter counter) {
+    auto value = *(stats->common.*counter);
+    for (auto&& child : stats->children) {
+        if (auto childValue = child->common.*counter) {
+            value -= *childValue;
+        }
+    }
+    return std::max(value, 0LL);
+}
+
+void foldedStacks(const sbe::PlanStageStats* stats,
+                  StageCounter counter,
+                  const std::string& parentFrames,
+                  BSONArrayBuilder* out) {
+    if (!(stats->common.*counter) || out->len() > kMaxExplainStatsBSONSizeMB) {
+        return;
+    }
+
+    std::string frames = str::stream()
+        << parentFrames << (parentFrames.empty() ? "" : ";") << stats->common.stageType << '['
+        << stats->common.nodeId << ']';
+    if (auto value = exclusiveCounter(stats, counter); value > 0) {
+        out->append(str::stream() << frames << ' ' << value);
+    }
+
+    for (auto&& child : stats->children) {
+        foldedStacks(child.get(), counter, frames, out);
+    }
+}
+
 void statsToBSON(const sbe::PlanStageStats* stats,
                  BSONObjBuilder* bob,
                  const BSONObjBuilder* topLevelBob) {
@@ -209,9 +252,18 @@ void statsToBSON(const sbe::PlanStageStats* stats,
 
     // Some top-level exec stats get pulled out of the root stage.
     bob->appendNumber("nReturned", stats->common.advances);
-    // Include executionTimeMillis if it was recorded.
+    // Include executionTimeMillis if it was recorded, or derive it from the stage's wall time.
+    // CPU time is only reported in the cpuNanos fields.
     if (stats->common.executionTimeMillis) {
         bob->appendNumber("executionTimeMillisEstimate", *stats->common.executionTimeMillis);
+    } else if (stats->common.wallNanos) {
+        bob->appendNumber("executionTimeMillisEstimate", *stats->common.wallNanos / 1000000);
+    }
+    for (auto&& [name, counter] : kStageCounters) {
+        if (auto value = stats->common.*counter) {
+            bob->appendNumber(name + "Inclusive", *value);
+            bob->appendNumber(name + "Exclusive", exclusiveCounter(stats, counter));
+        }
     }
     bob->appendNumber("advances", stats->common.advances);
     bob->appendNumber("opens", stats->common.opens);
@@ -276,6 +328,8 @@ PlanSummaryStats collectExecutionStatsSummary(const sbe::PlanStageStats* stats)
 
     if (stats->common.executionTimeMillis) {
         summary.executionTimeMillisEstimate = *stats->common.executionTimeMillis;
+    } else if (stats->common.wallNanos) {
+        summary.executionTimeMillisEstimate = *stats->common.wallNanos / 1000000;
     }
 
     // Collect cumulative execution stats for the plan.
@@ -465,6 +519,22 @@ PlanExplainer::PlanStatsDetails PlanExplainerSBE::getWinningPlanStats(
     return buildPlanStatsDetails(_solution->root(), stats.get(), verbosity);
 }
 
+BSONObj PlanExplainerSBE::getWinningPlanStageProfile() const {
+    if (!_root || !_root->getCommonStats()->cpuNanos) {
+        return BSONObj();
+    }
+
+    auto stats = _root->getStats(false /* includeDebugInfo  */);
+    BSONObjBuilder bob;
+    for (auto&& [name, counter] : kStageCounters) {
+        if (stats->common.*counter) {
+            BSONArrayBuilder stacks(bob.subarrayStart(name));
+            foldedStacks(stats.get(), counter, "", &stacks);
+        }
+    }
+    return bob.obj();
+}
+
 std::vector<PlanExplainer::PlanStatsDetails> PlanExplainerSBE::getRejectedPlansStats(
     ExplainOptions::Verbosity verbosity) const {
     if (_rejectedCandidates.empty()) {
@@ -61,6 +61,7 @@ public:
         ExplainOptions::Verbosity verbosity) const final;
     std::vector<PlanStatsDetails> getCachedPlanStats(const PlanCacheEntry::DebugInfo&,
                                                      ExplainOptions::Verbosity) const final;
+    BSONObj getWinningPlanStageProfile() const final;
 
 private:
     const sbe::PlanStage* _root{nullptr};
@@ -32,6 +32,7 @@
 #include "mongo/db/query/plan_yield_policy.h"
 
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
@@ -85,6 +86,7 @@ Status PlanYieldPolicy::yieldOrInterrupt(OperationContext* opCtx,
     ON_BLOCK_EXIT([this]() { resetTimer(); });
     _forceYield = false;
 
+    ScopedWaitEvent yieldWait(opCtx, WaitEvent::kYield);
     return yield(opCtx, whileYieldingFn);
 }
 
@@ -0,0 +1,366 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_stats_store.h"
+
+#include <algorithm>
+
+#include "mongo/base/simple_string_data_comparator.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_stats_store_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+const auto getOperationEntry =
+    OperationContext::declareDecoration<std::shared_ptr<QueryStatsEntry>>();
+
+// Number of entries each thread caches, by key hash, to find hot shapes without a partition lock.
+constexpr size_t kNumCachedEntries = 64;
+
+struct CachedEntry {
+    const QueryStatsStore* store = nullptr;
+    std::shared_ptr<QueryStatsEntry> entry;
+};
+
+thread_local std::array<CachedEntry, kNumCachedEntries> cachedEntries;
+
+size_t latencyBucket(long long micros) {
+    size_t bucket = 0;
+    while (micros > 1 && bucket < QueryStatsEntry::kNumLatencyBuckets - 1) {
+        micros >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+BSONObj shapifyObject(const BSONObj& obj, bool keepFieldPaths);
+
+BSONObj shapifyArray(const BSONObj& array, bool keepFieldPaths) {
+    BSONArrayBuilder builder;
+    for (auto&& elem : array) {
+        if (elem.type() == Object) {
+            builder.append(shapifyObject(elem.Obj(), keepFieldPaths));
+        } else if (elem.type() == Array) {
+            builder.append(shapifyArray(elem.Obj(), keepFieldPaths));
+        } else {
+            // An array of literals, e.g. the operand of $in, is one placeholder whatever its length
+            return BSON_ARRAY("?array");
+        }
+    }
+    return builder.arr();
+}
+
+void appendShapified(const BSONElement& elem, bool keepFieldPaths, BSONObjBuilder* builder) {
+    switch (elem.type()) {
+        case Object:
+            builder->append(elem.fieldNameStringData(),
+                            shapifyObject(elem.Obj(), keepFieldPaths));
+            break;
+        case Array:
+            builder->appendArray(elem.fieldNameStringData(),
+                                 shapifyArray(elem.Obj(), keepFieldPaths));
+            break;
+        case String:
+            if (keepFieldPaths && elem.valueStringData().startsWith("$")) {
+                builder->append(elem);
+                break;
+            }
+            builder->append(elem.fieldNameStringData(), "?string");
+            break;
+        default:
+            builder->append(elem.fieldNameStringData(),
+                            elem.isNumber() ? "?number"
+                                            : "?" + std::string(typeName(elem.type())));
+            break;
+    }
+}
+
+BSONObj shapifyObject(const BSONObj& obj, bool keepFieldPaths) {
+    BSONObjBuilder builder;
+    for (auto&& elem : obj) {
+        appendShapified(elem, keepFieldPaths, &builder);
+    }
+    return builder.obj();
+}
+
+std::string makeKey(const NamespaceString& nss, StringData command, StringData shapeKey) {
+    std::string key = nss.ns();
+    key.push_back('\0');
+    key.append(command.rawData(), command.size());
+    key.push_back('\0');
+    key.append(shapeKey.rawData(), shapeKey.size());
+    return key;
+}
+
+}  // namespace
+
+QueryStatsEntry::QueryStatsEntry(std::string key,
+                                 NamespaceString nss,
+                                 uint32_t queryHash,
+                                 BSONObj shape)
+    : _key(std::move(key)),
+      _nss(std::move(nss)),
+      _queryHash(queryHash),
+      _shape(std::move(shape)),
+      _firstSeen(Date_t::now()),
+      _approximateSize(sizeof(QueryStatsEntry) + _key.size() + _nss.size() + _shape.objsize()) {}
+
+void QueryStatsEntry::record(const Execution& execution) {
+    const auto micros = durationCount<Microseconds>(execution.duration);
+
+    if (execution.isGetMore) {
+        _getMores.fetchAndAddRelaxed(1);
+    } else {
+        _executions.fetchAndAddRelaxed(1);
+    }
+    _totalMicros.fetchAndAddRelaxed(micros);
+    _docsExamined.fetchAndAddRelaxed(execution.docsExamined);
+    _keysExamined.fetchAndAddRelaxed(execution.keysExamined);
+    _nreturned.fetchAndAddRelaxed(execution.nreturned);
+    _bytesReturned.fetchAndAddRelaxed(execution.bytesReturned);
+    _latencyBuckets[latencyBucket(micros)].fetchAndAddRelaxed(1);
+    _lastExecutionMillis.store(Date_t::now().toMillisSinceEpoch());
+
+    auto maxMicros = _maxMicros.load();
+    while (micros > maxMicros && !_maxMicros.compareAndSwap(&maxMicros, micros)) {
+    }
+
+    // A getMore runs the plan its cursor was created with.
+    if (execution.isGetMore || execution.planSummary.empty()) {
+        return;
+    }
+
+    const auto planSummaryHash = SimpleStringDataComparator::kInstance.hash(execution.planSummary);
+    if (planSummaryHash != _lastPlanSummaryHash.load()) {
+        stdx::lock_guard<Latch> lk(_planSummaryMutex);
+        _lastPlanSummary = execution.planSummary.toString();
+        _lastPlanSummaryHash.store(planSummaryHash);
+    }
+}
+
+void QueryStatsEntry::append(BSONObjBuilder* builder) const {
+    builder->append("ns", _nss.ns());
+    builder->append("queryHash", zeroPaddedHex(_queryHash));
+    builder->append("queryShape", _shape);
+    builder->append("firstSeen", _firstSeen);
+    builder->append("lastExecuted", Date_t::fromMillisSinceEpoch(_lastExecutionMillis.load()));
+    builder->append("executionCount", _executions.load());
+    builder->append("getMoreCount", _getMores.load());
+    builder->append("totalExecMicros", _totalMicros.load());
+    builder->append("maxExecMicros", _maxMicros.load());
+    builder->append("docsExamined", _docsExamined.load());
+    builder->append("keysExamined", _keysExamined.load());
+    builder->append("nreturned", _nreturned.load());
+    builder->append("bytesReturned", _bytesReturned.load());
+    {
+        stdx::lock_guard<Latch> lk(_planSummaryMutex);
+        if (!_lastPlanSummary.empty()) {
+            builder->append("lastPlanSummary", _lastPlanSummary);
+        }
+    }
+
+    BSONArrayBuilder histogram(builder->subarrayStart("latencyHistogram"));
+    for (size_t i = 0; i < kNumLatencyBuckets; ++i) {
+        if (auto count = _latencyBuckets[i].load()) {
+            histogram.append(BSON("micros" << (i == 0 ? 0LL : 1LL << i) << "count" << count));
+        }
+    }
+}
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* serviceContext) {
+    return getQueryStatsStore(serviceContext);
+}
+
+QueryStatsStore& QueryStatsStore::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool QueryStatsStore::isEnabled() {
+    return gQueryStatsStoreSizeBytes.load() > 0;
+}
+
+QueryStatsStore::~QueryStatsStore() {
+    // Threads may still cache entries of this store, which must not be taken for those of a store
+    // created later at the same address.
+    for (auto& partition : _partitions) {
+        for (auto& entry : partition.ring) {
+            entry->markEvicted();
+        }
+    }
+}
+
+template <typename MakeShape>
+void QueryStatsStore::_registerEntry(OperationContext* opCtx,
+                                     std::string key,
+                                     const NamespaceString& nss,
+                                     uint32_t queryHash,
+                                     MakeShape&& makeShape) {
+    const auto hash = std::hash<std::string>()(key);
+
+    auto& cached = cachedEntries[(hash / kNumPartitions) % kNumCachedEntries];
+    if (cached.store == this && !cached.entry->isEvicted() && cached.entry->key() == key) {
+        cached.entry->markReferenced();
+        getOperationEntry(opCtx) = cached.entry;
+        return;
+    }
+
+    auto& partition = _partitions[hash % kNumPartitions];
+    stdx::lock_guard<Latch> lk(partition.mutex);
+
+    if (auto it = partition.entries.find(key); it != partition.entries.end()) {
+        auto& entry = *it->second;
+        entry->markReferenced();
+        cached = {this, entry};
+        getOperationEntry(opCtx) = entry;
+        return;
+    }
+
+    auto entry = std::make_shared<QueryStatsEntry>(key, nss, queryHash, makeShape());
+    partition.bytes += entry->approximateSize();
+    partition.entries.emplace(std::move(key), partition.ring.insert(partition.hand, entry));
+    cached = {this, entry};
+    getOperationEntry(opCtx) = std::move(entry);
+
+    // Operations still holding an evicted entry keep updating it; it is freed when they finish.
+    const auto partitionBudget = static_cast<size_t>(gQueryStatsStoreSizeBytes.load()) /
+        kNumPartitions;
+    while (partition.bytes > partitionBudget && partition.ring.size() > 1) {
+        if (partition.hand == partition.ring.end()) {
+            partition.hand = partition.ring.begin();
+        }
+
+        auto& candidate = *partition.hand;
+        if (candidate->clearReferenced()) {
+            ++partition.hand;
+            continue;
+        }
+
+        partition.bytes -= candidate->approximateSize();
+        candidate->markEvicted();
+        partition.entries.erase(candidate->key());
+        partition.hand = partition.ring.erase(partition.hand);
+    }
+}
+
+void QueryStatsStore::registerShape(OperationContext* opCtx,
+                                    const NamespaceString& nss,
+                                    StringData command,
+                                    StringData shapeKey,
+                                    uint32_t queryHash,
+                                    const BSONObj& filter,
+                                    const BSONObj& projection,
+                                    const BSONObj& sort,
+                                    const BSONObj& collation) {
+    if (!isEnabled() || getOperationEntry(opCtx)) {
+        return;
+    }
+
+    _registerEntry(opCtx, makeKey(nss, command, shapeKey), nss, queryHash, [&] {
+        BSONObjBuilder shape;
+        shape.append("command", command);
+        shape.append("filter", shapify(filter));
+        if (!projection.isEmpty()) {
+            shape.append("projection", shapify(projection));
+        }
+        if (!sort.isEmpty()) {
+            shape.append("sort", sort);
+        }
+        if (!collation.isEmpty()) {
+            shape.append("collation", collation);
+        }
+        return shape.obj();
+    });
+}
+
+void QueryStatsStore::registerPipelineShape(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            const std::vector<BSONObj>& pipeline) {
+    if (!isEnabled() || getOperationEntry(opCtx)) {
+        return;
+    }
+
+    BSONArrayBuilder stages;
+    for (const auto& stage : pipeline) {
+        stages.append(shapifyStage(stage));
+    }
+    const auto shapedPipeline = stages.arr();
+    const StringData shapeKey(shapedPipeline.objdata(), shapedPipeline.objsize());
+
+    _registerEntry(opCtx,
+                   makeKey(nss, "aggregate"_sd, shapeKey),
+                   nss,
+                   static_cast<uint32_t>(SimpleStringDataComparator::kInstance.hash(shapeKey)),
+                   [&] { return BSON("command" << "aggregate" << "pipeline" << shapedPipeline); });
+}
+
+const std::shared_ptr<QueryStatsEntry>& QueryStatsStore::getEntry(OperationContext* opCtx) {
+    return getOperationEntry(opCtx);
+}
+
+void QueryStatsStore::setEntry(OperationContext* opCtx, std::shared_ptr<QueryStatsEntry> entry) {
+    getOperationEntry(opCtx) = std::move(entry);
+}
+
+std::vector<BSONObj> QueryStatsStore::toBSON() const {
+    std::vector<std::shared_ptr<QueryStatsEntry>> entries;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        entries.insert(entries.end(), partition.ring.begin(), partition.ring.end());
+    }
+
+    // Serialize outside the partition locks, so that reading the store does not stall queries.
+    std::vector<BSONObj> result;
+    result.reserve(entries.size());
+    for (const auto& entry : entries) {
+        BSONObjBuilder builder;
+        entry->append(&builder);
+        result.push_back(builder.obj());
+    }
+    return result;
+}
+
+BSONObj QueryStatsStore::shapify(const BSONObj& obj) {
+    return shapifyObject(obj, false /* keepFieldPaths */);
+}
+
+BSONObj QueryStatsStore::shapifyStage(const BSONObj& stage) {
+    return shapifyObject(stage, true /* keepFieldPaths */);
+}
+
+}  // namespace mongo
@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Execution statistics accumulated for one query shape of one command on one namespace. Every
+ * operation running the shape updates it with atomic adds. A lock is only taken to replace the last
+ * plan summary when the shape's plan changes.
+ */
+class QueryStatsEntry {
+public:
+    /**
+     * What one operation, either the initial command or a getMore, contributes.
+     */
+    struct Execution {
+        Microseconds duration;
+        bool isGetMore = false;
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+        StringData planSummary;
+    };
+
+    // Latencies are counted in power of two buckets of microseconds, the last open ended.
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    QueryStatsEntry(std::string key, NamespaceString nss, uint32_t queryHash, BSONObj shape);
+
+    void record(const Execution& execution);
+
+    void append(BSONObjBuilder* builder) const;
+
+    const std::string& key() const {
+        return _key;
+    }
+
+    /**
+     * Marks the entry as used since the store last considered evicting it.
+     */
+    void markReferenced() {
+        if (!_referenced.loadRelaxed()) {
+            _referenced.store(true);
+        }
+    }
+
+    /**
+     * Returns whether the entry was used since the last call, and clears that.
+     */
+    bool clearReferenced() {
+        return _referenced.swap(false);
+    }
+
+    void markEvicted() {
+        _evicted.store(true);
+    }
+
+    bool isEvicted() const {
+        return _evicted.load();
+    }
+
+    /**
+     * Memory charged against the store's budget for this entry.
+     */
+    size_t approximateSize() const {
+        return _approximateSize;
+    }
+
+private:
+    const std::string _key;
+    const NamespaceString _nss;
+    const uint32_t _queryHash;
+    const BSONObj _shape;
+    const Date_t _firstSeen;
+    const size_t _approximateSize;
+
+    AtomicWord<long long> _executions{0};
+    AtomicWord<long long> _getMores{0};
+    AtomicWord<long long> _totalMicros{0};
+    AtomicWord<long long> _maxMicros{0};
+    AtomicWord<long long> _docsExamined{0};
+    AtomicWord<long long> _keysExamined{0};
+    AtomicWord<long long> _nreturned{0};
+    AtomicWord<long long> _bytesReturned{0};
+    AtomicWord<long long> _lastExecutionMillis{0};
+    std::array<AtomicWord<long long>, kNumLatencyBuckets> _latencyBuckets;
+
+    AtomicWord<bool> _referenced{true};
+    AtomicWord<bool> _evicted{false};
+
+    // Hash of _lastPlanSummary, compared against on the record path so that an unchanged plan
+    // summary is neither locked nor copied.
+    AtomicWord<size_t> _lastPlanSummaryHash{0};
+
+    mutable Mutex _planSummaryMutex = MONGO_MAKE_LATCH("QueryStatsEntry::_planSummaryMutex");
+    std::string _lastPlanSummary;
+};
+
+/**
+ * A size bounded store of QueryStatsEntry by namespace, command and query shape, read by the
+ * $queryStats aggregation stage. Unlike the profiler it sees every execution of every shape, so
+ * cheap but frequent queries show up too.
+ *
+ * The store is split into partitions by key hash, each with its own lock, evicting with the clock
+ * algorithm: an entry used since the clock hand last passed it is skipped once. Each thread caches
+ * the entries it found last, so an operation running a hot shape finds its entry without taking a
+ * partition lock and only sets the entry's referenced bit. Operations hold on to their entry, so
+ * recording statistics takes no partition lock either.
+ */
+class QueryStatsStore {
+public:
+    static QueryStatsStore& get(ServiceContext* serviceContext);
+    static QueryStatsStore& get(OperationContext* opCtx);
+
+    /**
+     * Returns false if the store is disabled by queryStatsStoreSizeBytes.
+     */
+    static bool isEnabled();
+
+    QueryStatsStore() = default;
+    ~QueryStatsStore();
+
+    /**
+     * Finds or creates the entry for the shape of a query run by 'command' and attaches it to the
+     * operation, unless an earlier query of the same operation, e.g. the outer query of a $lookup,
+     * already attached one. 'shapeKey' identifies the shape; the shape document is only built for
+     * new entries.
+     */
+    void registerShape(OperationContext* opCtx,
+                       const NamespaceString& nss,
+                       StringData command,
+                       StringData shapeKey,
+                       uint32_t queryHash,
+                       const BSONObj& filter,
+                       const BSONObj& projection,
+                       const BSONObj& sort,
+                       const BSONObj& collation);
+
+    /**
+     * Like registerShape() for an aggregate, whose shape is its whole pipeline with the literal
+     * values replaced. Registering it before the pipeline's leading $match is planned keeps the
+     * aggregate apart from finds with the same filter.
+     */
+    void registerPipelineShape(OperationContext* opCtx,
+                               const NamespaceString& nss,
+                               const std::vector<BSONObj>& pipeline);
+
+    /**
+     * The entry attached to the operation, if any. Cursors carry their entry across getMores.
+     */
+    static const std::shared_ptr<QueryStatsEntry>& getEntry(OperationContext* opCtx);
+    static void setEntry(OperationContext* opCtx, std::shared_ptr<QueryStatsEntry> entry);
+
+    /**
+     * Returns one document per entry.
+     */
+    std::vector<BSONObj> toBSON() const;
+
+    /**
+     * Replaces the literal values in a filter or projection with placeholders naming their type,
+     * so that queries of the same shape have the same representation.
+     */
+    static BSONObj shapify(const BSONObj& obj);
+
+    /**
+     * Like shapify() for a stage of an aggregation pipeline, but keeps the field paths and
+     * variables referenced by its expressions, which are part of its shape.
+     */
+    static BSONObj shapifyStage(const BSONObj& stage);
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+
+    struct Partition {
+        using Ring = std::list<std::shared_ptr<QueryStatsEntry>>;
+
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryStatsStore::Partition::mutex");
+        // New entries are inserted just behind the hand, so they are the last it passes.
+        Ring ring;
+        Ring::iterator hand = ring.end();
+        stdx::unordered_map<std::string, Ring::iterator> entries;
+        size_t bytes = 0;
+    };
+
+    /**
+     * Attaches the entry with the given key to the operation, creating it with the shape returned
+     * by 'makeShape' if there is none.
+     */
+    template <typename MakeShape>
+    void _registerEntry(OperationContext* opCtx,
+                        std::string key,
+                        const NamespaceString& nss,
+                        uint32_t queryHash,
+                        MakeShape&& makeShape);
+
+    std::array<Partition, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
@@ -0,0 +1,222 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_stats_store.h"
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/query_stats_store_gen.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+void registerShape(OperationContext* opCtx,
+                   StringData shapeKey,
+                   const BSONObj& filter,
+                   StringData command = "find"_sd) {
+    QueryStatsStore::get(opCtx).registerShape(
+        opCtx, kNss, command, shapeKey, 0, filter, BSONObj(), BSONObj(), BSONObj());
+}
+
+TEST(QueryStatsStoreTest, ShapifyReplacesLiterals) {
+    ASSERT_BSONOBJ_EQ(
+        QueryStatsStore::shapify(fromjson("{a: 1, b: 'x', c: {$gt: 2.5}, d: {$in: [1, 2, 3]}}")),
+        fromjson("{a: '?number', b: '?string', c: {$gt: '?number'}, d: {$in: ['?array']}}"));
+    ASSERT_BSONOBJ_EQ(QueryStatsStore::shapify(fromjson("{$or: [{a: 1}, {b: true}]}")),
+                      fromjson("{$or: [{a: '?number'}, {b: '?bool'}]}"));
+}
+
+TEST(QueryStatsStoreTest, NothingIsRegisteredWhenDisabled) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    ASSERT_FALSE(QueryStatsStore::isEnabled());
+    registerShape(opCtx.get(), "shape", fromjson("{a: 1}"));
+    ASSERT_FALSE(QueryStatsStore::getEntry(opCtx.get()));
+    ASSERT(QueryStatsStore::get(opCtx.get()).toBSON().empty());
+}
+
+TEST(QueryStatsStoreTest, ExecutionsOfTheSameShapeShareAnEntry) {
+    const auto oldSize = gQueryStatsStoreSizeBytes.load();
+    gQueryStatsStoreSizeBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT([&] { gQueryStatsStoreSizeBytes.store(oldSize); });
+
+    QueryTestServiceContext serviceContext;
+    for (int i = 0; i < 2; ++i) {
+        auto opCtx = serviceContext.makeOperationContext();
+        registerShape(opCtx.get(), "shape", BSON("a" << i));
+
+        // Only the first registration of an operation counts.
+        registerShape(opCtx.get(), "other", BSON("a" << i));
+
+        QueryStatsEntry::Execution execution;
+        execution.duration = Microseconds(100 << i);
+        execution.isGetMore = i == 1;
+        execution.docsExamined = 10;
+        execution.nreturned = 5;
+        execution.planSummary = "COLLSCAN"_sd;
+        QueryStatsStore::getEntry(opCtx.get())->record(execution);
+    }
+
+    auto entries = QueryStatsStore::get(serviceContext.getServiceContext()).toBSON();
+    ASSERT_EQ(entries.size(), 1U);
+    const auto& entry = entries[0];
+    ASSERT_EQ(entry["ns"].str(), kNss.ns());
+    ASSERT_BSONOBJ_EQ(entry["queryShape"].Obj(),
+                      fromjson("{command: 'find', filter: {a: '?number'}}"));
+    ASSERT_EQ(entry["executionCount"].numberLong(), 1);
+    ASSERT_EQ(entry["getMoreCount"].numberLong(), 1);
+    ASSERT_EQ(entry["totalExecMicros"].numberLong(), 300);
+    ASSERT_EQ(entry["maxExecMicros"].numberLong(), 200);
+    ASSERT_EQ(entry["docsExamined"].numberLong(), 20);
+    ASSERT_EQ(entry["nreturned"].numberLong(), 10);
+    ASSERT_EQ(entry["lastPlanSummary"].str(), "COLLSCAN");
+    ASSERT_EQ(entry["latencyHistogram"].Array().size(), 2U);
+}
+
+TEST(QueryStatsStoreTest, LastPlanSummaryFollowsPlanChanges) {
+    const auto oldSize = gQueryStatsStoreSizeBytes.load();
+    gQueryStatsStoreSizeBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT([&] { gQueryStatsStoreSizeBytes.store(oldSize); });
+
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    registerShape(opCtx.get(), "shape", fromjson("{a: 1}"));
+    auto& entry = *QueryStatsStore::getEntry(opCtx.get());
+
+    auto lastPlanSummary = [&] {
+        BSONObjBuilder builder;
+        entry.append(&builder);
+        return builder.obj()["lastPlanSummary"].str();
+    };
+
+    QueryStatsEntry::Execution execution;
+    execution.planSummary = "COLLSCAN"_sd;
+    entry.record(execution);
+    ASSERT_EQ(lastPlanSummary(), "COLLSCAN");
+
+    execution.planSummary = "IXSCAN { a: 1 }"_sd;
+    entry.record(execution);
+    ASSERT_EQ(lastPlanSummary(), "IXSCAN { a: 1 }");
+
+    // A getMore continues the plan of its cursor and does not replace the summary.
+    execution.isGetMore = true;
+    execution.planSummary = "COLLSCAN"_sd;
+    entry.record(execution);
+    ASSERT_EQ(lastPlanSummary(), "IXSCAN { a: 1 }");
+}
+
+TEST(QueryStatsStoreTest, ShapifyStageKeepsFieldPaths) {
+    ASSERT_BSONOBJ_EQ(
+        QueryStatsStore::shapifyStage(fromjson("{$group: {_id: '$a', n: {$sum: 1}, s: 'x'}}")),
+        fromjson("{$group: {_id: '$a', n: {$sum: '?number'}, s: '?string'}}"));
+}
+
+TEST(QueryStatsStoreTest, CommandsAndPipelinesHaveShapesOfTheirOwn) {
+    const auto oldSize = gQueryStatsStoreSizeBytes.load();
+    gQueryStatsStoreSizeBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT([&] { gQueryStatsStoreSizeBytes.store(oldSize); });
+
+    QueryTestServiceContext serviceContext;
+    auto registerAndGet = [&](auto&& registerFn) {
+        auto opCtx = serviceContext.makeOperationContext();
+        registerFn(opCtx.get());
+        return QueryStatsStore::getEntry(opCtx.get());
+    };
+
+    auto find = registerAndGet([](auto* opCtx) { registerShape(opCtx, "shape", BSON("a" << 1)); });
+    auto count = registerAndGet(
+        [](auto* opCtx) { registerShape(opCtx, "shape", BSON("a" << 1), "count"_sd); });
+    auto groupByA = registerAndGet([](auto* opCtx) {
+        QueryStatsStore::get(opCtx).registerPipelineShape(
+            opCtx, kNss, {fromjson("{$match: {a: 1}}"), fromjson("{$group: {_id: '$a'}}")});
+    });
+    auto groupByB = registerAndGet([](auto* opCtx) {
+        QueryStatsStore::get(opCtx).registerPipelineShape(
+            opCtx, kNss, {fromjson("{$match: {a: 2}}"), fromjson("{$group: {_id: '$b'}}")});
+    });
+    auto groupByAAgain = registerAndGet([](auto* opCtx) {
+        QueryStatsStore::get(opCtx).registerPipelineShape(
+            opCtx, kNss, {fromjson("{$match: {a: 3}}"), fromjson("{$group: {_id: '$a'}}")});
+    });
+
+    ASSERT_NE(find, count);
+    ASSERT_NE(groupByA, groupByB);
+    ASSERT_EQ(groupByA, groupByAAgain);
+    ASSERT_EQ(QueryStatsStore::get(serviceContext.getServiceContext()).toBSON().size(), 4U);
+
+    BSONObjBuilder builder;
+    groupByA->append(&builder);
+    ASSERT_BSONOBJ_EQ(
+        builder.obj()["queryShape"].Obj(),
+        fromjson("{command: 'aggregate', pipeline: [{$match: {a: '?number'}}, {$group: {_id: "
+                 "'$a'}}]}"));
+}
+
+TEST(QueryStatsStoreTest, UnreferencedShapesAreEvicted) {
+    const auto oldSize = gQueryStatsStoreSizeBytes.load();
+    // Less than one entry per partition, so each partition keeps only its newest shape.
+    gQueryStatsStoreSizeBytes.store(1);
+    ON_BLOCK_EXIT([&] { gQueryStatsStoreSizeBytes.store(oldSize); });
+
+    QueryTestServiceContext serviceContext;
+    std::vector<std::shared_ptr<QueryStatsEntry>> entries;
+    for (int i = 0; i < 100; ++i) {
+        auto opCtx = serviceContext.makeOperationContext();
+        registerShape(opCtx.get(), std::to_string(i), BSON("a" << i));
+        ASSERT(QueryStatsStore::getEntry(opCtx.get()));
+        entries.push_back(QueryStatsStore::getEntry(opCtx.get()));
+    }
+
+    auto stored = QueryStatsStore::get(serviceContext.getServiceContext()).toBSON();
+    ASSERT_GT(stored.size(), 0U);
+    ASSERT_LTE(stored.size(), 16U);
+
+    // Evicted entries are never found again, even though this thread still caches some of them.
+    for (int i = 0; i < 100; ++i) {
+        auto opCtx = serviceContext.makeOperationContext();
+        registerShape(opCtx.get(), std::to_string(i), BSON("a" << i));
+        if (entries[i]->isEvicted()) {
+            ASSERT_NE(QueryStatsStore::getEntry(opCtx.get()), entries[i]);
+        }
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/query/classic_stage_builder.h"
 #include "mongo/db/query/plan_yield_policy.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/query/shard_filterer_factory_impl.h"
 
@@ -76,6 +77,11 @@ buildSlotBasedExecutableTree(OperationContext* opCtx,
     auto root = builder->build(solution.root());
     auto data = builder->getPlanStageData();
 
+    if (cq.getExpCtx()->explain) {
+        // Time each stage so that explain can report where the plan spends its CPU.
+        root->markShouldCollectTimingInfo(internalQueryExplainSBEHardwareCounters.load());
+    }
+
     root->attachToOperationContext(opCtx);
 
     // Register this plan to yield according to the configured policy.
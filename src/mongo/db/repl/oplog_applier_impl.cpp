@@ -38,6 +38,7 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
+#include "mongo/db/concurrency/admission_context.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/logical_session_id.h"
@@ -523,6 +524,10 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                         // so it is safe to exclude any writes from Flow Control.
                         opCtx->setShouldParticipateInFlowControl(false);
 
+                        // Replication lag grows with every ticket wait of the writer threads, so
+                        // they are admitted ahead of reads served by the secondary.
+                        AdmissionContext::get(opCtx.get()).setPriority(AdmissionPriority::kHigh);
+
                         status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
                             return applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyVector);
                         });
@@ -47,6 +47,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
 #include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/admission_context.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
@@ -479,6 +480,9 @@ OpTime ReplicationCoordinatorExternalStateImpl::onTransitionToPrimary(OperationC
     invariant(opCtx->lockState()->isRSTLExclusive());
     invariant(!opCtx->shouldParticipateInFlowControl());
 
+    // The node accepts no writes until it is done, so it must not queue behind user operations.
+    ScopedAdmissionPriority admissionPriority(opCtx, AdmissionPriority::kHigh);
+
     MongoDSessionCatalog::onStepUp(opCtx);
 
     invariant(
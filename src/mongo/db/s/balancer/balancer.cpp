@@ -642,9 +642,16 @@ int Balancer::_moveChunks(OperationContext* opCtx,
         return 0;
     }
 
+    auto migrateInfos = candidateChunks;
+    for (auto& migrateInfo : migrateInfos) {
+        if (migrateInfo.numChunks() > 1) {
+            _mergeChunksToMove(opCtx, &migrateInfo);
+        }
+    }
+
     auto migrationStatuses =
         _migrationManager.executeMigrationsForAutoBalance(opCtx,
-                                                          candidateChunks,
+                                                          migrateInfos,
                                                           balancerConfig->getMaxChunkSizeBytes(),
                                                           balancerConfig->getSecondaryThrottle(),
                                                           balancerConfig->waitForDelete());
@@ -652,20 +659,27 @@ int Balancer::_moveChunks(OperationContext* opCtx,
     int numChunksProcessed = 0;
 
     for (const auto& migrationStatusEntry : migrationStatuses) {
-        const Status& status = migrationStatusEntry.second;
-        if (status.isOK()) {
-            numChunksProcessed++;
-            continue;
-        }
-
         const MigrationIdentifier& migrationId = migrationStatusEntry.first;
 
-        const auto requestIt = std::find_if(candidateChunks.begin(),
-                                            candidateChunks.end(),
+        const auto requestIt = std::find_if(migrateInfos.begin(),
+                                            migrateInfos.end(),
                                             [&migrationId](const MigrateInfo& migrateInfo) {
                                                 return migrateInfo.getName() == migrationId;
                                             });
-        invariant(requestIt != candidateChunks.end());
+        invariant(requestIt != migrateInfos.end());
+
+        const Status& status = migrationStatusEntry.second;
+        const bool isChunkTooBig =
+            status == ErrorCodes::ChunkTooBig || status == ErrorCodes::ExceededMemoryLimit;
+
+        if (requestIt->numChunks() > 1) {
+            _splitMergedChunks(opCtx, *requestIt, isChunkTooBig);
+        }
+
+        if (status.isOK()) {
+            numChunksProcessed += requestIt->numChunks();
+            continue;
+        }
 
         // ChunkTooBig is returned by the source shard during the cloning phase if the migration
         // manager finds that the chunk is larger than some calculated size, the source shard is
@@ -673,7 +687,18 @@ int Balancer::_moveChunks(OperationContext* opCtx,
         // ExceededMemoryLimit is returned when the transfer mods queue surpasses 500MB regardless
         // of whether the source shard is in draining mode or the value if the 'froceJumbo' balancer
         // setting.
-        if (status == ErrorCodes::ChunkTooBig || status == ErrorCodes::ExceededMemoryLimit) {
+        if (isChunkTooBig && requestIt->numChunks() > 1) {
+            numChunksProcessed++;
+
+            LOGV2(5986709,
+                  "Migration {migrateInfo} of several chunks failed with {error}, split them back",
+                  "Migration of several chunks failed, split them back",
+                  "migrateInfo"_attr = redact(requestIt->toString()),
+                  "error"_attr = redact(status));
+            continue;
+        }
+
+        if (isChunkTooBig) {
             numChunksProcessed++;
 
             LOGV2(21871,
@@ -752,6 +777,92 @@ void Balancer::_splitOrMarkJumbo(OperationContext* opCtx,
     }
 }
 
+void Balancer::_mergeChunksToMove(OperationContext* opCtx, MigrateInfo* migrateInfo) {
+    auto status = shardutil::mergeChunks(opCtx,
+                                         migrateInfo->from,
+                                         migrateInfo->nss,
+                                         migrateInfo->version,
+                                         ChunkRange(migrateInfo->minKey, migrateInfo->maxKey));
+    if (status.isOK()) {
+        return;
+    }
+
+    LOGV2(5986710,
+          "Failed to merge the chunks of migration {migrateInfo}, moving only its first chunk: "
+          "{error}",
+          "Failed to merge the chunks of migration, moving only its first chunk",
+          "migrateInfo"_attr = redact(migrateInfo->toString()),
+          "error"_attr = redact(status));
+
+    migrateInfo->maxKey = migrateInfo->splitKeys.front();
+    migrateInfo->splitKeys.clear();
+}
+
+void Balancer::_splitMergedChunks(OperationContext* opCtx,
+                                  const MigrateInfo& migrateInfo,
+                                  bool splitOversizedChunks) {
+    try {
+        const auto cm = uassertStatusOK(
+            Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(
+                opCtx, migrateInfo.nss));
+        const auto chunk = cm.findIntersectingChunkWithSimpleCollation(migrateInfo.minKey);
+
+        // The chunk which starts the range spans all of it, unless the range was already split.
+        if (SimpleBSONObjComparator::kInstance.evaluate(chunk.getMax() == migrateInfo.maxKey)) {
+            uassertStatusOK(shardutil::splitChunkAtMultiplePoints(
+                opCtx,
+                chunk.getShardId(),
+                migrateInfo.nss,
+                cm.getShardKeyPattern(),
+                cm.getVersion(),
+                ChunkRange(migrateInfo.minKey, migrateInfo.maxKey),
+                migrateInfo.splitKeys));
+        }
+
+        if (!splitOversizedChunks) {
+            return;
+        }
+
+        // Unlike a single chunk, a chunk for which there are no split points is not marked as
+        // jumbo, because it need not be the one which made the range too big to move.
+        std::vector<BSONObj> bounds{migrateInfo.minKey};
+        bounds.insert(bounds.end(), migrateInfo.splitKeys.begin(), migrateInfo.splitKeys.end());
+        bounds.push_back(migrateInfo.maxKey);
+
+        for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+            const ChunkRange range(bounds[i], bounds[i + 1]);
+            const auto splitPoints = uassertStatusOK(shardutil::selectChunkSplitPoints(
+                opCtx,
+                chunk.getShardId(),
+                migrateInfo.nss,
+                cm.getShardKeyPattern(),
+                range,
+                Grid::get(opCtx)->getBalancerConfiguration()->getMaxChunkSizeBytes(),
+                boost::none));
+            if (splitPoints.empty()) {
+                continue;
+            }
+
+            const auto refreshedCM = uassertStatusOK(
+                Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(
+                    opCtx, migrateInfo.nss));
+            uassertStatusOK(shardutil::splitChunkAtMultiplePoints(opCtx,
+                                                                  chunk.getShardId(),
+                                                                  migrateInfo.nss,
+                                                                  cm.getShardKeyPattern(),
+                                                                  refreshedCM.getVersion(),
+                                                                  range,
+                                                                  splitPoints));
+        }
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(5986711,
+                      "Failed to split the chunks of migration {migrateInfo} back: {error}",
+                      "Failed to split the chunks of migration back",
+                      "migrateInfo"_attr = redact(migrateInfo.toString()),
+                      "error"_attr = redact(ex.toStatus()));
+    }
+}
+
 void Balancer::notifyPersistedBalancerSettingsChanged() {
     stdx::unique_lock<Latch> lock(_mutex);
     _condVar.notify_all();
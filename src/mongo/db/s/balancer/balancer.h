@@ -228,6 +228,22 @@ private:
                            const NamespaceString& nss,
                            const BSONObj& minKey);
 
+    /**
+     * Merges the chunks of a migration, which moves several contiguous chunks, on the donor so that
+     * they can be moved in a single session. If the merge fails, the migration is narrowed down to
+     * its first chunk.
+     */
+    void _mergeChunksToMove(OperationContext* opCtx, MigrateInfo* migrateInfo);
+
+    /**
+     * Splits the range of a migration, which moved several contiguous chunks, back at the bounds of
+     * the original chunks on whichever shard owns it now. If 'splitOversizedChunks' is true, the
+     * original chunks are also split further where they have grown past the maximum chunk size.
+     */
+    void _splitMergedChunks(OperationContext* opCtx,
+                            const MigrateInfo& migrateInfo,
+                            bool splitOversizedChunks);
+
     // Protects the state below
     Mutex _mutex = MONGO_MAKE_LATCH("Balancer::_mutex");
 
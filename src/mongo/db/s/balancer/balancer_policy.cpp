@@ -33,9 +33,11 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
 #include <random>
 
 #include "mongo/db/s/balancer/type_migration.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
@@ -618,7 +620,8 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
 
     unsigned numJumboChunks = 0;
 
-    for (const auto& chunk : chunks) {
+    for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+        const auto& chunk = *it;
         if (distribution.getTagForChunk(chunk) != tag)
             continue;
 
@@ -628,6 +631,25 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
         }
 
         migrations->emplace_back(to, chunk, forceJumbo, MigrateInfo::chunksImbalance);
+
+        // The shard's chunks are sorted by their min key, so the chunks which directly follow this
+        // one can be moved in the same migration, as long as neither shard is pushed past the
+        // ideal chunk count.
+        const size_t maxChunksToMove =
+            std::min({static_cast<size_t>(balancerMaxChunksPerMigration.load()),
+                      imbalance,
+                      idealNumberOfChunksPerShardForTag - min});
+
+        auto& migration = migrations->back();
+        for (auto next = std::next(it); next != chunks.end(); ++next) {
+            if (migration.numChunks() >= maxChunksToMove || next->getJumbo() ||
+                distribution.getTagForChunk(*next) != tag ||
+                SimpleBSONObjComparator::kInstance.evaluate(next->getMin() != migration.maxKey))
+                break;
+
+            migration.appendChunk(*next);
+        }
+
         invariant(usedShards->insert(chunk.getShard()).second);
         invariant(usedShards->insert(to).second);
         return true;
@@ -695,8 +717,20 @@ BSONObj MigrateInfo::getMigrationTypeQuery() const {
 }
 
 string MigrateInfo::toString() const {
-    return str::stream() << nss.ns() << ": [" << minKey << ", " << maxKey << "), from " << from
-                         << ", to " << to;
+    str::stream ss;
+    ss << nss.ns() << ": [" << minKey << ", " << maxKey << "), from " << from << ", to " << to;
+    if (!splitKeys.empty()) {
+        ss << ", " << numChunks() << " chunks";
+    }
+    return ss;
+}
+
+void MigrateInfo::appendChunk(const ChunkType& chunk) {
+    invariant(SimpleBSONObjComparator::kInstance.evaluate(chunk.getMin() == maxKey));
+    invariant(chunk.getShard() == from);
+
+    splitKeys.push_back(maxKey);
+    maxKey = chunk.getMax();
 }
 
 }  // namespace mongo
@@ -67,6 +67,18 @@ struct MigrateInfo {
 
     std::string toString() const;
 
+    /**
+     * Extends the migration to also move 'chunk', which must start where the migrated range ends.
+     */
+    void appendChunk(const ChunkType& chunk);
+
+    /**
+     * Returns the number of chunks, which the migrated range spans.
+     */
+    size_t numChunks() const {
+        return splitKeys.size() + 1;
+    }
+
     NamespaceString nss;
     ShardId to;
     ShardId from;
@@ -75,6 +87,10 @@ struct MigrateInfo {
     ChunkVersion version;
     MoveChunkRequest::ForceJumbo forceJumbo;
     MigrationReason reason;
+
+    // Bounds between the chunks of a migration, which moves several contiguous chunks as one range.
+    // The chunks are merged on the donor before the move and split back at these keys afterwards.
+    std::vector<BSONObj> splitKeys;
 };
 
 typedef std::vector<ClusterStatistics::ShardStatistics> ShardStatisticsVector;
@@ -33,9 +33,11 @@
 
 #include "mongo/db/keypattern.h"
 #include "mongo/db/s/balancer/balancer_policy.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -352,6 +354,82 @@ TEST(BalancerPolicy, JumboChunksNotMovedParallel) {
     ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[1].reason);
 }
 
+TEST(BalancerPolicy, ContiguousChunksMovedTogetherUpToTheIdealCount) {
+    balancerMaxChunksPerMigration.store(8);
+    ON_BLOCK_EXIT([] { balancerMaxChunksPerMigration.store(1); });
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_EQ(4U, migrations[0].numChunks());
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][3].getMax(), migrations[0].maxKey);
+    ASSERT_EQ(3U, migrations[0].splitKeys.size());
+    for (size_t i = 0; i < migrations[0].splitKeys.size(); i++) {
+        ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][i].getMax(), migrations[0].splitKeys[i]);
+    }
+    ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, ContiguousChunksMovedTogetherUpToTheLimit) {
+    balancerMaxChunksPerMigration.store(2);
+    ON_BLOCK_EXIT([] { balancerMaxChunksPerMigration.store(1); });
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(2U, migrations[0].numChunks());
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][1].getMax(), migrations[0].maxKey);
+}
+
+TEST(BalancerPolicy, ContiguousChunksMovedTogetherStopAtJumboChunk) {
+    balancerMaxChunksPerMigration.store(8);
+    ON_BLOCK_EXIT([] { balancerMaxChunksPerMigration.store(1); });
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    cluster.second[kShardId0][0].setJumbo(true);
+    cluster.second[kShardId0][3].setJumbo(true);
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(2U, migrations[0].numChunks());
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][1].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][2].getMax(), migrations[0].maxKey);
+}
+
+TEST(BalancerPolicy, ContiguousChunksMovedTogetherStopAtZoneBoundary) {
+    balancerMaxChunksPerMigration.store(8);
+    ON_BLOCK_EXIT([] { balancerMaxChunksPerMigration.store(1); });
+
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    DistributionStatus distribution(kNamespace, cluster.second);
+    ASSERT_OK(distribution.addRangeToZone(ZoneRange(BSON("x" << 2), BSON("x" << 3), "a")));
+
+    const auto migrations(balanceChunks(cluster.first, distribution, false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(2U, migrations[0].numChunks());
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][1].getMax(), migrations[0].maxKey);
+}
+
 TEST(BalancerPolicy, DrainingSingleChunk) {
     // shard0 is draining and chunks will go to shard1, even though it has a lot more chunks
     auto cluster = generateCluster(
@@ -468,7 +468,8 @@ std::shared_ptr<Notification<RemoteCommandResponse>> MigrationManager::_schedule
         migrateInfo.from,
         migrateInfo.to,
         ChunkRange(migrateInfo.minKey, migrateInfo.maxKey),
-        maxChunkSizeBytes,
+        // A range of several merged chunks may be as large as all of them together.
+        maxChunkSizeBytes * migrateInfo.numChunks(),
         secondaryThrottle,
         waitForDelete,
         migrateInfo.forceJumbo);
@@ -44,6 +44,7 @@
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
 #include "mongo/db/service_context.h"
@@ -68,6 +69,10 @@ const char kRecvChunkCommit[] = "_recvChunkCommit";
 const char kRecvChunkAbort[] = "_recvChunkAbort";
 
 const int kMaxObjectPerChunk{250000};
+
+// Lower bound of the size of the batches of the initial clone when the documents of the chunk are
+// streamed from the shard key index.
+const int kMinStreamingCloneBatchBytes{128 * 1024};
 const Hours kMaxWaitToCommitCloneForJumboChunk(6);
 
 MONGO_FAIL_POINT_DEFINE(failTooMuchMemoryUsed);
@@ -258,6 +263,8 @@ Status MigrationChunkClonerSourceLegacy::startClone(OperationContext* opCtx,
         _sessionCatalogSource->fetchNextOplog(opCtx);
     }
 
+    const bool streamsFromShardKeyIndex =
+        migrationClonerStreamFromShardKeyIndex.load() && !_forceJumbo;
     {
         // Ignore prepare conflicts when we load ids of currently available documents. This is
         // acceptable because we will track changes made by prepared transactions at transaction
@@ -271,12 +278,31 @@ Status MigrationChunkClonerSourceLegacy::startClone(OperationContext* opCtx,
         opCtx->recoveryUnit()->setPrepareConflictBehavior(
             PrepareConflictBehavior::kIgnoreConflicts);
 
-        auto storeCurrentLocsStatus = _storeCurrentLocs(opCtx);
-        if (storeCurrentLocsStatus == ErrorCodes::ChunkTooBig && _forceJumbo) {
+        if (streamsFromShardKeyIndex) {
+            // The documents are read straight from the shard key index while cloning, so there is
+            // no need to scan the chunk upfront. Whether it is too big is checked as it is cloned.
+            // Forced moves still scan upfront, since a jumbo chunk is cloned differently.
+            AutoGetCollection collection(opCtx, _args.getNss(), MODE_IS);
+            if (!collection) {
+                return {ErrorCodes::NamespaceNotFound,
+                        str::stream() << "Collection " << _args.getNss().ns()
+                                      << " does not exist."};
+            }
+
+            const auto maxRecsWhenFull =
+                _getMaxRecsWhenFull(opCtx, collection.getCollection()).first;
+
             stdx::lock_guard<Latch> sl(_mutex);
-            _jumboChunkCloneState.emplace();
-        } else if (!storeCurrentLocsStatus.isOK()) {
-            return storeCurrentLocsStatus;
+            _streamingCloneState.emplace();
+            _streamingCloneState->maxRecsWhenFull = maxRecsWhenFull;
+        } else {
+            auto storeCurrentLocsStatus = _storeCurrentLocs(opCtx);
+            if (storeCurrentLocsStatus == ErrorCodes::ChunkTooBig && _forceJumbo) {
+                stdx::lock_guard<Latch> sl(_mutex);
+                _jumboChunkCloneState.emplace();
+            } else if (!storeCurrentLocsStatus.isOK()) {
+                return storeCurrentLocsStatus;
+            }
         }
     }
 
@@ -297,6 +323,11 @@ Status MigrationChunkClonerSourceLegacy::startClone(OperationContext* opCtx,
                                             _shardKeyPattern.toBSON(),
                                             _args.getSecondaryThrottle());
 
+    // Let the recipient know that it may receive a document twice.
+    if (streamsFromShardKeyIndex) {
+        StartChunkCloneRequest::appendStreamsFromShardKeyIndex(&cmdBuilder);
+    }
+
     // Commands sent to shards that accept writeConcern, must always have writeConcern. So if the
     // StartChunkCloneRequest didn't add writeConcern (from secondaryThrottle), then we add the
     // implicit server default writeConcern.
@@ -695,11 +726,107 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
     _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
+void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromStreamingIndexScan(
+    OperationContext* opCtx, const CollectionPtr& collection, BSONArrayBuilder* arrBuilder) {
+    ElapsedTracker tracker(opCtx->getServiceContext()->getFastClockSource(),
+                           internalQueryExecYieldIterations.load(),
+                           Milliseconds(internalQueryExecYieldPeriodMS.load()));
+
+    auto& state = *_streamingCloneState;
+
+    // The recipient only requests the next batch once it has room for it, so the time between the
+    // start of two consecutive batches reflects the rate at which it inserts them. Size the new
+    // batch so that it takes about 'migrationClonerTargetBatchIntervalMS' to go through.
+    if (arrBuilder->arrSize() == 0) {
+        const auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
+        if (state.batchBytes > 0) {
+            const double elapsedSecs =
+                std::max<long long>(durationCount<Milliseconds>(now - state.batchStartTime), 1) /
+                1000.0;
+            const double bytesPerSecond = state.batchBytes / elapsedSecs;
+            state.bytesPerSecond = state.bytesPerSecond > 0
+                ? (state.bytesPerSecond + bytesPerSecond) / 2
+                : bytesPerSecond;
+
+            const double targetBatchBytes =
+                state.bytesPerSecond * migrationClonerTargetBatchIntervalMS.load() / 1000.0;
+            state.targetBatchBytes = static_cast<int>(
+                std::max(std::min(targetBatchBytes, static_cast<double>(BSONObjMaxUserSize)),
+                         static_cast<double>(kMinStreamingCloneBatchBytes)));
+        }
+
+        state.batchStartTime = now;
+        state.batchBytes = 0;
+    }
+
+    if (!state.clonerExec) {
+        state.clonerExec = uassertStatusOK(
+            _getIndexScanExecutor(opCtx, collection, InternalPlanner::IXSCAN_FETCH));
+    } else {
+        state.clonerExec->reattachToOperationContext(opCtx);
+        state.clonerExec->restoreState(&collection);
+    }
+
+    PlanExecutor::ExecState execState = state.clonerState;
+    try {
+        BSONObj obj;
+        while (arrBuilder->len() < state.targetBatchBytes &&
+               PlanExecutor::ADVANCED == (execState = state.clonerExec->getNext(&obj, nullptr))) {
+            opCtx->checkForInterrupt();
+
+            // Use the builder size instead of accumulating the document sizes directly so
+            // that we take into consideration the overhead of BSONArray indices.
+            if (arrBuilder->arrSize() &&
+                (arrBuilder->len() + obj.objsize() + 1024) > BSONObjMaxUserSize) {
+                state.clonerExec->enqueue(obj);
+                break;
+            }
+
+            stdx::unique_lock<Latch> lk(_mutex);
+            uassert(ErrorCodes::ChunkTooBig,
+                    str::stream() << "Cannot move chunk: the maximum number of documents for a "
+                                     "chunk is "
+                                  << state.maxRecsWhenFull << ", the maximum chunk size is "
+                                  << _args.getMaxChunkSizeBytes() << ". Found more documents in "
+                                  << "chunk ns: " << _args.getNss().ns() << " "
+                                  << _args.getMinKey() << " -> " << _args.getMaxKey(),
+                    static_cast<unsigned long long>(state.docsCloned) < state.maxRecsWhenFull);
+            state.docsCloned++;
+            lk.unlock();
+
+            arrBuilder->append(obj);
+
+            ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
+
+            // Return periodically to give the caller a chance to yield its locks. It will call
+            // again as long as it got documents from this call.
+            if (tracker.intervalHasElapsed()) {
+                break;
+            }
+        }
+    } catch (DBException& exception) {
+        exception.addContext("Executor error while scanning for documents belonging to chunk");
+        throw;
+    }
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    state.clonerState = execState;
+    state.batchBytes = arrBuilder->len();
+    lk.unlock();
+
+    state.clonerExec->saveState();
+    state.clonerExec->detachFromOperationContext();
+}
+
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
     stdx::lock_guard<Latch> sl(_mutex);
     if (_jumboChunkCloneState && _forceJumbo)
         return static_cast<uint64_t>(BSONObjMaxUserSize);
 
+    if (_streamingCloneState)
+        return std::min(static_cast<uint64_t>(BSONObjMaxUserSize),
+                        static_cast<uint64_t>(_streamingCloneState->targetBatchBytes));
+
     return std::min(static_cast<uint64_t>(BSONObjMaxUserSize),
                     _averageObjectSizeForCloneLocs * _cloneLocs.size());
 }
@@ -720,6 +847,15 @@ Status MigrationChunkClonerSourceLegacy::nextCloneBatch(OperationContext* opCtx,
         }
     }
 
+    if (_streamingCloneState) {
+        try {
+            _nextCloneBatchFromStreamingIndexScan(opCtx, collection, arrBuilder);
+            return Status::OK();
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }
+
     _nextCloneBatchFromCloneLocs(opCtx, collection, arrBuilder);
     return Status::OK();
 }
@@ -802,7 +938,8 @@ StatusWith<BSONObj> MigrationChunkClonerSourceLegacy::_callRecipient(const BSONO
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
 MigrationChunkClonerSourceLegacy::_getIndexScanExecutor(OperationContext* opCtx,
-                                                        const CollectionPtr& collection) {
+                                                        const CollectionPtr& collection,
+                                                        int scanOptions) {
     // Allow multiKey based on the invariant that shard keys must be single-valued. Therefore, any
     // multi-key index prefixed by shard key cannot be multikey over the shard key fields.
     const IndexDescriptor* idx =
@@ -829,7 +966,9 @@ MigrationChunkClonerSourceLegacy::_getIndexScanExecutor(OperationContext* opCtx,
                                       min,
                                       max,
                                       BoundInclusion::kIncludeStartKeyOnly,
-                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO);
+                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                      InternalPlanner::FORWARD,
+                                      scanOptions);
 }
 
 Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opCtx) {
@@ -848,24 +987,8 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
     // Use the average object size to estimate how many objects a full chunk would carry do that
     // while traversing the chunk's range using the sharding index, below there's a fair amount of
     // slack before we determine a chunk is too large because object sizes will vary.
-    unsigned long long maxRecsWhenFull;
-    long long avgRecSize;
-
-    const long long totalRecs = collection->numRecords(opCtx);
-    if (totalRecs > 0) {
-        avgRecSize = collection->dataSize(opCtx) / totalRecs;
-        // The calls to numRecords() and dataSize() are not atomic so it is possible that the data
-        // size becomes smaller than the number of records between the two calls, which would result
-        // in average record size of zero
-        if (avgRecSize == 0) {
-            avgRecSize = BSONObj::kMinBSONLength;
-        }
-        maxRecsWhenFull = _args.getMaxChunkSizeBytes() / avgRecSize;
-        maxRecsWhenFull = 130 * maxRecsWhenFull / 100;  // pad some slack
-    } else {
-        avgRecSize = 0;
-        maxRecsWhenFull = kMaxObjectPerChunk + 1;
-    }
+    const auto [maxRecsWhenFull, avgRecSize] =
+        _getMaxRecsWhenFull(opCtx, collection.getCollection());
 
     // Do a full traversal of the chunk and don't stop even if we think it is a large chunk we want
     // the number of records to better report, in that case.
@@ -919,6 +1042,26 @@ Status MigrationChunkClonerSourceLegacy::_storeCurrentLocs(OperationContext* opC
     return Status::OK();
 }
 
+std::pair<unsigned long long, long long> MigrationChunkClonerSourceLegacy::_getMaxRecsWhenFull(
+    OperationContext* opCtx, const CollectionPtr& collection) {
+    const long long totalRecs = collection->numRecords(opCtx);
+    if (totalRecs <= 0) {
+        return {kMaxObjectPerChunk + 1, 0};
+    }
+
+    long long avgRecSize = collection->dataSize(opCtx) / totalRecs;
+    // The calls to numRecords() and dataSize() are not atomic so it is possible that the data
+    // size becomes smaller than the number of records between the two calls, which would result
+    // in average record size of zero
+    if (avgRecSize == 0) {
+        avgRecSize = BSONObj::kMinBSONLength;
+    }
+
+    unsigned long long maxRecsWhenFull = _args.getMaxChunkSizeBytes() / avgRecSize;
+    maxRecsWhenFull = 130 * maxRecsWhenFull / 100;  // pad some slack
+    return {maxRecsWhenFull, avgRecSize};
+}
+
 long long MigrationChunkClonerSourceLegacy::_xferDeletes(BSONObjBuilder* builder,
                                                          std::list<BSONObj>* removeList,
                                                          long long initialSize) {
@@ -998,14 +1141,15 @@ Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationC
 
         const std::size_t cloneLocsRemaining = _cloneLocs.size();
 
-        if (_forceJumbo && _jumboChunkCloneState) {
+        if ((_forceJumbo && _jumboChunkCloneState) || _streamingCloneState) {
             LOGV2(21992,
                   "moveChunk data transfer progress: {response} mem used: {memoryUsedBytes} "
                   "documents cloned so far: {docsCloned}",
                   "moveChunk data transfer progress",
                   "response"_attr = redact(res),
                   "memoryUsedBytes"_attr = _memoryUsed,
-                  "docsCloned"_attr = _jumboChunkCloneState->docsCloned);
+                  "docsCloned"_attr = _streamingCloneState ? _streamingCloneState->docsCloned
+                                                           : _jumboChunkCloneState->docsCloned);
         } else {
             LOGV2(21993,
                   "moveChunk data transfer progress: {response} mem used: {memoryUsedBytes} "
@@ -1019,7 +1163,9 @@ Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationC
         if (res["state"].String() == "steady") {
             if (cloneLocsRemaining != 0 ||
                 (_jumboChunkCloneState && _forceJumbo &&
-                 PlanExecutor::IS_EOF != _jumboChunkCloneState->clonerState)) {
+                 PlanExecutor::IS_EOF != _jumboChunkCloneState->clonerState) ||
+                (_streamingCloneState &&
+                 PlanExecutor::IS_EOF != _streamingCloneState->clonerState)) {
                 return {ErrorCodes::OperationIncomplete,
                         str::stream() << "Unable to enter critical section because the recipient "
                                          "shard thinks all data is cloned while there are still "
@@ -222,7 +222,9 @@ private:
     StatusWith<BSONObj> _callRecipient(const BSONObj& cmdObj);
 
     StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> _getIndexScanExecutor(
-        OperationContext* opCtx, const CollectionPtr& collection);
+        OperationContext* opCtx,
+        const CollectionPtr& collection,
+        int scanOptions = InternalPlanner::IXSCAN_DEFAULT);
 
     void _nextCloneBatchFromIndexScan(OperationContext* opCtx,
                                       const CollectionPtr& collection,
@@ -232,6 +234,16 @@ private:
                                       const CollectionPtr& collection,
                                       BSONArrayBuilder* arrBuilder);
 
+    /**
+     * Appends to 'arrBuilder' the next documents of the chunk in shard key order, until the batch
+     * reaches the size targeted by _streamingCloneState. If 'arrBuilder' is empty, a new batch is
+     * starting and the target size is first adjusted to the rate at which the recipient consumed
+     * the previous batches.
+     */
+    void _nextCloneBatchFromStreamingIndexScan(OperationContext* opCtx,
+                                               const CollectionPtr& collection,
+                                               BSONArrayBuilder* arrBuilder);
+
     /**
      * Get the disklocs that belong to the chunk migrated and sort them in _cloneLocs (to avoid
      * seeking disk later).
@@ -240,6 +252,14 @@ private:
      */
     Status _storeCurrentLocs(OperationContext* opCtx);
 
+    /**
+     * Estimates from the average document size of the collection the maximum number of documents
+     * that the chunk may hold before it is considered too big to move. Returns this number along
+     * with the average document size.
+     */
+    std::pair<unsigned long long, long long> _getMaxRecsWhenFull(OperationContext* opCtx,
+                                                                 const CollectionPtr& collection);
+
     /**
      * Adds the OpTime to the list of OpTimes for oplog entries that we should consider migrating as
      * part of session migration.
@@ -395,6 +415,39 @@ private:
 
     // Set only once its discovered a chunk is jumbo
     boost::optional<JumboChunkCloneState> _jumboChunkCloneState;
+
+    struct StreamingCloneState {
+        // Size of the first batch, which is sized without any knowledge of how fast the recipient
+        // consumes them.
+        static constexpr int kInitialBatchBytes = 1024 * 1024;
+
+        // Plan executor for the scan of the shard key index, which also fetches the documents.
+        std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> clonerExec;
+
+        // The current state of 'clonerExec'.
+        PlanExecutor::ExecState clonerState{PlanExecutor::ADVANCED};
+
+        // Number of docs cloned so far.
+        int docsCloned = 0;
+
+        // Number of docs above which the chunk is too big to move, unless the move is forced.
+        unsigned long long maxRecsWhenFull = 0;
+
+        // Size in bytes up to which the batch being built is filled.
+        int targetBatchBytes = kInitialBatchBytes;
+
+        // When the batch being built was started and its size so far, used to estimate the rate at
+        // which the recipient consumes batches once the next batch is requested.
+        Date_t batchStartTime;
+        int batchBytes = 0;
+
+        // Moving average of the rate, in bytes per second, at which the recipient consumes batches.
+        double bytesPerSecond = 0;
+    };
+
+    // Set if the documents of the chunk are streamed from the shard key index, unless the chunk
+    // turns out to be jumbo.
+    boost::optional<StreamingCloneState> _streamingCloneState;
 };
 
 }  // namespace mongo
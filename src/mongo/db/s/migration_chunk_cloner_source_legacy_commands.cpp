@@ -43,6 +43,7 @@
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_chunk_cloner_source_legacy.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/migration_throttle.h"
 #include "mongo/db/write_concern.h"
 
 /**
@@ -181,6 +182,10 @@ public:
         }
 
         invariant(arrBuilder);
+
+        // Only throttle once the collection lock has been released.
+        MigrationThrottle::get(opCtx).throttle(opCtx, arrBuilder->len(), arrBuilder->arrSize());
+
         result.appendArray("objects", arrBuilder->arr());
 
         return true;
@@ -223,9 +228,19 @@ public:
         const MigrationSessionId migrationSessionId(
             uassertStatusOK(MigrationSessionId::extractFromBSON(cmdObj)));
 
-        AutoGetActiveCloner autoCloner(opCtx, migrationSessionId, true);
+        {
+            AutoGetActiveCloner autoCloner(opCtx, migrationSessionId, true);
 
-        uassertStatusOK(autoCloner.getCloner()->nextModsBatch(opCtx, autoCloner.getDb(), &result));
+            uassertStatusOK(
+                autoCloner.getCloner()->nextModsBatch(opCtx, autoCloner.getDb(), &result));
+        }
+
+        const BSONObj mods = result.asTempObj();
+        MigrationThrottle::get(opCtx).throttle(
+            opCtx,
+            mods["size"].safeNumberLong(),
+            (mods["reload"].isABSONObj() ? mods["reload"].Obj().nFields() : 0) +
+                (mods["deleted"].isABSONObj() ? mods["deleted"].Obj().nFields() : 0));
         return true;
     }
 
@@ -64,6 +64,7 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/session_catalog_mongod.h"
+#include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/storage/remove_saver.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
@@ -411,6 +412,7 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
     _min = cloneRequest.getMinKey();
     _max = cloneRequest.getMaxKey();
     _shardKeyPattern = cloneRequest.getShardKeyPattern();
+    _donorStreamsFromShardKeyIndex = cloneRequest.getStreamsFromShardKeyIndex();
 
     _epoch = epoch;
 
@@ -1041,6 +1043,20 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             uassert(50748, "Migration aborted while copying documents", getState() != ABORT);
         };
 
+        // The recipient held no documents in the range of the chunk before the migration, so a
+        // document with the same _id which is in that range was cloned earlier in this migration.
+        auto isResentDocument = [&](OperationContext* opCtx, const BSONObj& doc) {
+            if (!_donorStreamsFromShardKeyIndex) {
+                return false;
+            }
+
+            AutoGetCollection autoColl(opCtx, _nss, MODE_IS);
+            BSONObj localDoc;
+            return autoColl.getCollection() &&
+                Helpers::findById(opCtx, autoColl.getDb(), _nss.ns(), doc, localDoc) &&
+                isInRange(localDoc, _min, _max, _shardKeyPattern);
+        };
+
         auto insertBatchFn = [&](OperationContext* opCtx, BSONObj arr) {
             auto it = arr.begin();
             while (it != arr.end()) {
@@ -1050,28 +1066,47 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
                 assertNotAborted(opCtx);
 
-                write_ops::Insert insertOp(_nss);
-                insertOp.getWriteCommandBase().setOrdered(true);
-                insertOp.setDocuments([&] {
-                    std::vector<BSONObj> toInsert;
-                    while (it != arr.end() &&
-                           (batchMaxCloned <= 0 || batchNumCloned < batchMaxCloned)) {
-                        const auto& doc = *it;
-                        BSONObj docToClone = doc.Obj();
-                        toInsert.push_back(docToClone);
-                        batchNumCloned++;
-                        batchClonedBytes += docToClone.objsize();
-                        ++it;
-                    }
-                    return toInsert;
-                }());
+                std::vector<BSONObj> toInsert;
+                while (it != arr.end() &&
+                       (batchMaxCloned <= 0 || batchNumCloned < batchMaxCloned)) {
+                    const auto& doc = *it;
+                    BSONObj docToClone = doc.Obj();
+                    toInsert.push_back(docToClone);
+                    batchNumCloned++;
+                    batchClonedBytes += docToClone.objsize();
+                    ++it;
+                }
 
-                const auto reply = write_ops_exec::performInserts(opCtx, insertOp, true);
+                // When the donor streams the documents from the shard key index, a document whose
+                // shard key is updated during the scan can be sent a second time. Its newer version
+                // is transferred again as a modification, so the duplicate is skipped here and the
+                // rest of the batch is retried. Any other _id collision fails the migration.
+                auto docIt = toInsert.begin();
+                while (docIt != toInsert.end()) {
+                    write_ops::Insert insertOp(_nss);
+                    insertOp.getWriteCommandBase().setOrdered(true);
+                    insertOp.setDocuments({docIt, toInsert.end()});
+
+                    const auto reply = write_ops_exec::performInserts(opCtx, insertOp, true);
+
+                    for (unsigned long i = 0; i < reply.results.size(); ++i) {
+                        const auto& status = reply.results[i].getStatus();
+                        if (status == ErrorCodes::DuplicateKey &&
+                            IndexDescriptor::isIdIndexPattern(
+                                status.extraInfo<DuplicateKeyErrorInfo>()->getKeyPattern()) &&
+                            isResentDocument(opCtx, insertOp.getDocuments()[i])) {
+                            batchNumCloned--;
+                            batchClonedBytes -= insertOp.getDocuments()[i].objsize();
+                            continue;
+                        }
+
+                        uassertStatusOKWithContext(
+                            status,
+                            str::stream()
+                                << "Insert of " << insertOp.getDocuments()[i] << " failed.");
+                    }
 
-                for (unsigned long i = 0; i < reply.results.size(); ++i) {
-                    uassertStatusOKWithContext(
-                        reply.results[i],
-                        str::stream() << "Insert of " << insertOp.getDocuments()[i] << " failed.");
+                    docIt += reply.results.size();
                 }
 
                 {
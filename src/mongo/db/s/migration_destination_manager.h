@@ -247,6 +247,10 @@ private:
     BSONObj _max;
     BSONObj _shardKeyPattern;
 
+    // Whether the donor streams the documents from the shard key index, in which case it can send
+    // a document twice during the initial clone.
+    bool _donorStreamsFromShardKeyIndex{false};
+
     OID _epoch;
 
     WriteConcernOptions _writeConcern;
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/migration_throttle.h"
+
+#include <cmath>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getMigrationThrottle = ServiceContext::declareDecoration<MigrationThrottle>();
+
+}  // namespace
+
+Milliseconds MigrationThrottle::TokenBucket::consume(Date_t now,
+                                                     long long ratePerSecond,
+                                                     long long amount) {
+    if (ratePerSecond <= 0) {
+        _tokens = 0;
+        _lastRefill = Date_t();
+        return Milliseconds(0);
+    }
+
+    const double capacity = ratePerSecond;
+    if (_lastRefill == Date_t()) {
+        _tokens = capacity;
+    } else if (now > _lastRefill) {
+        const double elapsedSecs = durationCount<Microseconds>(now - _lastRefill) / 1000000.0;
+        _tokens = std::min(capacity, _tokens + elapsedSecs * ratePerSecond);
+    }
+    _lastRefill = std::max(_lastRefill, now);
+
+    _tokens -= amount;
+    if (_tokens >= 0) {
+        return Milliseconds(0);
+    }
+
+    return Milliseconds(static_cast<long long>(std::ceil(-_tokens * 1000 / ratePerSecond)));
+}
+
+MigrationThrottle& MigrationThrottle::get(ServiceContext* service) {
+    return getMigrationThrottle(service);
+}
+
+MigrationThrottle& MigrationThrottle::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void MigrationThrottle::throttle(OperationContext* opCtx, long long bytes, long long docs) {
+    const auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
+
+    Milliseconds waitTime;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        waitTime = std::max(_bytes.consume(now, migrationMaxClonedBytesPerSecond.load(), bytes),
+                            _docs.consume(now, migrationMaxClonedDocsPerSecond.load(), docs));
+    }
+
+    if (waitTime > Milliseconds(0)) {
+        opCtx->sleepFor(waitTime);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Limits the rate at which the donor shard of chunk migrations hands out documents to recipients,
+ * both in bytes and in number of documents, so that cloning a chunk and catching up on its
+ * modifications does not starve the foreground workload of I/O. The limits are the
+ * migrationMaxClonedBytesPerSecond and migrationMaxClonedDocsPerSecond server parameters and they
+ * apply to all the migrations the shard donates at once. There is only one instance of this
+ * object per shard.
+ */
+class MigrationThrottle {
+    MigrationThrottle(const MigrationThrottle&) = delete;
+    MigrationThrottle& operator=(const MigrationThrottle&) = delete;
+
+public:
+    /**
+     * Token bucket which refills at a given rate per second and can hold up to one second worth
+     * of tokens. Consumers are allowed to take more tokens than the bucket holds, in which case
+     * they have to wait for the debt to be repaid before proceeding.
+     */
+    class TokenBucket {
+    public:
+        /**
+         * Takes 'amount' tokens from the bucket at time 'now', after refilling it at
+         * 'ratePerSecond' since the last call, and returns how long the caller has to wait before
+         * proceeding. A rate of zero means that there is no limit.
+         */
+        Milliseconds consume(Date_t now, long long ratePerSecond, long long amount);
+
+    private:
+        double _tokens{0};
+        Date_t _lastRefill;
+    };
+
+    MigrationThrottle() = default;
+
+    static MigrationThrottle& get(ServiceContext* service);
+    static MigrationThrottle& get(OperationContext* opCtx);
+
+    /**
+     * Accounts for 'bytes' and 'docs' which were just read on behalf of a migration and blocks
+     * until doing so is within the configured limits. Must not be called with any locks held.
+     *
+     * Throws if the operation is interrupted while waiting.
+     */
+    void throttle(OperationContext* opCtx, long long bytes, long long docs);
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("MigrationThrottle::_mutex");
+
+    TokenBucket _bytes;
+    TokenBucket _docs;
+};
+
+}  // namespace mongo
@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/migration_throttle.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using TokenBucket = MigrationThrottle::TokenBucket;
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1000000);
+
+TEST(MigrationThrottleTokenBucket, NoLimit) {
+    TokenBucket bucket;
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 0, 1LL << 40));
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 0, 1LL << 40));
+}
+
+TEST(MigrationThrottleTokenBucket, BurstOfOneSecondIsAllowed) {
+    TokenBucket bucket;
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 1000, 600));
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 1000, 400));
+
+    // The bucket is now empty, so any further consumption has to wait.
+    ASSERT_EQ(Milliseconds(100), bucket.consume(kStart, 1000, 100));
+}
+
+TEST(MigrationThrottleTokenBucket, DebtIsRepaidOverTime) {
+    TokenBucket bucket;
+
+    // Taking five seconds worth of tokens at once leaves four seconds of debt.
+    ASSERT_EQ(Milliseconds(4000), bucket.consume(kStart, 1000, 5000));
+
+    // After waiting for the debt to be repaid, the bucket is empty.
+    ASSERT_EQ(Milliseconds(500), bucket.consume(kStart + Seconds(4), 1000, 500));
+}
+
+TEST(MigrationThrottleTokenBucket, RefillIsCappedAtOneSecond) {
+    TokenBucket bucket;
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 1000, 1000));
+
+    // Staying idle for a long time does not allow for a burst of more than one second.
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart + Seconds(60), 1000, 1000));
+    ASSERT_EQ(Milliseconds(1000), bucket.consume(kStart + Seconds(60), 1000, 1000));
+}
+
+TEST(MigrationThrottleTokenBucket, RemovingTheLimitClearsTheDebt) {
+    TokenBucket bucket;
+    ASSERT_EQ(Milliseconds(9000), bucket.consume(kStart, 1000, 10000));
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 0, 10000));
+
+    // Setting a limit again starts from a full bucket.
+    ASSERT_EQ(Milliseconds(0), bucket.consume(kStart, 1000, 1000));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -41,6 +41,8 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
+#include "mongo/db/concurrency/admission_context.h"
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/delete.h"
@@ -54,9 +56,11 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/remove_saver.h"
@@ -64,7 +68,9 @@
 #include "mongo/executor/task_executor.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/cancelation.h"
+#include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/future_util.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -251,6 +257,10 @@ auto withTemporaryOperationContext(Callable&& callable) {
     auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
     auto opCtx = uniqueOpCtx.get();
 
+    // Range deletion is background work which should not compete with user operations for storage
+    // engine tickets.
+    AdmissionContext::get(opCtx).setPriority(AdmissionPriority::kLow);
+
     {
         // We acquire the global IX lock and then immediately release it to ensure this operation
         // would be killed by the RstlKillOpThread during step-up or stepdown. Note that the
@@ -263,6 +273,43 @@ auto withTemporaryOperationContext(Callable&& callable) {
     return callable(opCtx);
 }
 
+/**
+ * Gathers the signals RangeDeletionPacer uses to size the next batch.
+ */
+RangeDeletionPacer::Observation observeRangeDeletionBatch(OperationContext* opCtx,
+                                                          Milliseconds batchDuration) {
+    RangeDeletionPacer::Observation observation;
+    observation.batchDuration = batchDuration;
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->isReplEnabled()) {
+        const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime().wallTime;
+        const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime().wallTime;
+        if (lastApplied != Date_t() && lastCommitted != Date_t() && lastApplied > lastCommitted) {
+            observation.majorityLag = lastApplied - lastCommitted;
+        }
+    }
+
+    if (auto writeTickets = Locker::getGlobalThrottling(MODE_IX);
+        writeTickets && writeTickets->outof() > 0) {
+        observation.availableWriteTicketRatio =
+            static_cast<double>(writeTickets->available()) / writeTickets->outof();
+    }
+
+    return observation;
+}
+
+/**
+ * Backoff policy for AsyncTry which asks the pacer how long to wait before the next batch.
+ */
+struct PacedDelay {
+    Milliseconds nextSleep() {
+        return pacer->getDelay();
+    }
+
+    std::shared_ptr<RangeDeletionPacer> pacer;
+};
+
 void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& migrationId) {
     // While at this point we are guaranteed for our operation context to be killed if there is a
     // step-up or stepdown, it is still possible that a stepdown and a subsequent step-up happened
@@ -301,15 +348,21 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    auto pacer = std::make_shared<RangeDeletionPacer>(
+        numDocsToRemovePerBatch, delayBetweenBatches, rangeDeleterAdaptivePacing.load());
+
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
+                   const auto batchSize = pacer->getBatchSize();
                    LOGV2_DEBUG(5346200,
                                1,
                                "Starting batch deletion",
                                "namespace"_attr = nss,
                                "range"_attr = redact(range.toString()),
-                               "numDocsToRemovePerBatch"_attr = numDocsToRemovePerBatch,
-                               "delayBetweenBatches"_attr = delayBetweenBatches);
+                               "numDocsToRemovePerBatch"_attr = batchSize,
+                               "delayBetweenBatches"_attr = pacer->getDelay());
+
+                   Timer batchTimer;
 
                    if (migrationId) {
                        ensureRangeDeletionTaskStillExists(opCtx, *migrationId);
@@ -329,7 +382,10 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                                                      collection.getCollection(),
                                                                      keyPattern,
                                                                      range,
-                                                                     numDocsToRemovePerBatch));
+                                                                     batchSize));
+
+                   pacer->recordBatch(
+                       observeRangeDeletionBatch(opCtx, Milliseconds(batchTimer.millis())));
 
                    LOGV2_DEBUG(
                        23769,
@@ -356,7 +412,7 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(PacedDelay{pacer})
         .on(executor, CancelationToken::uncancelable())
         .ignoreValue();
 }
@@ -414,6 +470,41 @@ ExecutorFuture<void> waitForDeletionsToMajorityReplicate(
 
 }  // namespace
 
+RangeDeletionPacer::RangeDeletionPacer(int initialBatchSize, Milliseconds minDelay, bool adaptive)
+    : _initialBatchSize(std::max(initialBatchSize, 1)),
+      _minDelay(minDelay),
+      _adaptive(adaptive),
+      _batchSize(_initialBatchSize),
+      _delay(_minDelay) {}
+
+void RangeDeletionPacer::recordBatch(const Observation& observation) {
+    if (!_adaptive) {
+        return;
+    }
+
+    const bool underPressure =
+        observation.majorityLag > Milliseconds(rangeDeleterMaxMajorityLagMS.load()) ||
+        (observation.availableWriteTicketRatio &&
+         *observation.availableWriteTicketRatio < kMinAvailableWriteTicketRatio);
+
+    if (underPressure) {
+        _batchSize = std::max(_batchSize / 2, 1);
+        _delay = std::min(std::max({_delay * 2, _minDelay, kMinBackoffDelay}),
+                          std::max(_minDelay, kMaxBackoffDelay));
+        return;
+    }
+
+    // Never grow past the configured maximum, but also never cap below the size the caller asked
+    // for.
+    const int maxBatchSize = std::max(rangeDeleterMaxBatchSize.load(), _initialBatchSize);
+    if (observation.batchDuration > Milliseconds(rangeDeleterTargetBatchDurationMS.load())) {
+        _batchSize = std::max(_batchSize / 2, 1);
+    } else {
+        _batchSize = std::min(_batchSize + std::max(_batchSize / 4, 1), maxBatchSize);
+    }
+    _delay = std::max(_delay / 2, _minDelay);
+}
+
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
     SemiFuture<void> waitForActiveQueriesToComplete,
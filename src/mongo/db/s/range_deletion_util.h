@@ -50,6 +50,64 @@ extern AtomicWord<int> rangeDeleterBatchSize;
 // next batch of deletions.
 extern AtomicWord<int> rangeDeleterBatchDelayMS;
 
+/**
+ * Chooses the number of documents to delete in each range deletion batch and the delay before the
+ * next batch, based on how the previous batch went. Batches grow by a quarter while they finish
+ * within rangeDeleterTargetBatchDurationMS, up to rangeDeleterMaxBatchSize, and are halved when
+ * they take longer. When the majority replication lag exceeds rangeDeleterMaxMajorityLagMS or write
+ * tickets are nearly exhausted, the batch is halved and the delay doubled, so that cleanup yields
+ * to user writes; the delay decays back to its minimum once the pressure goes away.
+ *
+ * When adaptive pacing is disabled, the initial batch size and delay are used unchanged. Not
+ * thread-safe: the batch loop of a single range deletion drives it serially.
+ */
+class RangeDeletionPacer {
+public:
+    /**
+     * What was observed around the most recently completed batch.
+     */
+    struct Observation {
+        // How long the batch took to run, including lock acquisition.
+        Milliseconds batchDuration{0};
+
+        // How far the majority commit point trails this node's last applied write.
+        Milliseconds majorityLag{0};
+
+        // Fraction of write tickets that were available, if tickets are in use.
+        boost::optional<double> availableWriteTicketRatio;
+    };
+
+    // Fraction of available write tickets below which the pacer backs off.
+    static constexpr double kMinAvailableWriteTicketRatio = 0.1;
+
+    // Backoff delay used under pressure when the minimum delay is zero, and the most it may grow.
+    static constexpr Milliseconds kMinBackoffDelay{10};
+    static constexpr Milliseconds kMaxBackoffDelay{10 * 1000};
+
+    RangeDeletionPacer(int initialBatchSize, Milliseconds minDelay, bool adaptive);
+
+    int getBatchSize() const {
+        return _batchSize;
+    }
+
+    Milliseconds getDelay() const {
+        return _delay;
+    }
+
+    /**
+     * Adjusts the batch size and delay for the next batch.
+     */
+    void recordBatch(const Observation& observation);
+
+private:
+    const int _initialBatchSize;
+    const Milliseconds _minDelay;
+    const bool _adaptive;
+
+    int _batchSize;
+    Milliseconds _delay;
+};
+
 /**
  * Deletes a range of orphaned documents for the given namespace and collection UUID. Returns a
  * future which will be resolved when the range has finished being deleted. The resulting future
@@ -61,7 +119,9 @@ extern AtomicWord<int> rangeDeleterBatchDelayMS;
  * 2. Waits for delayForActiveQueriesOnSecondariesToComplete seconds before deleting any documents,
  *    to give queries running on secondaries a chance to finish.
  * 3. Delete documents in a series of batches with up to numDocsToRemovePerBatch documents per
- *    batch, with a delay of delayBetweenBatches milliseconds in between batches.
+ *    batch, with a delay of delayBetweenBatches milliseconds in between batches. With
+ *    rangeDeleterAdaptivePacing these are only the starting batch size and the minimum delay; see
+ *    RangeDeletionPacer.
  */
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
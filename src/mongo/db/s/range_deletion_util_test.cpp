@@ -42,6 +42,7 @@
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -917,5 +918,98 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeDoesNotCrashWhenShardKeyIndexDoes
     cleanupComplete.get();
 }
 
+RangeDeletionPacer::Observation fastBatch() {
+    RangeDeletionPacer::Observation observation;
+    observation.batchDuration = Milliseconds(1);
+    return observation;
+}
+
+TEST(RangeDeletionPacerTest, KeepsInitialValuesWhenNotAdaptive) {
+    RangeDeletionPacer pacer(10, Milliseconds(20), false /* adaptive */);
+
+    auto congested = fastBatch();
+    congested.availableWriteTicketRatio = 0.0;
+    pacer.recordBatch(fastBatch());
+    pacer.recordBatch(congested);
+
+    ASSERT_EQ(pacer.getBatchSize(), 10);
+    ASSERT_EQ(pacer.getDelay(), Milliseconds(20));
+}
+
+TEST(RangeDeletionPacerTest, GrowsFastBatchesUpToMaxBatchSize) {
+    const auto maxBatchSizeBefore = rangeDeleterMaxBatchSize.load();
+    ON_BLOCK_EXIT([&] { rangeDeleterMaxBatchSize.store(maxBatchSizeBefore); });
+    rangeDeleterMaxBatchSize.store(100);
+
+    RangeDeletionPacer pacer(1, Milliseconds(0), true /* adaptive */);
+    pacer.recordBatch(fastBatch());
+    ASSERT_EQ(pacer.getBatchSize(), 2);
+
+    for (int i = 0; i < 100; ++i) {
+        pacer.recordBatch(fastBatch());
+    }
+    ASSERT_EQ(pacer.getBatchSize(), 100);
+    ASSERT_EQ(pacer.getDelay(), Milliseconds(0));
+}
+
+TEST(RangeDeletionPacerTest, NeverCapsBelowInitialBatchSize) {
+    const auto maxBatchSizeBefore = rangeDeleterMaxBatchSize.load();
+    ON_BLOCK_EXIT([&] { rangeDeleterMaxBatchSize.store(maxBatchSizeBefore); });
+    rangeDeleterMaxBatchSize.store(10);
+
+    RangeDeletionPacer pacer(128, Milliseconds(0), true /* adaptive */);
+    pacer.recordBatch(fastBatch());
+    ASSERT_EQ(pacer.getBatchSize(), 128);
+}
+
+TEST(RangeDeletionPacerTest, ShrinksSlowBatches) {
+    RangeDeletionPacer pacer(128, Milliseconds(20), true /* adaptive */);
+
+    auto slow = fastBatch();
+    slow.batchDuration = Milliseconds(rangeDeleterTargetBatchDurationMS.load() + 1);
+    pacer.recordBatch(slow);
+
+    ASSERT_EQ(pacer.getBatchSize(), 64);
+    ASSERT_EQ(pacer.getDelay(), Milliseconds(20));
+}
+
+TEST(RangeDeletionPacerTest, BacksOffWhenMajorityLagIsHigh) {
+    RangeDeletionPacer pacer(128, Milliseconds(20), true /* adaptive */);
+
+    auto lagging = fastBatch();
+    lagging.majorityLag = Milliseconds(rangeDeleterMaxMajorityLagMS.load() + 1);
+    pacer.recordBatch(lagging);
+    ASSERT_EQ(pacer.getBatchSize(), 64);
+    ASSERT_EQ(pacer.getDelay(), Milliseconds(40));
+
+    for (int i = 0; i < 100; ++i) {
+        pacer.recordBatch(lagging);
+    }
+    ASSERT_EQ(pacer.getBatchSize(), 1);
+    ASSERT_EQ(pacer.getDelay(), RangeDeletionPacer::kMaxBackoffDelay);
+
+    // Once the lag goes away the delay decays back to the configured minimum.
+    for (int i = 0; i < 100; ++i) {
+        pacer.recordBatch(fastBatch());
+    }
+    ASSERT_EQ(pacer.getDelay(), Milliseconds(20));
+}
+
+TEST(RangeDeletionPacerTest, BacksOffWhenWriteTicketsAreScarce) {
+    RangeDeletionPacer pacer(128, Milliseconds(0), true /* adaptive */);
+
+    auto plentyOfTickets = fastBatch();
+    plentyOfTickets.availableWriteTicketRatio = 0.5;
+    pacer.recordBatch(plentyOfTickets);
+    ASSERT_EQ(pacer.getBatchSize(), 160);
+    ASSERT_EQ(pacer.getDelay(), Milliseconds(0));
+
+    auto fewTickets = fastBatch();
+    fewTickets.availableWriteTicketRatio = 0.05;
+    pacer.recordBatch(fewTickets);
+    ASSERT_EQ(pacer.getBatchSize(), 80);
+    ASSERT_EQ(pacer.getDelay(), RangeDeletionPacer::kMinBackoffDelay);
+}
+
 }  // namespace
 }  // namespace mongo
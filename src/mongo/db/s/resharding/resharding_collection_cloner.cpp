@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/resharding/resharding_collection_cloner.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "mongo/bson/json.h"
@@ -41,6 +42,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
@@ -50,12 +52,16 @@
 #include "mongo/db/pipeline/document_source_replace_root.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/db/query/query_request.h"
+#include "mongo/db/s/resharding/resharding_collection_cloner_progress_gen.h"
+#include "mongo/db/s/resharding/resharding_data_copy_util.h"
+#include "mongo/db/s/resharding/resharding_metrics.h"
 #include "mongo/db/s/resharding/resharding_server_parameters_gen.h"
 #include "mongo/db/s/resharding_util.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/grid.h"
 #include "mongo/s/stale_shard_version_helpers.h"
 #include "mongo/util/future_util.h"
 #include "mongo/util/scopeguard.h"
@@ -75,6 +81,11 @@ bool collectionHasSimpleCollation(OperationContext* opCtx, const NamespaceString
     return !sourceChunkMgr.getDefaultCollator();
 }
 
+ReshardingCollectionClonerRangeId makeRangeId(const NamespaceString& outputNss,
+                                              const ChunkRange& range) {
+    return ReshardingCollectionClonerRangeId(outputNss, range.getMin(), range.getMax());
+}
+
 }  // namespace
 
 ReshardingCollectionCloner::ReshardingCollectionCloner(ShardKeyPattern newShardKeyPattern,
@@ -93,7 +104,8 @@ ReshardingCollectionCloner::ReshardingCollectionCloner(ShardKeyPattern newShardK
 std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipeline(
     OperationContext* opCtx,
     std::shared_ptr<MongoProcessInterface> mongoProcessInterface,
-    Value resumeId) {
+    Value resumeId,
+    const boost::optional<ChunkRange>& range) {
     using Doc = Document;
     using Arr = std::vector<Value>;
     using V = Value;
@@ -159,17 +171,27 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipel
         }
     }
 
-    stages.emplace_back(DocumentSourceLookUp::createFromBson(
-        Doc{{"$lookup",
-             Doc{{"from",
-                  Doc{{"db", tempCacheChunksNss.db()}, {"coll", tempCacheChunksNss.coll()}}},
-                 {"let", Doc{{"sk", extractShardKeyExpr}}},
-                 {"pipeline",
-                  Arr{V{Doc{{"$match",
-                             Doc{{"$expr",
-                                  Doc{{"$eq",
-                                       Arr{V{"$shard"_sd}, V{_recipientShard.toString()}}}}}}}}},
-                      V{Doc(fromjson("{$match: {$expr: {$let: {\
+    Arr lookupPipeline{
+        V{Doc{{"$match",
+               Doc{{"$expr",
+                    Doc{{"$eq", Arr{V{"$shard"_sd}, V{_recipientShard.toString()}}}}}}}}}};
+
+    if (range) {
+        // Only consider the recipient's chunks which start within the range being cloned. The
+        // range bounds are chunk boundaries, so these chunks lie entirely within the range.
+        lookupPipeline.emplace_back(Doc{
+            {"$match",
+             Doc{{"$expr",
+                  Doc{{"$and",
+                       Arr{V{Doc{{"$gte",
+                                  Arr{V{"$_id"_sd},
+                                      V{Doc{{"$literal", Value(range->getMin())}}}}}}},
+                           V{Doc{{"$lt",
+                                  Arr{V{"$_id"_sd},
+                                      V{Doc{{"$literal", Value(range->getMax())}}}}}}}}}}}}}});
+    }
+
+    lookupPipeline.emplace_back(Doc(fromjson("{$match: {$expr: {$let: {\
                             vars: {\
                                 min: {$map: {input: {$objectToArray: '$_id'}, in: '$$this.v'}},\
                                 max: {$map: {input: {$objectToArray: '$max'}, in: '$$this.v'}}\
@@ -185,7 +207,14 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipel
                                     else: {$lt:  ['$$sk', '$$max']}\
                                 }}\
                             ]}\
-                        }}}}"))}}},
+                        }}}}")));
+
+    stages.emplace_back(DocumentSourceLookUp::createFromBson(
+        Doc{{"$lookup",
+             Doc{{"from",
+                  Doc{{"db", tempCacheChunksNss.db()}, {"coll", tempCacheChunksNss.coll()}}},
+                 {"let", Doc{{"sk", extractShardKeyExpr}}},
+                 {"pipeline", std::move(lookupPipeline)},
                  {"as", "intersectingChunk"_sd}}}}
             .toBson()
             .firstElement(),
@@ -211,6 +240,98 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipel
     return Pipeline::create(std::move(stages), std::move(expCtx));
 }
 
+std::vector<ChunkRange> ReshardingCollectionCloner::prepareRanges(
+    OperationContext* opCtx, const std::function<std::vector<ChunkRange>()>& splitRanges) {
+    const auto& nss = NamespaceString::kReshardingCollectionClonerProgressNamespace;
+    resharding::data_copy::ensureCollectionExists(opCtx, nss);
+
+    const auto globalMin = _newShardKeyPattern.getKeyPattern().globalMin();
+    const auto globalMax = _newShardKeyPattern.getKeyPattern().globalMax();
+
+    std::vector<ChunkRange> ranges;
+    {
+        const std::string outputNsField = str::stream()
+            << ReshardingCollectionClonerProgress::kRangeIdFieldName << "."
+            << ReshardingCollectionClonerRangeId::kOutputNsFieldName;
+
+        DBDirectClient client(opCtx);
+        auto cursor = client.query(nss, BSON(outputNsField << _outputNss.ns()));
+        while (cursor->more()) {
+            auto progress = ReshardingCollectionClonerProgress::parse(
+                IDLParserErrorContext("ReshardingCollectionClonerProgress"), cursor->nextSafe());
+            ranges.emplace_back(progress.getRangeId().getMin().getOwned(),
+                                progress.getRangeId().getMax().getOwned());
+        }
+    }
+
+    if (!ranges.empty()) {
+        std::sort(ranges.begin(), ranges.end(), [](const auto& lhs, const auto& rhs) {
+            return SimpleBSONObjComparator::kInstance.evaluate(lhs.getMin() < rhs.getMin());
+        });
+
+        bool coversKeySpace =
+            SimpleBSONObjComparator::kInstance.evaluate(ranges.front().getMin() == globalMin) &&
+            SimpleBSONObjComparator::kInstance.evaluate(ranges.back().getMax() == globalMax);
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            coversKeySpace = coversKeySpace &&
+                SimpleBSONObjComparator::kInstance.evaluate(ranges[i - 1].getMax() ==
+                                                            ranges[i].getMin());
+        }
+
+        uassert(5986706,
+                str::stream() << "Cannot resume cloning into '" << _outputNss
+                              << "' because the ranges persisted by a previous run do not cover "
+                                 "the whole new shard key space",
+                coversKeySpace);
+
+        LOGV2(5986707,
+              "Resuming cloning sharded collection with the ranges of the previous run",
+              "sourceNamespace"_attr = _sourceNss,
+              "outputNamespace"_attr = _outputNss,
+              "numRanges"_attr = ranges.size());
+
+        return ranges;
+    }
+
+    auto highestInsertedId = _findHighestInsertedId(opCtx);
+    BSONObjBuilder idBuilder;
+    highestInsertedId.addToBsonObj(&idBuilder, "_id");
+    auto idObj = idBuilder.obj();
+
+    ranges = highestInsertedId.missing()
+        ? splitRanges()
+        : std::vector<ChunkRange>{ChunkRange(globalMin, globalMax)};
+
+    // Persist every range in the same storage transaction so a later run finds all or none of them.
+    writeConflictRetry(opCtx, "ReshardingCollectionCloner::prepareRanges", nss.ns(), [&] {
+        AutoGetCollection progressColl(opCtx, nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        for (const auto& range : ranges) {
+            _updateRangeProgress(opCtx, range, idObj["_id"]);
+        }
+        wuow.commit();
+    });
+
+    return ranges;
+}
+
+Value ReshardingCollectionCloner::findLastInsertedId(OperationContext* opCtx,
+                                                     const ChunkRange& range) {
+    DBDirectClient client(opCtx);
+    auto doc = client.findOne(NamespaceString::kReshardingCollectionClonerProgressNamespace.ns(),
+                              BSON(ReshardingCollectionClonerProgress::kRangeIdFieldName
+                                   << makeRangeId(_outputNss, range).toBSON()));
+    uassert(5986300,
+            str::stream() << "Missing resharding collection cloner progress for range "
+                          << range.toString() << " of '" << _outputNss << "'",
+            !doc.isEmpty());
+
+    auto progress = ReshardingCollectionClonerProgress::parse(
+        IDLParserErrorContext("ReshardingCollectionClonerProgress"), doc);
+    const auto& lastInsertedId = progress.getLastInsertedId();
+    return lastInsertedId ? Value{lastInsertedId->getElement()} : Value{};
+}
+
 Value ReshardingCollectionCloner::_findHighestInsertedId(OperationContext* opCtx) {
     AutoGetCollection outputColl(opCtx, _outputNss, MODE_IS);
     uassert(ErrorCodes::NamespaceNotFound,
@@ -236,6 +357,28 @@ Value ReshardingCollectionCloner::_findHighestInsertedId(OperationContext* opCtx
     return value;
 }
 
+void ReshardingCollectionCloner::_updateRangeProgress(OperationContext* opCtx,
+                                                      const ChunkRange& range,
+                                                      const BSONElement& lastInsertedId) {
+    ReshardingCollectionClonerProgress progress(makeRangeId(_outputNss, range));
+    if (!lastInsertedId.eoo()) {
+        progress.setLastInsertedId(IDLAnyType(lastInsertedId));
+    }
+
+    const auto& nss = NamespaceString::kReshardingCollectionClonerProgressNamespace;
+    writeConflictRetry(opCtx, "ReshardingCollectionCloner::_updateRangeProgress", nss.ns(), [&] {
+        AutoGetCollection progressColl(opCtx, nss, MODE_IX);
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Resharding collection cloner's progress collection '" << nss
+                              << "' did not already exist",
+                progressColl);
+
+        WriteUnitOfWork wuow(opCtx);
+        Helpers::upsert(opCtx, nss.ns(), progress.toBSON());
+        wuow.commit();
+    });
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_targetAggregationRequest(
     OperationContext* opCtx, const Pipeline& pipeline) {
     AggregateCommand request(_sourceNss, pipeline.serializeToBson());
@@ -287,7 +430,8 @@ std::vector<InsertStatement> ReshardingCollectionCloner::_fillBatch(Pipeline& pi
 }
 
 void ReshardingCollectionCloner::_insertBatch(OperationContext* opCtx,
-                                              std::vector<InsertStatement>& batch) {
+                                              std::vector<InsertStatement>& batch,
+                                              const ChunkRange& range) {
     writeConflictRetry(opCtx, "ReshardingCollectionCloner::_insertBatch", _outputNss.ns(), [&] {
         AutoGetCollection outputColl(opCtx, _outputNss, MODE_IX);
         uassert(ErrorCodes::NamespaceNotFound,
@@ -307,6 +451,10 @@ void ReshardingCollectionCloner::_insertBatch(OperationContext* opCtx,
         }
 
         uassertStatusOK(outputColl->insertDocuments(opCtx, batch.begin(), batch.end(), nullptr));
+
+        // The batch is in _id order, so its last document is where the range resumes from.
+        _updateRangeProgress(opCtx, range, batch.back().doc["_id"]);
+
         wuow.commit();
     });
 }
@@ -352,8 +500,116 @@ auto ReshardingCollectionCloner::_withTemporaryOperationContext(Callable&& calla
     }
 }
 
+std::vector<ChunkRange> ReshardingCollectionCloner::splitRecipientChunks(
+    const ShardKeyPattern& newShardKeyPattern,
+    const std::vector<BSONObj>& chunkMins,
+    int numRanges) {
+    const auto globalMin = newShardKeyPattern.getKeyPattern().globalMin();
+    const auto globalMax = newShardKeyPattern.getKeyPattern().globalMax();
+
+    const auto numChunks = chunkMins.size();
+    const auto numSplits = std::min(static_cast<size_t>(std::max(numRanges, 1)), numChunks);
+    if (numSplits <= 1) {
+        return {ChunkRange(globalMin, globalMax)};
+    }
+
+    std::vector<ChunkRange> ranges;
+    ranges.reserve(numSplits);
+
+    BSONObj rangeMin = globalMin;
+    for (size_t i = 1; i < numSplits; ++i) {
+        const auto& rangeMax = chunkMins[i * numChunks / numSplits];
+        ranges.emplace_back(rangeMin, rangeMax);
+        rangeMin = rangeMax;
+    }
+    ranges.emplace_back(rangeMin, globalMax);
+
+    return ranges;
+}
+
+std::vector<ChunkRange> ReshardingCollectionCloner::_splitRecipientRanges(OperationContext* opCtx,
+                                                                          int numRanges) {
+    auto catalogCache = Grid::get(opCtx)->catalogCache();
+    auto outputChunkMgr = uassertStatusOK(
+        catalogCache->getShardedCollectionRoutingInfoWithRefresh(opCtx, _outputNss));
+
+    std::vector<BSONObj> chunkMins;
+    outputChunkMgr.forEachChunk([&](const auto& chunk) {
+        if (chunk.getShardId() == _recipientShard) {
+            chunkMins.emplace_back(chunk.getMin());
+        }
+        return true;
+    });
+
+    return splitRecipientChunks(_newShardKeyPattern, chunkMins, numRanges);
+}
+
 ExecutorFuture<void> ReshardingCollectionCloner::run(
     std::shared_ptr<executor::TaskExecutor> executor, CancelationToken cancelToken) {
+    return ExecutorFuture<void>(executor).then([this, executor, cancelToken] {
+        auto ranges = _withTemporaryOperationContext([&](auto* opCtx) {
+            return prepareRanges(opCtx, [&] {
+                const auto parallelism = resharding::gReshardingCollectionClonerParallelism;
+                if (parallelism <= 1) {
+                    return splitRecipientChunks(_newShardKeyPattern, {}, 1);
+                }
+                return _splitRecipientRanges(opCtx, parallelism);
+            });
+        });
+
+        if (ranges.size() > 1) {
+            LOGV2(5986301,
+                  "Cloning sharded collection in parallel ranges",
+                  "sourceNamespace"_attr = _sourceNss,
+                  "outputNamespace"_attr = _outputNss,
+                  "numRanges"_attr = ranges.size());
+        }
+
+        ReshardingMetrics::get(cc().getServiceContext())->setRangesToCopy(ranges);
+
+        // Cancel the remaining ranges as soon as one of them fails so the error is reported
+        // without waiting for the rest of the collection to be cloned.
+        CancelationSource cancelSource(cancelToken);
+
+        std::vector<ExecutorFuture<void>> rangeFutures;
+        rangeFutures.reserve(ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            rangeFutures.emplace_back(
+                _runOnRange(executor, cancelSource.token(), ranges[i], i)
+                    .onCompletion([cancelSource](Status status) mutable {
+                        if (!status.isOK()) {
+                            cancelSource.cancel();
+                        }
+                        return status;
+                    }));
+        }
+
+        return whenAll(std::move(rangeFutures))
+            .thenRunOn(executor)
+            .then([cancelSource](std::vector<Status> statuses) {
+                // Prefer the error which caused the other ranges to be canceled.
+                Status firstError = Status::OK();
+                for (auto& status : statuses) {
+                    if (status.isOK()) {
+                        continue;
+                    }
+                    if (!status.isA<ErrorCategory::CancelationError>()) {
+                        return status;
+                    }
+                    if (firstError.isOK()) {
+                        firstError = std::move(status);
+                    }
+                }
+                return firstError;
+            });
+    });
+}
+
+ExecutorFuture<void> ReshardingCollectionCloner::_runOnRange(
+    std::shared_ptr<executor::TaskExecutor> executor,
+    CancelationToken cancelToken,
+    ChunkRange range,
+    size_t rangeIndex) {
     struct ChainContext {
         std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
         bool moreToCome = true;
@@ -361,14 +617,16 @@ ExecutorFuture<void> ReshardingCollectionCloner::run(
 
     auto chainCtx = std::make_shared<ChainContext>();
 
-    return AsyncTry([this, chainCtx] {
+    return AsyncTry([this, chainCtx, range, rangeIndex] {
                if (!chainCtx->pipeline) {
                    chainCtx->pipeline = _withTemporaryOperationContext([&](auto* opCtx) {
-                       auto idToResumeFrom = _findHighestInsertedId(opCtx);
+                       auto idToResumeFrom = findLastInsertedId(opCtx, range);
                        auto pipeline = _targetAggregationRequest(
                            opCtx,
-                           *makePipeline(
-                               opCtx, MongoProcessInterface::create(opCtx), idToResumeFrom));
+                           *makePipeline(opCtx,
+                                         MongoProcessInterface::create(opCtx),
+                                         idToResumeFrom,
+                                         range));
 
                        if (!idToResumeFrom.missing()) {
                            // Skip inserting the first document retrieved after resuming because
@@ -410,7 +668,14 @@ ExecutorFuture<void> ReshardingCollectionCloner::run(
                        return false;
                    }
 
-                   _insertBatch(opCtx, batch);
+                   _insertBatch(opCtx, batch, range);
+
+                   int64_t batchBytes = 0;
+                   for (const auto& insert : batch) {
+                       batchBytes += insert.doc.objsize();
+                   }
+                   ReshardingMetrics::get(opCtx->getServiceContext())
+                       ->onDocumentsCopiedForRange(rangeIndex, batch.size(), batchBytes);
                    return true;
                });
            })
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -39,6 +40,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/repl/oplog.h"
+#include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/future.h"
 
@@ -53,6 +55,16 @@ class TaskExecutor;
 class OperationContext;
 class ServiceContext;
 
+/**
+ * Copies the documents of the collection being resharded which the recipient shard owns under the
+ * new shard key into the temporary resharding collection, as of atClusterTime.
+ *
+ * With reshardingCollectionClonerParallelism > 1, the recipient's chunks are split into that many
+ * contiguous ranges of the new shard key, each cloned by its own aggregation against the donor
+ * shards and its own insert loop. Each range resumes independently from the highest _id inserted
+ * for it, which is persisted along with every batch it inserts. The ranges chosen by the first run
+ * are persisted too and reused when resuming, whatever the parallelism is by then.
+ */
 class ReshardingCollectionCloner {
 public:
     ReshardingCollectionCloner(ShardKeyPattern newShardKeyPattern,
@@ -65,19 +77,69 @@ public:
     std::unique_ptr<Pipeline, PipelineDeleter> makePipeline(
         OperationContext* opCtx,
         std::shared_ptr<MongoProcessInterface> mongoProcessInterface,
-        Value resumeId = Value());
+        Value resumeId = Value(),
+        const boost::optional<ChunkRange>& range = boost::none);
 
     ExecutorFuture<void> run(std::shared_ptr<executor::TaskExecutor> executor,
                              CancelationToken cancelToken);
 
+    /**
+     * Splits the chunks the recipient owns under the new shard key into at most 'numRanges'
+     * contiguous ranges with roughly the same number of chunks each. The ranges cover the whole
+     * new shard key space and their bounds are chunk boundaries.
+     */
+    static std::vector<ChunkRange> splitRecipientChunks(const ShardKeyPattern& newShardKeyPattern,
+                                                        const std::vector<BSONObj>& chunkMins,
+                                                        int numRanges);
+
+    /**
+     * Returns the ranges of the new shard key to clone, in order.
+     *
+     * The first run persists a progress document for each of the ranges returned by 'splitRanges'
+     * before inserting anything, and later runs return the persisted ranges instead, so a range
+     * never resumes from the progress of ranges split differently. Documents already in the
+     * temporary resharding collection without any progress document were inserted in _id order by
+     * a single insert loop, so a single range resuming after the highest of their _ids is persisted
+     * for them instead.
+     */
+    std::vector<ChunkRange> prepareRanges(
+        OperationContext* opCtx, const std::function<std::vector<ChunkRange>()>& splitRanges);
+
+    /**
+     * Returns the _id of the last document of 'range' inserted into the temporary resharding
+     * collection, or a missing Value if there is none. The range must come from prepareRanges().
+     */
+    Value findLastInsertedId(OperationContext* opCtx, const ChunkRange& range);
+
 private:
+    ExecutorFuture<void> _runOnRange(std::shared_ptr<executor::TaskExecutor> executor,
+                                     CancelationToken cancelToken,
+                                     ChunkRange range,
+                                     size_t rangeIndex);
+
+    std::vector<ChunkRange> _splitRecipientRanges(OperationContext* opCtx, int numRanges);
+
     Value _findHighestInsertedId(OperationContext* opCtx);
 
+    /**
+     * Records 'lastInsertedId' as the _id of the last document of 'range' inserted into the
+     * temporary resharding collection. An EOO element records that none has been inserted yet.
+     */
+    void _updateRangeProgress(OperationContext* opCtx,
+                              const ChunkRange& range,
+                              const BSONElement& lastInsertedId);
+
     std::unique_ptr<Pipeline, PipelineDeleter> _targetAggregationRequest(OperationContext* opCtx,
                                                                          const Pipeline& pipeline);
 
     std::vector<InsertStatement> _fillBatch(Pipeline& pipeline);
-    void _insertBatch(OperationContext* opCtx, std::vector<InsertStatement>& batch);
+    /**
+     * Inserts 'batch' of documents belonging to 'range' into the temporary resharding collection.
+     * The progress document of the range is updated in the same storage transaction.
+     */
+    void _insertBatch(OperationContext* opCtx,
+                      std::vector<InsertStatement>& batch,
+                      const ChunkRange& range);
 
     template <typename Callable>
     auto _withTemporaryOperationContext(Callable&& callable);
@@ -36,10 +36,13 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/json.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/s/resharding/resharding_collection_cloner.h"
+#include "mongo/db/s/resharding/resharding_collection_cloner_progress_gen.h"
 #include "mongo/db/s/resharding_util.h"
+#include "mongo/db/s/shard_server_test_fixture.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 
@@ -78,7 +81,8 @@ protected:
         ShardKeyPattern newShardKeyPattern,
         ShardId recipientShard,
         std::deque<DocumentSource::GetNextResult> sourceCollectionData,
-        std::deque<DocumentSource::GetNextResult> configCacheChunksData) {
+        std::deque<DocumentSource::GetNextResult> configCacheChunksData,
+        const boost::optional<ChunkRange>& range = boost::none) {
         auto tempNss = constructTemporaryReshardingNss(_sourceNss.db(), _sourceUUID);
         ReshardingCollectionCloner cloner(std::move(newShardKeyPattern),
                                           _sourceNss,
@@ -88,7 +92,10 @@ protected:
                                           std::move(tempNss));
 
         auto pipeline = cloner.makePipeline(
-            _opCtx.get(), std::make_shared<MockMongoInterface>(std::move(configCacheChunksData)));
+            _opCtx.get(),
+            std::make_shared<MockMongoInterface>(std::move(configCacheChunksData)),
+            Value(),
+            range);
 
         pipeline->addInitialSource(DocumentSourceMock::createForTest(
             std::move(sourceCollectionData), pipeline->getContext()));
@@ -254,5 +261,184 @@ TEST_F(ReshardingCollectionClonerTest, CompoundHashedShardKey) {
     ASSERT_FALSE(pipeline->getNext());
 }
 
+TEST_F(ReshardingCollectionClonerTest, RangeOnlyClonesChunksStartingWithinIt) {
+    auto pipeline =
+        makePipeline(ShardKeyPattern(fromjson("{x: 1}")),
+                     ShardId("shard1"),
+                     {Doc(fromjson("{_id: 1, x: -5}")),
+                      Doc(fromjson("{_id: 2, x: 5}")),
+                      Doc(fromjson("{_id: 3, x: 15}")),
+                      Doc(fromjson("{_id: 4, x: {$maxKey: 1}}"))},
+                     {Doc(fromjson("{_id: {x: {$minKey: 1}}, max: {x: 0}, shard: 'shard1'}")),
+                      Doc(fromjson("{_id: {x: 0}, max: {x: 10}, shard: 'shard2'}")),
+                      Doc(fromjson("{_id: {x: 10}, max: {x: {$maxKey: 1}}, shard: 'shard1'}"))},
+                     ChunkRange(BSON("x" << 10), BSON("x" << MAXKEY)));
+
+    auto next = pipeline->getNext();
+    ASSERT(next);
+    ASSERT_BSONOBJ_BINARY_EQ(BSON("_id" << 3 << "x" << 15 << "$sortKey" << BSON_ARRAY(3)),
+                             next->toBson());
+
+    next = pipeline->getNext();
+    ASSERT(next);
+    ASSERT_BSONOBJ_BINARY_EQ(BSON("_id" << 4 << "x" << MAXKEY << "$sortKey" << BSON_ARRAY(4)),
+                             next->toBson());
+
+    ASSERT_FALSE(pipeline->getNext());
+}
+
+TEST(ReshardingCollectionClonerSplitTest, SplitsChunksIntoContiguousRanges) {
+    const ShardKeyPattern shardKeyPattern(BSON("x" << 1));
+    const std::vector<BSONObj> chunkMins{
+        BSON("x" << MINKEY), BSON("x" << 10), BSON("x" << 20), BSON("x" << 30)};
+
+    auto ranges = ReshardingCollectionCloner::splitRecipientChunks(shardKeyPattern, chunkMins, 2);
+    ASSERT_EQ(ranges.size(), 2U);
+    ASSERT_BSONOBJ_EQ(ranges[0].getMin(), BSON("x" << MINKEY));
+    ASSERT_BSONOBJ_EQ(ranges[0].getMax(), BSON("x" << 20));
+    ASSERT_BSONOBJ_EQ(ranges[1].getMin(), BSON("x" << 20));
+    ASSERT_BSONOBJ_EQ(ranges[1].getMax(), BSON("x" << MAXKEY));
+}
+
+TEST(ReshardingCollectionClonerSplitTest, NeverCreatesMoreRangesThanChunks) {
+    const ShardKeyPattern shardKeyPattern(BSON("x" << 1));
+    const std::vector<BSONObj> chunkMins{BSON("x" << 10), BSON("x" << 20), BSON("x" << 30)};
+
+    auto ranges = ReshardingCollectionCloner::splitRecipientChunks(shardKeyPattern, chunkMins, 8);
+    ASSERT_EQ(ranges.size(), 3U);
+    ASSERT_BSONOBJ_EQ(ranges[0].getMin(), BSON("x" << MINKEY));
+    ASSERT_BSONOBJ_EQ(ranges[0].getMax(), BSON("x" << 20));
+    ASSERT_BSONOBJ_EQ(ranges[1].getMax(), BSON("x" << 30));
+    ASSERT_BSONOBJ_EQ(ranges[2].getMax(), BSON("x" << MAXKEY));
+}
+
+TEST(ReshardingCollectionClonerSplitTest, RecipientWithoutChunksGetsSingleRange) {
+    const ShardKeyPattern shardKeyPattern(BSON("x" << 1 << "y" << 1));
+
+    auto ranges = ReshardingCollectionCloner::splitRecipientChunks(shardKeyPattern, {}, 4);
+    ASSERT_EQ(ranges.size(), 1U);
+    ASSERT_BSONOBJ_EQ(ranges[0].getMin(), BSON("x" << MINKEY << "y" << MINKEY));
+    ASSERT_BSONOBJ_EQ(ranges[0].getMax(), BSON("x" << MAXKEY << "y" << MAXKEY));
+}
+
+class ReshardingCollectionClonerResumeTest : public ShardServerTestFixture {
+protected:
+    void setUp() override {
+        ShardServerTestFixture::setUp();
+
+        DBDirectClient client(operationContext());
+        client.createCollection(_outputNss.ns());
+    }
+
+    ReshardingCollectionCloner makeCloner() {
+        return ReshardingCollectionCloner(ShardKeyPattern(BSON("x" << 1)),
+                                          _sourceNss,
+                                          _sourceUUID,
+                                          ShardId("shard1"),
+                                          Timestamp(1, 0), /* dummy value */
+                                          _outputNss);
+    }
+
+    /**
+     * Writes the progress document of 'range' as a previous run would have, recording 'lastId' as
+     * the _id of the last document of the range inserted unless it is empty.
+     */
+    void writeProgress(const ChunkRange& range, BSONObj lastId) {
+        ReshardingCollectionClonerProgress progress(
+            ReshardingCollectionClonerRangeId(_outputNss, range.getMin(), range.getMax()));
+        if (!lastId.isEmpty()) {
+            progress.setLastInsertedId(IDLAnyType(lastId.firstElement()));
+        }
+
+        DBDirectClient client(operationContext());
+        client.update(NamespaceString::kReshardingCollectionClonerProgressNamespace.ns(),
+                      BSON(ReshardingCollectionClonerProgress::kRangeIdFieldName
+                           << progress.getRangeId().toBSON()),
+                      progress.toBSON(),
+                      true /* upsert */);
+    }
+
+    const ChunkRange _lowRange{BSON("x" << MINKEY), BSON("x" << 10)};
+    const ChunkRange _highRange{BSON("x" << 10), BSON("x" << MAXKEY)};
+
+    const NamespaceString _sourceNss = NamespaceString("test"_sd, "collection_being_resharded"_sd);
+    const CollectionUUID _sourceUUID = UUID::gen();
+    const NamespaceString _outputNss = constructTemporaryReshardingNss("test", _sourceUUID);
+};
+
+TEST_F(ReshardingCollectionClonerResumeTest, ResumesFromProgressDocuments) {
+    auto cloner = makeCloner();
+    auto ranges = cloner.prepareRanges(
+        operationContext(), [&] { return std::vector<ChunkRange>{_lowRange, _highRange}; });
+    ASSERT_EQ(ranges.size(), 2U);
+    ASSERT_TRUE(cloner.findLastInsertedId(operationContext(), _lowRange).missing());
+    ASSERT_TRUE(cloner.findLastInsertedId(operationContext(), _highRange).missing());
+
+    // Only the low range inserted documents before the restart.
+    writeProgress(_lowRange, BSON("_id" << 5));
+
+    auto resumedCloner = makeCloner();
+    ranges = resumedCloner.prepareRanges(
+        operationContext(), [&] { return std::vector<ChunkRange>{_lowRange, _highRange}; });
+    ASSERT_EQ(ranges.size(), 2U);
+    ASSERT_VALUE_EQ(resumedCloner.findLastInsertedId(operationContext(), _lowRange), Value(5));
+    ASSERT_TRUE(resumedCloner.findLastInsertedId(operationContext(), _highRange).missing());
+}
+
+TEST_F(ReshardingCollectionClonerResumeTest, ResumeAfterChangedSplitReusesPreviousRanges) {
+    writeProgress(_lowRange, BSON("_id" << 5));
+    writeProgress(_highRange, BSON("_id" << 7));
+
+    // The parallelism or the recipient's chunks changed since the previous run split them.
+    bool splitCalled = false;
+    auto cloner = makeCloner();
+    auto ranges = cloner.prepareRanges(operationContext(), [&] {
+        splitCalled = true;
+        return std::vector<ChunkRange>{ChunkRange(BSON("x" << MINKEY), BSON("x" << MAXKEY))};
+    });
+
+    ASSERT_FALSE(splitCalled);
+    ASSERT_EQ(ranges.size(), 2U);
+    ASSERT_BSONOBJ_EQ(ranges[0].getMin(), _lowRange.getMin());
+    ASSERT_BSONOBJ_EQ(ranges[0].getMax(), _lowRange.getMax());
+    ASSERT_BSONOBJ_EQ(ranges[1].getMin(), _highRange.getMin());
+    ASSERT_BSONOBJ_EQ(ranges[1].getMax(), _highRange.getMax());
+    ASSERT_VALUE_EQ(cloner.findLastInsertedId(operationContext(), ranges[0]), Value(5));
+    ASSERT_VALUE_EQ(cloner.findLastInsertedId(operationContext(), ranges[1]), Value(7));
+}
+
+TEST_F(ReshardingCollectionClonerResumeTest, RefusesToResumeWhenPreviousRangesHaveGap) {
+    writeProgress(_lowRange, BSON("_id" << 5));
+
+    auto cloner = makeCloner();
+    ASSERT_THROWS_CODE(
+        cloner.prepareRanges(operationContext(),
+                             [&] { return std::vector<ChunkRange>{_lowRange, _highRange}; }),
+        DBException,
+        5986706);
+}
+
+TEST_F(ReshardingCollectionClonerResumeTest, SerialFallbackResumesAfterHighestInsertedId) {
+    // Documents inserted in _id order by a single insert loop which persisted no progress.
+    DBDirectClient client(operationContext());
+    client.insert(_outputNss.ns(), BSON("_id" << 1 << "x" << 20));
+    client.insert(_outputNss.ns(), BSON("_id" << 2 << "x" << 0));
+    client.insert(_outputNss.ns(), BSON("_id" << 3 << "x" << 20));
+
+    auto cloner = makeCloner();
+    auto ranges = cloner.prepareRanges(
+        operationContext(), [&] { return std::vector<ChunkRange>{_lowRange, _highRange}; });
+    ASSERT_EQ(ranges.size(), 1U);
+    ASSERT_BSONOBJ_EQ(ranges[0].getMin(), BSON("x" << MINKEY));
+    ASSERT_BSONOBJ_EQ(ranges[0].getMax(), BSON("x" << MAXKEY));
+    ASSERT_VALUE_EQ(cloner.findLastInsertedId(operationContext(), ranges[0]), Value(3));
+
+    // A later run keeps resuming the single range rather than splitting it.
+    auto resumedCloner = makeCloner();
+    ranges = resumedCloner.prepareRanges(
+        operationContext(), [&] { return std::vector<ChunkRange>{_lowRange, _highRange}; });
+    ASSERT_EQ(ranges.size(), 1U);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -66,6 +66,38 @@ ReshardingDonorOplogId getId(const repl::OplogEntry& oplog) {
         oplog.get_id()->getDocument().toBson());
 }
 
+/**
+ * Returns a future which becomes ready with the outcome of 'future', or with a CallbackCanceled
+ * error as soon as 'cancelToken' is canceled, whichever comes first.
+ */
+SemiFuture<void> awaitUnlessCanceled(Future<void> future, const CancelationToken& cancelToken) {
+    struct SharedBlock {
+        SharedBlock(Promise<void> promise) : promise(std::move(promise)) {}
+
+        AtomicWord<bool> done{false};
+        Promise<void> promise;
+    };
+
+    auto [promise, result] = makePromiseFuture<void>();
+    auto sharedBlock = std::make_shared<SharedBlock>(std::move(promise));
+
+    cancelToken.onCancel().unsafeToInlineFuture().getAsync([sharedBlock](Status status) {
+        // The token only resolves with an error if its source is destroyed without canceling it.
+        if (status.isOK() && !sharedBlock->done.swap(true)) {
+            sharedBlock->promise.setError(
+                {ErrorCodes::CallbackCanceled, "Waiting for oplog entries was canceled"});
+        }
+    });
+
+    std::move(future).getAsync([sharedBlock](Status status) {
+        if (!sharedBlock->done.swap(true)) {
+            sharedBlock->promise.setFrom(std::move(status));
+        }
+    });
+
+    return std::move(result).semi();
+}
+
 }  // anonymous namespace
 
 ReshardingDonorOplogIterator::ReshardingDonorOplogIterator(
@@ -207,7 +239,7 @@ std::vector<repl::OplogEntry> ReshardingDonorOplogIterator::_fillBatch(Pipeline&
 }
 
 ExecutorFuture<std::vector<repl::OplogEntry>> ReshardingDonorOplogIterator::getNextBatch(
-    std::shared_ptr<executor::TaskExecutor> executor) {
+    std::shared_ptr<executor::TaskExecutor> executor, CancelationToken cancelToken) {
     if (_hasSeenFinalOplogEntry) {
         invariant(!_pipeline);
         return ExecutorFuture(std::move(executor), std::vector<repl::OplogEntry>{});
@@ -246,8 +278,12 @@ ExecutorFuture<std::vector<repl::OplogEntry>> ReshardingDonorOplogIterator::getN
 
     if (batch.empty() && !_hasSeenFinalOplogEntry) {
         return ExecutorFuture(executor)
-            .then([this] { return _insertNotifier->awaitInsert(_resumeToken); })
-            .then([this, executor] { return getNextBatch(std::move(executor)); });
+            .then([this, cancelToken] {
+                return awaitUnlessCanceled(_insertNotifier->awaitInsert(_resumeToken), cancelToken);
+            })
+            .then([this, executor, cancelToken] {
+                return getNextBatch(std::move(executor), cancelToken);
+            });
     }
 
     return ExecutorFuture(std::move(executor), std::move(batch));
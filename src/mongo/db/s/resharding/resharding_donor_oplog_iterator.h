@@ -36,6 +36,7 @@
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/s/resharding/donor_oplog_id_gen.h"
 #include "mongo/executor/task_executor.h"
+#include "mongo/util/cancelation.h"
 #include "mongo/util/future.h"
 
 namespace mongo {
@@ -67,9 +68,12 @@ public:
      *  - An empty vector is returned when there are no more oplog entries left to apply.
      *  - A non-immediately ready future is returned when the iterator has been exhausted, but the
      *    final oplog entry hasn't been returned yet.
+     *
+     * Canceling 'cancelToken' makes a future still waiting for oplog entries become ready with a
+     * CallbackCanceled error.
      */
     virtual ExecutorFuture<std::vector<repl::OplogEntry>> getNextBatch(
-        std::shared_ptr<executor::TaskExecutor> executor) = 0;
+        std::shared_ptr<executor::TaskExecutor> executor, CancelationToken cancelToken) = 0;
 };
 
 /**
@@ -94,7 +98,7 @@ public:
         OperationContext* opCtx, std::shared_ptr<MongoProcessInterface> mongoProcessInterface);
 
     ExecutorFuture<std::vector<repl::OplogEntry>> getNextBatch(
-        std::shared_ptr<executor::TaskExecutor> executor) override;
+        std::shared_ptr<executor::TaskExecutor> executor, CancelationToken cancelToken) override;
 
     static constexpr auto kActualOpFieldName = "actualOp"_sd;
     static constexpr auto kPreImageOpFieldName = "preImageOp"_sd;
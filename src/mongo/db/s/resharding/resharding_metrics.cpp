@@ -49,6 +49,9 @@ constexpr auto kDocumentsCopied = "documentsCopied";
 constexpr auto kBytesToCopy = "approxBytesToCopy";
 constexpr auto kBytesCopied = "bytesCopied";
 constexpr auto kCopyTimeElapsed = "totalCopyTimeElapsedMillis";
+constexpr auto kRangesCopied = "rangesCopied";
+constexpr auto kRangeMin = "min";
+constexpr auto kRangeMax = "max";
 constexpr auto kOplogsFetched = "oplogEntriesFetched";
 constexpr auto kOplogsApplied = "oplogEntriesApplied";
 constexpr auto kApplyTimeElapsed = "totalApplyTimeElapsedMillis";
@@ -166,6 +169,38 @@ void ReshardingMetrics::onDocumentsCopied(int64_t documents, int64_t bytes) noex
     _currentOp->bytesCopied += bytes;
 }
 
+void ReshardingMetrics::setRangesToCopy(const std::vector<ChunkRange>& ranges) noexcept {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_currentOp || _currentOp->isCompleted() ||
+        _currentOp->recipientState != RecipientStateEnum::kCloning) {
+        return;
+    }
+
+    _currentOp->rangesCopied.clear();
+    for (const auto& range : ranges) {
+        _currentOp->rangesCopied.push_back({range});
+    }
+}
+
+void ReshardingMetrics::onDocumentsCopiedForRange(size_t rangeIndex,
+                                                  int64_t documents,
+                                                  int64_t bytes) noexcept {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_currentOp || _currentOp->isCompleted() ||
+        _currentOp->recipientState != RecipientStateEnum::kCloning) {
+        return;
+    }
+
+    _currentOp->documentsCopied += documents;
+    _currentOp->bytesCopied += bytes;
+
+    if (rangeIndex < _currentOp->rangesCopied.size()) {
+        auto& progress = _currentOp->rangesCopied[rangeIndex];
+        progress.documentsCopied += documents;
+        progress.bytesCopied += bytes;
+    }
+}
+
 void ReshardingMetrics::onOplogEntriesFetched(int64_t entries) noexcept {
     stdx::lock_guard<Latch> lk(_mutex);
     invariant(_currentOp.has_value() && !_currentOp->isCompleted(), kNoOperationInProgress);
@@ -250,6 +285,16 @@ void ReshardingMetrics::OperationMetrics::append(BSONObjBuilder* bob) const {
     bob->append(kBytesToCopy, bytesToCopy);
     bob->append(kBytesCopied, bytesCopied);
     bob->append(kCopyTimeElapsed, getElapsedTime(copyingDocuments));
+    if (!rangesCopied.empty()) {
+        BSONArrayBuilder rangesBuilder(bob->subarrayStart(kRangesCopied));
+        for (const auto& progress : rangesCopied) {
+            BSONObjBuilder rangeBuilder(rangesBuilder.subobjStart());
+            rangeBuilder.append(kRangeMin, progress.range.getMin());
+            rangeBuilder.append(kRangeMax, progress.range.getMax());
+            rangeBuilder.append(kDocumentsCopied, progress.documentsCopied);
+            rangeBuilder.append(kBytesCopied, progress.bytesCopied);
+        }
+    }
 
     bob->append(kOplogsFetched, oplogEntriesFetched);
     bob->append(kOplogsApplied, oplogEntriesApplied);
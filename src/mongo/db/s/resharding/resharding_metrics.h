@@ -28,11 +28,13 @@
  */
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/service_context.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/resharding/common_types_gen.h"
 #include "mongo/util/clock_source.h"
 #include "mongo/util/duration.h"
@@ -66,6 +68,12 @@ public:
     void setDocumentsToCopy(int64_t documents, int64_t bytes) noexcept;
     void onDocumentsCopied(int64_t documents, int64_t bytes) noexcept;
 
+    // Allows the collection cloner to report the progress of each range of the new shard key it
+    // clones separately. Unlike the above, these are ignored unless a resharding operation is
+    // tracked and the recipient is in cloning state, since the cloner runs regardless.
+    void setRangesToCopy(const std::vector<ChunkRange>& ranges) noexcept;
+    void onDocumentsCopiedForRange(size_t rangeIndex, int64_t documents, int64_t bytes) noexcept;
+
     // Allows updating "oplog entries to apply" metrics when the recipient is in applying state.
     void onOplogEntriesFetched(int64_t entries) noexcept;
     void onOplogEntriesApplied(int64_t entries) noexcept;
@@ -134,6 +142,13 @@ private:
         int64_t bytesToCopy = 0;
         int64_t bytesCopied = 0;
 
+        struct RangeProgress {
+            ChunkRange range;
+            int64_t documentsCopied = 0;
+            int64_t bytesCopied = 0;
+        };
+        std::vector<RangeProgress> rangesCopied;
+
         TimeInterval applyingOplogEntries;
         int64_t oplogEntriesFetched = 0;
         int64_t oplogEntriesApplied = 0;
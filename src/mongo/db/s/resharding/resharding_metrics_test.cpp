@@ -215,4 +215,29 @@ TEST_F(ReshardingMetricsTest, EstimatedRemainingOperationTime) {
     checkMetrics(kTag, kTimerStep * (kOplogEntriesFetched / kOplogEntriesApplied - 1));
 }
 
+TEST_F(ReshardingMetricsTest, ReportsProgressPerCopiedRange) {
+    // Progress reported while no operation is tracked is ignored.
+    getMetrics()->onDocumentsCopiedForRange(0, 1, 10);
+
+    getMetrics()->onStart();
+    getMetrics()->setRecipientState(RecipientStateEnum::kCloning);
+    getMetrics()->setRangesToCopy({ChunkRange(BSON("x" << MINKEY), BSON("x" << 0)),
+                                   ChunkRange(BSON("x" << 0), BSON("x" << MAXKEY))});
+    getMetrics()->onDocumentsCopiedForRange(0, 2, 20);
+    getMetrics()->onDocumentsCopiedForRange(1, 3, 30);
+    getMetrics()->onDocumentsCopiedForRange(1, 1, 10);
+
+    const auto report = getReport();
+    checkMetrics(report, "documentsCopied", 6);
+    checkMetrics(report, "bytesCopied", 60);
+
+    const auto ranges = report.getObjectField("rangesCopied");
+    ASSERT_EQ(ranges.nFields(), 2);
+    const auto secondRange = ranges["1"].Obj();
+    ASSERT_BSONOBJ_EQ(secondRange.getObjectField("min"), BSON("x" << 0));
+    checkMetrics(ranges["0"].Obj(), "documentsCopied", 2);
+    checkMetrics(secondRange, "documentsCopied", 4);
+    checkMetrics(secondRange, "bytesCopied", 40);
+}
+
 }  // namespace mongo
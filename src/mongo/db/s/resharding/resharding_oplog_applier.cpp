@@ -262,6 +262,15 @@ ReshardingOplogApplier::ReshardingOplogApplier(
       _writerPool(writerPool),
       _oplogIter(std::move(oplogIterator)) {}
 
+ReshardingOplogApplier::~ReshardingOplogApplier() {
+    if (_nextBatchToApply) {
+        // A batch fetched ahead of time which was never applied still refers to the oplog iterator.
+        // It may be waiting for oplog entries which will never be buffered, so cancel it first.
+        _fetchCancelSource.cancel();
+        _nextBatchToApply->getNoThrow().getStatus().ignore();
+    }
+}
+
 ExecutorFuture<void> ReshardingOplogApplier::applyUntilCloneFinishedTs() {
     invariant(_stage == ReshardingOplogApplier::Stage::kStarted);
 
@@ -284,17 +293,38 @@ ExecutorFuture<void> ReshardingOplogApplier::applyUntilDone() {
         .onError([this](Status status) { return _onError(status); });
 }
 
+ExecutorFuture<ReshardingOplogApplier::OplogBatch> ReshardingOplogApplier::_fetchNextBatch() {
+    return ExecutorFuture(_executor).then([this] {
+        auto batchClient = makeKillableClient(_service, kClientName);
+        AlternativeClientRegion acr(batchClient);
+
+        return _oplogIter->getNextBatch(_executor, _fetchCancelSource.token());
+    });
+}
+
 ExecutorFuture<void> ReshardingOplogApplier::_scheduleNextBatch() {
-    return ExecutorFuture(_executor)
-        .then([this] {
-            auto batchClient = makeKillableClient(_service, kClientName);
-            AlternativeClientRegion acr(batchClient);
+    auto nextBatch = [&] {
+        if (!_nextBatchToApply) {
+            return _fetchNextBatch();
+        }
 
-            return _oplogIter->getNextBatch(_executor);
-        })
+        auto prefetchedBatch = std::move(*_nextBatchToApply);
+        _nextBatchToApply.reset();
+        return prefetchedBatch;
+    }();
+
+    return std::move(nextBatch)
         .then([this](OplogBatch batch) {
             _currentBatchToApply = std::move(batch);
 
+            if (!_currentBatchToApply.empty()) {
+                // Overlap fetching the next batch from the donor's oplog buffer with applying this
+                // one. The oplog iterator is only ever used by one fetch at a time, and the
+                // prefetched batch is not applied until this one has been applied and its
+                // progress recorded, so oplog entries are still applied in order.
+                _nextBatchToApply.emplace(_fetchNextBatch());
+            }
+
             auto applyBatchClient = makeKillableClient(_service, kClientName);
             AlternativeClientRegion acr(applyBatchClient);
             auto applyBatchOpCtx = makeInterruptibleOperationContext();
@@ -331,7 +361,8 @@ ExecutorFuture<void> ReshardingOplogApplier::_scheduleNextBatch() {
             if (_stage == ReshardingOplogApplier::Stage::kStarted &&
                 lastAppliedTs >= _reshardingCloneFinishedTs) {
                 _stage = ReshardingOplogApplier::Stage::kReachedCloningTS;
-                // TODO: SERVER-51741 preemptively schedule next batch
+                // The next batch has already started being fetched and is picked up by
+                // applyUntilDone().
                 return false;
             }
 
@@ -39,6 +39,7 @@
 #include "mongo/db/s/resharding/resharding_oplog_batch_preparer.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/chunk_manager.h"
+#include "mongo/util/cancelation.h"
 #include "mongo/util/future.h"
 
 namespace mongo {
@@ -66,6 +67,8 @@ public:
                            std::shared_ptr<executor::TaskExecutor> executor,
                            ThreadPool* writerPool);
 
+    ~ReshardingOplogApplier();
+
     /**
      * Applies oplog from the iterator until it has at least applied an oplog entry with timestamp
      * greater than or equal to reshardingCloneFinishedTs.
@@ -100,6 +103,12 @@ private:
      */
     ExecutorFuture<void> _scheduleNextBatch();
 
+    /**
+     * Returns a future that becomes ready with the next batch of oplog entries from the iterator.
+     * The batch starts being fetched as soon as this is called.
+     */
+    ExecutorFuture<OplogBatch> _fetchNextBatch();
+
     /**
      * Setup the worker threads to apply the ops in the current buffer in parallel. Waits for all
      * worker threads to finish (even when some of them finished early due to an error).
@@ -181,9 +190,17 @@ private:
     // (S) Thread pool for replication oplog applier;
     ThreadPool* _writerPool;
 
+    // (S) Canceled on destruction to stop a batch being fetched ahead of time from waiting for
+    // more oplog entries.
+    CancelationSource _fetchCancelSource;
+
     // (R) Buffer for the current batch of oplog entries to apply.
     OplogBatch _currentBatchToApply;
 
+    // (R) The batch following _currentBatchToApply, fetched from the iterator while the current
+    // batch is being applied.
+    boost::optional<ExecutorFuture<OplogBatch>> _nextBatchToApply;
+
     // (R) Buffer for internally generated oplog entries that needs to be processed for this batch.
     std::list<repl::OplogEntry> _currentDerivedOps;
 
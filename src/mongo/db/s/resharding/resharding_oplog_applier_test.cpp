@@ -68,7 +68,7 @@ public:
     }
 
     ExecutorFuture<std::vector<repl::OplogEntry>> getNextBatch(
-        std::shared_ptr<executor::TaskExecutor> executor) override {
+        std::shared_ptr<executor::TaskExecutor> executor, CancelationToken cancelToken) override {
         // This operation context is unused by the function but confirms that the Client calling
         // getNextBatch() doesn't already have an operation context.
         auto opCtx = cc().makeOperationContext();
@@ -102,6 +102,84 @@ private:
     bool _doThrow{false};
 };
 
+/**
+ * Oplog iterator which only returns a batch once the test hands it out, so that the test controls
+ * when each batch requested by the applier becomes available.
+ */
+class ControlledOplogIteratorMock : public ReshardingDonorOplogIteratorInterface {
+public:
+    struct Request {
+        Request(Promise<std::vector<repl::OplogEntry>> promise) : promise(std::move(promise)) {}
+
+        Promise<std::vector<repl::OplogEntry>> promise;
+        bool done = false;
+    };
+
+    struct State {
+        void waitForRequests(size_t numRequests) {
+            stdx::unique_lock<Latch> lk(mutex);
+            cv.wait(lk, [&] { return requests.size() >= numRequests; });
+        }
+
+        void handOut(size_t requestIndex, std::vector<repl::OplogEntry> batch) {
+            stdx::lock_guard<Latch> lk(mutex);
+            auto& request = *requests.at(requestIndex);
+            invariant(!request.done);
+            request.done = true;
+            request.promise.emplaceValue(std::move(batch));
+        }
+
+        size_t getNumRequests() {
+            stdx::lock_guard<Latch> lk(mutex);
+            return requests.size();
+        }
+
+        int getNumCanceled() {
+            stdx::lock_guard<Latch> lk(mutex);
+            return numCanceled;
+        }
+
+        Mutex mutex = MONGO_MAKE_LATCH("ControlledOplogIteratorMock::State::mutex");
+        stdx::condition_variable cv;
+        std::vector<std::shared_ptr<Request>> requests;
+        int numCanceled = 0;
+    };
+
+    explicit ControlledOplogIteratorMock(std::shared_ptr<State> state) : _state(std::move(state)) {}
+
+    ExecutorFuture<std::vector<repl::OplogEntry>> getNextBatch(
+        std::shared_ptr<executor::TaskExecutor> executor, CancelationToken cancelToken) override {
+        auto [promise, future] = makePromiseFuture<std::vector<repl::OplogEntry>>();
+        auto request = std::make_shared<Request>(std::move(promise));
+
+        {
+            stdx::lock_guard<Latch> lk(_state->mutex);
+            _state->requests.push_back(request);
+            _state->cv.notify_all();
+        }
+
+        cancelToken.onCancel().unsafeToInlineFuture().getAsync(
+            [state = _state, request](Status status) {
+                if (!status.isOK()) {
+                    return;
+                }
+
+                stdx::lock_guard<Latch> lk(state->mutex);
+                if (!request->done) {
+                    request->done = true;
+                    ++state->numCanceled;
+                    request->promise.setError(
+                        {ErrorCodes::CallbackCanceled, "ControlledOplogIteratorMock canceled"});
+                }
+            });
+
+        return std::move(future).thenRunOn(std::move(executor));
+    }
+
+private:
+    const std::shared_ptr<State> _state;
+};
+
 class ReshardingOplogApplierTest : public ShardingMongodTestFixture {
 public:
     const HostAndPort kConfigHostAndPort{"DummyConfig", 12345};
@@ -419,6 +497,106 @@ TEST_F(ReshardingOplogApplierTest, InsertTypeOplogAppliedInMultipleBatches) {
     ASSERT_EQ(Timestamp(19, 3), progressDoc->getProgress().getTs());
 }
 
+TEST_F(ReshardingOplogApplierTest, NextBatchIsFetchedWhileCurrentBatchIsApplied) {
+    auto state = std::make_shared<ControlledOplogIteratorMock::State>();
+    auto iterator = std::make_unique<ControlledOplogIteratorMock>(state);
+
+    boost::optional<ReshardingOplogApplier> applier;
+    auto executor = makeTaskExecutorForApplier();
+    auto writerPool = repl::makeReplWriterPool(kWriterPoolSize);
+    applier.emplace(getServiceContext(),
+                    sourceId(),
+                    oplogNs(),
+                    crudNs(),
+                    crudUUID(),
+                    stashCollections(),
+                    0U, /* myStashIdx */
+                    Timestamp(6, 3),
+                    std::move(iterator),
+                    chunkManager(),
+                    executor,
+                    writerPool.get());
+
+    auto future = applier->applyUntilCloneFinishedTs();
+
+    {
+        // Block the application of the first batch. The second batch must still be requested.
+        AutoGetCollection outputColl(operationContext(), appliedToNs(), MODE_X);
+
+        state->waitForRequests(1);
+        state->handOut(0,
+                       {makeOplog(repl::OpTime(Timestamp(5, 3), 1),
+                                  repl::OpTypeEnum::kInsert,
+                                  BSON("_id" << 1),
+                                  boost::none)});
+        state->waitForRequests(2);
+    }
+
+    // The second batch depends on the first one having been applied.
+    state->handOut(1,
+                   {makeOplog(repl::OpTime(Timestamp(6, 3), 1),
+                              repl::OpTypeEnum::kUpdate,
+                              BSON("$set" << BSON("x" << 1)),
+                              BSON("_id" << 1))});
+    future.get();
+
+    // The batch fetched ahead of time when the clone timestamp was reached is handed over to the
+    // catch-up phase.
+    state->waitForRequests(3);
+    future = applier->applyUntilDone();
+    state->handOut(2, {});
+    future.get();
+
+    DBDirectClient client(operationContext());
+    auto doc = client.findOne(appliedToNs().ns(), BSON("_id" << 1));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1 << "x" << 1), doc);
+
+    auto progressDoc = ReshardingOplogApplier::checkStoredProgress(operationContext(), sourceId());
+    ASSERT_TRUE(progressDoc);
+    ASSERT_EQ(Timestamp(6, 3), progressDoc->getProgress().getClusterTime());
+    ASSERT_EQ(Timestamp(6, 3), progressDoc->getProgress().getTs());
+
+    ASSERT_EQ(3U, state->getNumRequests());
+    ASSERT_EQ(0, state->getNumCanceled());
+}
+
+TEST_F(ReshardingOplogApplierTest, DestructorCancelsBatchBeingFetched) {
+    auto state = std::make_shared<ControlledOplogIteratorMock::State>();
+    auto iterator = std::make_unique<ControlledOplogIteratorMock>(state);
+
+    boost::optional<ReshardingOplogApplier> applier;
+    auto executor = makeTaskExecutorForApplier();
+    auto writerPool = repl::makeReplWriterPool(kWriterPoolSize);
+    applier.emplace(getServiceContext(),
+                    sourceId(),
+                    oplogNs(),
+                    crudNs(),
+                    crudUUID(),
+                    stashCollections(),
+                    0U, /* myStashIdx */
+                    Timestamp(5, 3),
+                    std::move(iterator),
+                    chunkManager(),
+                    executor,
+                    writerPool.get());
+
+    auto future = applier->applyUntilCloneFinishedTs();
+    state->waitForRequests(1);
+    state->handOut(0,
+                   {makeOplog(repl::OpTime(Timestamp(5, 3), 1),
+                              repl::OpTypeEnum::kInsert,
+                              BSON("_id" << 1),
+                              boost::none)});
+    future.get();
+
+    // The next batch is being fetched, but no more oplog entries will ever be buffered for it.
+    // Destroying the applier must not wait for them.
+    state->waitForRequests(2);
+    applier.reset();
+
+    ASSERT_EQ(1, state->getNumCanceled());
+}
+
 TEST_F(ReshardingOplogApplierTest, ErrorDuringBatchApplyCloningPhase) {
     std::deque<repl::OplogEntry> crudOps;
     crudOps.push_back(makeOplog(repl::OpTime(Timestamp(5, 3), 1),
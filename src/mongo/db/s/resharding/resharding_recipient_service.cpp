@@ -227,8 +227,8 @@ void ReshardingRecipientService::RecipientStateMachine::interrupt(Status status)
         fetcher->interrupt(status);
     }
 
-    for (auto&& threadPool : _oplogApplierWorkers) {
-        threadPool->shutdown();
+    if (_oplogApplierWorkers) {
+        _oplogApplierWorkers->shutdown();
     }
 
     if (!_coordinatorHasCommitted.getFuture().isReady()) {
@@ -401,7 +401,16 @@ ExecutorFuture<void> ReshardingRecipientService::RecipientStateMachine::
 
     auto numDonors = _recipientDoc.getDonorShardsMirroring().size();
     _oplogAppliers.reserve(numDonors);
-    _oplogApplierWorkers.reserve(numDonors);
+
+    {
+        // The pool is sized to give each donor as many threads as it would have had in a pool of
+        // its own.
+        stdx::lock_guard<Latch> lk(_mutex);
+        _oplogApplierWorkers = repl::makeReplWriterPool(
+            resharding::gReshardingWriterThreadCount * static_cast<int>(numDonors),
+            "ReshardingOplogApplierWorker",
+            true /* isKillableByStepdown */);
+    }
 
     auto* serviceContext = Client::getCurrent()->getServiceContext();
     const auto& sourceChunkMgr = [&] {
@@ -424,14 +433,6 @@ ExecutorFuture<void> ReshardingRecipientService::RecipientStateMachine::
     size_t i = 0;
     auto futuresToWaitOn = std::move(_oplogFetcherFutures);
     for (const auto& donor : _recipientDoc.getDonorShardsMirroring()) {
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _oplogApplierWorkers.emplace_back(
-                repl::makeReplWriterPool(resharding::gReshardingWriterThreadCount,
-                                         "ReshardingOplogApplierWorker",
-                                         true /* isKillableByStepdown */));
-        }
-
         const auto& oplogBufferNss =
             getLocalOplogBufferNamespace(_recipientDoc.get_id(), donor.getId());
         _oplogAppliers.emplace_back(std::make_unique<ReshardingOplogApplier>(
@@ -453,7 +454,7 @@ ExecutorFuture<void> ReshardingRecipientService::RecipientStateMachine::
                 _oplogFetchers[i].get()),
             sourceChunkMgr,
             **executor,
-            _oplogApplierWorkers.back().get()));
+            _oplogApplierWorkers.get()));
 
         // The contents of the temporary resharding collection are already consistent because the
         // ReshardingCollectionCloner uses atClusterTime. Using replication's initial sync
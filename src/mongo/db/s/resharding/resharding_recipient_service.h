@@ -168,7 +168,10 @@ private:
     std::unique_ptr<ReshardingCollectionCloner> _collectionCloner;
 
     std::vector<std::unique_ptr<ReshardingOplogApplier>> _oplogAppliers;
-    std::vector<std::unique_ptr<ThreadPool>> _oplogApplierWorkers;
+
+    // Writer threads shared by the ReshardingOplogAppliers of all donor shards, so that threads
+    // left idle by one donor's applier can apply the writer vectors of another.
+    std::unique_ptr<ThreadPool> _oplogApplierWorkers;
 
     // The ReshardingOplogFetcher must be destructed before the corresponding ReshardingOplogApplier
     // to ensure the future returned by awaitInsert() is always eventually readied.
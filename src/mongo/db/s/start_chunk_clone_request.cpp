@@ -50,6 +50,7 @@ const char kToShardId[] = "toShardName";
 const char kChunkMinKey[] = "min";
 const char kChunkMaxKey[] = "max";
 const char kShardKeyPattern[] = "shardKeyPattern";
+const char kStreamsFromShardKeyIndex[] = "streamsFromShardKeyIndex";
 
 }  // namespace
 
@@ -152,6 +153,14 @@ StatusWith<StartChunkCloneRequest> StartChunkCloneRequest::createFromCommand(Nam
         }
     }
 
+    {
+        Status status = bsonExtractBooleanFieldWithDefault(
+            obj, kStreamsFromShardKeyIndex, false, &request._streamsFromShardKeyIndex);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     request._migrationId = UUID::parse(obj);
     request._lsid =
         LogicalSessionId::parse(IDLParserErrorContext("StartChunkCloneRequest"), obj[kLsid].Obj());
@@ -194,4 +203,8 @@ void StartChunkCloneRequest::appendAsCommand(
     secondaryThrottle.append(builder);
 }
 
+void StartChunkCloneRequest::appendStreamsFromShardKeyIndex(BSONObjBuilder* builder) {
+    builder->append(kStreamsFromShardKeyIndex, true);
+}
+
 }  // namespace mongo
@@ -74,6 +74,12 @@ public:
                                 const BSONObj& shardKeyPattern,
                                 const MigrationSecondaryThrottleOptions& secondaryThrottle);
 
+    /**
+     * Appends to a command constructed by appendAsCommand that the donor streams the documents of
+     * the chunk from the shard key index, which can send a document more than once.
+     */
+    static void appendStreamsFromShardKeyIndex(BSONObjBuilder* builder);
+
     const NamespaceString& getNss() const {
         return _nss;
     }
@@ -127,6 +133,10 @@ public:
         return _secondaryThrottle;
     }
 
+    bool getStreamsFromShardKeyIndex() const {
+        return _streamsFromShardKeyIndex;
+    }
+
 private:
     StartChunkCloneRequest(NamespaceString nss,
                            MigrationSessionId sessionId,
@@ -158,6 +168,9 @@ private:
 
     // The parsed secondary throttle options
     MigrationSecondaryThrottleOptions _secondaryThrottle;
+
+    // Whether the donor streams the documents from the shard key index
+    bool _streamsFromShardKeyIndex{false};
 };
 
 }  // namespace mongo
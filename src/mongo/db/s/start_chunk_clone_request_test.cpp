@@ -94,6 +94,36 @@ TEST(StartChunkCloneRequest, CreateAsCommandComplete) {
     ASSERT_BSONOBJ_EQ(BSON("Key" << 1), request.getShardKeyPattern());
     ASSERT_EQ(MigrationSecondaryThrottleOptions::kOff,
               request.getSecondaryThrottle().getSecondaryThrottle());
+    ASSERT_FALSE(request.getStreamsFromShardKeyIndex());
+}
+
+TEST(StartChunkCloneRequest, CreateAsCommandStreamingFromShardKeyIndex) {
+    auto serviceContext = ServiceContext::make();
+    auto client = serviceContext->makeClient("TestClient");
+    auto opCtx = client->makeOperationContext();
+
+    BSONObjBuilder builder;
+    StartChunkCloneRequest::appendAsCommand(
+        &builder,
+        NamespaceString("TestDB.TestColl"),
+        UUID::gen(),
+        makeLogicalSessionId(opCtx.get()),
+        0,
+        MigrationSessionId::generate("shard0001", "shard0002"),
+        assertGet(ConnectionString::parse("TestDonorRS/Donor1:12345,Donor2:12345,Donor3:12345")),
+        ShardId("shard0001"),
+        ShardId("shard0002"),
+        BSON("Key" << -100),
+        BSON("Key" << 100),
+        BSON("Key" << 1),
+        MigrationSecondaryThrottleOptions::create(MigrationSecondaryThrottleOptions::kOff));
+    StartChunkCloneRequest::appendStreamsFromShardKeyIndex(&builder);
+
+    BSONObj cmdObj = builder.obj();
+
+    auto request = assertGet(StartChunkCloneRequest::createFromCommand(
+        NamespaceString(cmdObj["_recvChunkStart"].String()), cmdObj));
+    ASSERT(request.getStreamsFromShardKeyIndex());
 }
 
 }  // namespace
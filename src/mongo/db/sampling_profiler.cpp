@@ -0,0 +1,446 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sampling_profiler.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <fstream>
+
+#if defined(__linux__)
+#include <cxxabi.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/stacktrace.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr int kMaxFrequencyHz = 1000;
+constexpr std::size_t kMaxFrames = 64;
+constexpr std::size_t kRingSize = 4096;
+constexpr std::size_t kMaxCachedThreadRoles = 10000;
+constexpr std::size_t kSummaryTopFunctions = 10;
+constexpr auto kDrainPeriod = Milliseconds(100);
+
+// Samples lost because the signal handler found its ring slot not yet drained
+AtomicWord<long long> gRingDroppedSamples{0};
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+// Frames captured in the signal handler that belong to the profiler rather than the sampled code:
+// rawBacktrace, the signal handler and the kernel's signal return trampoline.
+constexpr std::size_t kSignalFrames = 3;
+
+/**
+ * One backtrace captured by the signal handler. The handler claims an empty slot by moving it to
+ * kWriting, and publishes it with kFull. The aggregator thread copies full slots out and moves them
+ * back to kEmpty.
+ */
+struct Sample {
+    enum State : int { kEmpty, kWriting, kFull };
+
+    AtomicWord<int> state{kEmpty};
+    int tid;
+    std::size_t depth;
+    void* frames[kMaxFrames + kSignalFrames];
+};
+
+// Allocated on first start and never freed, since a late signal may still be writing to it.
+Sample* gRing = nullptr;
+AtomicWord<std::size_t> gRingNext{0};
+
+/**
+ * SIGPROF handler. Must remain async-signal-safe: no allocation, no locks.
+ */
+void onProfilingSignal(int, siginfo_t*, void*) {
+    const int savedErrno = errno;
+
+    auto& sample = gRing[gRingNext.fetchAndAdd(1) % kRingSize];
+    int expected = Sample::kEmpty;
+    if (sample.state.compareAndSwap(&expected, Sample::kWriting)) {
+        sample.tid = static_cast<int>(syscall(SYS_gettid));
+        sample.depth = rawBacktrace(sample.frames, kMaxFrames + kSignalFrames);
+        sample.state.store(Sample::kFull);
+    } else {
+        // The aggregator has fallen a full ring behind
+        gRingDroppedSamples.fetchAndAdd(1);
+    }
+
+    errno = savedErrno;
+}
+
+void setProfilingTimer(int frequencyHz) {
+    itimerval timer{};
+    if (frequencyHz > 0) {
+        timer.it_interval.tv_usec = 1000 * 1000 / frequencyHz;
+        timer.it_value = timer.it_interval;
+    }
+    uassert(ErrorCodes::OperationFailed,
+            str::stream() << "Failed to set the profiling timer: " << errnoWithDescription(),
+            setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+}
+
+void setProfilingSignalHandler(bool install) {
+    struct sigaction action {};
+    sigemptyset(&action.sa_mask);
+    if (install) {
+        action.sa_sigaction = &onProfilingSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+    } else {
+        // A SIGPROF already pending when the timer is disarmed would otherwise terminate the
+        // process.
+        action.sa_handler = SIG_IGN;
+    }
+    uassert(ErrorCodes::OperationFailed,
+            str::stream() << "Failed to set the SIGPROF handler: " << errnoWithDescription(),
+            sigaction(SIGPROF, &action, nullptr) == 0);
+}
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+/**
+ * Reduces a thread name to the role it was started for, by dropping the trailing counter most
+ * threads are named with: "conn42" becomes "conn" and "ReplWriterWorker-3" "ReplWriterWorker".
+ */
+std::string threadRoleFromName(std::string name) {
+    while (!name.empty() &&
+           (std::isdigit(static_cast<unsigned char>(name.back())) || name.back() == '-' ||
+            name.back() == '_' || name.back() == ':')) {
+        name.pop_back();
+    }
+    return name.empty() ? "unknown" : name;
+}
+
+}  // namespace
+
+void SamplingProfiler::Profile::serialize(BSONObjBuilder* builder) const {
+    builder->append("running", running);
+    builder->append("frequencyHz", frequencyHz);
+    builder->append("samples", samples);
+    builder->append("droppedSamples", droppedSamples);
+
+    BSONArrayBuilder stacksBuilder(builder->subarrayStart("stacks"));
+    for (const auto& stack : stacks) {
+        BSONObjBuilder stackBuilder(stacksBuilder.subobjStart());
+        stackBuilder.append("role", stack.role);
+        stackBuilder.append("samples", stack.samples);
+        stackBuilder.append("stack", stack.frames);
+    }
+}
+
+SamplingProfiler& SamplingProfiler::get() {
+    // SIGPROF and its timer are process wide, so there is one profiler per process rather than per
+    // ServiceContext.
+    static auto& profiler = *new SamplingProfiler();
+    return profiler;
+}
+
+bool SamplingProfiler::isSupported() {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SamplingProfiler::start(const StartProfiling& options) {
+    stdx::lock_guard<Latch> controlLk(_controlMutex);
+
+    uassert(ErrorCodes::IllegalOperation,
+            "The sampling profiler is not supported on this platform",
+            isSupported());
+    uassert(ErrorCodes::BadValue, "Profiling already active", !_running.load());
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "frequencyHz must be between 1 and " << kMaxFrequencyHz,
+            options.getFrequencyHz() >= 1 && options.getFrequencyHz() <= kMaxFrequencyHz);
+    uassert(ErrorCodes::BadValue, "maxStacks must be positive", options.getMaxStacks() > 0);
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stopRequested = false;
+        _frequencyHz = options.getFrequencyHz();
+        _maxStacks = options.getMaxStacks();
+        _samples = 0;
+        _overflowSamples = 0;
+        _stacks.clear();
+        _roleSamples.clear();
+        _threadRoles.clear();
+    }
+
+    if (!gRing) {
+        gRing = new Sample[kRingSize];
+    }
+    for (std::size_t i = 0; i < kRingSize; ++i) {
+        gRing[i].state.store(Sample::kEmpty);
+    }
+    gRingDroppedSamples.store(0);
+
+    // The first backtrace initializes libunwind, which is not safe to do from a signal handler
+    void* warmup[kMaxFrames];
+    rawBacktrace(warmup, kMaxFrames);
+
+    setProfilingSignalHandler(true);
+    try {
+        setProfilingTimer(_frequencyHz);
+    } catch (const DBException&) {
+        setProfilingSignalHandler(false);
+        throw;
+    }
+
+    _thread = stdx::thread([this] {
+        setThreadName("SamplingProfiler");
+        _run();
+    });
+
+    _running.store(true);
+#endif
+}
+
+void SamplingProfiler::stop() {
+    stdx::lock_guard<Latch> controlLk(_controlMutex);
+
+    uassert(ErrorCodes::BadValue, "Profiling not active", _running.load());
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    setProfilingTimer(0);
+    setProfilingSignalHandler(false);
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stopRequested = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+
+    // Keep the final samples available to getProfile
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drain(lk);
+    _running.store(false);
+#endif
+}
+
+void SamplingProfiler::_run() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (!_stopRequested) {
+        _cv.wait_for(lk, kDrainPeriod.toSystemDuration(), [&] { return _stopRequested; });
+        _drain(lk);
+    }
+}
+
+void SamplingProfiler::_drain(WithLock) {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    if (!gRing) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < kRingSize; ++i) {
+        auto& sample = gRing[i];
+        if (sample.state.load() != Sample::kFull) {
+            continue;
+        }
+
+        auto depth = std::min(sample.depth, kMaxFrames + kSignalFrames);
+        StackKey key;
+        key.first = _roleForThread(sample.tid);
+        if (depth > kSignalFrames) {
+            key.second.assign(sample.frames + kSignalFrames, sample.frames + depth);
+        }
+        sample.state.store(Sample::kEmpty);
+
+        ++_samples;
+        ++_roleSamples[key.first];
+
+        auto it = _stacks.find(key);
+        if (it != _stacks.end()) {
+            ++it->second;
+        } else if (_stacks.size() < _maxStacks) {
+            _stacks.emplace(std::move(key), 1);
+        } else {
+            ++_overflowSamples;
+        }
+    }
+#endif
+}
+
+const std::string& SamplingProfiler::_roleForThread(int tid) {
+    auto it = _threadRoles.find(tid);
+    if (it != _threadRoles.end()) {
+        return it->second;
+    }
+
+    if (_threadRoles.size() >= kMaxCachedThreadRoles) {
+        _threadRoles.clear();
+    }
+
+    std::string threadName;
+    std::ifstream in(std::string(str::stream() << "/proc/self/task/" << tid << "/comm"));
+    std::getline(in, threadName);
+
+    return _threadRoles.emplace(tid, threadRoleFromName(std::move(threadName))).first->second;
+}
+
+const std::string& SamplingProfiler::_symbolize(void* address) {
+    auto it = _symbols.find(address);
+    if (it != _symbols.end()) {
+        return it->second;
+    }
+
+    std::string name;
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    StackTraceAddressMetadataGenerator metaGen;
+    const auto& meta = metaGen.load(address);
+    if (const auto& symbol = meta.symbol(); symbol) {
+        name = symbol.name().toString();
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+        if (demangled && status == 0) {
+            name = demangled;
+        }
+        free(demangled);
+    }
+#endif
+    if (name.empty()) {
+        name = "0x" + unsignedHex(reinterpret_cast<uintptr_t>(address));
+    }
+
+    return _symbols.emplace(address, std::move(name)).first->second;
+}
+
+SamplingProfiler::Profile SamplingProfiler::getProfile(std::size_t limit) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drain(lk);
+
+    Profile profile;
+    profile.running = _running.load();
+    profile.frequencyHz = _frequencyHz;
+    profile.samples = _samples;
+    profile.droppedSamples = _overflowSamples + gRingDroppedSamples.load();
+
+    std::vector<std::pair<const StackKey*, long long>> sorted;
+    sorted.reserve(_stacks.size());
+    for (const auto& [key, samples] : _stacks) {
+        sorted.emplace_back(&key, samples);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+    });
+    sorted.resize(std::min(sorted.size(), limit));
+
+    for (const auto& [key, samples] : sorted) {
+        // Folded stacks read from the outermost frame in, while backtraces start at the innermost
+        std::string frames;
+        for (auto frame = key->second.rbegin(); frame != key->second.rend(); ++frame) {
+            if (!frames.empty()) {
+                frames += ';';
+            }
+            frames += _symbolize(*frame);
+        }
+        profile.stacks.push_back({key->first, std::move(frames), samples});
+    }
+
+    return profile;
+}
+
+void SamplingProfiler::appendSummary(BSONObjBuilder* builder) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drain(lk);
+
+    builder->append("running", _running.load());
+    builder->append("frequencyHz", _frequencyHz);
+    builder->append("samples", _samples);
+    builder->append("droppedSamples", _overflowSamples + gRingDroppedSamples.load());
+
+    {
+        BSONObjBuilder rolesBuilder(builder->subobjStart("roles"));
+        for (const auto& [role, samples] : _roleSamples) {
+            rolesBuilder.append(role, samples);
+        }
+    }
+
+    // Self time per function, from the innermost frame of each stack
+    std::map<std::string, long long> functionSamples;
+    for (const auto& [key, samples] : _stacks) {
+        if (!key.second.empty()) {
+            functionSamples[_symbolize(key.second.front())] += samples;
+        }
+    }
+    std::vector<std::pair<std::string, long long>> topFunctions(functionSamples.begin(),
+                                                                functionSamples.end());
+    auto topEnd = topFunctions.begin() + std::min(topFunctions.size(), kSummaryTopFunctions);
+    std::partial_sort(topFunctions.begin(),
+                      topEnd,
+                      topFunctions.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+    BSONArrayBuilder topBuilder(builder->subarrayStart("topFunctions"));
+    for (auto it = topFunctions.begin(); it != topEnd; ++it) {
+        topBuilder.append(BSON("function" << it->first << "samples" << it->second));
+    }
+}
+
+class SamplingProfiler::SamplingProfilerSSS : public ServerStatusSection {
+public:
+    SamplingProfilerSSS() : ServerStatusSection("cpuProfile") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& profiler = SamplingProfiler::get();
+
+        if (!profiler._running.load()) {
+            return BSON("running" << false);
+        }
+
+        BSONObjBuilder builder;
+        profiler.appendSummary(&builder);
+        return builder.obj();
+    }
+} samplingProfilerStats;
+
+}  // namespace mongo
@@ -0,0 +1,150 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/sampling_profiler_gen.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+/**
+ * A process wide sampling CPU profiler, turned on and off via startProfiling and stopProfiling.
+ *
+ * While running, an ITIMER_PROF timer delivers SIGPROF to whichever thread is consuming CPU,
+ * frequencyHz times per second of process CPU time. The signal handler only captures a raw
+ * backtrace into a preallocated ring of samples. A background thread drains the ring, attributes
+ * each sample to a thread role derived from the thread name (conn, ReplWriterWorker, ...), and
+ * aggregates identical stacks. Symbolization is deferred until the profile is read, so the cost
+ * while running is one backtrace per sample.
+ *
+ * Only supported on platforms where backtraces can be taken from a signal handler.
+ */
+class SamplingProfiler {
+public:
+    /**
+     * The aggregated samples, most sampled stack first. Returned by getProfile.
+     */
+    struct Profile {
+        struct Stack {
+            std::string role;
+            // Function names from the outermost frame to the innermost, separated by ';'
+            std::string frames;
+            long long samples;
+        };
+
+        bool running = false;
+        int frequencyHz = 0;
+        long long samples = 0;
+        long long droppedSamples = 0;
+        std::vector<Stack> stacks;
+
+        void serialize(BSONObjBuilder* builder) const;
+    };
+
+    static SamplingProfiler& get();
+
+    /**
+     * Returns true if this platform can take backtraces from a signal handler.
+     */
+    static bool isSupported();
+
+    // Start and stop block until the associated operation has succeeded or failed
+    //
+    // On failure these methods throw
+    void start(const StartProfiling& options);
+    void stop();
+
+    /**
+     * Returns the stacks aggregated since the profiler was last started, symbolized.
+     */
+    Profile getProfile(std::size_t limit);
+
+    /**
+     * Appends sample counts per thread role and for the most sampled functions, for serverStatus
+     * and therefore FTDC.
+     */
+    void appendSummary(BSONObjBuilder* builder);
+
+private:
+    class SamplingProfilerSSS;
+
+    using StackKey = std::pair<std::string, std::vector<void*>>;
+
+    /**
+     * Move the samples captured by the signal handler into _stacks.
+     */
+    void _drain(WithLock);
+
+    /**
+     * Background thread body, drains until stop is called.
+     */
+    void _run();
+
+    const std::string& _roleForThread(int tid);
+    const std::string& _symbolize(void* address);
+
+    AtomicWord<bool> _running{false};
+
+    // Serializes start and stop
+    Mutex _controlMutex = MONGO_MAKE_LATCH("SamplingProfiler::_controlMutex");
+
+    // Guards everything below
+    Mutex _mutex = MONGO_MAKE_LATCH("SamplingProfiler::_mutex");
+    stdx::condition_variable _cv;
+    bool _stopRequested = false;
+    stdx::thread _thread;
+
+    int _frequencyHz = 0;
+    std::size_t _maxStacks = 0;
+    long long _samples = 0;
+    // Samples lost because maxStacks distinct stacks were already aggregated
+    long long _overflowSamples = 0;
+
+    std::map<StackKey, long long> _stacks;
+    std::map<std::string, long long> _roleSamples;
+
+    stdx::unordered_map<int, std::string> _threadRoles;
+    stdx::unordered_map<void*, std::string> _symbols;
+};
+
+}  // namespace mongo
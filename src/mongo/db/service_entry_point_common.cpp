@@ -46,6 +46,7 @@
 #include "mongo/db/command_can_run_here.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
+#include "mongo/db/concurrency/admission_context.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/curop_metrics.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/ops/write_ops_exec.h"
 #include "mongo/db/query/find.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/repl/optime.h"
@@ -1382,6 +1384,9 @@ Future<void> ExecCommandDatabase::_initiateCommand() try {
             helpField = element;
         } else if (fieldName == "comment") {
             opCtx->setComment(element.wrap());
+        } else if (fieldName == kAdmissionPriorityFieldName) {
+            AdmissionContext::get(opCtx).setPriority(
+                parseAdmissionPriorityField(element, _isInternalClient()));
         } else if (fieldName == QueryRequest::queryOptionMaxTimeMS) {
             uasserted(ErrorCodes::InvalidOptions,
                       "no such command option $maxTimeMs; use maxTimeMS instead");
@@ -2300,6 +2305,22 @@ Future<void> HandleRequest::completeOperation() try {
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
             currentOp.getReadWriteType());
 
+    // Operations issued through DBDirectClient share the outer operation's entry, which records
+    // the whole outer operation once it completes.
+    const auto& queryStatsEntry = QueryStatsStore::getEntry(opCtx);
+    if (queryStatsEntry && !executionContext->client().isInDirectClient()) {
+        const auto& debug = currentOp.debug();
+        QueryStatsEntry::Execution execution;
+        execution.duration = currentOp.elapsedTimeExcludingPauses();
+        execution.isGetMore = debug.logicalOp == LogicalOp::opGetMore;
+        execution.docsExamined = debug.additiveMetrics.docsExamined.value_or(0);
+        execution.keysExamined = debug.additiveMetrics.keysExamined.value_or(0);
+        execution.nreturned = std::max(debug.nreturned, 0LL);
+        execution.bytesReturned = executionContext->getResponse().response.size();
+        execution.planSummary = currentOp.getPlanSummary();
+        queryStatsEntry->record(execution);
+    }
+
     if (shouldProfile) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/collection_cache_stats.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getCollectionCacheStats = ServiceContext::declareDecoration<CollectionCacheStats>();
+
+// The engine's counters restart from zero when it reopens an ident, in which case everything it
+// reports has happened since the previous sample.
+long long growth(long long previous, long long current) {
+    return current >= previous ? current - previous : current;
+}
+
+CollectionCacheStats::Counters growth(const CollectionCacheStats::Counters& previous,
+                                      const CollectionCacheStats::Counters& current) {
+    CollectionCacheStats::Counters result;
+    result.bytesReadIntoCache = growth(previous.bytesReadIntoCache, current.bytesReadIntoCache);
+    result.pagesReadIntoCache = growth(previous.pagesReadIntoCache, current.pagesReadIntoCache);
+    result.unmodifiedPagesEvicted =
+        growth(previous.unmodifiedPagesEvicted, current.unmodifiedPagesEvicted);
+    result.modifiedPagesEvicted =
+        growth(previous.modifiedPagesEvicted, current.modifiedPagesEvicted);
+    return result;
+}
+
+}  // namespace
+
+void CollectionCacheStats::Counters::add(const Counters& other) {
+    bytesReadIntoCache += other.bytesReadIntoCache;
+    pagesReadIntoCache += other.pagesReadIntoCache;
+    unmodifiedPagesEvicted += other.unmodifiedPagesEvicted;
+    modifiedPagesEvicted += other.modifiedPagesEvicted;
+}
+
+void CollectionCacheStats::Counters::append(BSONObjBuilder* builder) const {
+    builder->append("bytesReadIntoCache", bytesReadIntoCache);
+    builder->append("pagesReadIntoCache", pagesReadIntoCache);
+    builder->append("unmodifiedPagesEvicted", unmodifiedPagesEvicted);
+    builder->append("modifiedPagesEvicted", modifiedPagesEvicted);
+}
+
+CollectionCacheStats& CollectionCacheStats::get(ServiceContext* service) {
+    return getCollectionCacheStats(service);
+}
+
+void CollectionCacheStats::update(const std::vector<NamespaceString>& sampledNamespaces,
+                                  std::vector<Sample> samples,
+                                  Date_t sampledAt,
+                                  size_t maxEntries) {
+    const std::set<NamespaceString> sampled(sampledNamespaces.begin(), sampledNamespaces.end());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // Set aside the entries of the sampled namespaces, so that idents which are not reported
+    // anymore are dropped.
+    StringMap<Entry> previous;
+    for (auto&& [ident, entry] : _entries) {
+        if (sampled.count(entry.sample.nss)) {
+            previous.emplace(ident, std::move(entry));
+        }
+    }
+    for (auto&& [ident, entry] : previous) {
+        _entries.erase(ident);
+    }
+
+    for (auto&& sample : samples) {
+        Entry entry;
+        auto it = previous.find(sample.ident);
+        if (it != previous.end()) {
+            entry.recent = growth(it->second.sample.counters, sample.counters);
+            entry.total = it->second.total;
+        } else {
+            entry.recent = sample.counters;
+        }
+        entry.total.add(entry.recent);
+        entry.sample = std::move(sample);
+        entry.sampledAt = sampledAt;
+
+        auto ident = entry.sample.ident;
+        _entries[ident] = std::move(entry);
+    }
+
+    if (_entries.size() > maxEntries) {
+        std::vector<std::pair<long long, std::string>> bySize;
+        bySize.reserve(_entries.size());
+        for (auto&& [ident, entry] : _entries) {
+            bySize.emplace_back(entry.sample.bytesInCache, ident);
+        }
+        std::nth_element(bySize.begin(),
+                         bySize.begin() + maxEntries,
+                         bySize.end(),
+                         [](auto&& lhs, auto&& rhs) { return lhs.first > rhs.first; });
+        for (auto it = bySize.begin() + maxEntries; it != bySize.end(); ++it) {
+            _entries.erase(it->second);
+        }
+    }
+}
+
+void CollectionCacheStats::appendCollectionStats(const NamespaceString& nss,
+                                                 BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    const Entry* collection = nullptr;
+    std::map<std::string, const Entry*> indexes;
+    long long bytesInCache = 0;
+    Date_t sampledAt;
+    for (auto&& [ident, entry] : _entries) {
+        if (entry.sample.nss != nss) {
+            continue;
+        }
+        bytesInCache += entry.sample.bytesInCache;
+        sampledAt = entry.sampledAt;
+        if (entry.sample.indexName.empty()) {
+            collection = &entry;
+        } else {
+            indexes.emplace(entry.sample.indexName, &entry);
+        }
+    }
+
+    auto appendEntry = [](const Entry& entry, BSONObjBuilder* entryBuilder) {
+        entryBuilder->append("bytesInCache", entry.sample.bytesInCache);
+        entry.total.append(entryBuilder);
+        BSONObjBuilder recentBuilder(entryBuilder->subobjStart("recent"));
+        entry.recent.append(&recentBuilder);
+    };
+
+    BSONObjBuilder cacheBuilder(builder->subobjStart("cacheStats"));
+    if (sampledAt != Date_t()) {
+        cacheBuilder.appendDate("sampledAt", sampledAt);
+    }
+    cacheBuilder.append("bytesInCache", bytesInCache);
+    if (collection) {
+        BSONObjBuilder collectionBuilder(cacheBuilder.subobjStart("collection"));
+        appendEntry(*collection, &collectionBuilder);
+    }
+    if (!indexes.empty()) {
+        BSONObjBuilder indexesBuilder(cacheBuilder.subobjStart("indexes"));
+        for (auto&& [indexName, entry] : indexes) {
+            BSONObjBuilder indexBuilder(indexesBuilder.subobjStart(indexName));
+            appendEntry(*entry, &indexBuilder);
+        }
+    }
+}
+
+void CollectionCacheStats::appendSummary(size_t topCount, BSONObjBuilder* builder) const {
+    struct CollectionTotals {
+        long long bytesInCache = 0;
+        Counters total;
+    };
+
+    std::map<NamespaceString, CollectionTotals> collections;
+    CollectionTotals overall;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        builder->append("trackedIdents", static_cast<long long>(_entries.size()));
+        for (auto&& [ident, entry] : _entries) {
+            auto& totals = collections[entry.sample.nss];
+            totals.bytesInCache += entry.sample.bytesInCache;
+            totals.total.add(entry.total);
+            overall.bytesInCache += entry.sample.bytesInCache;
+            overall.total.add(entry.total);
+        }
+    }
+    builder->append("trackedCollections", static_cast<long long>(collections.size()));
+    builder->append("bytesInCache", overall.bytesInCache);
+    overall.total.append(builder);
+
+    std::vector<CollectionTotals> top;
+    top.reserve(collections.size());
+    for (auto&& [nss, totals] : collections) {
+        top.push_back(totals);
+    }
+    auto largestFirst = [](auto&& lhs, auto&& rhs) { return lhs.bytesInCache > rhs.bytesInCache; };
+    if (top.size() > topCount) {
+        std::nth_element(top.begin(), top.begin() + topCount, top.end(), largestFirst);
+        top.resize(topCount);
+    }
+    std::sort(top.begin(), top.end(), largestFirst);
+    top.resize(topCount);
+
+    BSONArrayBuilder topBuilder(builder->subarrayStart("topCollections"));
+    for (auto&& totals : top) {
+        BSONObjBuilder collectionBuilder(topBuilder.subobjStart());
+        collectionBuilder.append("bytesInCache", totals.bytesInCache);
+        totals.total.append(&collectionBuilder);
+    }
+}
+
+}  // namespace mongo
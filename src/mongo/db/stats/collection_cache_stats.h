@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Bounded table of the storage engine cache usage of collections and indexes, filled in by a
+ * periodic sampler of recently used collections and read by $collStats and the diagnostic data
+ * collector. Tracking this per ident shows which collections fill the cache and which ones
+ * repeatedly read pages back into it after they were evicted.
+ */
+class CollectionCacheStats {
+public:
+    struct Counters {
+        long long bytesReadIntoCache = 0;
+        long long pagesReadIntoCache = 0;
+        long long unmodifiedPagesEvicted = 0;
+        long long modifiedPagesEvicted = 0;
+
+        void add(const Counters& other);
+        void append(BSONObjBuilder* builder) const;
+    };
+
+    /**
+     * What the storage engine reported for one ident. The counters are cumulative since the
+     * engine last reset them.
+     */
+    struct Sample {
+        std::string ident;
+        NamespaceString nss;
+        // Empty for the collection's record store.
+        std::string indexName;
+        long long bytesInCache = 0;
+        Counters counters;
+    };
+
+    static CollectionCacheStats& get(ServiceContext* service);
+
+    /**
+     * Replaces what the table holds for 'sampledNamespaces' with 'samples', the samples of their
+     * idents taken at 'sampledAt'. The entries of other namespaces are kept. Only the 'maxEntries'
+     * idents with the most bytes in cache are kept overall.
+     */
+    void update(const std::vector<NamespaceString>& sampledNamespaces,
+                std::vector<Sample> samples,
+                Date_t sampledAt,
+                size_t maxEntries);
+
+    /**
+     * Appends a 'cacheStats' document for the collection 'nss' and its indexes.
+     */
+    void appendCollectionStats(const NamespaceString& nss, BSONObjBuilder* builder) const;
+
+    /**
+     * Appends the totals over all tracked idents, and an array of the totals of the 'topCount'
+     * collections, indexes included, with the most bytes in cache, largest first. Namespaces are
+     * left out, and the array is padded with zeroed entries so that its shape never changes.
+     */
+    void appendSummary(size_t topCount, BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        Sample sample;
+        // The growth of the counters over all samples taken while the ident was tracked, which
+        // unlike the engine's counters never goes back, and over the last sampling interval. An
+        // ident seen for the first time contributes everything the engine counted for it so far.
+        Counters total;
+        Counters recent;
+        Date_t sampledAt;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CollectionCacheStats::_mutex");
+    StringMap<Entry> _entries;
+};
+
+}  // namespace mongo
@@ -0,0 +1,204 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/collection_cache_stats_sampler.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/stats/collection_cache_stats.h"
+#include "mongo/db/stats/collection_cache_stats_sampler_gen.h"
+#include "mongo/db/stats/top.h"
+#include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getSampler = ServiceContext::declareDecoration<CollectionCacheStatsSampler>();
+
+}  // namespace
+
+CollectionCacheStatsSampler& CollectionCacheStatsSampler::get(ServiceContext* serviceContext) {
+    auto& sampler = getSampler(serviceContext);
+    sampler._init(serviceContext);
+    return sampler;
+}
+
+void CollectionCacheStatsSampler::sample(OperationContext* opCtx) {
+    auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    if (!storageEngine || !storageEngine->getEngine()) {
+        return;
+    }
+    auto engine = storageEngine->getEngine();
+
+    // Pick the namespaces with the most operations since they were last sampled. Those which Top
+    // stopped tracking were dropped, and their entries are removed from the table.
+    Top::UsageMap usage;
+    Top::get(opCtx->getServiceContext()).cloneMap(usage);
+
+    std::vector<std::pair<long long, std::string>> used;
+    for (auto&& [ns, data] : usage) {
+        auto it = _lastSampledUseCounts.find(ns);
+        auto uses = data.total.count - (it != _lastSampledUseCounts.end() ? it->second : 0);
+        if (uses > 0) {
+            used.emplace_back(uses, ns);
+        }
+    }
+    std::vector<NamespaceString> sampledNamespaces;
+    for (auto it = _lastSampledUseCounts.begin(); it != _lastSampledUseCounts.end();) {
+        if (!usage.count(it->first)) {
+            sampledNamespaces.emplace_back(it->first);
+            _lastSampledUseCounts.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+
+    const auto maxCollections =
+        static_cast<size_t>(gCollectionCacheStatsMaxCollectionsPerPass.load());
+    auto busiestFirst = [](auto&& lhs, auto&& rhs) { return lhs.first > rhs.first; };
+    if (used.size() > maxCollections) {
+        std::nth_element(used.begin(), used.begin() + maxCollections, used.end(), busiestFirst);
+        used.resize(maxCollections);
+    }
+
+    // Never queue behind an exclusive lock, the collection is sampled again next time.
+    opCtx->lockState()->setMaxLockTimeout(Milliseconds(0));
+
+    std::vector<CollectionCacheStats::Sample> samples;
+    auto addSample = [&](const std::string& ident,
+                         const NamespaceString& nss,
+                         const std::string& indexName) {
+        auto stats = engine->getIdentCacheStats(opCtx, ident);
+        if (!stats) {
+            return;
+        }
+
+        CollectionCacheStats::Sample sample;
+        sample.ident = ident;
+        sample.nss = nss;
+        sample.indexName = indexName;
+        sample.bytesInCache = stats->bytesInCache;
+        sample.counters.bytesReadIntoCache = stats->bytesReadIntoCache;
+        sample.counters.pagesReadIntoCache = stats->pagesReadIntoCache;
+        sample.counters.unmodifiedPagesEvicted = stats->unmodifiedPagesEvicted;
+        sample.counters.modifiedPagesEvicted = stats->modifiedPagesEvicted;
+        samples.push_back(std::move(sample));
+    };
+
+    for (auto&& [uses, ns] : used) {
+        NamespaceString nss(ns);
+        if (!nss.isValid()) {
+            continue;
+        }
+
+        try {
+            AutoGetCollection collection(opCtx, nss, MODE_IS);
+            sampledNamespaces.push_back(nss);
+            _lastSampledUseCounts[ns] = usage[ns].total.count;
+            if (!collection) {
+                continue;
+            }
+
+            addSample(collection->getRecordStore()->getIdent(), nss, "");
+            auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, true);
+            while (it->more()) {
+                auto entry = it->next();
+                addSample(entry->getIdent(), nss, entry->descriptor()->indexName());
+            }
+        } catch (const ExceptionFor<ErrorCodes::LockTimeout>&) {
+        } catch (const ExceptionFor<ErrorCodes::CommandNotSupportedOnView>&) {
+            // Views have no storage of their own.
+            _lastSampledUseCounts[ns] = usage[ns].total.count;
+        }
+    }
+
+    CollectionCacheStats::get(opCtx->getServiceContext())
+        .update(sampledNamespaces,
+                std::move(samples),
+                opCtx->getServiceContext()->getFastClockSource()->now(),
+                static_cast<size_t>(gCollectionCacheStatsMaxEntries.load()));
+}
+
+auto CollectionCacheStatsSampler::operator*() const noexcept -> PeriodicJobAnchor& {
+    stdx::lock_guard lk(_mutex);
+    return *_anchor;
+}
+
+auto CollectionCacheStatsSampler::operator-> () const noexcept -> PeriodicJobAnchor* {
+    stdx::lock_guard lk(_mutex);
+    return _anchor.get();
+}
+
+void CollectionCacheStatsSampler::_init(ServiceContext* serviceContext) {
+    stdx::lock_guard lk(_mutex);
+    if (_anchor) {
+        return;
+    }
+
+    auto periodicRunner = serviceContext->getPeriodicRunner();
+    invariant(periodicRunner);
+
+    // The job wakes up every second so that changes to the sampling interval apply right away.
+    PeriodicRunner::PeriodicJob job(
+        "sampleCollectionCacheStats",
+        [lastSample = Date_t()](Client* client) mutable {
+            const auto interval = Seconds(gCollectionCacheStatsSampleIntervalSecs.load());
+            const auto now = client->getServiceContext()->getFastClockSource()->now();
+            if (interval <= Seconds(0) || now - lastSample < interval) {
+                return;
+            }
+            lastSample = now;
+
+            auto opCtx = client->makeOperationContext();
+            try {
+                CollectionCacheStatsSampler::get(client->getServiceContext()).sample(opCtx.get());
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(5986703,
+                            2,
+                            "Failed to sample collection cache usage",
+                            "error"_attr = ex.toStatus());
+            }
+        },
+        Seconds(1));
+
+    _anchor = std::make_shared<PeriodicJobAnchor>(periodicRunner->makeJob(std::move(job)));
+}
+
+}  // namespace mongo
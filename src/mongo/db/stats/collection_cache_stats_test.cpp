@@ -0,0 +1,188 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/collection_cache_stats.h"
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+CollectionCacheStats::Sample makeSample(StringData ident,
+                                        StringData ns,
+                                        StringData indexName,
+                                        long long bytesInCache,
+                                        long long pagesRead) {
+    CollectionCacheStats::Sample sample;
+    sample.ident = ident.toString();
+    sample.nss = NamespaceString(ns);
+    sample.indexName = indexName.toString();
+    sample.bytesInCache = bytesInCache;
+    sample.counters.pagesReadIntoCache = pagesRead;
+    return sample;
+}
+
+BSONObj collectionStats(const CollectionCacheStats& stats, StringData ns) {
+    BSONObjBuilder builder;
+    stats.appendCollectionStats(NamespaceString(ns), &builder);
+    return builder.obj().getObjectField("cacheStats").getOwned();
+}
+
+std::vector<NamespaceString> namespaces(std::initializer_list<StringData> nsList) {
+    std::vector<NamespaceString> result;
+    for (auto&& ns : nsList) {
+        result.emplace_back(ns);
+    }
+    return result;
+}
+
+TEST(CollectionCacheStatsTest, AttributesIdentsToTheirCollection) {
+    CollectionCacheStats stats;
+    stats.update(namespaces({"test.a", "test.b"}),
+                 {makeSample("collection-1", "test.a", "", 100, 1),
+                  makeSample("index-2", "test.a", "_id_", 20, 2),
+                  makeSample("collection-3", "test.b", "", 7, 3)},
+                 Date_t::fromMillisSinceEpoch(1000),
+                 10);
+
+    auto a = collectionStats(stats, "test.a");
+    ASSERT_EQ(a["sampledAt"].date(), Date_t::fromMillisSinceEpoch(1000));
+    ASSERT_EQ(a["bytesInCache"].numberLong(), 120);
+    ASSERT_EQ(a["collection"]["bytesInCache"].numberLong(), 100);
+    ASSERT_EQ(a["indexes"]["_id_"]["pagesReadIntoCache"].numberLong(), 2);
+
+    auto missing = collectionStats(stats, "test.c");
+    ASSERT_FALSE(missing.hasField("sampledAt"));
+    ASSERT_EQ(missing["bytesInCache"].numberLong(), 0);
+    ASSERT_FALSE(missing.hasField("collection"));
+}
+
+TEST(CollectionCacheStatsTest, RecentCountersSurviveEngineResets) {
+    CollectionCacheStats stats;
+    const auto a = namespaces({"test.a"});
+    stats.update(a, {makeSample("collection-1", "test.a", "", 100, 10)}, Date_t(), 10);
+    stats.update(a, {makeSample("collection-1", "test.a", "", 100, 15)}, Date_t(), 10);
+
+    auto collection = collectionStats(stats, "test.a")["collection"].Obj();
+    ASSERT_EQ(collection["pagesReadIntoCache"].numberLong(), 15);
+    ASSERT_EQ(collection["recent"]["pagesReadIntoCache"].numberLong(), 5);
+
+    // The engine reopened the ident and started counting from zero again.
+    stats.update(a, {makeSample("collection-1", "test.a", "", 100, 4)}, Date_t(), 10);
+    collection = collectionStats(stats, "test.a")["collection"].Obj();
+    ASSERT_EQ(collection["pagesReadIntoCache"].numberLong(), 19);
+    ASSERT_EQ(collection["recent"]["pagesReadIntoCache"].numberLong(), 4);
+}
+
+TEST(CollectionCacheStatsTest, KeepsNamespacesWhichWereNotSampled) {
+    CollectionCacheStats stats;
+    stats.update(namespaces({"test.a", "test.b"}),
+                 {makeSample("collection-1", "test.a", "", 100, 1),
+                  makeSample("index-2", "test.a", "_id_", 20, 2),
+                  makeSample("collection-3", "test.b", "", 7, 3)},
+                 Date_t::fromMillisSinceEpoch(1000),
+                 10);
+
+    // The index of test.a was dropped, and test.b was not used.
+    stats.update(namespaces({"test.a"}),
+                 {makeSample("collection-1", "test.a", "", 50, 1)},
+                 Date_t::fromMillisSinceEpoch(2000),
+                 10);
+
+    auto a = collectionStats(stats, "test.a");
+    ASSERT_EQ(a["sampledAt"].date(), Date_t::fromMillisSinceEpoch(2000));
+    ASSERT_EQ(a["bytesInCache"].numberLong(), 50);
+    ASSERT_FALSE(a.hasField("indexes"));
+
+    auto b = collectionStats(stats, "test.b");
+    ASSERT_EQ(b["sampledAt"].date(), Date_t::fromMillisSinceEpoch(1000));
+    ASSERT_EQ(b["bytesInCache"].numberLong(), 7);
+
+    // test.b was dropped.
+    stats.update(namespaces({"test.b"}), {}, Date_t::fromMillisSinceEpoch(3000), 10);
+    ASSERT_FALSE(collectionStats(stats, "test.b").hasField("collection"));
+    ASSERT_EQ(collectionStats(stats, "test.a")["bytesInCache"].numberLong(), 50);
+}
+
+TEST(CollectionCacheStatsTest, KeepsTheIdentsWithTheMostBytesInCache) {
+    CollectionCacheStats stats;
+    stats.update(namespaces({"test.a", "test.b"}),
+                 {makeSample("collection-1", "test.a", "", 1, 0),
+                  makeSample("collection-2", "test.b", "", 3, 0)},
+                 Date_t(),
+                 2);
+    stats.update(
+        namespaces({"test.c"}), {makeSample("collection-3", "test.c", "", 2, 0)}, Date_t(), 2);
+
+    ASSERT_FALSE(collectionStats(stats, "test.a").hasField("collection"));
+    ASSERT(collectionStats(stats, "test.b").hasField("collection"));
+    ASSERT(collectionStats(stats, "test.c").hasField("collection"));
+}
+
+TEST(CollectionCacheStatsTest, SummaryRanksCollectionsWithoutNamingThem) {
+    CollectionCacheStats stats;
+    stats.update(namespaces({"test.z", "test.m", "test.a"}),
+                 {makeSample("collection-1", "test.z", "", 5, 1),
+                  makeSample("index-2", "test.z", "a_1", 5, 2),
+                  makeSample("collection-3", "test.m", "", 9, 4),
+                  makeSample("collection-4", "test.a", "", 1, 8)},
+                 Date_t(),
+                 10);
+
+    BSONObjBuilder builder;
+    stats.appendSummary(4, &builder);
+    auto summary = builder.obj();
+    ASSERT_EQ(summary["trackedIdents"].numberLong(), 4);
+    ASSERT_EQ(summary["trackedCollections"].numberLong(), 3);
+    ASSERT_EQ(summary["bytesInCache"].numberLong(), 20);
+    ASSERT_EQ(summary["pagesReadIntoCache"].numberLong(), 15);
+
+    // The array always has as many entries, padded with zeroes.
+    auto top = summary["topCollections"].Array();
+    ASSERT_EQ(top.size(), 4U);
+    ASSERT_EQ(top[0]["bytesInCache"].numberLong(), 10);
+    ASSERT_EQ(top[0]["pagesReadIntoCache"].numberLong(), 3);
+    ASSERT_EQ(top[1]["bytesInCache"].numberLong(), 9);
+    ASSERT_EQ(top[2]["bytesInCache"].numberLong(), 1);
+    ASSERT_EQ(top[3]["bytesInCache"].numberLong(), 0);
+    ASSERT_EQ(summary.toString().find("test."), std::string::npos);
+
+    BSONObjBuilder limitedBuilder;
+    stats.appendSummary(1, &limitedBuilder);
+    auto limitedTop = limitedBuilder.obj()["topCollections"].Array();
+    ASSERT_EQ(limitedTop.size(), 1U);
+    ASSERT_EQ(limitedTop[0]["bytesInCache"].numberLong(), 10);
+}
+
+}  // namespace
+}  // namespace mongo
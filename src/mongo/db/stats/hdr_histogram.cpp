@@ -0,0 +1,205 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_histogram.h"
+
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+namespace {
+// Percentiles reported by append(), with the field names they are reported under.
+const std::pair<double, const char*> kReportedPercentiles[] = {
+    {50.0, "p50"}, {90.0, "p90"}, {99.0, "p99"}, {99.9, "p99_9"}, {99.99, "p99_99"}};
+}  // namespace
+
+HdrHistogram::HdrHistogram(int significantDigits) : _significantDigits(significantDigits) {
+    invariant(significantDigits > 0 && significantDigits <= kMaxSignificantDigits);
+
+    // Buckets of width 1 are needed up to 2 * 10^significantDigits so that the relative error of
+    // every bucket, its width divided by its lower bound, stays below 10^-significantDigits.
+    const uint64_t exactLimit = 2 * static_cast<uint64_t>(std::pow(10, significantDigits));
+    _subBucketBits = 64 - countLeadingZeros64(exactLimit - 1);
+    _bands.resize(64 - _subBucketBits + 1);
+}
+
+HdrHistogram::Position HdrHistogram::_positionOf(uint64_t value) const {
+    if (value < (1ULL << _subBucketBits)) {
+        return {0, static_cast<size_t>(value)};
+    }
+    const int log2 = 63 - countLeadingZeros64(value);
+    const size_t band = log2 - _subBucketBits + 1;
+    return {band, static_cast<size_t>((value >> band) - (1ULL << (_subBucketBits - 1)))};
+}
+
+uint64_t HdrHistogram::_lowestEquivalentValue(Position pos) const {
+    if (pos.band == 0) {
+        return pos.index;
+    }
+    return (pos.index + (1ULL << (_subBucketBits - 1))) << pos.band;
+}
+
+uint64_t HdrHistogram::_highestEquivalentValue(Position pos) const {
+    if (pos.band == 0) {
+        return pos.index;
+    }
+    return _lowestEquivalentValue(pos) + ((1ULL << pos.band) - 1);
+}
+
+void HdrHistogram::recordMultiple(uint64_t value, uint64_t count) {
+    if (!isEnabled() || count == 0) {
+        return;
+    }
+
+    const auto pos = _positionOf(value);
+    auto& band = _bands[pos.band];
+    if (band.empty()) {
+        band.resize(pos.band == 0 ? (1ULL << _subBucketBits) : (1ULL << (_subBucketBits - 1)));
+    }
+    band[pos.index] += count;
+    _count += count;
+    _sum += value * count;
+    _max = std::max(_max, value);
+}
+
+void HdrHistogram::add(const HdrHistogram& other) {
+    if (!other.isEnabled()) {
+        return;
+    }
+    if (!isEnabled()) {
+        *this = other;
+        return;
+    }
+    invariant(_significantDigits == other._significantDigits);
+
+    for (size_t i = 0; i < other._bands.size(); ++i) {
+        const auto& from = other._bands[i];
+        if (from.empty()) {
+            continue;
+        }
+        auto& to = _bands[i];
+        if (to.empty()) {
+            to = from;
+            continue;
+        }
+        for (size_t j = 0; j < from.size(); ++j) {
+            to[j] += from[j];
+        }
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _max = std::max(_max, other._max);
+}
+
+uint64_t HdrHistogram::valueAtPercentile(double percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    const auto rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(std::min(percentile, 100.0) / 100.0 * _count)));
+    uint64_t seen = 0;
+    for (size_t band = 0; band < _bands.size(); ++band) {
+        for (size_t index = 0; index < _bands[band].size(); ++index) {
+            seen += _bands[band][index];
+            if (seen >= rank) {
+                return std::min(_highestEquivalentValue({band, index}), _max);
+            }
+        }
+    }
+    return _max;
+}
+
+void HdrHistogram::append(bool includeBuckets, BSONObjBuilder* builder) const {
+    builder->append("significantDigits", _significantDigits);
+    builder->append("count", static_cast<long long>(_count));
+    builder->append("sum", static_cast<long long>(_sum));
+    builder->append("max", static_cast<long long>(_max));
+    for (const auto& [percentile, name] : kReportedPercentiles) {
+        builder->append(name, static_cast<long long>(valueAtPercentile(percentile)));
+    }
+
+    if (includeBuckets) {
+        BSONArrayBuilder bucketsBuilder(builder->subarrayStart("buckets"));
+        for (size_t band = 0; band < _bands.size(); ++band) {
+            for (size_t index = 0; index < _bands[band].size(); ++index) {
+                if (_bands[band][index] == 0) {
+                    continue;
+                }
+                BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+                bucketBuilder.append("lowerBound",
+                                     static_cast<long long>(_lowestEquivalentValue({band, index})));
+                bucketBuilder.append("count", static_cast<long long>(_bands[band][index]));
+                bucketBuilder.doneFast();
+            }
+        }
+        bucketsBuilder.doneFast();
+    }
+}
+
+StatusWith<HdrHistogram> HdrHistogram::parse(const BSONObj& obj) {
+    const auto digits = obj["significantDigits"];
+    if (!digits.isNumber() || digits.numberInt() < 1 ||
+        digits.numberInt() > kMaxSignificantDigits) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Invalid histogram significantDigits: " << digits};
+    }
+    const auto buckets = obj["buckets"];
+    if (buckets.type() != Array) {
+        return {ErrorCodes::BadValue, "Histogram buckets must be an array"};
+    }
+
+    HdrHistogram histogram(digits.numberInt());
+    for (const auto& bucket : buckets.Obj()) {
+        if (bucket.type() != Object || !bucket["lowerBound"].isNumber() ||
+            !bucket["count"].isNumber() || bucket["lowerBound"].safeNumberLong() < 0 ||
+            bucket["count"].safeNumberLong() < 0) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Invalid histogram bucket: " << bucket};
+        }
+        histogram.recordMultiple(bucket["lowerBound"].safeNumberLong(),
+                                 bucket["count"].safeNumberLong());
+    }
+
+    // The buckets only keep the lower bound of the values, the exact sum and maximum are reported
+    // separately.
+    histogram._sum = obj["sum"].safeNumberLong();
+    histogram._max = std::max(histogram._max, static_cast<uint64_t>(obj["max"].safeNumberLong()));
+    return histogram;
+}
+
+}  // namespace mongo
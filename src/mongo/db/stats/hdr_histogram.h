@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A high dynamic range histogram of non-negative integer values. Values are recorded with a
+ * relative error of at most 10^-significantDigits: values below 2 * 10^significantDigits are
+ * counted exactly, and above that every power of two is split into equally sized buckets. The
+ * buckets of each power of two are only allocated once a value falls into it.
+ *
+ * Histograms with the same number of significant digits can be merged without losing precision,
+ * including from their BSON form, so histograms reported by several processes can be combined.
+ *
+ * A default-constructed histogram is disabled and ignores recorded values.
+ *
+ * Note: This class is not thread-safe.
+ */
+class HdrHistogram {
+public:
+    static constexpr int kMaxSignificantDigits = 3;
+
+    HdrHistogram() = default;
+    explicit HdrHistogram(int significantDigits);
+
+    /**
+     * Parses a histogram from the output of append() with includeBuckets set.
+     */
+    static StatusWith<HdrHistogram> parse(const BSONObj& obj);
+
+    bool isEnabled() const {
+        return _significantDigits > 0;
+    }
+
+    int significantDigits() const {
+        return _significantDigits;
+    }
+
+    uint64_t count() const {
+        return _count;
+    }
+
+    uint64_t sum() const {
+        return _sum;
+    }
+
+    uint64_t max() const {
+        return _max;
+    }
+
+    void record(uint64_t value) {
+        recordMultiple(value, 1);
+    }
+
+    void recordMultiple(uint64_t value, uint64_t count);
+
+    /**
+     * Adds the values recorded by 'other'. A disabled histogram takes on the precision of
+     * 'other'; otherwise both must have the same number of significant digits.
+     */
+    void add(const HdrHistogram& other);
+
+    /**
+     * Returns the largest value that is equivalent, within the histogram's precision, to the value
+     * below which 'percentile' percent of the recorded values fall. Returns 0 if nothing was
+     * recorded.
+     */
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /**
+     * Appends the count, sum, maximum and a fixed set of percentiles and, if requested, the
+     * non-empty buckets as {lowerBound, count} documents.
+     */
+    void append(bool includeBuckets, BSONObjBuilder* builder) const;
+
+private:
+    struct Position {
+        size_t band;
+        size_t index;
+    };
+
+    Position _positionOf(uint64_t value) const;
+    uint64_t _lowestEquivalentValue(Position pos) const;
+    uint64_t _highestEquivalentValue(Position pos) const;
+
+    int _significantDigits = 0;
+
+    // Band 0 counts values below 2^_subBucketBits exactly. Band n > 0 covers
+    // [2^(_subBucketBits + n - 1), 2^(_subBucketBits + n)) with 2^(_subBucketBits - 1) buckets
+    // of width 2^n. Bands are left empty until a value falls into them.
+    int _subBucketBits = 0;
+    std::vector<std::vector<uint64_t>> _bands;
+
+    uint64_t _count = 0;
+    uint64_t _sum = 0;
+    uint64_t _max = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_histogram.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj toBSON(const HdrHistogram& histogram) {
+    BSONObjBuilder builder;
+    histogram.append(true, &builder);
+    return builder.obj();
+}
+
+TEST(HdrHistogramTest, DisabledHistogramIgnoresValues) {
+    HdrHistogram histogram;
+    ASSERT_FALSE(histogram.isEnabled());
+    histogram.record(10);
+    ASSERT_EQ(histogram.count(), 0U);
+    ASSERT_EQ(histogram.valueAtPercentile(50), 0U);
+}
+
+TEST(HdrHistogramTest, SmallValuesAreExact) {
+    HdrHistogram histogram(2);
+    for (uint64_t i = 1; i <= 100; ++i) {
+        histogram.record(i);
+    }
+    ASSERT_EQ(histogram.count(), 100U);
+    ASSERT_EQ(histogram.sum(), 5050U);
+    ASSERT_EQ(histogram.max(), 100U);
+    ASSERT_EQ(histogram.valueAtPercentile(50), 50U);
+    ASSERT_EQ(histogram.valueAtPercentile(99), 99U);
+    ASSERT_EQ(histogram.valueAtPercentile(99.9), 100U);
+    ASSERT_EQ(histogram.valueAtPercentile(100), 100U);
+}
+
+TEST(HdrHistogramTest, LargeValuesStayWithinPrecision) {
+    for (int digits = 1; digits <= HdrHistogram::kMaxSignificantDigits; ++digits) {
+        const double maxRelativeError = std::pow(10, -digits);
+        for (uint64_t value = 1; value < (1ULL << 50); value = value * 3 + 1) {
+            HdrHistogram histogram(digits);
+            histogram.record(value);
+            histogram.record(std::numeric_limits<uint64_t>::max());
+            const auto reported = histogram.valueAtPercentile(50);
+            ASSERT_GTE(reported, value);
+            ASSERT_LTE(static_cast<double>(reported - value) / value, maxRelativeError)
+                << "digits: " << digits << ", value: " << value << ", reported: " << reported;
+        }
+    }
+}
+
+TEST(HdrHistogramTest, AddMergesHistograms) {
+    HdrHistogram first(2);
+    HdrHistogram second(2);
+    HdrHistogram all(2);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        (i % 2 ? first : second).record(i * 37);
+        all.record(i * 37);
+    }
+
+    HdrHistogram merged;
+    merged.add(first);
+    merged.add(second);
+    ASSERT_EQ(merged.significantDigits(), 2);
+    ASSERT_BSONOBJ_EQ(toBSON(merged), toBSON(all));
+}
+
+TEST(HdrHistogramTest, ParseRoundTripsForMerging) {
+    HdrHistogram histogram(3);
+    for (uint64_t i = 0; i < 500; ++i) {
+        histogram.record(i * i * 11);
+    }
+
+    auto parsed = HdrHistogram::parse(toBSON(histogram));
+    ASSERT_OK(parsed.getStatus());
+    ASSERT_BSONOBJ_EQ(toBSON(parsed.getValue()), toBSON(histogram));
+
+    // Histograms reported by different processes can be merged from their BSON form.
+    HdrHistogram merged = parsed.getValue();
+    merged.add(histogram);
+    ASSERT_EQ(merged.count(), 2 * histogram.count());
+    ASSERT_EQ(merged.sum(), 2 * histogram.sum());
+    ASSERT_EQ(merged.valueAtPercentile(99), histogram.valueAtPercentile(99));
+}
+
+TEST(HdrHistogramTest, ParseRejectsInvalidHistograms) {
+    ASSERT_NOT_OK(HdrHistogram::parse(BSON("significantDigits" << 0 << "buckets" << BSONArray()))
+                      .getStatus());
+    ASSERT_NOT_OK(HdrHistogram::parse(BSON("significantDigits" << 2)).getStatus());
+    ASSERT_NOT_OK(HdrHistogram::parse(BSON("significantDigits"
+                                           << 2 << "buckets"
+                                           << BSON_ARRAY(BSON("lowerBound" << -1 << "count" << 1))))
+                      .getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/db/stats/wait_latency_metrics.h"
 
 namespace mongo {
 namespace {
@@ -60,5 +61,27 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the high-resolution histograms of time spent waiting, when they are enabled.
+ */
+class WaitLatencyServerStatusSection final : public ServerStatusSection {
+public:
+    WaitLatencyServerStatusSection() : ServerStatusSection("waitLatencies") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder waitLatencyBuilder;
+        bool includeHistograms = false;
+        if (configElem.type() == BSONType::Object) {
+            includeHistograms = configElem.Obj()["histograms"].trueValue();
+        }
+        WaitLatencyMetrics::get().append(includeHistograms, &waitLatencyBuilder);
+        return waitLatencyBuilder.obj();
+    }
+} waitLatencyServerStatusSection;
 }  // namespace
 }  // namespace mongo
@@ -50,6 +50,11 @@ public:
         return true;
     }
 
+    Milliseconds updateInterval() const override {
+        // Locks every client in turn.
+        return Milliseconds(500);
+    }
+
     BSONObj generateSection(OperationContext* opCtx,
                             const BSONElement& configElement) const override {
         std::valarray<int> clientStatusCounts(5);
@@ -113,6 +118,11 @@ public:
         return true;
     }
 
+    Milliseconds updateInterval() const override {
+        // Sums the lock statistics of every lock manager partition.
+        return Milliseconds(500);
+    }
+
     BSONObj generateSection(OperationContext* opCtx,
                             const BSONElement& configElement) const override {
         BSONObjBuilder ret;
@@ -35,6 +35,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/hdr_histogram_gen.h"
 #include "mongo/platform/bits.h"
 
 namespace mongo {
@@ -92,10 +93,61 @@ const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
                                                549755813888,
                                                1099511627776};
 
+// static
+bool OperationLatencyHdrHistograms::isEnabled() {
+    return gLatencyHistogramSignificantDigits != 0;
+}
+
+void OperationLatencyHdrHistograms::increment(uint64_t latency, Command::ReadWriteType type) {
+    if (MONGO_likely(!isEnabled())) {
+        return;
+    }
+
+    auto& histogram = _histograms[_indexOf(type)];
+    if (!histogram.isEnabled()) {
+        histogram = HdrHistogram(gLatencyHistogramSignificantDigits);
+    }
+    histogram.record(latency);
+}
+
+void OperationLatencyHdrHistograms::append(Command::ReadWriteType type,
+                                           bool includeBuckets,
+                                           BSONObjBuilder* builder) const {
+    const auto& histogram = _histograms[_indexOf(type)];
+    if (histogram.isEnabled()) {
+        histogram.append(includeBuckets, builder);
+    } else {
+        HdrHistogram(gLatencyHistogramSignificantDigits).append(includeBuckets, builder);
+    }
+}
+
+void OperationLatencyHdrHistograms::add(const OperationLatencyHdrHistograms& other) {
+    for (size_t i = 0; i < _histograms.size(); ++i) {
+        _histograms[i].add(other._histograms[i]);
+    }
+}
+
+size_t OperationLatencyHdrHistograms::_indexOf(Command::ReadWriteType type) {
+    switch (type) {
+        case Command::ReadWriteType::kRead:
+            return 0;
+        case Command::ReadWriteType::kWrite:
+            return 1;
+        case Command::ReadWriteType::kCommand:
+            return 2;
+        case Command::ReadWriteType::kTransaction:
+            return 3;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
 void OperationLatencyHistogram::_append(const HistogramData& data,
                                         const char* key,
+                                        Command::ReadWriteType type,
                                         bool includeHistograms,
                                         bool slowMSBucketsOnly,
+                                        const OperationLatencyHdrHistograms* hdrHistograms,
                                         BSONObjBuilder* builder) const {
 
     uint64_t filteredCount = 0;
@@ -141,16 +193,51 @@ void OperationLatencyHistogram::_append(const HistogramData& data,
 
     histogramBuilder.append("latency", static_cast<long long>(data.sum));
     histogramBuilder.append("ops", static_cast<long long>(data.entryCount));
+
+    if (gLatencyHistogramSignificantDigits > 0) {
+        BSONObjBuilder hdrBuilder(histogramBuilder.subobjStart("hdr"));
+        if (hdrHistograms) {
+            hdrHistograms->append(type, includeHistograms, &hdrBuilder);
+        } else {
+            HdrHistogram(gLatencyHistogramSignificantDigits).append(includeHistograms, &hdrBuilder);
+        }
+        hdrBuilder.doneFast();
+    }
     histogramBuilder.doneFast();
 }
 
 void OperationLatencyHistogram::append(bool includeHistograms,
                                        bool slowMSBucketsOnly,
-                                       BSONObjBuilder* builder) const {
-    _append(_reads, "reads", includeHistograms, slowMSBucketsOnly, builder);
-    _append(_writes, "writes", includeHistograms, slowMSBucketsOnly, builder);
-    _append(_commands, "commands", includeHistograms, slowMSBucketsOnly, builder);
-    _append(_transactions, "transactions", includeHistograms, slowMSBucketsOnly, builder);
+                                       BSONObjBuilder* builder,
+                                       const OperationLatencyHdrHistograms* hdrHistograms) const {
+    _append(_reads,
+            "reads",
+            Command::ReadWriteType::kRead,
+            includeHistograms,
+            slowMSBucketsOnly,
+            hdrHistograms,
+            builder);
+    _append(_writes,
+            "writes",
+            Command::ReadWriteType::kWrite,
+            includeHistograms,
+            slowMSBucketsOnly,
+            hdrHistograms,
+            builder);
+    _append(_commands,
+            "commands",
+            Command::ReadWriteType::kCommand,
+            includeHistograms,
+            slowMSBucketsOnly,
+            hdrHistograms,
+            builder);
+    _append(_transactions,
+            "transactions",
+            Command::ReadWriteType::kTransaction,
+            includeHistograms,
+            slowMSBucketsOnly,
+            hdrHistograms,
+            builder);
 }
 
 // Computes the log base 2 of value, and checks for cases of split buckets.
@@ -186,6 +273,21 @@ void OperationLatencyHistogram::_incrementData(uint64_t latency, int bucket, His
     data->sum += latency;
 }
 
+void OperationLatencyHistogram::_addData(const HistogramData& from, HistogramData* to) {
+    for (size_t i = 0; i < kMaxBuckets; i++) {
+        to->buckets[i] += from.buckets[i];
+    }
+    to->entryCount += from.entryCount;
+    to->sum += from.sum;
+}
+
+void OperationLatencyHistogram::add(const OperationLatencyHistogram& other) {
+    _addData(other._reads, &_reads);
+    _addData(other._writes, &_writes);
+    _addData(other._commands, &_commands);
+    _addData(other._transactions, &_transactions);
+}
+
 void OperationLatencyHistogram::increment(uint64_t latency, Command::ReadWriteType type) {
     int bucket = _getBucket(latency);
     switch (type) {
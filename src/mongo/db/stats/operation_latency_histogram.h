@@ -31,11 +31,46 @@
 #include <array>
 
 #include "mongo/db/commands.h"
+#include "mongo/db/stats/hdr_histogram.h"
 
 namespace mongo {
 
 class BSONObjBuilder;
 
+/**
+ * High-resolution histograms of the latencies of read, write, command, and multi-document
+ * transaction operations, recorded only when latencyHistogramSignificantDigits is non-zero. They
+ * are kept apart from OperationLatencyHistogram so that its copies and stripes do not each carry
+ * several kilobytes of buckets.
+ *
+ * Note: This class is not thread-safe.
+ */
+class OperationLatencyHdrHistograms {
+public:
+    /**
+     * Returns whether latencyHistogramSignificantDigits enables recording anything.
+     */
+    static bool isEnabled();
+
+    void increment(uint64_t latency, Command::ReadWriteType type);
+
+    /**
+     * Appends the histogram for operations of the given type.
+     */
+    void append(Command::ReadWriteType type, bool includeBuckets, BSONObjBuilder* builder) const;
+
+    /**
+     * Adds the latencies recorded by 'other' to these histograms.
+     */
+    void add(const OperationLatencyHdrHistograms& other);
+
+private:
+    static size_t _indexOf(Command::ReadWriteType type);
+
+    // Indexed by _indexOf(), in the order reads, writes, commands, transactions.
+    std::array<HdrHistogram, 4> _histograms;
+};
+
 /**
  * Stores statistics for latencies of read, write, command, and multi-document transaction
  * operations.
@@ -55,9 +90,19 @@ public:
     void increment(uint64_t latency, Command::ReadWriteType type);
 
     /**
-     * Appends the four histograms with latency totals and operation counts.
+     * Appends the four histograms with latency totals and operation counts, along with the
+     * high-resolution histograms in 'hdrHistograms' if latencyHistogramSignificantDigits is
+     * non-zero.
+     */
+    void append(bool includeHistograms,
+                bool slowMSBucketsOnly,
+                BSONObjBuilder* builder,
+                const OperationLatencyHdrHistograms* hdrHistograms = nullptr) const;
+
+    /**
+     * Adds the counts and latencies recorded by 'other' to this histogram.
      */
-    void append(bool includeHistograms, bool slowMSBucketsOnly, BSONObjBuilder* builder) const;
+    void add(const OperationLatencyHistogram& other);
 
 private:
     struct HistogramData {
@@ -72,12 +117,16 @@ private:
 
     void _append(const HistogramData& data,
                  const char* key,
+                 Command::ReadWriteType type,
                  bool includeHistograms,
                  bool slowMSBucketsOnly,
+                 const OperationLatencyHdrHistograms* hdrHistograms,
                  BSONObjBuilder* builder) const;
 
     void _incrementData(uint64_t latency, int bucket, HistogramData* data);
 
+    static void _addData(const HistogramData& from, HistogramData* to);
+
     HistogramData _reads, _writes, _commands, _transactions;
 };
 }  // namespace mongo
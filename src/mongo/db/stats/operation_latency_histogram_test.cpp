@@ -38,7 +38,9 @@
 
 #include "mongo/db/commands.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/stats/hdr_histogram_gen.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -64,6 +66,67 @@ TEST(OperationLatencyHistogram, EnsureIncrementsStored) {
     ASSERT_EQUALS(out["transactions"]["ops"].Long(), kMaxBuckets);
 }
 
+TEST(OperationLatencyHistogram, AddMergesCountsAndLatency) {
+    OperationLatencyHistogram hist;
+    OperationLatencyHistogram other;
+    hist.increment(10, Command::ReadWriteType::kRead);
+    other.increment(20, Command::ReadWriteType::kRead);
+    other.increment(5, Command::ReadWriteType::kTransaction);
+    hist.add(other);
+
+    BSONObjBuilder outBuilder;
+    hist.append(true, false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(), 30);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array().size(), 2U);
+    ASSERT_EQUALS(out["transactions"]["ops"].Long(), 1);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 0);
+}
+
+TEST(OperationLatencyHistogram, AppendsHdrHistogramsOnlyWhenEnabled) {
+    OperationLatencyHistogram hist;
+    OperationLatencyHdrHistograms hdrHistograms;
+    hist.increment(10, Command::ReadWriteType::kRead);
+    hdrHistograms.increment(10, Command::ReadWriteType::kRead);
+
+    BSONObjBuilder disabledBuilder;
+    hist.append(false, false, &disabledBuilder, &hdrHistograms);
+    ASSERT_FALSE(disabledBuilder.done()["reads"].Obj().hasField("hdr"));
+
+    gLatencyHistogramSignificantDigits = 2;
+    ON_BLOCK_EXIT([] { gLatencyHistogramSignificantDigits = 0; });
+    hdrHistograms.increment(10, Command::ReadWriteType::kRead);
+    hdrHistograms.increment(20, Command::ReadWriteType::kRead);
+
+    BSONObjBuilder enabledBuilder;
+    hist.append(false, false, &enabledBuilder, &hdrHistograms);
+    BSONObj out = enabledBuilder.done();
+    ASSERT_EQUALS(out["reads"]["hdr"]["count"].numberLong(), 2);
+    ASSERT_EQUALS(out["writes"]["hdr"]["count"].numberLong(), 0);
+}
+
+TEST(OperationLatencyHistogram, AddMergesHdrHistograms) {
+    gLatencyHistogramSignificantDigits = 2;
+    ON_BLOCK_EXIT([] { gLatencyHistogramSignificantDigits = 0; });
+
+    OperationLatencyHdrHistograms first, second, merged;
+    first.increment(10, Command::ReadWriteType::kRead);
+    second.increment(20, Command::ReadWriteType::kRead);
+    second.increment(30, Command::ReadWriteType::kWrite);
+    merged.add(first);
+    merged.add(second);
+
+    OperationLatencyHistogram hist;
+    BSONObjBuilder builder;
+    hist.append(false, false, &builder, &merged);
+    BSONObj out = builder.done();
+    ASSERT_EQUALS(out["reads"]["hdr"]["count"].numberLong(), 2);
+    ASSERT_EQUALS(out["reads"]["hdr"]["sum"].numberLong(), 30);
+    ASSERT_EQUALS(out["writes"]["hdr"]["count"].numberLong(), 1);
+    ASSERT_EQUALS(out["commands"]["hdr"]["count"].numberLong(), 0);
+}
+
 TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
     OperationLatencyHistogram hist;
     // Increment at the boundary, boundary+1, and boundary-1.
@@ -33,8 +33,15 @@
 
 #include "mongo/db/stats/top.h"
 
+#include <limits>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -47,8 +54,12 @@ namespace {
 
 const auto getTop = ServiceContext::declareDecoration<Top>();
 
+AtomicWord<unsigned long long> nextUsageVersion{1};
+
 }  // namespace
 
+Top::Top() = default;
+
 Top::UsageData::UsageData(const UsageData& older, const UsageData& newer) {
     // this won't be 100% accurate on rollovers and drop(), but at least it won't be negative
     time = (newer.time >= older.time) ? (newer.time - older.time) : newer.time;
@@ -66,6 +77,19 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       remove(older.remove, newer.remove),
       commands(older.commands, newer.commands) {}
 
+void Top::CollectionData::add(const CollectionData& other) {
+    total.add(other.total);
+    readLock.add(other.readLock);
+    writeLock.add(other.writeLock);
+    queries.add(other.queries);
+    getmore.add(other.getmore);
+    insert.add(other.insert);
+    update.add(other.update);
+    remove.add(other.remove);
+    commands.add(other.commands);
+    opLatencyHistogram.add(other.opLatencyHistogram);
+}
+
 // static
 Top& Top::get(ServiceContext* service) {
     return getTop(service);
@@ -82,10 +106,89 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::hasher().hashed_key(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto coll = _getOrCreateCollection(hashedNs);
+    coll->stats.update([&](CollectionData& c) {
+        _record(opCtx, c, logicalOp, lockType, micros, readWriteType);
+    });
+    _incrementHdrHistograms(opCtx, micros, &coll->hdrHistograms, readWriteType);
+}
+
+// static
+size_t Top::_currentStripe() {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % kNumStripes;
+    }
+#endif
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % kNumStripes;
+}
 
-    CollectionData& coll = _usage[hashedNs];
-    _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
+// static
+size_t Top::_shardOf(const StringMapHashedKey& hashedNs) {
+    // The low bits of the hash are left to the maps of the shards.
+    return hashedNs.hash() >> (std::numeric_limits<size_t>::digits - kUsageShardBits);
+}
+
+// static
+unsigned long long Top::_newUsageVersion() {
+    return nextUsageVersion.fetchAndAdd(1);
+}
+
+Top::StripedCollectionData* Top::_getOrCreateCollection(StringMapHashedKey hashedNs) {
+    // The latest version of each shard of some Top's map that this thread has seen. Versions are
+    // unique across all shards of all Tops, so a copy cached from another shard never looks
+    // current.
+    struct CachedUsage {
+        unsigned long long version = 0;
+        std::shared_ptr<StripedUsageMap> usage;
+    };
+    static thread_local std::array<CachedUsage, kNumUsageShards> cachedShards;
+
+    const auto shardIndex = _shardOf(hashedNs);
+    auto& shard = _usageShards[shardIndex];
+    auto& cached = cachedShards[shardIndex];
+
+    if (cached.version == shard.version.load()) {
+        auto it = cached.usage->find(hashedNs);
+        if (it != cached.usage->end()) {
+            return it->second.get();
+        }
+    }
+
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
+    cached.version = shard.version.load();
+    cached.usage = shard.usage;
+
+    auto it = shard.usage->find(hashedNs);
+    if (it != shard.usage->end()) {
+        return it->second.get();
+    }
+
+    auto usageCopy = std::make_shared<StripedUsageMap>(*shard.usage);
+    (*usageCopy)[hashedNs] = make_intrusive<StripedCollectionData>();
+    shard.usage = std::move(usageCopy);
+    shard.version.store(_newUsageVersion());
+
+    cached.version = shard.version.load();
+    cached.usage = shard.usage;
+    return cached.usage->find(hashedNs)->second.get();
+}
+
+std::shared_ptr<Top::StripedUsageMap> Top::_getUsage(size_t shard) const {
+    stdx::lock_guard<SimpleMutex> lk(_usageShards[shard].lock);
+    return _usageShards[shard].usage;
+}
+
+Top::UsageMap Top::_mergeUsage() const {
+    UsageMap merged;
+    for (size_t shard = 0; shard < kNumUsageShards; ++shard) {
+        auto usage = _getUsage(shard);
+        for (const auto& [ns, coll] : *usage) {
+            merged[ns] = coll->stats.merged();
+        }
+    }
+    return merged;
 }
 
 void Top::_record(OperationContext* opCtx,
@@ -134,18 +237,26 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(const NamespaceString& nss) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(nss.ns());
+    auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
+    auto& shard = _usageShards[_shardOf(hashedNs)];
+
+    stdx::lock_guard<SimpleMutex> lk(shard.lock);
+    if (shard.usage->find(hashedNs) == shard.usage->end()) {
+        return;
+    }
+
+    auto usageCopy = std::make_shared<StripedUsageMap>(*shard.usage);
+    usageCopy->erase(nss.ns());
+    shard.usage = std::move(usageCopy);
+    shard.version.store(_newUsageVersion());
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out = _mergeUsage();
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    _appendToUsageMap(b, _mergeUsage());
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -190,9 +301,16 @@ void Top::appendLatencyStats(const NamespaceString& nss,
                              bool includeHistograms,
                              BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto usage = _getUsage(_shardOf(hashedNs));
+    auto it = usage->find(hashedNs);
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
+    if (it != usage->end()) {
+        auto hdrHistograms = it->second->hdrHistograms.merged();
+        it->second->stats.merged().opLatencyHistogram.append(
+            includeHistograms, false, &latencyStatsBuilder, &hdrHistograms);
+    } else {
+        OperationLatencyHistogram().append(includeHistograms, false, &latencyStatsBuilder);
+    }
     builder->append("ns", nss.ns());
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -203,20 +321,29 @@ void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
     if (!opCtx->shouldIncrementLatencyStats())
         return;
 
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    _globalHistogramStats.update([&](OperationLatencyHistogram& histogram) {
+        _incrementHistogram(opCtx, latency, &histogram, readWriteType);
+    });
+    _incrementHdrHistograms(opCtx, latency, &_globalHdrHistograms, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms,
                                    bool slowMSBucketsOnly,
                                    BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
+    auto hdrHistograms = _globalHdrHistograms.merged();
+    _globalHistogramStats.merged().append(
+        includeHistograms, slowMSBucketsOnly, builder, &hdrHistograms);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    _globalHistogramStats.update([&](OperationLatencyHistogram& histogram) {
+        histogram.increment(latency, Command::ReadWriteType::kTransaction);
+    });
+    if (OperationLatencyHdrHistograms::isEnabled()) {
+        _globalHdrHistograms.update([&](OperationLatencyHdrHistograms& hdrHistograms) {
+            hdrHistograms.increment(latency, Command::ReadWriteType::kTransaction);
+        });
+    }
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
@@ -229,4 +356,21 @@ void Top::_incrementHistogram(OperationContext* opCtx,
         histogram->increment(latency, readWriteType);
     }
 }
+
+void Top::_incrementHdrHistograms(OperationContext* opCtx,
+                                  long long latency,
+                                  Striped<OperationLatencyHdrHistograms>* hdrHistograms,
+                                  Command::ReadWriteType readWriteType) {
+    if (MONGO_likely(!OperationLatencyHdrHistograms::isEnabled())) {
+        return;
+    }
+
+    // Only update histograms if operation came from a user.
+    Client* client = opCtx->getClient();
+    if (client->isFromUserConnection() && !client->isInDirectClient()) {
+        hdrHistograms->update([&](OperationLatencyHdrHistograms& histograms) {
+            histograms.increment(latency, readWriteType);
+        });
+    }
+}
 }  // namespace mongo
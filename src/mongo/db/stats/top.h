@@ -33,13 +33,19 @@
  * DB usage monitor.
  */
 
+#include <array>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <memory>
 
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/intrusive_counter.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -47,12 +53,18 @@ class ServiceContext;
 
 /**
  * tracks usage by collection
+ *
+ * The tracked collections are spread by namespace over shards, each a copy-on-write map of which
+ * each thread caches the latest version it has seen. Recording an operation only takes the lock of
+ * a shard the first time a thread records after a collection of that shard was added or dropped.
+ * The statistics of each collection are striped by CPU once operations on it start contending.
+ * Readers merge the stripes.
  */
 class Top {
 public:
     static Top& get(ServiceContext* service);
 
-    Top() = default;
+    Top();
 
     struct UsageData {
         UsageData() : time(0), count(0) {}
@@ -64,6 +76,11 @@ public:
             count++;
             time += micros;
         }
+
+        void add(const UsageData& other) {
+            count += other.count;
+            time += other.time;
+        }
     };
 
     struct CollectionData {
@@ -85,6 +102,8 @@ public:
         UsageData remove;
         UsageData commands;
         OperationLatencyHistogram opLatencyHistogram;
+
+        void add(const CollectionData& other);
     };
 
     enum class LockType {
@@ -137,6 +156,109 @@ public:
                                   BSONObjBuilder* builder);
 
 private:
+    // Number of stripes statistics are spread over once updates to them contend.
+    static constexpr size_t kNumStripes = 16;
+
+    /**
+     * Statistics of type T, which must provide add(const T&), updated by many threads at once.
+     * Updates go to a single copy until two of them contend for it. From then on each update goes
+     * to the stripe of the CPU it runs on, so stripes are only allocated for hot statistics.
+     */
+    template <typename T>
+    class Striped {
+    public:
+        Striped() = default;
+        Striped(const Striped&) = delete;
+        Striped& operator=(const Striped&) = delete;
+
+        ~Striped() {
+            delete _stripes.load();
+        }
+
+        template <typename UpdateFn>
+        void update(UpdateFn&& fn) {
+            auto stripes = _stripes.load();
+            if (!stripes) {
+                stdx::unique_lock<stdx::mutex> lk(_first.mutex, stdx::try_to_lock);
+                if (lk.owns_lock()) {
+                    fn(_first.data);
+                    return;
+                }
+                stripes = _allocateStripes();
+            }
+
+            auto& stripe = (*stripes)[_currentStripe()];
+            stdx::lock_guard<stdx::mutex> lk(stripe.mutex);
+            fn(stripe.data);
+        }
+
+        /**
+         * Returns the sum of all stripes.
+         */
+        T merged() const {
+            T result;
+            {
+                stdx::lock_guard<stdx::mutex> lk(_first.mutex);
+                result.add(_first.data);
+            }
+            if (auto stripes = _stripes.load()) {
+                for (const auto& stripe : *stripes) {
+                    stdx::lock_guard<stdx::mutex> lk(stripe.mutex);
+                    result.add(stripe.data);
+                }
+            }
+            return result;
+        }
+
+    private:
+        struct Stripe {
+            mutable stdx::mutex mutex;  // NOLINT
+            T data;
+        };
+        using Stripes = std::array<CacheAligned<Stripe>, kNumStripes>;
+
+        Stripes* _allocateStripes() {
+            auto stripes = std::make_unique<Stripes>();
+            Stripes* expected = nullptr;
+            if (_stripes.compareAndSwap(&expected, stripes.get())) {
+                return stripes.release();
+            }
+            return expected;
+        }
+
+        Stripe _first;
+        AtomicWord<Stripes*> _stripes{nullptr};
+    };
+
+    struct StripedCollectionData : public RefCountable {
+        Striped<CollectionData> stats;
+        Striped<OperationLatencyHdrHistograms> hdrHistograms;
+    };
+
+    // The collection entries are pointers so that updates made through a map which has since been
+    // replaced by a copy are not lost.
+    using StripedUsageMap = StringMap<boost::intrusive_ptr<StripedCollectionData>>;
+
+    // Returns the stripe used by the calling thread.
+    static size_t _currentStripe();
+
+    // Returns the shard of _usageShards tracking the collection.
+    static size_t _shardOf(const StringMapHashedKey& hashedNs);
+
+    // Returns a version number never handed out before, by any Top.
+    static unsigned long long _newUsageVersion();
+
+    /**
+     * Returns the statistics of the given collection, starting to track it if needed. The returned
+     * pointer stays valid until the calling thread's next call, since the thread's cached copy of
+     * the map keeps the entry alive.
+     */
+    StripedCollectionData* _getOrCreateCollection(StringMapHashedKey hashedNs);
+
+    std::shared_ptr<StripedUsageMap> _getUsage(size_t shard) const;
+
+    UsageMap _mergeUsage() const;
+
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
@@ -153,9 +275,32 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    void _incrementHdrHistograms(OperationContext* opCtx,
+                                 long long latency,
+                                 Striped<OperationLatencyHdrHistograms>* hdrHistograms,
+                                 Command::ReadWriteType readWriteType);
+
+    // Number of bits of the namespace hash, from the top, which select the shard of a collection.
+    static constexpr int kUsageShardBits = 5;
+    static constexpr size_t kNumUsageShards = size_t{1} << kUsageShardBits;
+
+    struct UsageShard {
+        // Protects usage. Updating the statistics of a collection does not take it.
+        mutable SimpleMutex lock;
+
+        // Replaced by a modified copy, never modified in place, whenever a collection of the shard
+        // is added or dropped.
+        std::shared_ptr<StripedUsageMap> usage = std::make_shared<StripedUsageMap>();
+
+        // Changed, after usage, every time usage is replaced. Threads compare it against the
+        // version of their cached copy of usage to tell whether that copy is still current.
+        AtomicWord<unsigned long long> version{_newUsageVersion()};
+    };
+
+    Striped<OperationLatencyHistogram> _globalHistogramStats;
+    Striped<OperationLatencyHdrHistograms> _globalHdrHistograms;
+
+    std::array<CacheAligned<UsageShard>, kNumUsageShards> _usageShards;
 };
 
 }  // namespace mongo
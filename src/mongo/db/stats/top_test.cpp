@@ -29,8 +29,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include "mongo/db/client.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/stats/hdr_histogram_gen.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 
@@ -40,4 +47,131 @@ TEST(TopTest, CollectionDropped) {
     Top().collectionDropped(NamespaceString("test.coll"));
 }
 
+class TopServiceContextTest : public ServiceContextTest {};
+
+TEST_F(TopServiceContextTest, ConcurrentRecordsAreMerged) {
+    constexpr int kNumThreads = 8;
+    constexpr int kRecordsPerThread = 1000;
+    Top top;
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] {
+            ThreadClient tc(getServiceContext());
+            auto opCtx = tc->makeOperationContext();
+            for (int j = 0; j < kRecordsPerThread; ++j) {
+                top.record(opCtx.get(),
+                           "test.coll",
+                           LogicalOp::opInsert,
+                           Top::LockType::WriteLocked,
+                           2,
+                           false,
+                           Command::ReadWriteType::kWrite);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Top::UsageMap usage;
+    top.cloneMap(usage);
+    ASSERT_EQ(usage.size(), 1U);
+    const auto& coll = usage["test.coll"];
+    ASSERT_EQ(coll.total.count, kNumThreads * kRecordsPerThread);
+    ASSERT_EQ(coll.total.time, 2 * kNumThreads * kRecordsPerThread);
+    ASSERT_EQ(coll.insert.count, kNumThreads * kRecordsPerThread);
+    ASSERT_EQ(coll.writeLock.count, kNumThreads * kRecordsPerThread);
+    ASSERT_EQ(coll.queries.count, 0);
+
+    top.collectionDropped(NamespaceString("test.coll"));
+    top.cloneMap(usage);
+    ASSERT(usage.empty());
+}
+
+TEST(TopTest, ConcurrentHdrHistogramIncrementsAreMerged) {
+    gLatencyHistogramSignificantDigits = 2;
+    ON_BLOCK_EXIT([] { gLatencyHistogramSignificantDigits = 0; });
+
+    constexpr int kNumThreads = 8;
+    constexpr int kIncrementsPerThread = 1000;
+    Top top;
+
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kIncrementsPerThread; ++j) {
+                top.incrementGlobalTransactionLatencyStats(5);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BSONObjBuilder builder;
+    top.appendGlobalLatencyStats(false, false, &builder);
+    BSONObj out = builder.done();
+    ASSERT_EQ(out["transactions"]["ops"].numberLong(), kNumThreads * kIncrementsPerThread);
+    ASSERT_EQ(out["transactions"]["hdr"]["count"].numberLong(), kNumThreads * kIncrementsPerThread);
+    ASSERT_EQ(out["transactions"]["hdr"]["max"].numberLong(), 5);
+}
+
+TEST_F(TopServiceContextTest, RecordAfterDropStartsOverAndTopsDoNotShareCollections) {
+    auto opCtx = makeOperationContext();
+    auto recordInsert = [&](Top& top) {
+        top.record(opCtx.get(),
+                   "test.coll",
+                   LogicalOp::opInsert,
+                   Top::LockType::WriteLocked,
+                   2,
+                   false,
+                   Command::ReadWriteType::kWrite);
+    };
+
+    Top top;
+    recordInsert(top);
+    recordInsert(top);
+    top.collectionDropped(NamespaceString("test.coll"));
+    recordInsert(top);
+
+    Top otherTop;
+    recordInsert(otherTop);
+
+    Top::UsageMap usage;
+    top.cloneMap(usage);
+    ASSERT_EQ(usage["test.coll"].total.count, 1);
+
+    otherTop.cloneMap(usage);
+    ASSERT_EQ(usage["test.coll"].total.count, 1);
+}
+
+TEST_F(TopServiceContextTest, CollectionsAreAddedAndDroppedIndependently) {
+    constexpr int kNumCollections = 200;
+    auto opCtx = makeOperationContext();
+    auto nssAt = [](int i) { return NamespaceString("test", "coll" + std::to_string(i)); };
+
+    Top top;
+    for (int i = 0; i < kNumCollections; ++i) {
+        top.record(opCtx.get(),
+                   nssAt(i).ns(),
+                   LogicalOp::opQuery,
+                   Top::LockType::ReadLocked,
+                   i,
+                   false,
+                   Command::ReadWriteType::kRead);
+    }
+    for (int i = 0; i < kNumCollections; i += 2) {
+        top.collectionDropped(nssAt(i));
+    }
+
+    Top::UsageMap usage;
+    top.cloneMap(usage);
+    ASSERT_EQ(usage.size(), static_cast<size_t>(kNumCollections / 2));
+    for (int i = 1; i < kNumCollections; i += 2) {
+        ASSERT_EQ(usage[nssAt(i).ns()].queries.count, 1);
+        ASSERT_EQ(usage[nssAt(i).ns()].queries.time, i);
+    }
+}
+
 }  // namespace
@@ -0,0 +1,242 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include <chrono>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MONGO_WAIT_EVENTS_HAVE_TSC
+#endif
+
+#include "mongo/base/init.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/stats/wait_latency_metrics.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/static_immortal.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/with_alignment.h"
+
+namespace mongo {
+
+namespace {
+
+// Set once during startup, before any operation can wait.
+bool useTsc = false;
+double nanosPerTick = 1.0;
+
+uint64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t now() {
+#if defined(MONGO_WAIT_EVENTS_HAVE_TSC)
+    if (useTsc) {
+        return __rdtsc();
+    }
+#endif
+    return steadyNanos();
+}
+
+Nanoseconds elapsedSince(uint64_t start) {
+    const auto end = now();
+    // A thread migrating between sockets may observe a slightly earlier counter.
+    if (end <= start) {
+        return Nanoseconds(0);
+    }
+    return Nanoseconds(static_cast<long long>((end - start) * nanosPerTick));
+}
+
+#if defined(MONGO_WAIT_EVENTS_HAVE_TSC)
+/**
+ * The counter only measures time if it ticks at a constant rate across frequency scaling and
+ * sleep states.
+ */
+bool hasInvariantTsc() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return edx & (1u << 8);
+}
+#endif
+
+MONGO_INITIALIZER(CalibrateWaitEventClock)(InitializerContext*) {
+#if defined(MONGO_WAIT_EVENTS_HAVE_TSC)
+    if (!hasInvariantTsc()) {
+        return;
+    }
+
+    const auto startNanos = steadyNanos();
+    const auto startTicks = __rdtsc();
+    sleepmillis(10);
+    const auto endNanos = steadyNanos();
+    const auto endTicks = __rdtsc();
+
+    if (endTicks <= startTicks || endNanos <= startNanos) {
+        return;
+    }
+    nanosPerTick = static_cast<double>(endNanos - startNanos) / (endTicks - startTicks);
+    useTsc = true;
+#endif
+}
+
+struct GlobalCounters {
+    AtomicWord<long long> count{0};
+    AtomicWord<long long> nanos{0};
+};
+
+// Most operations record some wait, so the process totals are striped by thread to keep every
+// operation from writing the same cache line.
+constexpr size_t kGlobalStripes = 16;
+using GlobalStripe = CacheAligned<std::array<GlobalCounters, kNumWaitEvents>>;
+
+auto& globalStripes() {
+    static StaticImmortal<std::array<GlobalStripe, kGlobalStripes>> stripes;
+    return *stripes;
+}
+
+GlobalStripe& localStripe() {
+    static AtomicWord<unsigned> nextStripe{0};
+    thread_local GlobalStripe& stripe =
+        globalStripes()[nextStripe.fetchAndAddRelaxed(1) % kGlobalStripes];
+    return stripe;
+}
+
+/**
+ * Returns the wait latency histogram, if any, that waits on 'event' are also recorded in.
+ */
+boost::optional<WaitLatencyMetrics::WaitType> waitLatencyTypeFor(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kTicket:
+            return WaitLatencyMetrics::WaitType::kTicket;
+        case WaitEvent::kStorageCache:
+            return WaitLatencyMetrics::WaitType::kStorageCache;
+        default:
+            return boost::none;
+    }
+}
+
+}  // namespace
+
+StringData toString(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kTicket:
+            return "ticket"_sd;
+        case WaitEvent::kStorageCache:
+            return "storageCache"_sd;
+        case WaitEvent::kPrepareConflict:
+            return "prepareConflict"_sd;
+        case WaitEvent::kJournalFlush:
+            return "journalFlush"_sd;
+        case WaitEvent::kReplication:
+            return "replication"_sd;
+        case WaitEvent::kNetwork:
+            return "network"_sd;
+        case WaitEvent::kYield:
+            return "yield"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+const OperationContext::Decoration<WaitEventStats> WaitEventStats::get =
+    OperationContext::declareDecoration<WaitEventStats>();
+
+void WaitEventStats::record(OperationContext* opCtx, WaitEvent event, Nanoseconds duration) {
+    const auto index = static_cast<size_t>(event);
+    const auto nanos = durationCount<Nanoseconds>(duration);
+
+    if (opCtx) {
+        // Only this operation's thread writes its counters.
+        auto& counters = get(opCtx)._events[index];
+        counters.count.store(counters.count.loadRelaxed() + 1);
+        counters.nanos.store(counters.nanos.loadRelaxed() + nanos);
+    }
+
+    auto& totals = localStripe()[index];
+    totals.count.fetchAndAddRelaxed(1);
+    totals.nanos.fetchAndAddRelaxed(nanos);
+
+    if (WaitLatencyMetrics::isEnabled()) {
+        if (auto type = waitLatencyTypeFor(event)) {
+            WaitLatencyMetrics::get().record(*type, duration_cast<Microseconds>(duration));
+        }
+    }
+}
+
+void WaitEventStats::appendGlobal(BSONObjBuilder* builder) {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        long long count = 0;
+        long long nanos = 0;
+        for (const auto& stripe : globalStripes()) {
+            count += stripe[i].count.loadRelaxed();
+            nanos += stripe[i].nanos.loadRelaxed();
+        }
+        BSONObjBuilder eventBuilder(builder->subobjStart(toString(static_cast<WaitEvent>(i))));
+        eventBuilder.append("count", count);
+        eventBuilder.append("micros", nanos / 1000);
+    }
+}
+
+void WaitEventStats::append(BSONObjBuilder* builder) const {
+    for (size_t i = 0; i < kNumWaitEvents; ++i) {
+        const auto count = _events[i].count.load();
+        if (count == 0) {
+            continue;
+        }
+        BSONObjBuilder eventBuilder(builder->subobjStart(toString(static_cast<WaitEvent>(i))));
+        eventBuilder.append("count", count);
+        eventBuilder.append("micros", _events[i].nanos.load() / 1000);
+    }
+}
+
+bool WaitEventStats::empty() const {
+    for (const auto& counters : _events) {
+        if (counters.count.load() > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ScopedWaitEvent::ScopedWaitEvent(OperationContext* opCtx, WaitEvent event)
+    : _opCtx(opCtx), _event(event), _start(now()) {}
+
+ScopedWaitEvent::~ScopedWaitEvent() {
+    WaitEventStats::record(_opCtx, _event, elapsedSince(_start));
+}
+
+}  // namespace mongo
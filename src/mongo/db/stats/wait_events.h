@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "mongo/base/string_data.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * The blocking points an operation's wall time is broken down by.
+ */
+enum class WaitEvent {
+    kTicket,           // Waiting for a storage engine read or write ticket.
+    kStorageCache,     // Stalled on storage engine cache eviction.
+    kPrepareConflict,  // Waiting for a prepared transaction to commit or abort.
+    kJournalFlush,     // Waiting for the journal to be flushed, for j:true or fsync write concern.
+    kReplication,      // Waiting for secondaries to acknowledge a write concern, e.g. w:majority.
+    kNetwork,          // Waiting for responses to requests sent to other hosts.
+    kYield,            // Yielding locks and the storage snapshot during query execution.
+};
+constexpr size_t kNumWaitEvents = 7;
+
+StringData toString(WaitEvent event);
+
+/**
+ * Counts of and time spent in each WaitEvent by one operation, and in total by the process.
+ *
+ * The per operation counters are only written by the thread running the operation, but may be
+ * read concurrently by $currentOp.
+ */
+class WaitEventStats {
+public:
+    static const OperationContext::Decoration<WaitEventStats> get;
+
+    /**
+     * Records one wait against 'opCtx', if any, and the process totals. Ticket and storage cache
+     * waits also go to the matching WaitLatencyMetrics histogram.
+     */
+    static void record(OperationContext* opCtx, WaitEvent event, Nanoseconds duration);
+
+    /**
+     * Appends {count, micros} for each event of the process totals.
+     */
+    static void appendGlobal(BSONObjBuilder* builder);
+
+    /**
+     * Appends {count, micros} for each event this operation has waited on.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+    bool empty() const;
+
+private:
+    struct Counters {
+        AtomicWord<long long> count{0};
+        AtomicWord<long long> nanos{0};
+    };
+
+    std::array<Counters, kNumWaitEvents> _events;
+};
+
+/**
+ * Times a blocking wait for the lifetime of the object and records it as a WaitEvent. Waits may
+ * nest, for instance a yield includes reacquiring a ticket, in which case both are recorded.
+ *
+ * Timing uses the CPU's timestamp counter where it is invariant, so that instrumenting a wait that
+ * does not block costs a few nanoseconds.
+ */
+class ScopedWaitEvent {
+    ScopedWaitEvent(const ScopedWaitEvent&) = delete;
+    ScopedWaitEvent& operator=(const ScopedWaitEvent&) = delete;
+
+public:
+    ScopedWaitEvent(OperationContext* opCtx, WaitEvent event);
+    ~ScopedWaitEvent();
+
+private:
+    OperationContext* const _opCtx;
+    const WaitEvent _event;
+    const uint64_t _start;
+};
+
+}  // namespace mongo
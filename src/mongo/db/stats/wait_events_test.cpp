@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_events.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/stats/hdr_histogram_gen.h"
+#include "mongo/db/stats/wait_latency_metrics.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+class WaitEventsTest : public ServiceContextTest {};
+
+BSONObj globalTotals() {
+    BSONObjBuilder builder;
+    WaitEventStats::appendGlobal(&builder);
+    return builder.obj();
+}
+
+TEST_F(WaitEventsTest, EmptyUntilWaited) {
+    auto opCtx = makeOperationContext();
+    auto& stats = WaitEventStats::get(opCtx.get());
+    ASSERT_TRUE(stats.empty());
+
+    BSONObjBuilder builder;
+    stats.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(), BSONObj());
+}
+
+TEST_F(WaitEventsTest, RecordAppendsOnlyEventsWaitedOn) {
+    auto opCtx = makeOperationContext();
+    WaitEventStats::record(opCtx.get(), WaitEvent::kTicket, Microseconds(5));
+    WaitEventStats::record(opCtx.get(), WaitEvent::kTicket, Microseconds(7));
+    WaitEventStats::record(opCtx.get(), WaitEvent::kJournalFlush, Milliseconds(2));
+
+    auto& stats = WaitEventStats::get(opCtx.get());
+    ASSERT_FALSE(stats.empty());
+
+    BSONObjBuilder builder;
+    stats.append(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("ticket" << BSON("count" << 2LL << "micros" << 12LL) << "journalFlush"
+                                    << BSON("count" << 1LL << "micros" << 2000LL)));
+}
+
+TEST_F(WaitEventsTest, RecordAddsToGlobalTotals) {
+    auto before = globalTotals();
+
+    auto opCtx = makeOperationContext();
+    WaitEventStats::record(opCtx.get(), WaitEvent::kReplication, Microseconds(30));
+    WaitEventStats::record(nullptr, WaitEvent::kReplication, Microseconds(20));
+
+    auto after = globalTotals();
+    ASSERT_EQ(after["replication"]["count"].numberLong() -
+                  before["replication"]["count"].numberLong(),
+              2);
+    ASSERT_EQ(after["replication"]["micros"].numberLong() -
+                  before["replication"]["micros"].numberLong(),
+              50);
+
+    // Every event is always reported, so the totals keep a fixed shape for FTDC.
+    ASSERT_EQ(after.nFields(), static_cast<int>(kNumWaitEvents));
+}
+
+TEST_F(WaitEventsTest, TicketWaitsFeedTheWaitLatencyHistogram) {
+    gLatencyHistogramSignificantDigits = 2;
+    ON_BLOCK_EXIT([] { gLatencyHistogramSignificantDigits = 0; });
+
+    auto ticketCount = [] {
+        BSONObjBuilder builder;
+        WaitLatencyMetrics::get().append(false, &builder);
+        return builder.obj()["tickets"]["count"].numberLong();
+    };
+
+    auto before = ticketCount();
+    WaitEventStats::record(nullptr, WaitEvent::kTicket, Microseconds(30));
+    WaitEventStats::record(nullptr, WaitEvent::kReplication, Microseconds(30));
+    ASSERT_EQ(ticketCount() - before, 1);
+}
+
+TEST_F(WaitEventsTest, ScopedWaitEventTimesItsScope) {
+    auto opCtx = makeOperationContext();
+    {
+        ScopedWaitEvent wait(opCtx.get(), WaitEvent::kNetwork);
+        sleepmillis(20);
+    }
+
+    BSONObjBuilder builder;
+    WaitEventStats::get(opCtx.get()).append(&builder);
+    auto network = builder.obj()["network"];
+    ASSERT_EQ(network["count"].numberLong(), 1);
+    ASSERT_GTE(network["micros"].numberLong(), 20 * 1000);
+    // Allow for a slow machine, but catch a badly calibrated clock.
+    ASSERT_LT(network["micros"].numberLong(), 10 * 1000 * 1000);
+}
+
+}  // namespace
+}  // namespace mongo
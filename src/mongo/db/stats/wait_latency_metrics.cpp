@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/wait_latency_metrics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/stats/hdr_histogram_gen.h"
+#include "mongo/util/static_immortal.h"
+
+namespace mongo {
+
+namespace {
+const char* waitTypeName(WaitLatencyMetrics::WaitType type) {
+    switch (type) {
+        case WaitLatencyMetrics::WaitType::kTicket:
+            return "tickets";
+        case WaitLatencyMetrics::WaitType::kLock:
+            return "locks";
+        case WaitLatencyMetrics::WaitType::kStorageCache:
+            return "storageCache";
+        case WaitLatencyMetrics::WaitType::kMajorityWriteConcern:
+            return "majorityWriteConcern";
+    }
+    MONGO_UNREACHABLE;
+}
+}  // namespace
+
+WaitLatencyMetrics& WaitLatencyMetrics::get() {
+    static StaticImmortal<WaitLatencyMetrics> metrics;
+    return *metrics;
+}
+
+bool WaitLatencyMetrics::isEnabled() {
+    return gLatencyHistogramSignificantDigits > 0;
+}
+
+void WaitLatencyMetrics::record(WaitType type, Microseconds duration) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    auto& entry = _histograms[static_cast<size_t>(type)];
+    stdx::lock_guard<SimpleMutex> lk(entry.mutex);
+    if (!entry.histogram.isEnabled()) {
+        entry.histogram = HdrHistogram(gLatencyHistogramSignificantDigits);
+    }
+    entry.histogram.record(std::max<int64_t>(durationCount<Microseconds>(duration), 0));
+}
+
+void WaitLatencyMetrics::append(bool includeBuckets, BSONObjBuilder* builder) const {
+    if (!isEnabled()) {
+        return;
+    }
+
+    for (size_t i = 0; i < kNumWaitTypes; ++i) {
+        const auto& entry = _histograms[i];
+        HdrHistogram histogram;
+        {
+            stdx::lock_guard<SimpleMutex> lk(entry.mutex);
+            histogram = entry.histogram;
+        }
+        if (!histogram.isEnabled()) {
+            histogram = HdrHistogram(gLatencyHistogramSignificantDigits);
+        }
+
+        BSONObjBuilder waitBuilder(builder->subobjStart(waitTypeName(static_cast<WaitType>(i))));
+        histogram.append(includeBuckets, &waitBuilder);
+        waitBuilder.doneFast();
+    }
+}
+
+}  // namespace mongo
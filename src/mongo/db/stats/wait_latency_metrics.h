@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+
+#include "mongo/db/stats/hdr_histogram.h"
+#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Process-wide high-resolution histograms of the time operations spend waiting, by what they wait
+ * for. Only collected when latencyHistogramSignificantDigits is non-zero.
+ */
+class WaitLatencyMetrics {
+public:
+    enum class WaitType {
+        kTicket,                // Waiting for a storage engine read or write ticket.
+        kLock,                  // Waiting for a lock that was not immediately granted.
+        kStorageCache,          // Waiting for cache eviction, for operations with storage stats.
+        kMajorityWriteConcern,  // Waiting for a write to be majority committed.
+    };
+    static constexpr size_t kNumWaitTypes = 4;
+
+    static WaitLatencyMetrics& get();
+
+    static bool isEnabled();
+
+    /**
+     * Records one wait of the given type. Does nothing unless the histograms are enabled.
+     */
+    void record(WaitType type, Microseconds duration);
+
+    /**
+     * Appends a sub-document per wait type, see HdrHistogram::append().
+     */
+    void append(bool includeBuckets, BSONObjBuilder* builder) const;
+
+private:
+    struct Histogram {
+        mutable SimpleMutex mutex;
+        HdrHistogram histogram;
+    };
+
+    std::array<Histogram, kNumWaitTypes> _histograms;
+};
+
+}  // namespace mongo
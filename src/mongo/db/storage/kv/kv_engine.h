@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <memory>
 #include <string>
 #include <vector>
@@ -52,6 +53,18 @@ class SnapshotManager;
 
 class KVEngine {
 public:
+    /**
+     * Cache residency and traffic of a single ident. The counters are cumulative, but engines may
+     * reset them, e.g. when the ident is closed and reopened.
+     */
+    struct IdentCacheStats {
+        long long bytesInCache = 0;
+        long long bytesReadIntoCache = 0;
+        long long pagesReadIntoCache = 0;
+        long long unmodifiedPagesEvicted = 0;
+        long long modifiedPagesEvicted = 0;
+    };
+
     /**
      * During the startup process, the storage engine is one of the first components to be started
      * up and fully initialized. But that fully initialized storage engine may not be recognized as
@@ -468,6 +481,23 @@ public:
         MONGO_UNREACHABLE
     }
 
+    /**
+     * Append a handful of cache gauges to the builder. This must be cheap enough to be called many
+     * times a second by the high frequency diagnostic data collectors. Engines without a cache
+     * append nothing.
+     */
+    virtual void appendCacheStats(BSONObjBuilder* builder) const {}
+
+    /**
+     * Returns the cache statistics of 'ident', or boost::none if the engine has no cache or the
+     * ident cannot be inspected right now. Called periodically for the idents of recently used
+     * collections, so it must not take longer than reading the ident's cheap statistics.
+     */
+    virtual boost::optional<IdentCacheStats> getIdentCacheStats(OperationContext* opCtx,
+                                                                StringData ident) const {
+        return boost::none;
+    }
+
     /**
      * The destructor will never be called from mongod, but may be called from tests.
      * Engines may assume that this will only be called in the case of clean shutdown, even if
@@ -86,9 +86,11 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
+#include "mongo/util/concurrency/adaptive_ticket_controller.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
@@ -242,6 +244,141 @@ private:
     stdx::condition_variable _condvar;
 };
 
+/**
+ * Periodically resizes the FIFO read and write ticket holders as decided by an
+ * AdaptiveTicketController for each, from their throughput and queueing delay and from how full
+ * the WiredTiger cache is.
+ */
+class WiredTigerKVEngine::WiredTigerConcurrencyAdjuster : public BackgroundJob {
+public:
+    WiredTigerConcurrencyAdjuster(WT_CONNECTION* conn,
+                                  FifoTicketHolder* reading,
+                                  FifoTicketHolder* writing)
+        : BackgroundJob(false /* deleteSelf */),
+          _conn(conn),
+          _reading(reading),
+          _writing(writing),
+          _readController(_makeOptions()),
+          _writeController(_makeOptions()) {}
+
+    virtual string name() const {
+        return "WTConcurrencyAdjuster";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(5986000, 1, "starting {name} thread", "name"_attr = name());
+
+        while (!_shuttingDown.load()) {
+            {
+                const Milliseconds interval(gWiredTigerAdaptiveConcurrencyIntervalMillis.load());
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, interval.toSystemDuration());
+            }
+
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            const auto now = Microseconds(static_cast<long long>(curTimeMicros64()));
+            const auto cachePressure = _getCachePressure();
+            _adjust("read"_sd, &_readController, _reading, now, cachePressure);
+            _adjust("write"_sd, &_writeController, _writing, now, cachePressure);
+        }
+        LOGV2_DEBUG(5986001, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+    void appendStats(BSONObjBuilder& b) const {
+        {
+            BSONObjBuilder bb(b.subobjStart("write"));
+            _writeController.appendStats(bb);
+        }
+        {
+            BSONObjBuilder bb(b.subobjStart("read"));
+            _readController.appendStats(bb);
+        }
+    }
+
+private:
+    static AdaptiveTicketController::Options _makeOptions() {
+        AdaptiveTicketController::Options options;
+        options.minTickets = gWiredTigerAdaptiveConcurrencyMinTickets.load();
+        options.maxTickets =
+            std::max(options.minTickets, gWiredTigerAdaptiveConcurrencyMaxTickets.load());
+        options.cachePressureThreshold =
+            gWiredTigerAdaptiveConcurrencyCachePressureThreshold.load();
+        return options;
+    }
+
+    /**
+     * Returns the fraction of the cache in use, or 0 if the statistics are unavailable.
+     */
+    double _getCachePressure() {
+        WiredTigerSession session(_conn);
+        auto inUse = WiredTigerUtil::getStatisticsValue(session.getSession(),
+                                                        "statistics:",
+                                                        "statistics=(fast)",
+                                                        WT_STAT_CONN_CACHE_BYTES_INUSE);
+        auto max = WiredTigerUtil::getStatisticsValue(
+            session.getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (!inUse.isOK() || !max.isOK() || max.getValue() <= 0) {
+            return 0;
+        }
+        return static_cast<double>(inUse.getValue()) / max.getValue();
+    }
+
+    static void _adjust(StringData kind,
+                        AdaptiveTicketController* controller,
+                        FifoTicketHolder* holder,
+                        Microseconds now,
+                        double cachePressure) {
+        controller->setOptions(_makeOptions());
+
+        AdaptiveTicketController::Sample sample;
+        sample.now = now;
+        sample.finishedProcessing = holder->finishedProcessing();
+        sample.removedFromQueue = holder->removedFromQueue();
+        sample.totalTimeQueued = holder->totalTimeQueued();
+        sample.cachePressure = cachePressure;
+
+        const int current = holder->outof();
+        const int tickets = controller->update(sample, current);
+        if (tickets != current) {
+            LOGV2_DEBUG(5986002,
+                        1,
+                        "Adjusting number of concurrent transactions",
+                        "kind"_attr = kind,
+                        "from"_attr = current,
+                        "to"_attr = tickets);
+            fassert(5986003, holder->resize(tickets));
+        }
+    }
+
+    WT_CONNECTION* _conn;
+    FifoTicketHolder* _reading;
+    FifoTicketHolder* _writing;
+
+    AdaptiveTicketController _readController;
+    AdaptiveTicketController _writeController;
+
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerConcurrencyAdjuster::_mutex");  // protects _condvar
+    // The adjuster thread idles on this condition variable between adjustments. It can be
+    // triggered early to expediate shutdown.
+    stdx::condition_variable _condvar;
+};
+
 std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult& r) {
     if (r.isOK()) {
         if (r.getValue()) {
@@ -257,50 +394,75 @@ std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult
 }
 
 namespace {
-TicketHolder openWriteTransaction(128);
-TicketHolder openReadTransaction(128);
-}  // namespace
+AtomicWord<int> openWriteTransactionTickets{128};
+AtomicWord<int> openReadTransactionTickets{128};
 
-OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
-    : ServerParameter(name, spt), _data(&openWriteTransaction) {}
+// The ticket holders are created along with the first storage engine, once the startup parameters
+// selecting their queueing policy have been parsed. Until then, the concurrent transactions
+// parameters only record the requested number of tickets.
+std::unique_ptr<TicketHolder> openWriteTransaction;
+std::unique_ptr<TicketHolder> openReadTransaction;
 
-void OpenWriteTransactionParam::append(OperationContext* opCtx,
-                                       BSONObjBuilder& b,
-                                       const std::string& name) {
-    b.append(name, _data->outof());
+std::unique_ptr<TicketHolder> makeTicketHolder(int numTickets) {
+    if (gWiredTigerFifoTicketQueueing || gWiredTigerAdaptiveConcurrency) {
+        return std::make_unique<FifoTicketHolder>(numTickets);
+    }
+    return std::make_unique<SemaphoreTicketHolder>(numTickets);
 }
 
-Status OpenWriteTransactionParam::setFromString(const std::string& str) {
+Status setNumTickets(StringData name,
+                     const std::string& str,
+                     AtomicWord<int>* numTickets,
+                     TicketHolder* holder) {
     int num = 0;
     Status status = NumberParser{}(str, &num);
     if (!status.isOK()) {
         return status;
     }
     if (num <= 0) {
-        return {ErrorCodes::BadValue, str::stream() << name() << " has to be > 0"};
+        return {ErrorCodes::BadValue, str::stream() << name << " has to be > 0"};
+    }
+    // Startup values are only applied once the holders exist, so validate them the same way as
+    // a resize would at runtime.
+    if (num < 5) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Minimum value for " << name << " is 5; given " << num};
+    }
+    if (holder) {
+        status = holder->resize(num);
+        if (!status.isOK()) {
+            return status;
+        }
     }
-    return _data->resize(num);
+    numTickets->store(num);
+    return Status::OK();
+}
+}  // namespace
+
+OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
+    : ServerParameter(name, spt), _data(&openWriteTransactionTickets) {}
+
+void OpenWriteTransactionParam::append(OperationContext* opCtx,
+                                       BSONObjBuilder& b,
+                                       const std::string& name) {
+    b.append(name, openWriteTransaction ? openWriteTransaction->outof() : _data->load());
+}
+
+Status OpenWriteTransactionParam::setFromString(const std::string& str) {
+    return setNumTickets(name(), str, _data, openWriteTransaction.get());
 }
 
 OpenReadTransactionParam::OpenReadTransactionParam(StringData name, ServerParameterType spt)
-    : ServerParameter(name, spt), _data(&openReadTransaction) {}
+    : ServerParameter(name, spt), _data(&openReadTransactionTickets) {}
 
 void OpenReadTransactionParam::append(OperationContext* opCtx,
                                       BSONObjBuilder& b,
                                       const std::string& name) {
-    b.append(name, _data->outof());
+    b.append(name, openReadTransaction ? openReadTransaction->outof() : _data->load());
 }
 
 Status OpenReadTransactionParam::setFromString(const std::string& str) {
-    int num = 0;
-    Status status = NumberParser{}(str, &num);
-    if (!status.isOK()) {
-        return status;
-    }
-    if (num <= 0) {
-        return {ErrorCodes::BadValue, str::stream() << name() << " has to be > 0"};
-    }
-    return _data->resize(num);
+    return setNumTickets(name(), str, _data, openReadTransaction.get());
 }
 
 StringData WiredTigerKVEngine::kTableUriPrefix = "table:"_sd;
@@ -564,7 +726,19 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
-    Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+    if (!openReadTransaction) {
+        openReadTransaction = makeTicketHolder(openReadTransactionTickets.load());
+        openWriteTransaction = makeTicketHolder(openWriteTransactionTickets.load());
+    }
+    Locker::setGlobalThrottling(openReadTransaction.get(), openWriteTransaction.get());
+
+    if (gWiredTigerAdaptiveConcurrency) {
+        _concurrencyAdjuster = std::make_unique<WiredTigerConcurrencyAdjuster>(
+            _conn,
+            checked_cast<FifoTicketHolder*>(openReadTransaction.get()),
+            checked_cast<FifoTicketHolder*>(openWriteTransaction.get()));
+        _concurrencyAdjuster->go();
+    }
 
     _runTimeConfigParam.reset(new WiredTigerEngineRuntimeConfigParameter(
         "wiredTigerEngineRuntimeConfig", ServerParameterType::kRuntimeOnly));
@@ -586,25 +760,86 @@ void WiredTigerKVEngine::notifyStartupComplete() {
     WiredTigerUtil::notifyStartupComplete();
 }
 
-void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
+void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) const {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
-        bbb.append("out", openWriteTransaction.used());
-        bbb.append("available", openWriteTransaction.available());
-        bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction->appendStats(bbb);
         bbb.done();
     }
     {
         BSONObjBuilder bbb(bb.subobjStart("read"));
-        bbb.append("out", openReadTransaction.used());
-        bbb.append("available", openReadTransaction.available());
-        bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction->appendStats(bbb);
+        bbb.done();
+    }
+    if (_concurrencyAdjuster) {
+        BSONObjBuilder bbb(bb.subobjStart("adaptive"));
+        _concurrencyAdjuster->appendStats(bbb);
         bbb.done();
     }
     bb.done();
 }
 
+void WiredTigerKVEngine::appendCacheStats(BSONObjBuilder* builder) const {
+    // This is sampled at a high frequency, so it borrows a cached session and looks up every
+    // statistic on one cursor.
+    UniqueWiredTigerSession session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+
+    WT_CURSOR* cursor = nullptr;
+    if (s->open_cursor(s, "statistics:", nullptr, "statistics=(fast)", &cursor) != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+    auto appendStat = [&](StringData name, int key) {
+        int64_t value = 0;
+        cursor->set_key(cursor, key);
+        if (cursor->search(cursor) == 0 &&
+            cursor->get_value(cursor, nullptr, nullptr, &value) == 0) {
+            builder->append(name, static_cast<long long>(value));
+        }
+    };
+
+    appendStat("bytesInCache", WT_STAT_CONN_CACHE_BYTES_INUSE);
+    appendStat("dirtyBytesInCache", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    appendStat("maxBytesConfigured", WT_STAT_CONN_CACHE_BYTES_MAX);
+    appendStat("pagesEvictedByApplicationThreads", WT_STAT_CONN_CACHE_EVICTION_APP);
+}
+
+boost::optional<KVEngine::IdentCacheStats> WiredTigerKVEngine::getIdentCacheStats(
+    OperationContext* opCtx, StringData ident) const {
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    WT_SESSION* s = session->getSession();
+
+    // A single statistics cursor serves all the lookups. Opening it fails if the table is being
+    // dropped or otherwise busy, in which case it is skipped until the next sample.
+    const std::string uri = "statistics:" + _uri(ident);
+    WT_CURSOR* cursor = nullptr;
+    if (s->open_cursor(s, uri.c_str(), nullptr, "statistics=(fast)", &cursor) != 0) {
+        return boost::none;
+    }
+    ON_BLOCK_EXIT([&] { cursor->close(cursor); });
+
+    auto getStat = [&](int key) -> long long {
+        int64_t value = 0;
+        cursor->set_key(cursor, key);
+        if (cursor->search(cursor) != 0 ||
+            cursor->get_value(cursor, nullptr, nullptr, &value) != 0) {
+            return 0;
+        }
+        return value;
+    };
+
+    IdentCacheStats stats;
+    stats.bytesInCache = getStat(WT_STAT_DSRC_CACHE_BYTES_INUSE);
+    stats.bytesReadIntoCache = getStat(WT_STAT_DSRC_CACHE_BYTES_READ);
+    stats.pagesReadIntoCache = getStat(WT_STAT_DSRC_CACHE_READ);
+    stats.unmodifiedPagesEvicted = getStat(WT_STAT_DSRC_CACHE_EVICTION_CLEAN);
+    stats.modifiedPagesEvicted = getStat(WT_STAT_DSRC_CACHE_EVICTION_DIRTY);
+    return stats;
+}
+
 /**
  * Table of MongoDB<->WiredTiger<->Log version numbers:
  *
@@ -712,6 +947,9 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_concurrencyAdjuster) {
+        _concurrencyAdjuster->shutdown();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
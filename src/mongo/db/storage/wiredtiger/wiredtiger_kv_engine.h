@@ -332,7 +332,12 @@ public:
         return _oplogManager.get();
     }
 
-    static void appendGlobalStats(BSONObjBuilder& b);
+    void appendGlobalStats(BSONObjBuilder& b) const;
+
+    void appendCacheStats(BSONObjBuilder* builder) const override;
+
+    boost::optional<IdentCacheStats> getIdentCacheStats(OperationContext* opCtx,
+                                                        StringData ident) const override;
 
     Timestamp getStableTimestamp() const override;
     Timestamp getOldestTimestamp() const override;
@@ -387,6 +392,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerConcurrencyAdjuster;
 
     struct IdentToDrop {
         std::string uri;
@@ -480,6 +486,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerConcurrencyAdjuster> _concurrencyAdjuster;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -31,6 +31,7 @@
 
 #include "mongo/db/curop.h"
 #include "mongo/db/prepare_conflict_tracker.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/util/fail_point.h"
@@ -78,6 +79,7 @@ int wiredTigerPrepareConflictRetry(OperationContext* opCtx, F&& f) {
     // error other than WT_PREPARE_CONFLICT. Reset PrepareConflictTracker accordingly.
     ON_BLOCK_EXIT([opCtx] { PrepareConflictTracker::get(opCtx).endPrepareConflict(opCtx); });
     PrepareConflictTracker::get(opCtx).beginPrepareConflict(opCtx);
+    ScopedWaitEvent prepareConflictWait(opCtx, WaitEvent::kPrepareConflict);
 
     auto client = opCtx->getClient();
     if (client->isFromSystemConnection()) {
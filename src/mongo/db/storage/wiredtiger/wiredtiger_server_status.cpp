@@ -55,6 +55,11 @@ bool WiredTigerServerStatusSection::includeByDefault() const {
     return true;
 }
 
+Milliseconds WiredTigerServerStatusSection::updateInterval() const {
+    // Takes the global lock and reads every statistic of the storage engine.
+    return Milliseconds(500);
+}
+
 BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                                                        const BSONElement& configElement) const {
     Lock::GlobalLock lk(
@@ -86,7 +91,7 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
         bob.append("reason", status.reason());
     }
 
-    WiredTigerKVEngine::appendGlobalStats(bob);
+    _engine->appendGlobalStats(bob);
 
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
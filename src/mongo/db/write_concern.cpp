@@ -45,6 +45,8 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/timer_stats.h"
+#include "mongo/db/stats/wait_events.h"
+#include "mongo/db/stats/wait_latency_metrics.h"
 #include "mongo/db/storage/control/journal_flusher.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/transaction_validation.h"
@@ -314,14 +316,17 @@ Status waitForWriteConcern(OperationContext* opCtx,
                     result->fsyncFiles = 1;
                 } else {
                     // We only need to commit the journal if we're durable
+                    ScopedWaitEvent journalWait(opCtx, WaitEvent::kJournalFlush);
                     JournalFlusher::get(opCtx)->waitForJournalFlush();
                 }
                 break;
             }
-            case WriteConcernOptions::SyncMode::JOURNAL:
+            case WriteConcernOptions::SyncMode::JOURNAL: {
                 waitForNoOplogHolesIfNeeded(opCtx);
+                ScopedWaitEvent journalWait(opCtx, WaitEvent::kJournalFlush);
                 JournalFlusher::get(opCtx)->waitForJournalFlush();
                 break;
+            }
         }
     } catch (const DBException& ex) {
         return ex.toStatus();
@@ -360,6 +365,12 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     gleWtimeStats.recordMillis(durationCount<Milliseconds>(replStatus.duration));
+    WaitEventStats::record(opCtx, WaitEvent::kReplication, replStatus.duration);
+    if (replStatus.status.isOK() &&
+        writeConcernWithPopulatedSyncMode.wMode == WriteConcernOptions::kMajority) {
+        WaitLatencyMetrics::get().record(WaitLatencyMetrics::WaitType::kMajorityWriteConcern,
+                                         replStatus.duration);
+    }
     result->wTime = durationCount<Milliseconds>(replStatus.duration);
 
     result->wcUsed = writeConcern;
@@ -33,6 +33,7 @@
 
 #include "mongo/executor/connection_pool.h"
 
+#include <cmath>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
@@ -130,13 +131,18 @@ void ConnectionPool::ControllerInterface::init(ConnectionPool* pool) {
     _pool = pool;
 }
 
+Milliseconds ConnectionPool::ControllerInterface::demandHalfLife() const {
+    return _pool->_options.demandHalfLife;
+}
+
 std::string ConnectionPool::ConnectionControls::toString() const {
     return "{{ maxPending: {}, target: {}, }}"_format(maxPendingConnections, targetConnections);
 }
 
 std::string ConnectionPool::HostState::toString() const {
-    return "{{ requests: {}, ready: {}, pending: {}, active: {}, isExpired: {} }}"_format(
-        requests, ready, pending, active, health.isExpired);
+    return "{{ requests: {}, ready: {}, pending: {}, active: {}, predictedDemand: {}, "
+           "isExpired: {} }}"_format(
+               requests, ready, pending, active, predictedDemand, health.isExpired);
 }
 
 /**
@@ -160,7 +166,7 @@ public:
         const auto minConns = getPool()->_options.minConnections;
         const auto maxConns = getPool()->_options.maxConnections;
 
-        data.target = stats.requests + stats.active;
+        data.target = std::max(stats.requests + stats.active, stats.predictedDemand);
         if (data.target < minConns) {
             data.target = minConns;
         } else if (data.target > maxConns) {
@@ -320,6 +326,20 @@ public:
      */
     size_t requestsPending() const;
 
+    /**
+     * Returns the time taken to establish the connections this pool has created.
+     */
+    const ConnectionEstablishmentHistogram& establishmentLatency() const {
+        return _establishmentLatency;
+    }
+
+    /**
+     * Resets the activity timestamp so that a pool without requests is kept for hostTimeout.
+     */
+    void markActive() {
+        _lastActiveTime = _parent->_factory->now();
+    }
+
     /**
      * Returns the HostAndPort for this pool.
      */
@@ -393,6 +413,12 @@ private:
     // Update the controller and potentially change the controls
     void updateController();
 
+    // Fold the current number of in-flight requests into the decaying demand peak
+    void updateDemandEstimate();
+
+    // How long to wait before retrying a host after consecutive connection failures
+    Milliseconds hostRetryTimeout() const;
+
 private:
     const std::shared_ptr<ConnectionPool> _parent;
 
@@ -426,6 +452,16 @@ private:
 
     size_t _created = 0;
 
+    ConnectionEstablishmentHistogram _establishmentLatency;
+
+    // Number of connection attempts that failed since the last successful one, used to back off
+    // from a host that keeps failing.
+    size_t _consecutiveFailures = 0;
+
+    // Exponentially decaying peak of requests + active connections, see Options::demandHalfLife.
+    double _demandEstimate = 0.0;
+    Date_t _demandEstimateUpdated;
+
     transport::Session::TagMask _tags = transport::Session::kPending;
 
     HostHealth _health;
@@ -565,6 +601,34 @@ SemiFuture<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPo
     return std::move(connFuture).semi();
 }
 
+void ConnectionPool::warmUp(std::vector<HostAndPort> hosts) {
+    // Hop onto the executor so that callers, including controllers, never take our lock.
+    _factory->getExecutor()->schedule(
+        [weakSelf = weak_from_this(), hosts = std::move(hosts)](Status status) {
+            auto self = weakSelf.lock();
+            if (!status.isOK() || !self) {
+                return;
+            }
+
+            stdx::lock_guard lk(self->_mutex);
+            for (const auto& host : hosts) {
+                auto& pool = self->_pools[host];
+                if (pool) {
+                    continue;
+                }
+
+                LOGV2_DEBUG(5986500,
+                            2,
+                            "Warming up connection pool",
+                            "pool"_attr = self->_name,
+                            "hostAndPort"_attr = host);
+                pool = SpecificPool::make(self, host, transport::kGlobalSSLMode);
+                pool->markActive();
+                pool->updateState();
+            }
+        });
+}
+
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
     stdx::lock_guard lk(_mutex);
 
@@ -576,6 +640,7 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
                                      pool->availableConnections(),
                                      pool->createdConnections(),
                                      pool->refreshingConnections()};
+        hostStats.establishmentLatency = pool->establishmentLatency();
         stats->updateStatsForHost(_name, host, hostStats);
     }
 }
@@ -747,6 +812,7 @@ void ConnectionPool::SpecificPool::finishRefresh(ConnectionInterface* connPtr, S
 
     // Pass a failure on through
     if (!status.isOK()) {
+        ++_consecutiveFailures;
         LOGV2_DEBUG(22563,
                     kDiagnosticLogLevel,
                     "Connection failed to {hostAndPort} due to {error}",
@@ -773,6 +839,8 @@ void ConnectionPool::SpecificPool::finishRefresh(ConnectionInterface* connPtr, S
                 "Finishing connection refresh",
                 "hostAndPort"_attr = _hostAndPort);
 
+    _consecutiveFailures = 0;
+
     // If the connection refreshed successfully, throw it back in the ready pool
     addToReady(std::move(conn));
 
@@ -1051,7 +1119,11 @@ void ConnectionPool::SpecificPool::spawnConnections() {
 
         // Run the setup callback
         handle->setup(_parent->_controller->pendingTimeout(),
-                      guardCallback([this](auto conn, auto status) {
+                      guardCallback([this, start = _parent->_factory->now()](auto conn,
+                                                                             auto status) {
+                          if (status.isOK()) {
+                              _establishmentLatency.record(_parent->_factory->now() - start);
+                          }
                           finishRefresh(std::move(conn), std::move(status));
                       }));
     }
@@ -1097,7 +1169,7 @@ void ConnectionPool::SpecificPool::updateEventTimer() {
     // If our pending event has triggered, then schedule a retry as the next event
     auto nextEventTime = _eventTimerExpiration;
     if (nextEventTime <= now) {
-        nextEventTime = now + kHostRetryTimeout;
+        nextEventTime = now + hostRetryTimeout();
     }
 
     // If our expiration comes before our next event, then it is the next event
@@ -1145,6 +1217,37 @@ void ConnectionPool::SpecificPool::updateEventTimer() {
     _eventTimer->setTimeout(timeout, std::move(deferredStateUpdateFunc));
 }
 
+Milliseconds ConnectionPool::SpecificPool::hostRetryTimeout() const {
+    if (!_health.isFailed || _consecutiveFailures <= 1) {
+        return kHostRetryTimeout;
+    }
+
+    // Double the retry timeout for every consecutive failure, up to kMaxHostRetryTimeout.
+    auto timeout = kHostRetryTimeout;
+    for (size_t i = 1; i < _consecutiveFailures && timeout < kMaxHostRetryTimeout; ++i) {
+        timeout *= 2;
+    }
+    return std::min(timeout, kMaxHostRetryTimeout);
+}
+
+void ConnectionPool::SpecificPool::updateDemandEstimate() {
+    const auto now = _parent->_factory->now();
+    const auto demand = static_cast<double>(requestsPending() + inUseConnections());
+    const auto halfLife = _parent->_controller->demandHalfLife();
+
+    if (halfLife <= Milliseconds(0) || now <= _demandEstimateUpdated) {
+        _demandEstimate = halfLife <= Milliseconds(0) ? demand : std::max(_demandEstimate, demand);
+    } else {
+        // Decay the previous peak by how long ago it was seen, but never below the current demand,
+        // so that a burst is absorbed immediately and forgotten gradually.
+        const auto elapsed = durationCount<Milliseconds>(now - _demandEstimateUpdated);
+        const auto decay =
+            std::exp2(-static_cast<double>(elapsed) / durationCount<Milliseconds>(halfLife));
+        _demandEstimate = std::max(_demandEstimate * decay, demand);
+    }
+    _demandEstimateUpdated = std::max(now, _demandEstimateUpdated);
+}
+
 void ConnectionPool::SpecificPool::updateController() {
     if (_health.isShutdown) {
         return;
@@ -1152,6 +1255,8 @@ void ConnectionPool::SpecificPool::updateController() {
 
     auto& controller = *_parent->_controller;
 
+    updateDemandEstimate();
+
     // Update our own state
     HostState state{
         _health,
@@ -1159,6 +1264,7 @@ void ConnectionPool::SpecificPool::updateController() {
         refreshingConnections(),
         availableConnections(),
         inUseConnections(),
+        static_cast<size_t>(std::lround(_demandEstimate)),
     };
     LOGV2_DEBUG(22578,
                 kDiagnosticLogLevel,
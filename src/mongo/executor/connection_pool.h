@@ -32,6 +32,7 @@
 #include <functional>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "mongo/config.h"
 #include "mongo/executor/egress_tag_closer.h"
@@ -90,6 +91,8 @@ public:
     static constexpr Milliseconds kDefaultRefreshRequirement = Minutes(1);
     static constexpr Milliseconds kDefaultRefreshTimeout = Seconds(20);
     static constexpr Milliseconds kHostRetryTimeout = Seconds(1);
+    static constexpr Milliseconds kMaxHostRetryTimeout = Seconds(30);
+    static constexpr Milliseconds kDefaultDemandHalfLife = Milliseconds(0);
 
     static const Status kConnectionStateUnknown;
 
@@ -139,6 +142,13 @@ public:
          */
         Milliseconds hostTimeout = kDefaultHostTimeout;
 
+        /**
+         * Half-life of the exponentially decaying peak of in-flight requests kept for each host.
+         * Controllers size a pool to at least this estimate so that connections established for
+         * a burst are kept for the next one. Zero sizes pools from their current demand only.
+         */
+        Milliseconds demandHalfLife = kDefaultDemandHalfLife;
+
         /**
          * An egress tag closer manager which will provide global access to this connection pool.
          * The manager set's tags and potentially drops connections that don't match those tags.
@@ -210,6 +220,7 @@ public:
         size_t pending = 0;
         size_t ready = 0;
         size_t active = 0;
+        size_t predictedDemand = 0;
 
         std::string toString() const;
     };
@@ -259,6 +270,12 @@ public:
                      Milliseconds timeout,
                      GetConnectionCallback cb);
 
+    /**
+     * Asynchronously creates a pool for each of the given hosts which does not already have one, so
+     * that connections to it are established before the first request needs them.
+     */
+    void warmUp(std::vector<HostAndPort> hosts);
+
     void appendConnectionStats(ConnectionPoolStats* stats) const;
 
     size_t getNumConnectionsPerHost(const HostAndPort& hostAndPort) const;
@@ -433,7 +450,8 @@ private:
  *
  * Generally speaking, a Controller will be given HostState via updateState and then return Controls
  * via getControls. A Controller is expected to not directly mutate its SpecificPool, including via
- * its ConnectionPool pointer. A Controller is expected to be given to only one ConnectionPool.
+ * its ConnectionPool pointer, other than through the asynchronous ConnectionPool::warmUp(). A
+ * Controller is expected to be given to only one ConnectionPool.
  */
 class ConnectionPool::ControllerInterface {
 public:
@@ -481,6 +499,11 @@ public:
     virtual Milliseconds pendingTimeout() const = 0;
     virtual Milliseconds toRefreshTimeout() const = 0;
 
+    /**
+     * Get the half-life of the in-flight request peak reported as HostState::predictedDemand
+     */
+    virtual Milliseconds demandHalfLife() const;
+
     /**
      * Get the name for this controller
      *
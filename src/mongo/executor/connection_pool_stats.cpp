@@ -31,11 +31,55 @@
 
 #include "mongo/executor/connection_pool_stats.h"
 
+#include <limits>
+
 #include "mongo/bson/bsonobjbuilder.h"
 
 namespace mongo {
 namespace executor {
 
+void ConnectionEstablishmentHistogram::record(Milliseconds latency) {
+    size_t bucket = 0;
+    while (bucket < kNumBuckets - 1 && latency >= Milliseconds(1ll << bucket)) {
+        ++bucket;
+    }
+    ++buckets[bucket];
+    ++count;
+    totalLatency += latency;
+}
+
+ConnectionEstablishmentHistogram& ConnectionEstablishmentHistogram::operator+=(
+    const ConnectionEstablishmentHistogram& other) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    totalLatency += other.totalLatency;
+
+    return *this;
+}
+
+void ConnectionEstablishmentHistogram::appendToBSON(BSONObjBuilder& builder) const {
+    BSONObjBuilder histogramBuilder(builder.subobjStart("establishmentLatency"));
+    histogramBuilder.appendNumber("count", static_cast<long long>(count));
+    histogramBuilder.appendNumber("totalMillis", durationCount<Milliseconds>(totalLatency));
+
+    BSONArrayBuilder bucketsBuilder(histogramBuilder.subarrayStart("histogram"));
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        if (buckets[i] == 0) {
+            continue;
+        }
+
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        if (i < kNumBuckets - 1) {
+            bucketBuilder.appendNumber("lessThanMillis", 1ll << i);
+        } else {
+            bucketBuilder.appendNumber("lessThanMillis", std::numeric_limits<long long>::max());
+        }
+        bucketBuilder.appendNumber("count", static_cast<long long>(buckets[i]));
+    }
+}
+
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
                                        size_t nCreated,
@@ -49,6 +93,7 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    establishmentLatency += other.establishmentLatency;
 
     return *this;
 }
@@ -74,6 +119,7 @@ void ConnectionPoolStats::updateStatsForHost(std::string pool,
     totalAvailable += newStats.available;
     totalCreated += newStats.created;
     totalRefreshing += newStats.refreshing;
+    totalEstablishmentLatency += newStats.establishmentLatency;
 }
 
 void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFTDC) {
@@ -81,6 +127,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
     result.appendNumber("totalAvailable", totalAvailable);
     result.appendNumber("totalCreated", totalCreated);
     result.appendNumber("totalRefreshing", totalRefreshing);
+    totalEstablishmentLatency.appendToBSON(result);
 
     if (forFTDC) {
         BSONObjBuilder poolBuilder(result.subobjStart("connectionsInUsePerPool"));
@@ -114,6 +161,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
                 hostInfo.appendNumber("available", hostStats.available);
                 hostInfo.appendNumber("created", hostStats.created);
                 hostInfo.appendNumber("refreshing", hostStats.refreshing);
+                hostStats.establishmentLatency.appendToBSON(hostInfo);
             }
         }
     }
@@ -126,6 +174,7 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             hostInfo.appendNumber("available", hostStats.available);
             hostInfo.appendNumber("created", hostStats.created);
             hostInfo.appendNumber("refreshing", hostStats.refreshing);
+            hostStats.establishmentLatency.appendToBSON(hostInfo);
         }
     }
 }
@@ -29,12 +29,37 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
+
+class BSONObjBuilder;
+
 namespace executor {
 
+/**
+ * Histogram of the time taken to establish connections, including any handshake and
+ * authentication. Bucket i counts connections established in less than 2^i milliseconds; the last
+ * bucket counts everything slower.
+ */
+struct ConnectionEstablishmentHistogram {
+    static constexpr size_t kNumBuckets = 16;
+
+    void record(Milliseconds latency);
+
+    ConnectionEstablishmentHistogram& operator+=(const ConnectionEstablishmentHistogram& other);
+
+    void appendToBSON(BSONObjBuilder& builder) const;
+
+    std::array<size_t, kNumBuckets> buckets{};
+    size_t count = 0u;
+    Milliseconds totalLatency{0};
+};
+
 /**
  * Holds connection information for a specific pool or remote host. These objects are maintained by
  * a parent ConnectionPoolStats object and should not need to be created directly.
@@ -50,6 +75,7 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+    ConnectionEstablishmentHistogram establishmentLatency;
 };
 
 /**
@@ -66,6 +92,7 @@ struct ConnectionPoolStats {
     size_t totalAvailable = 0u;
     size_t totalCreated = 0u;
     size_t totalRefreshing = 0u;
+    ConnectionEstablishmentHistogram totalEstablishmentLatency;
 
     using StatsByHost = std::map<HostAndPort, ConnectionStatsPer>;
 
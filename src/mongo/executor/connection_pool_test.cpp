@@ -41,6 +41,7 @@
 #include <fmt/ostream.h>
 
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -1530,6 +1531,106 @@ TEST_F(ConnectionPoolTest, ReturnAfterShutdown) {
     pool->shutdown();
 }
 
+/**
+ * Verify that warming up a host establishes its minimum connections before any request.
+ */
+TEST_F(ConnectionPoolTest, WarmUpEstablishesMinConnections) {
+    ConnectionPool::Options options;
+    options.minConnections = 2;
+    auto pool = makePool(options);
+
+    pool->warmUp({HostAndPort()});
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 2u);
+
+    ConnectionImpl::pushSetup(Status::OK());
+    ConnectionImpl::pushSetup(Status::OK());
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 2u);
+
+    // The first request is served from the warm pool without a new setup.
+    bool reachedA = false;
+    pool->get_forTest(HostAndPort(),
+                      Milliseconds(5000),
+                      [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                          ASSERT(swConn.isOK());
+                          doneWith(swConn.getValue());
+                          reachedA = true;
+                      });
+    ASSERT(reachedA);
+    ASSERT_EQ(ConnectionImpl::setupQueueDepth(), 0u);
+}
+
+/**
+ * Verify that the time taken to set up connections is reported per host.
+ */
+TEST_F(ConnectionPoolTest, EstablishmentLatencyIsReported) {
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    auto pool = makePool();
+
+    ConnectionImpl::pushSetup([&] {
+        PoolImpl::setNow(now + Milliseconds(5));
+        return Status::OK();
+    });
+    pool->get_forTest(HostAndPort(),
+                      Milliseconds(5000),
+                      [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                          ASSERT(swConn.isOK());
+                          doneWith(swConn.getValue());
+                      });
+
+    ConnectionPoolStats stats;
+    pool->appendConnectionStats(&stats);
+
+    const auto& histogram = stats.statsByHost[HostAndPort()].establishmentLatency;
+    ASSERT_EQ(histogram.count, 1u);
+    ASSERT_EQ(histogram.totalLatency, Milliseconds(5));
+    ASSERT_EQ(histogram.buckets[3], 1u);
+    ASSERT_EQ(stats.totalEstablishmentLatency.count, 1u);
+}
+
+/**
+ * Verify that connections established for a burst are refreshed rather than dropped while the
+ * demand estimate remembers the burst.
+ */
+TEST_F(ConnectionPoolTest, PredictedDemandKeepsConnectionsAfterBurst) {
+    ConnectionPool::Options options;
+    options.minConnections = 0;
+    options.refreshRequirement = Milliseconds(1000);
+    options.refreshTimeout = Milliseconds(500);
+    options.hostTimeout = Minutes(10);
+    options.demandHalfLife = Minutes(10);
+    auto pool = makePool(options);
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    std::vector<ConnectionPool::ConnectionHandle> connections;
+    for (int i = 0; i < 2; ++i) {
+        ConnectionImpl::pushSetup(Status::OK());
+        pool->get_forTest(HostAndPort(),
+                          Milliseconds(5000),
+                          [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                              ASSERT(swConn.isOK());
+                              connections.push_back(std::move(swConn.getValue()));
+                          });
+    }
+    ASSERT_EQ(connections.size(), 2u);
+
+    for (auto& conn : connections) {
+        doneWith(conn);
+    }
+    connections.clear();
+
+    // Once the connections need a refresh, the pool is idle, but the burst is still remembered.
+    PoolImpl::setNow(now + Milliseconds(1000));
+    ASSERT_EQ(ConnectionImpl::refreshQueueDepth(), 2u);
+
+    ConnectionImpl::pushRefresh(Status::OK());
+    ConnectionImpl::pushRefresh(Status::OK());
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 2u);
+}
+
 }  // namespace connection_pool_test_details
 }  // namespace executor
 }  // namespace mongo
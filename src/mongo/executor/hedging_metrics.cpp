@@ -29,12 +29,23 @@
 
 #include "mongo/executor/hedging_metrics.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include <absl/hash/hash.h>
+
 namespace mongo {
 
 namespace {
 const auto HedgingMetricsDecoration = ServiceContext::declareDecoration<HedgingMetrics>();
 }  // namespace
 
+HedgingMetrics::~HedgingMetrics() {
+    for (auto& slot : _latencyByHost) {
+        delete slot.load();
+    }
+}
+
 HedgingMetrics* HedgingMetrics::get(ServiceContext* service) {
     return &HedgingMetricsDecoration(service);
 }
@@ -67,12 +78,127 @@ void HedgingMetrics::incrementNumAdvantageouslyHedgedOperations() {
     _numAdvantageouslyHedgedOperations.fetchAndAdd(1);
 }
 
+long long HedgingMetrics::getNumHedgesSkippedForBudget() const {
+    return _numHedgesSkippedForBudget.load();
+}
+
+HedgingMetrics::HostLatency* HedgingMetrics::_findHostLatency(const HostAndPort& host,
+                                                              bool create) const {
+    const auto start = absl::Hash<HostAndPort>{}(host);
+    for (size_t i = 0; i < kMaxLatencyHosts; ++i) {
+        auto& slot = _latencyByHost[(start + i) % kMaxLatencyHosts];
+        auto hostLatency = slot.load();
+        if (!hostLatency) {
+            if (!create) {
+                return nullptr;
+            }
+
+            auto newHostLatency = std::make_unique<HostLatency>(host);
+            if (slot.compareAndSwap(&hostLatency, newHostLatency.get())) {
+                return newHostLatency.release();
+            }
+            // Another thread filled the slot first, and 'hostLatency' now holds what it stored.
+        }
+        if (hostLatency->host == host) {
+            return hostLatency;
+        }
+    }
+    return nullptr;
+}
+
+void HedgingMetrics::recordLatency(const HostAndPort& host, Milliseconds latency) {
+    if (auto hostLatency = _findHostLatency(host, true /* create */)) {
+        hostLatency->histogram.record(latency);
+    }
+}
+
+boost::optional<Milliseconds> HedgingMetrics::getLatencyPercentile(const HostAndPort& host,
+                                                                   int percentile) const {
+    auto hostLatency = _findHostLatency(host, false /* create */);
+    if (!hostLatency) {
+        return boost::none;
+    }
+    return hostLatency->histogram.getPercentile(percentile);
+}
+
+void HedgingMetrics::creditHedgeBudget(int maxHedgedOperationsPercent) {
+    auto budget = _hedgeBudget.load();
+    long long newBudget;
+    do {
+        newBudget = std::min(budget + maxHedgedOperationsPercent, kMaxHedgeBudget * 100);
+    } while (!_hedgeBudget.compareAndSwap(&budget, newBudget));
+}
+
+bool HedgingMetrics::tryConsumeHedgeBudget() {
+    auto budget = _hedgeBudget.load();
+    do {
+        if (budget < 100) {
+            _numHedgesSkippedForBudget.fetchAndAdd(1);
+            return false;
+        }
+    } while (!_hedgeBudget.compareAndSwap(&budget, budget - 100));
+    return true;
+}
+
+void HedgingMetrics::LatencyHistogram::record(Milliseconds latency) {
+    size_t bucket = 0;
+    if (latency > Milliseconds(1)) {
+        bucket = std::min(
+            static_cast<size_t>(std::ceil(std::log(static_cast<double>(latency.count())) /
+                                          std::log(kBucketGrowth))),
+            kNumBuckets - 1);
+    }
+    _buckets[bucket].fetchAndAdd(1);
+
+    // The count only grows one sample at a time, so exactly one recorder reaches the window and
+    // halves the histogram.
+    if (_count.addAndFetch(1) != kLatencyWindow) {
+        return;
+    }
+
+    long long removed = 0;
+    for (auto& bucketCount : _buckets) {
+        auto count = bucketCount.load();
+        while (!bucketCount.compareAndSwap(&count, count / 2)) {
+        }
+        removed += count - count / 2;
+    }
+    _count.subtractAndFetch(removed);
+}
+
+boost::optional<Milliseconds> HedgingMetrics::LatencyHistogram::getPercentile(
+    int percentile) const {
+    if (_count.load() < kMinLatencySamples) {
+        return boost::none;
+    }
+
+    // Rank against a snapshot of the buckets, since they may change while being read.
+    std::array<long long, kNumBuckets> buckets;
+    long long total = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        buckets[i] = _buckets[i].load();
+        total += buckets[i];
+    }
+
+    const auto rank = static_cast<long long>(std::ceil(total * percentile / 100.0));
+    long long seen = 0;
+    size_t bucket = 0;
+    for (; bucket < kNumBuckets - 1; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            break;
+        }
+    }
+    return Milliseconds(static_cast<long long>(std::ceil(std::pow(kBucketGrowth, bucket))));
+}
+
 BSONObj HedgingMetrics::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("numTotalOperations", _numTotalOperations.load());
     builder.append("numTotalHedgedOperations", _numTotalHedgedOperations.load());
     builder.append("numAdvantageouslyHedgedOperations", _numAdvantageouslyHedgedOperations.load());
+    builder.append("numHedgesSkippedForBudget", _numHedgesSkippedForBudget.load());
 
     return builder.obj();
 }
@@ -29,13 +29,23 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 /**
  * Container for server-wide hedging metrics.
+ *
+ * Besides the counters reported in serverStatus, this tracks the recent round-trip time of
+ * hedgeable requests per target host, so that a hedge can be held back until the first request has
+ * been outstanding longer than a chosen percentile of its host's latency, and a budget that bounds
+ * the share of hedgeable operations which actually send a hedge.
  */
 class HedgingMetrics {
     HedgingMetrics(const HedgingMetrics&) = delete;
@@ -43,6 +53,7 @@ class HedgingMetrics {
 
 public:
     HedgingMetrics() = default;
+    ~HedgingMetrics();
 
     static HedgingMetrics* get(ServiceContext* service);
     static HedgingMetrics* get(OperationContext* opCtx);
@@ -56,9 +67,89 @@ public:
     long long getNumAdvantageouslyHedgedOperations() const;
     void incrementNumAdvantageouslyHedgedOperations();
 
+    long long getNumHedgesSkippedForBudget() const;
+
+    /**
+     * Records the round-trip time of a hedgeable request served by 'host'. Takes no lock, and drops
+     * the sample if latencies are already being tracked for kMaxLatencyHosts other hosts.
+     */
+    void recordLatency(const HostAndPort& host, Milliseconds latency);
+
+    /**
+     * Returns the given percentile of the round-trip times recently recorded for 'host', or
+     * boost::none if too few have been recorded for it to be meaningful.
+     */
+    boost::optional<Milliseconds> getLatencyPercentile(const HostAndPort& host,
+                                                       int percentile) const;
+
+    /**
+     * Credits the hedge budget for one hedgeable operation, of which at most
+     * 'maxHedgedOperationsPercent' percent may send a hedge.
+     */
+    void creditHedgeBudget(int maxHedgedOperationsPercent);
+
+    /**
+     * Consumes the budget for one hedge. Returns false, and counts the hedge as skipped, if the
+     * budget is exhausted.
+     */
+    bool tryConsumeHedgeBudget();
+
     BSONObj toBSON() const;
 
+    // Number of latency samples a host needs before its percentiles are used.
+    static constexpr long long kMinLatencySamples = 20;
+
+    // Once a host has this many samples, its histogram is halved so that old samples age out.
+    static constexpr long long kLatencyWindow = 1024;
+
+    // The most hedges the budget can accumulate while operations are not being hedged.
+    static constexpr long long kMaxHedgeBudget = 100;
+
+    // The most hosts whose latencies are tracked.
+    static constexpr size_t kMaxLatencyHosts = 1024;
+
 private:
+    /**
+     * Log-bucketed histogram of latencies, where bucket i counts latencies of at most
+     * kBucketGrowth^i milliseconds. Concurrent readers may observe a sample in its bucket before it
+     * is counted, or the other way around.
+     */
+    class LatencyHistogram {
+    public:
+        void record(Milliseconds latency);
+        boost::optional<Milliseconds> getPercentile(int percentile) const;
+
+    private:
+        static constexpr size_t kNumBuckets = 64;
+        static constexpr double kBucketGrowth = 1.25;
+
+        std::array<AtomicWord<long long>, kNumBuckets> _buckets;
+        AtomicWord<long long> _count{0};
+    };
+
+    struct HostLatency {
+        explicit HostLatency(const HostAndPort& host) : host(host) {}
+
+        const HostAndPort host;
+        LatencyHistogram histogram;
+    };
+
+    /**
+     * Returns the latencies tracked for 'host', starting to track them if 'create' is true and
+     * there is room. Returns nullptr otherwise.
+     */
+    HostLatency* _findHostLatency(const HostAndPort& host, bool create) const;
+
+    // Open-addressed table of per-host latencies. Slots are filled by compare-and-swap and never
+    // emptied, so that recording a latency takes no lock.
+    mutable std::array<AtomicWord<HostLatency*>, kMaxLatencyHosts> _latencyByHost;
+
+    // Hedges the budget currently allows, in hundredths of a hedge.
+    AtomicWord<long long> _hedgeBudget{0};
+
+    // The number of hedges that were not sent because the hedge budget was exhausted.
+    AtomicWord<long long> _numHedgesSkippedForBudget{0};
+
     // The number of all operations with readPreference options such that they could be hedged.
     AtomicWord<long long> _numTotalOperations{0};
 
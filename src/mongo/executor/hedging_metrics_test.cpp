@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/executor/hedging_metrics.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const HostAndPort kHost("a", 1);
+
+TEST(HedgingMetricsTest, NoLatencyPercentileUntilEnoughSamples) {
+    HedgingMetrics hm;
+    ASSERT_FALSE(hm.getLatencyPercentile(kHost, 95));
+
+    for (long long i = 0; i < HedgingMetrics::kMinLatencySamples - 1; ++i) {
+        hm.recordLatency(kHost, Milliseconds(10));
+    }
+    ASSERT_FALSE(hm.getLatencyPercentile(kHost, 95));
+
+    hm.recordLatency(kHost, Milliseconds(10));
+    ASSERT_TRUE(hm.getLatencyPercentile(kHost, 95));
+    ASSERT_FALSE(hm.getLatencyPercentile(HostAndPort("b", 1), 95));
+}
+
+TEST(HedgingMetricsTest, LatencyPercentileBoundsRecordedLatencies) {
+    HedgingMetrics hm;
+    for (int i = 0; i < 95; ++i) {
+        hm.recordLatency(kHost, Milliseconds(10));
+    }
+    for (int i = 0; i < 5; ++i) {
+        hm.recordLatency(kHost, Milliseconds(1000));
+    }
+
+    // Buckets grow by a quarter, so a percentile may overestimate by that much.
+    auto p95 = *hm.getLatencyPercentile(kHost, 95);
+    ASSERT_GTE(p95, Milliseconds(10));
+    ASSERT_LTE(p95, Milliseconds(13));
+
+    auto p99 = *hm.getLatencyPercentile(kHost, 99);
+    ASSERT_GTE(p99, Milliseconds(1000));
+    ASSERT_LTE(p99, Milliseconds(1250));
+}
+
+TEST(HedgingMetricsTest, OldLatenciesAgeOut) {
+    HedgingMetrics hm;
+    for (long long i = 0; i < HedgingMetrics::kLatencyWindow; ++i) {
+        hm.recordLatency(kHost, Milliseconds(1000));
+    }
+    for (long long i = 0; i < 4 * HedgingMetrics::kLatencyWindow; ++i) {
+        hm.recordLatency(kHost, Milliseconds(10));
+    }
+    ASSERT_LTE(*hm.getLatencyPercentile(kHost, 95), Milliseconds(13));
+}
+
+TEST(HedgingMetricsTest, ConcurrentlyRecordedLatenciesAreAllCounted) {
+    HedgingMetrics hm;
+    const HostAndPort hosts[] = {HostAndPort("a", 1), HostAndPort("b", 1)};
+
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 500; ++i) {
+                hm.recordLatency(hosts[t % 2], Milliseconds(10));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& host : hosts) {
+        auto p50 = *hm.getLatencyPercentile(host, 50);
+        ASSERT_GTE(p50, Milliseconds(10));
+        ASSERT_LTE(p50, Milliseconds(13));
+    }
+}
+
+TEST(HedgingMetricsTest, LatenciesOfHostsBeyondTheCapAreDropped) {
+    HedgingMetrics hm;
+    for (size_t i = 0; i < HedgingMetrics::kMaxLatencyHosts; ++i) {
+        HostAndPort host("a", static_cast<int>(i + 1));
+        for (long long j = 0; j < HedgingMetrics::kMinLatencySamples; ++j) {
+            hm.recordLatency(host, Milliseconds(10));
+        }
+        ASSERT_TRUE(hm.getLatencyPercentile(host, 95));
+    }
+
+    HostAndPort extraHost("b", 1);
+    for (long long j = 0; j < HedgingMetrics::kMinLatencySamples; ++j) {
+        hm.recordLatency(extraHost, Milliseconds(10));
+    }
+    ASSERT_FALSE(hm.getLatencyPercentile(extraHost, 95));
+}
+
+TEST(HedgingMetricsTest, HedgeBudgetLimitsShareOfHedgedOperations) {
+    HedgingMetrics hm;
+    int hedged = 0;
+    for (int i = 0; i < 1000; ++i) {
+        hm.creditHedgeBudget(5);
+        if (hm.tryConsumeHedgeBudget()) {
+            ++hedged;
+        }
+    }
+    ASSERT_EQ(hedged, 50);
+    ASSERT_EQ(hm.getNumHedgesSkippedForBudget(), 950);
+}
+
+TEST(HedgingMetricsTest, HedgeBudgetAccumulationIsCapped) {
+    HedgingMetrics hm;
+    for (long long i = 0; i < 10 * HedgingMetrics::kMaxHedgeBudget; ++i) {
+        hm.creditHedgeBudget(100);
+    }
+
+    int hedged = 0;
+    while (hm.tryConsumeHedgeBudget()) {
+        ++hedged;
+    }
+    ASSERT_EQ(hedged, HedgingMetrics::kMaxHedgeBudget);
+}
+
+TEST(HedgingMetricsTest, FullBudgetHedgesEveryOperation) {
+    HedgingMetrics hm;
+    for (int i = 0; i < 1000; ++i) {
+        hm.creditHedgeBudget(100);
+        ASSERT_TRUE(hm.tryConsumeHedgeBudget());
+    }
+    ASSERT_EQ(hm.getNumHedgesSkippedForBudget(), 0);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -412,6 +412,8 @@ void NetworkInterfaceTL::CommandStateBase::tryFinish(Status status) noexcept {
     }
 
     invariant(requestManager);
+    requestManager->cancelHedgeTimers();
+
     if (operationKey &&
         !MONGO_unlikely(networkInterfaceShouldNotKillPendingRequests.shouldFail())) {
         // Kill operations for requests that we didn't use to fulfill the promise.
@@ -498,6 +500,7 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         auto hm = HedgingMetrics::get(_svcCtx);
         invariant(hm);
         hm->incrementNumTotalOperations();
+        hm->creditHedgeBudget(cmdState->requestOnAny.hedgeOptions->maxHedgedOperationsPercent);
     }
 
     // When our command finishes, run onFinish out of line.
@@ -663,14 +666,104 @@ void NetworkInterfaceTL::RequestManager::killOperationsForPendingRequests() {
     }
 }
 
+void NetworkInterfaceTL::RequestManager::cancelHedgeTimers() {
+    std::vector<std::shared_ptr<transport::ReactorTimer>> timers;
+    {
+        stdx::lock_guard<Latch> lk(mutex);
+        isLocked = true;
+        timers = std::exchange(hedgeTimers, {});
+    }
+
+    for (auto& timer : timers) {
+        timer->cancel(cmdState->baton);
+    }
+}
+
+boost::optional<Milliseconds> NetworkInterfaceTL::RequestManager::getHedgeDelay(WithLock) {
+    const auto& hedgeOptions = cmdState->requestOnAny.hedgeOptions;
+    auto svcCtx = cmdState->interface->_svcCtx;
+    if (!hedgeOptions || hedgeOptions->hedgeDelayPercentile <= 0 || !svcCtx) {
+        return boost::none;
+    }
+
+    auto firstRequest = requests.front().lock();
+    if (!firstRequest) {
+        return boost::none;
+    }
+
+    auto threshold = HedgingMetrics::get(svcCtx)->getLatencyPercentile(
+        firstRequest->host, hedgeOptions->hedgeDelayPercentile);
+    if (!threshold) {
+        return boost::none;
+    }
+
+    auto remaining = *threshold - firstRequest->stopwatch.elapsed();
+    if (remaining <= Milliseconds(0)) {
+        return boost::none;
+    }
+    return remaining;
+}
+
+void NetworkInterfaceTL::RequestManager::sendHedgeAfterDelay(size_t idx,
+                                                             Milliseconds delay) noexcept {
+    LOGV2_DEBUG(5986400,
+                2,
+                "Delaying hedged request",
+                "requestId"_attr = cmdState->requestOnAny.id,
+                "target"_attr = cmdState->requestOnAny.target[idx],
+                "delay"_attr = delay);
+
+    auto& reactor = cmdState->interface->_reactor;
+    std::shared_ptr<transport::ReactorTimer> timer = reactor->makeTimer();
+    {
+        stdx::lock_guard<Latch> lk(mutex);
+        if (isLocked) {
+            return;
+        }
+        hedgeTimers.push_back(timer);
+    }
+
+    timer->waitUntil(reactor->now() + delay, cmdState->baton)
+        .getAsync([this, anchor = cmdState->shared_from_this(), idx](Status status) {
+            if (!status.isOK()) {
+                // The command finished first, or the reactor or baton is going away.
+                return;
+            }
+
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                if (isLocked || sentIdx >= cmdState->maxConcurrentRequests()) {
+                    return;
+                }
+            }
+
+            const auto& request = cmdState->requestOnAny;
+            auto connFuture = cmdState->interface->_pool->get(
+                request.target[idx], request.sslMode, request.timeout);
+            if (connFuture.isReady()) {
+                trySend(std::move(connFuture).getNoThrow(), idx, true /* hedgeDelayElapsed */);
+                return;
+            }
+
+            std::move(connFuture)
+                .thenRunOn(cmdState->interface->_reactor)
+                .getAsync([this, anchor = std::move(anchor), idx](auto swConn) {
+                    trySend(std::move(swConn), idx, true /* hedgeDelayElapsed */);
+                });
+        });
+}
+
 void NetworkInterfaceTL::RequestManager::trySend(
-    StatusWith<ConnectionPool::ConnectionHandle> swConn, size_t idx) noexcept {
+    StatusWith<ConnectionPool::ConnectionHandle> swConn,
+    size_t idx,
+    bool hedgeDelayElapsed) noexcept {
     // Our connection wasn't any good
     if (!swConn.isOK()) {
         {
             stdx::lock_guard<Latch> lk(mutex);
 
-            auto currentConnsResolved = ++connsResolved;
+            // A connection for a delayed hedge was already counted when the first one resolved.
+            auto currentConnsResolved = hedgeDelayElapsed ? connsResolved : ++connsResolved;
             if (currentConnsResolved < cmdState->maxPossibleConns()) {
                 // If we still have connections outstanding, we don't need to fail the promise.
                 return;
@@ -705,10 +798,13 @@ void NetworkInterfaceTL::RequestManager::trySend(
     std::shared_ptr<RequestState> requestState;
 
     {
-        stdx::lock_guard<Latch> lk(mutex);
+        stdx::unique_lock<Latch> lk(mutex);
 
-        // Increment the number of conns we were able to resolve.
-        ++connsResolved;
+        // Increment the number of conns we were able to resolve. A connection acquired for a
+        // delayed hedge was already counted when the first one resolved.
+        if (!hedgeDelayElapsed) {
+            ++connsResolved;
+        }
 
         auto haveSentAll = sentIdx >= cmdState->maxConcurrentRequests();
         if (haveSentAll || isLocked) {
@@ -718,6 +814,28 @@ void NetworkInterfaceTL::RequestManager::trySend(
             return;
         }
 
+        if (sentIdx > 0) {
+            if (auto hedgeDelay = hedgeDelayElapsed ? boost::none : getHedgeDelay(lk)) {
+                // Return the connection rather than hold it for the delay, since the first
+                // request usually answers before the hedge is due.
+                lk.unlock();
+                swConn.getValue()->indicateSuccess();
+                sendHedgeAfterDelay(idx, *hedgeDelay);
+                return;
+            }
+
+            auto svcCtx = cmdState->interface->_svcCtx;
+            if (svcCtx && !HedgingMetrics::get(svcCtx)->tryConsumeHedgeBudget()) {
+                LOGV2_DEBUG(5986401,
+                            2,
+                            "Skipping hedged request because the hedge budget is exhausted",
+                            "requestId"_attr = cmdState->requestOnAny.id,
+                            "target"_attr = cmdState->requestOnAny.target[idx]);
+                swConn.getValue()->indicateSuccess();
+                return;
+            }
+        }
+
         auto currentSentIdx = sentIdx++;
 
         requestState = std::make_shared<RequestState>(this, cmdState->shared_from_this(), idx);
@@ -821,6 +939,12 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
             returnConnection(status);
 
             const auto commandStatus = getStatusFromCommandResult(response.data);
+            if (status.isOK() && commandStatus.isOK() && response.elapsed &&
+                cmdState->requestOnAny.hedgeOptions && cmdState->interface->_svcCtx) {
+                // Feed the hedge delay of later operations targeting this host.
+                HedgingMetrics::get(cmdState->interface->_svcCtx)
+                    ->recordLatency(host, duration_cast<Milliseconds>(*response.elapsed));
+            }
             if (isHedge) {
                 // Ignore maxTimeMS expiration, StaleDbVersion or any error belonging to
                 // StaleShardVersionError
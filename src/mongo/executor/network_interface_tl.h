@@ -233,10 +233,35 @@ private:
     struct RequestManager {
         RequestManager(CommandStateBase* cmdState);
 
-        void trySend(StatusWith<ConnectionPool::ConnectionHandle> swConn, size_t idx) noexcept;
+        /**
+         * Sends a request on the given connection unless the command is already satisfied. A
+         * hedge is held back until the hedge delay has elapsed, after which it is retried with
+         * 'hedgeDelayElapsed' set, and is dropped if the hedge budget is exhausted.
+         */
+        void trySend(StatusWith<ConnectionPool::ConnectionHandle> swConn,
+                     size_t idx,
+                     bool hedgeDelayElapsed = false) noexcept;
         void cancelRequests();
         void killOperationsForPendingRequests();
 
+        /**
+         * Cancels the timers of hedges that are still being held back, since the command has
+         * finished.
+         */
+        void cancelHedgeTimers();
+
+        /**
+         * Returns how much longer a hedge should wait for the first request before being sent, or
+         * boost::none if it should be sent right away.
+         */
+        boost::optional<Milliseconds> getHedgeDelay(WithLock);
+
+        /**
+         * Waits until 'delay' has elapsed and then acquires a connection to the target at 'idx'
+         * and retries sending the hedge on it, unless the command has finished in the meantime.
+         */
+        void sendHedgeAfterDelay(size_t idx, Milliseconds delay) noexcept;
+
         CommandStateBase* cmdState;
         std::vector<std::weak_ptr<RequestState>> requests;
 
@@ -250,6 +275,9 @@ private:
 
         // Set to true when the command finishes or is canceled to block remaining requests.
         bool isLocked{false};
+
+        // Timers of hedges being held back until their hedge delay has elapsed.
+        std::vector<std::shared_ptr<transport::ReactorTimer>> hedgeTimers;
     };
 
     struct RequestState final : public std::enable_shared_from_this<RequestState> {
@@ -47,6 +47,11 @@ struct RemoteCommandRequestBase {
     struct HedgeOptions {
         size_t count = 0;
         int maxTimeMSForHedgedReads = 0;
+        // Hold each hedge back until the first request has been outstanding longer than this
+        // percentile of its target's recent latency. Zero sends hedges as soon as possible.
+        int hedgeDelayPercentile = 0;
+        // The share of hedgeable operations that may send a hedge.
+        int maxHedgedOperationsPercent = 100;
     };
 
     enum FireAndForgetMode { kOn, kOff };
@@ -47,7 +47,7 @@ struct SpecialArgRecord {
 };
 
 // clang-format off
-static constexpr std::array<SpecialArgRecord, 34> specials{{
+static constexpr std::array<SpecialArgRecord, 35> specials{{
     //                                       /-isGeneric
     //                                       |  /-stripFromRequest
     //                                       |  |  /-stripFromReply
@@ -84,7 +84,8 @@ static constexpr std::array<SpecialArgRecord, 34> specials{{
     {"comment"_sd,                           1, 0, 0},
     {"maxTimeMSOpOnly"_sd,                   1, 1, 0},
     {"$configTime"_sd,                       1, 1, 1},
-    {"$topologyTime"_sd,                     1, 1, 1}}};
+    {"$topologyTime"_sd,                     1, 1, 1},
+    {"$priority"_sd,                         1, 0, 0}}};
 // clang-format on
 
 TEST(CommandGenericArgument, AllGenericArgumentsAndReplyFields) {
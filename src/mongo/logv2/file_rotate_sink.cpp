@@ -32,13 +32,19 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/string_map.h"
 
 
@@ -68,18 +74,216 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 }  // namespace
 
 struct FileRotateSink::Impl {
-    Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
-    StringMap<boost::shared_ptr<stream_t>> files;
+    Impl(LogTimestampFormat tsFormat, size_t bufferSize, bool drop)
+        : timestampFormat(tsFormat), asyncBufferSize(bufferSize), dropOnOverflow(drop) {}
+
+    bool isAsync() const {
+        return asyncBufferSize > 0;
+    }
+
+    // Appends a formatted record to the pending buffer, waiting for the writer thread to make room
+    // unless dropping is allowed. Returns false if the record was dropped.
+    bool enqueue(StringData line, bool mustNotDrop);
+
+    // Waits until everything enqueued before the call has been written by the writer thread.
+    void waitForWriter();
+
+    // Writes buffered records until shutdown is requested and the buffer has been drained.
+    void writerLoop();
+
+    // Formats a record reporting 'numDropped' records that could not be buffered.
+    std::string formatDroppedNotice(uint64_t numDropped);
+
+    // Terminates the process if any of the files is in a failed state. Must hold streamMutex.
+    void abortIfWriteFailed();
+
     LogTimestampFormat timestampFormat;
+    const size_t asyncBufferSize;
+    const bool dropOnOverflow;
+
+    // Guards the files and the streams registered with the text_ostream_backend.
+    stdx::mutex streamMutex;  // NOLINT
+    StringMap<boost::shared_ptr<stream_t>> files;
+
+    // State below is only used in asynchronous mode and is guarded by bufferMutex. Records are
+    // appended to 'pending'; the writer thread swaps it with its own buffer and writes it out.
+    stdx::mutex bufferMutex;  // NOLINT
+    stdx::condition_variable writerCV;
+    stdx::condition_variable producerCV;
+    std::string pending;
+    uint64_t bytesEnqueued = 0;
+    uint64_t bytesWritten = 0;
+    // Dropped records counted, included in a notice being written, and written out.
+    uint64_t droppedTotal = 0;
+    uint64_t droppedNoticed = 0;
+    uint64_t droppedWritten = 0;
+    bool shutdown = false;
+    stdx::thread writer;
 };
 
-FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
-    : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+bool FileRotateSink::Impl::enqueue(StringData line, bool mustNotDrop) {
+    const size_t size = line.size() + 1;
+    stdx::unique_lock<stdx::mutex> lk(bufferMutex);
+    // A record larger than the whole buffer is accepted once the buffer is empty.
+    auto hasRoom = [&] { return pending.empty() || pending.size() + size <= asyncBufferSize; };
+    if (!hasRoom()) {
+        if (dropOnOverflow && !mustNotDrop) {
+            // The buffer is not empty, so the writer is already awake and will report this.
+            ++droppedTotal;
+            return false;
+        }
+        producerCV.wait(lk, hasRoom);
+    }
+
+    // The writer only sleeps while the buffer is empty, so it needs waking on the first append.
+    const bool wasEmpty = pending.empty();
+    pending.append(line.rawData(), line.size());
+    pending.push_back('\n');
+    bytesEnqueued += size;
+    if (wasEmpty)
+        writerCV.notify_one();
+    return true;
+}
+
+void FileRotateSink::Impl::waitForWriter() {
+    stdx::unique_lock<stdx::mutex> lk(bufferMutex);
+    if (writer.get_id() == stdx::this_thread::get_id())
+        return;
+    const auto targetBytes = bytesEnqueued;
+    const auto targetDropped = droppedTotal;
+    producerCV.wait(
+        lk, [&] { return bytesWritten >= targetBytes && droppedWritten >= targetDropped; });
+}
+
+void FileRotateSink::Impl::writerLoop() {
+    setThreadName("LogWriter");
+
+    std::string batch;
+    stdx::unique_lock<stdx::mutex> lk(bufferMutex);
+    while (true) {
+        writerCV.wait(
+            lk, [&] { return !pending.empty() || droppedTotal > droppedNoticed || shutdown; });
+        if (pending.empty() && droppedTotal == droppedNoticed)
+            return;
+
+        batch.swap(pending);
+        const size_t recordBytes = batch.size();
+        const auto dropped = droppedTotal - droppedNoticed;
+        droppedNoticed = droppedTotal;
+        lk.unlock();
+        producerCV.notify_all();
+
+        // The writer must never log through logv2 as it would wait on itself when the buffer is
+        // full, so the notice about dropped records is formatted here and written with the batch.
+        if (dropped > 0)
+            batch += formatDroppedNotice(dropped);
+
+        {
+            stdx::lock_guard<stdx::mutex> streamLock(streamMutex);
+            for (auto& file : files) {
+                file.second->write(batch.data(), batch.size());
+                file.second->flush();
+            }
+            abortIfWriteFailed();
+        }
+        batch.clear();
+
+        lk.lock();
+        bytesWritten += recordBytes;
+        droppedWritten += dropped;
+        producerCV.notify_all();
+    }
+}
+
+std::string FileRotateSink::Impl::formatDroppedNotice(uint64_t dropped) {
+    DynamicAttributes attrs;
+    attrs.add("numDropped", static_cast<long long>(dropped));
+
+    fmt::memory_buffer buffer;
+    JSONFormatter(nullptr, timestampFormat)
+        .format(buffer,
+                LogSeverity::Warning(),
+                LogComponent::kControl,
+                Date_t::now(),
+                5986600,
+                getThreadName(),
+                "Dropped log records because the asynchronous log buffer was full",
+                TypeErasedAttributeStorage(attrs),
+                LogTag::kNone,
+                LogTruncation::Disabled);
+    // Commented out log line below to get validation of the log id with the errorcodes
+    // linter LOGV2_WARNING(5986600, "Dropped log records because the asynchronous log buffer was
+    // full");
+    buffer.push_back('\n');
+    return std::string(buffer.data(), buffer.size());
+}
+
+void FileRotateSink::Impl::abortIfWriteFailed() {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::any_of(files.begin(), files.end(), isFailed)) {
+        try {
+            auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+            auto failedEnd = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+
+            auto getFilename = [](const auto& file) -> const auto& {
+                return file.first;
+            };
+            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+            auto end = boost::make_transform_iterator(failedEnd, getFilename);
+            auto sequence = logv2::seqLog(begin, end);
+
+            DynamicAttributes attrs;
+            attrs.add("files", sequence);
+
+            fmt::memory_buffer buffer;
+            JSONFormatter(nullptr, timestampFormat)
+                .format(buffer,
+                        LogSeverity::Severe(),
+                        LogComponent::kControl,
+                        Date_t::now(),
+                        4522200,
+                        getThreadName(),
+                        "Writing to log file failed, aborting application",
+                        TypeErasedAttributeStorage(attrs),
+                        LogTag::kNone,
+                        LogTruncation::Disabled);
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
+        } catch (...) {
+            // If the formatting code throws for any reason, ignore and proceed with aborting the
+            // application.
+        }
+
+        std::abort();
+    }
+}
+
+FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat,
+                               size_t asyncBufferSizeBytes,
+                               bool dropOnOverflow)
+    : _impl(std::make_unique<Impl>(timestampFormat, asyncBufferSizeBytes, dropOnOverflow)) {
+    if (_impl->isAsync()) {
+        _impl->pending.reserve(asyncBufferSizeBytes);
+        _impl->writer = stdx::thread([impl = _impl.get()] { impl->writerLoop(); });
+    }
+}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->writer.joinable()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_impl->bufferMutex);
+            _impl->shutdown = true;
+        }
+        _impl->writerCV.notify_one();
+        _impl->writer.join();
+    }
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
+        stdx::lock_guard<stdx::mutex> lk(_impl->streamMutex);
         add_stream(statusWithFile.getValue());
         _impl->files[filename] = statusWithFile.getValue();
     }
@@ -87,6 +291,8 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    flush();
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -95,6 +301,9 @@ void FileRotateSink::removeFile(const std::string& filename) {
 }
 
 Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
+    // Records logged before the rotation belong in the file being rotated out.
+    flush();
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamMutex);
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -140,46 +349,29 @@ Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
+    if (!_impl->isAsync()) {
+        stdx::lock_guard<stdx::mutex> lk(_impl->streamMutex);
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        _impl->abortIfWriteFailed();
+        return;
+    }
 
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
+    // Severe records usually precede termination of the process, so they are never dropped and
+    // are on disk, together with everything logged before them, by the time we return.
+    using boost::log::extract;
+    const bool severe =
+        extract<LogSeverity>(attributes::severity(), rec).get() >= LogSeverity::Severe();
+    if (_impl->enqueue(formatted_string, severe) && severe)
+        flush();
+}
 
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (...) {
-            // If the formatting code throws for any reason, ignore and proceed with aborting the
-            // application.
-        }
+void FileRotateSink::flush() {
+    if (_impl->isAsync())
+        _impl->waitForWriter();
 
-        std::abort();
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamMutex);
+    for (auto& file : _impl->files) {
+        file.second->flush();
     }
 }
 
@@ -40,9 +40,18 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// When constructed with a non-zero asyncBufferSizeBytes, consume() only appends the formatted
+// record to a buffer of that size and a dedicated writer thread writes everything buffered in a
+// single write per file. When the buffer is full, the logging thread either waits for the writer
+// or, if dropOnOverflow is set, drops the record; the writer reports how many were dropped in the
+// log itself. Severe records are written before consume() returns, as are all records buffered
+// ahead of them, so that nothing is lost when the process is about to abort.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
-    FileRotateSink(LogTimestampFormat timestampFormat);
+    FileRotateSink(LogTimestampFormat timestampFormat,
+                   size_t asyncBufferSizeBytes = 0,
+                   bool dropOnOverflow = false);
     ~FileRotateSink();
 
     Status addFile(const std::string& filename, bool append);
@@ -52,6 +61,10 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    // Waits until every record consumed so far has been written and flushes the files. May be
+    // called concurrently with consume().
+    void flush();
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
@@ -72,6 +72,7 @@ struct LogDomainGlobal::Impl {
     Impl(LogDomainGlobal& parent);
     Status configure(LogDomainGlobal::ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
+    void flush();
 
     const ConfigurationOptions& config() const;
 
@@ -82,6 +83,9 @@ struct LogDomainGlobal::Impl {
     ConfigurationOptions _config;
     boost::shared_ptr<boost::log::sinks::unlocked_sink<ConsoleBackend>> _consoleSink;
     boost::shared_ptr<boost::log::sinks::unlocked_sink<RotatableFileBackend>> _rotatableFileSink;
+    // The file backend of _rotatableFileSink. FileRotateSink::flush() is thread-safe so this allows
+    // flushing without waiting behind records being consumed.
+    boost::shared_ptr<FileRotateSink> _fileRotateSink;
 #ifndef _WIN32
     boost::shared_ptr<boost::log::sinks::unlocked_sink<SyslogBackend>> _syslogSink;
 #endif
@@ -158,8 +162,11 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
 #endif
 
     if (options.fileEnabled) {
+        auto fileSink = boost::make_shared<FileRotateSink>(options.timestampFormat,
+                                                           options.fileAsyncBufferSizeBytes,
+                                                           options.fileAsyncDropOnOverflow);
         auto backend = boost::make_shared<RotatableFileBackend>(
-            boost::make_shared<FileRotateSink>(options.timestampFormat),
+            fileSink,
             boost::make_shared<RamLogSink>(RamLog::get("global")),
             boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
             boost::make_shared<UserAssertSink>());
@@ -177,9 +184,11 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
         _rotatableFileSink->set_filter(ComponentSettingsFilter(_parent, _settings));
 
         boost::log::core::get()->add_sink(_rotatableFileSink);
+        _fileRotateSink = std::move(fileSink);
     } else if (_rotatableFileSink) {
         boost::log::core::get()->remove_sink(_rotatableFileSink);
         _rotatableFileSink.reset();
+        _fileRotateSink.reset();
     }
 
     auto setFormatters = [this](auto&& mkFmt) {
@@ -230,6 +239,12 @@ Status LogDomainGlobal::Impl::rotate(bool rename, StringData renameSuffix) {
     return Status::OK();
 }
 
+void LogDomainGlobal::Impl::flush() {
+    if (_fileRotateSink) {
+        _fileRotateSink->flush();
+    }
+}
+
 LogSource& LogDomainGlobal::Impl::source() {
     // Use a thread_local logger so we don't need to have locking. thread_locals are destroyed
     // before statics so keep track of number of thread_locals we have active and if this code
@@ -283,6 +298,10 @@ Status LogDomainGlobal::rotate(bool rename, StringData renameSuffix) {
     return _impl->rotate(rename, renameSuffix);
 }
 
+void LogDomainGlobal::flush() {
+    _impl->flush();
+}
+
 LogComponentSettings& LogDomainGlobal::settings() {
     return _impl->_settings;
 }
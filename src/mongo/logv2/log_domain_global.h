@@ -45,6 +45,11 @@ public:
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // Size of the buffer used to hand records to a background writer thread; 0 writes to the
+        // file on the logging thread.
+        size_t fileAsyncBufferSizeBytes{0};
+        // Drop records rather than wait for the writer thread when the buffer is full.
+        bool fileAsyncDropOnOverflow{false};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
@@ -62,6 +67,12 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
 
+    /**
+     * Writes out any records still buffered for the log file. Safe to call from any thread,
+     * including while other threads are logging.
+     */
+    void flush();
+
     const ConfigurationOptions& config() const;
 
     LogComponentSettings& settings();
@@ -44,6 +44,7 @@
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/constants.h"
+#include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_capture_backend.h"
@@ -1705,6 +1706,77 @@ TEST_F(LogV2Test, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogV2Test, AsyncFileLogging) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/file.log";
+
+    auto backend = boost::make_shared<FileRotateSink>(LogTimestampFormat::kISO8601UTC, 256);
+    ASSERT_OK(backend->addFile(file_name, false));
+    auto sink = wrapInSynchronousSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    auto readFile = [&](std::string const& filename) {
+        std::vector<std::string> lines;
+        std::ifstream file(filename);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    // Records larger than the buffer in total have to wait for the writer thread but all of them
+    // are written in order.
+    for (int i = 0; i < 100; ++i)
+        LOGV2(5986601, "test {i}", "i"_attr = i);
+    sink->flush();
+    auto lines = readFile(file_name);
+    ASSERT_EQ(lines.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        ASSERT_EQ(lines[i], fmt::format("test {}", i));
+
+    // Records logged before rotation stay in the rotated file.
+    LOGV2(5986602, "before rotation");
+    ASSERT_OK(backend->rotate(true, ".rotated"));
+    LOGV2(5986603, "after rotation");
+    sink->flush();
+    ASSERT_EQ(readFile(file_name + ".rotated").back(), "before rotation");
+    ASSERT(readFile(file_name) == std::vector<std::string>{"after rotation"});
+
+    // Severe records are written before returning.
+    LOGV2_FATAL_CONTINUE(5986604, "severe");
+    ASSERT_EQ(readFile(file_name).back(), "severe");
+}
+
+TEST_F(LogV2Test, AsyncFileLoggingDropOnOverflow) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/file.log";
+
+    auto backend = boost::make_shared<FileRotateSink>(LogTimestampFormat::kISO8601UTC, 64, true);
+    ASSERT_OK(backend->addFile(file_name, false));
+    auto sink = wrapInSynchronousSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    constexpr int kNumRecords = 1000;
+    for (int i = 0; i < kNumRecords; ++i)
+        LOGV2(5986605, "test {i}", "i"_attr = i);
+    sink->flush();
+
+    // Every record is either in the file or accounted for by a notice from the writer thread.
+    long long written = 0;
+    long long dropped = 0;
+    std::ifstream file(file_name);
+    for (std::string line; std::getline(file, line, '\n');) {
+        if (StringData(line).startsWith("test "))
+            ++written;
+        else
+            dropped += mongo::fromjson(line)["attr"]["numDropped"].numberLong();
+    }
+    ASSERT_EQ(written + dropped, kNumRecords);
+}
+
 TEST_F(LogV2Test, UserAssert) {
     std::vector<std::string> lines;
     auto sink = wrapInSynchronousSink(wrapInCompositeBackend(
@@ -37,6 +37,7 @@
 #include <memory>
 
 #include "mongo/client/remote_command_targeter.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -111,6 +112,7 @@ AsyncRequestsSender::Response AsyncRequestsSender::next() noexcept {
 
     // Try to pop a value from the queue
     try {
+        ScopedWaitEvent networkWait(_opCtx, WaitEvent::kNetwork);
         return _responseQueue.pop(_opCtx);
     } catch (const DBException& ex) {
         // If we're interrupted, save that value and overwrite all outstanding requests (that we're
@@ -33,6 +33,8 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <numeric>
+
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -111,16 +113,51 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
     return flattened;
 }
 
+/**
+ * Returns the first position in [lo, hi) for which 'isAfter' holds, or 'hi' if there is none.
+ * 'isAfter' must be monotonic over the range.
+ */
+template <typename IsAfter>
+size_t binarySearchFirstAfter(size_t lo, size_t hi, const IsAfter& isAfter) {
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (isAfter(mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * Same as binarySearchFirstAfter() over [from, size), but gallops forwards from 'from' to bracket
+ * the result first, so it is cheap when the result is close to 'from'.
+ */
+template <typename IsAfter>
+size_t gallopFirstAfter(size_t from, size_t size, const IsAfter& isAfter) {
+    size_t lo = from;
+    size_t hi = from;
+    for (size_t step = 1; hi < size && !isAfter(hi); step *= 2) {
+        lo = hi + 1;
+        hi = from + step;
+    }
+
+    return binarySearchFirstAfter(lo, std::min(hi, size), isAfter);
+}
+
 }  // namespace
 
 ShardVersionMap ChunkMap::constructShardVersionMap() const {
     ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
+    auto current = _begin();
+    const auto end = _end();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != _chunkMap.cend()) {
+    while (current != end) {
         const auto& firstChunkInRange = *current;
         const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
 
@@ -137,20 +174,14 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
 
         auto& maxShardVersion = shardVersionIt->second.shardVersion;
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+        std::shared_ptr<ChunkInfo> rangeLast;
+        for (; current != end && (*current)->getShardIdAt(boost::none) == currentRangeShardId;
+             ++current) {
+            rangeLast = *current;
 
-                             if (maxShardVersion.isOlderThan(currentChunk->getLastmod()))
-                                 maxShardVersion = currentChunk->getLastmod();
-
-                             return false;
-                         });
-
-        const auto rangeLast = *std::prev(current);
+            if (maxShardVersion.isOlderThan(rangeLast->getLastmod()))
+                maxShardVersion = rangeLast->getLastmod();
+        }
 
         const auto& rangeMin = firstChunkInRange->getMin();
         const auto& rangeMax = rangeLast->getMax();
@@ -179,7 +210,7 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
         invariant(maxShardVersion.isSet());
     }
 
-    if (!_chunkMap.empty()) {
+    if (_size > 0) {
         invariant(!shardVersions.empty());
         invariant(firstMin.is_initialized());
         invariant(lastMax.is_initialized());
@@ -191,22 +222,83 @@ ShardVersionMap ChunkMap::constructShardVersionMap() const {
     return shardVersions;
 }
 
-void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+size_t ChunkBoundsIndex::findFirstAfterFrom(StringData keyString,
+                                            bool isMaxInclusive,
+                                            size_t from) const {
+    return gallopFirstAfter(
+        from, size(), [&](size_t i) { return _isAfter(i, keyString, isMaxInclusive); });
+}
 
-    if (_collectionVersion.isOlderThan(chunk->getLastmod()))
-        _collectionVersion = chunk->getLastmod();
+size_t ChunkBoundsIndex::_findFirstAfter(StringData keyString,
+                                         bool isMaxInclusive,
+                                         size_t lo,
+                                         size_t hi) const {
+    return binarySearchFirstAfter(
+        lo, hi, [&](size_t i) { return _isAfter(i, keyString, isMaxInclusive); });
+}
+
+ChunkMap::Block::Block(ChunkVector::const_iterator begin, ChunkVector::const_iterator end)
+    : chunks(begin, end) {
+    size_t numBytes = 0;
+    for (const auto& chunk : chunks) {
+        numBytes += chunk->getMaxKeyString().size();
+    }
+
+    maxKeys.reserve(chunks.size(), numBytes);
+    for (const auto& chunk : chunks) {
+        maxKeys.append(chunk->getMaxKeyString());
+    }
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
+    if (it != _end())
         return *it;
 
     return std::shared_ptr<ChunkInfo>();
 }
 
+std::vector<std::shared_ptr<ChunkInfo>> ChunkMap::findIntersectingChunks(
+    const std::vector<BSONObj>& shardKeys) const {
+    std::vector<std::string> keyStrings;
+    keyStrings.reserve(shardKeys.size());
+    for (const auto& shardKey : shardKeys) {
+        keyStrings.push_back(ShardKeyPattern::toKeyString(shardKey));
+    }
+
+    std::vector<size_t> order(shardKeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keyStrings](size_t lhs, size_t rhs) {
+        return keyStrings[lhs] < keyStrings[rhs];
+    });
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks(shardKeys.size());
+    size_t blockIndex = 0;
+    size_t chunkIndex = 0;
+
+    for (const auto i : order) {
+        const auto& keyString = keyStrings[i];
+
+        const size_t nextBlockIndex = _findFirstBlockAfter(keyString, true, blockIndex);
+        if (nextBlockIndex == _blocks.size()) {
+            // This and all the remaining keys are past the max key of the last chunk
+            break;
+        }
+
+        if (nextBlockIndex != blockIndex) {
+            blockIndex = nextBlockIndex;
+            chunkIndex = 0;
+        }
+
+        const auto& block = *_blocks[blockIndex];
+        chunkIndex = block.maxKeys.findFirstAfterFrom(keyString, true, chunkIndex);
+        chunks[i] = block.chunks[chunkIndex];
+    }
+
+    return chunks;
+}
+
 void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion& version) {
     uassert(ErrorCodes::ConflictingOperationInProgress,
             str::stream() << "Changed chunk " << chunk->toString()
@@ -218,41 +310,69 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
     size_t changedChunkIndex = 0;
 
-    ChunkMap updatedChunkMap(
-        getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
-
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
-            validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
-            continue;
-        }
-
-        if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+    ChunkMap updatedChunkMap(getVersion().epoch(), getVersion().getTimestamp());
+    updatedChunkMap._collectionVersion = _collectionVersion;
+    updatedChunkMap._blocks.reserve(_blocks.size() + changedChunks.size() / kMaxChunksPerBlock + 1);
+
+    // Chunks of the blocks which are being rebuilt. They can only be cut into new blocks once the
+    // next block is known to be carried over unchanged, because until then the last pending chunk
+    // may still be replaced by an overlapping newer one.
+    ChunkVector pendingChunks;
+
+    const auto appendChunk = [&](const std::shared_ptr<ChunkInfo>& chunk) {
+        appendChunkTo(pendingChunks, chunk);
+
+        if (updatedChunkMap._collectionVersion.isOlderThan(chunk->getLastmod()))
+            updatedChunkMap._collectionVersion = chunk->getLastmod();
+    };
+
+    const auto flushPendingChunks = [&] {
+        updatedChunkMap._appendBlocks(std::move(pendingChunks));
+        pendingChunks.clear();
+    };
+
+    for (const auto& block : _blocks) {
+        const bool precedesNextChangedChunk = changedChunkIndex == changedChunks.size() ||
+            SimpleBSONObjComparator::kInstance.evaluate(
+                block->chunks.back()->getMax() <= changedChunks[changedChunkIndex]->getMin());
+        const bool followsPendingChunks = pendingChunks.empty() ||
+            SimpleBSONObjComparator::kInstance.evaluate(pendingChunks.back()->getMax() <=
+                                                        block->chunks.front()->getMin());
+
+        // A block which overlaps neither the next changed chunk nor the chunks appended so far
+        // would be copied verbatim by the merge below, so share it instead
+        if (precedesNextChangedChunk && followsPendingChunks) {
+            flushPendingChunks();
+            updatedChunkMap._blocks.push_back(block);
+            updatedChunkMap._size += block->chunks.size();
             continue;
         }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+        for (const auto& chunkInfo : block->chunks) {
+            while (changedChunkIndex < changedChunks.size() &&
+                   chunkInfo->getRange().overlaps(changedChunks[changedChunkIndex]->getRange())) {
+                auto& changedChunk = changedChunks[changedChunkIndex++];
 
-        if (overlap) {
-            auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
+                auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
+                changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+                validateChunk(changedChunk, getVersion());
+                appendChunk(changedChunk);
+            }
 
-            validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
-        } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            appendChunk(chunkInfo);
         }
     }
 
+    for (; changedChunkIndex < changedChunks.size(); ++changedChunkIndex) {
+        validateChunk(changedChunks[changedChunkIndex], getVersion());
+        appendChunk(changedChunks[changedChunkIndex]);
+    }
+
+    flushPendingChunks();
+
     return updatedChunkMap;
 }
 
@@ -260,45 +380,84 @@ BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
-            arrayBuilder.append(chunk->toString());
+        for (const auto& block : _blocks) {
+            for (const auto& chunk : block->chunks) {
+                arrayBuilder.append(chunk->toString());
+            }
         }
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
-    auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+size_t ChunkMap::numSharedBlocks_ForTest(const ChunkMap& other) const {
+    return std::count_if(_blocks.begin(), _blocks.end(), [&other](const auto& block) {
+        return std::find(other._blocks.begin(), other._blocks.end(), block) !=
+            other._blocks.end();
+    });
+}
 
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+size_t ChunkMap::_findFirstBlockAfter(StringData keyString,
+                                      bool isMaxInclusive,
+                                      size_t from) const {
+    return gallopFirstAfter(from, _blocks.size(), [&](size_t i) {
+        const int cmp = _blocks[i]->maxKey().compare(keyString);
+        return isMaxInclusive ? cmp > 0 : cmp >= 0;
+    });
+}
+
+void ChunkMap::_appendBlocks(ChunkVector chunks) {
+    if (chunks.empty())
+        return;
+
+    // Coalesce a small run of rebuilt chunks with the preceding block, so that repeated merges of
+    // chunks do not degrade the map into many tiny blocks
+    if (!_blocks.empty() && chunks.size() < kMaxChunksPerBlock / 2 &&
+        _blocks.back()->chunks.size() + chunks.size() <= kMaxChunksPerBlock) {
+        const auto& lastBlock = _blocks.back()->chunks;
+        chunks.insert(chunks.begin(), lastBlock.begin(), lastBlock.end());
+        _size -= lastBlock.size();
+        _blocks.pop_back();
+    }
+
+    // Spread the chunks evenly across the minimum number of blocks which can hold them
+    const size_t numBlocks = (chunks.size() + kMaxChunksPerBlock - 1) / kMaxChunksPerBlock;
+    for (size_t i = 0; i < numBlocks; ++i) {
+        const auto blockBegin = chunks.begin() + chunks.size() * i / numBlocks;
+        const auto blockEnd = chunks.begin() + chunks.size() * (i + 1) / numBlocks;
+        _blocks.push_back(std::make_shared<const Block>(blockBegin, blockEnd));
     }
+
+    _size += chunks.size();
+}
+
+ChunkMap::ConstIterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                         bool isMaxInclusive) const {
+    const auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
+
+    // The last chunk of each block bounds the max keys of all the chunks in it, so the block
+    // containing the chunk is the first one whose last chunk satisfies the search
+    const size_t blockIndex = _findFirstBlockAfter(shardKeyString, isMaxInclusive);
+    if (blockIndex == _blocks.size())
+        return _end();
+
+    const auto& block = *_blocks[blockIndex];
+    const size_t chunkIndex = block.maxKeys.findFirstAfter(shardKeyString, isMaxInclusive);
+    invariant(chunkIndex < block.chunks.size());
+
+    return ConstIterator(&_blocks, blockIndex, chunkIndex);
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+std::pair<ChunkMap::ConstIterator, ChunkMap::ConstIterator> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
     const auto itMin = _findIntersectingChunk(min);
     const auto itMax = [&]() {
         auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+        return it == _end() ? it : ++it;
     }();
 
     return {itMin, itMax};
@@ -367,6 +526,28 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
     return Chunk(*chunkInfo, _clusterTime);
 }
 
+std::vector<boost::optional<Chunk>> ChunkManager::findIntersectingChunksWithSimpleCollation(
+    const std::vector<BSONObj>& shardKeys) const {
+    const auto chunkInfos = _rt->optRt->findIntersectingChunks(shardKeys);
+
+    std::vector<boost::optional<Chunk>> chunks;
+    chunks.reserve(chunkInfos.size());
+
+    for (size_t i = 0; i < chunkInfos.size(); ++i) {
+        if (!chunkInfos[i]) {
+            chunks.emplace_back(boost::none);
+            continue;
+        }
+
+        // The routing table has no gaps, so the chunk with the lowest max key above the shard key
+        // always contains it
+        dassert(chunkInfos[i]->containsKey(shardKeys[i]));
+        chunks.emplace_back(Chunk(*chunkInfos[i], _clusterTime));
+    }
+
+    return chunks;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
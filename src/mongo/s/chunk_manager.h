@@ -66,6 +66,62 @@ struct ShardVersionTargetingInfo {
 // shard is currently marked as needing a catalog cache refresh (stale).
 using ShardVersionMap = stdx::unordered_map<ShardId, ShardVersionTargetingInfo, ShardId::Hasher>;
 
+/**
+ * Ascending sequence of chunk max keys in KeyString format, laid out back to back in a single
+ * buffer. Searching it only touches that buffer and the array of offsets into it, rather than
+ * dereferencing a ChunkInfo and its separately allocated KeyString on every probe.
+ */
+class ChunkBoundsIndex {
+public:
+    void reserve(size_t numKeys, size_t numBytes) {
+        _keyEnds.reserve(numKeys);
+        _keyStrings.reserve(numBytes);
+    }
+
+    void append(StringData keyString) {
+        _keyStrings.append(keyString.rawData(), keyString.size());
+        _keyEnds.push_back(_keyStrings.size());
+    }
+
+    size_t size() const {
+        return _keyEnds.size();
+    }
+
+    StringData at(size_t i) const {
+        const size_t begin = i == 0 ? 0 : _keyEnds[i - 1];
+        return StringData(_keyStrings.data() + begin, _keyEnds[i] - begin);
+    }
+
+    /**
+     * Returns the position of the first key which is greater than 'keyString' (or not less than it
+     * if 'isMaxInclusive' is false), or size() if there is none.
+     */
+    size_t findFirstAfter(StringData keyString, bool isMaxInclusive) const {
+        return _findFirstAfter(keyString, isMaxInclusive, 0, size());
+    }
+
+    /**
+     * Same as findFirstAfter(), but only considers the keys at or after position 'from'. Searches
+     * outwards from 'from' first, so it is cheaper than findFirstAfter() when the result is known
+     * to be close to 'from'.
+     */
+    size_t findFirstAfterFrom(StringData keyString, bool isMaxInclusive, size_t from) const;
+
+private:
+    bool _isAfter(size_t i, StringData keyString, bool isMaxInclusive) const {
+        const int cmp = at(i).compare(keyString);
+        return isMaxInclusive ? cmp > 0 : cmp >= 0;
+    }
+
+    size_t _findFirstAfter(StringData keyString, bool isMaxInclusive, size_t lo, size_t hi) const;
+
+    // Concatenation of all the KeyStrings
+    std::string _keyStrings;
+
+    // Offset in '_keyStrings' at which each KeyString ends
+    std::vector<uint32_t> _keyEnds;
+};
+
 /**
  * This class serves as a Facade around how the mapping of ranges to chunks is represented. It also
  * provides a simpler, high-level interface for domain specific operations without exposing the
@@ -75,16 +131,66 @@ class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    // The chunks are stored as a sequence of immutable blocks of consecutive chunks, each of which
+    // holds at most kMaxChunksPerBlock entries. The map produced by createMerged() only rebuilds
+    // the blocks touched by the changed chunks and shares all the other blocks with the map it was
+    // created from, so an incremental refresh does not need to copy the entire routing table.
+    struct Block {
+        Block(ChunkVector::const_iterator begin, ChunkVector::const_iterator end);
+
+        ChunkVector chunks;
+
+        // Max keys of 'chunks', used for targeting
+        ChunkBoundsIndex maxKeys;
+
+        // Max key of the last chunk, which bounds the max keys of all the chunks in the block
+        StringData maxKey() const {
+            return maxKeys.at(maxKeys.size() - 1);
+        }
+    };
+
+    using ChunkBlock = std::shared_ptr<const Block>;
+    using ChunkBlockVector = std::vector<ChunkBlock>;
+
+    class ConstIterator {
+    public:
+        ConstIterator(const ChunkBlockVector* blocks, size_t blockIndex, size_t chunkIndex)
+            : _blocks(blocks), _blockIndex(blockIndex), _chunkIndex(chunkIndex) {}
+
+        const std::shared_ptr<ChunkInfo>& operator*() const {
+            return (*_blocks)[_blockIndex]->chunks[_chunkIndex];
+        }
+
+        ConstIterator& operator++() {
+            if (++_chunkIndex == (*_blocks)[_blockIndex]->chunks.size()) {
+                ++_blockIndex;
+                _chunkIndex = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return _blockIndex == other._blockIndex && _chunkIndex == other._chunkIndex;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const ChunkBlockVector* _blocks;
+        size_t _blockIndex;
+        size_t _chunkIndex;
+    };
+
 public:
-    explicit ChunkMap(OID epoch,
-                      const boost::optional<Timestamp>& timestamp,
-                      size_t initialCapacity = 0)
-        : _collectionVersion(0, 0, epoch, timestamp) {
-        _chunkMap.reserve(initialCapacity);
-    }
+    static constexpr size_t kMaxChunksPerBlock = 256;
+
+    explicit ChunkMap(OID epoch, const boost::optional<Timestamp>& timestamp)
+        : _collectionVersion(0, 0, epoch, timestamp) {}
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -93,9 +199,9 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto it = shardKey.isEmpty() ? _begin() : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
+        for (const auto end = _end(); it != end; ++it) {
             if (!handler(*it))
                 break;
         }
@@ -117,19 +223,52 @@ public:
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
-    void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
+    /**
+     * Returns the chunk which contains each of 'shardKeys' at the same position as the key, or
+     * nullptr if there is no such chunk. The keys are resolved in ascending order, so that keys
+     * which fall close to each other only search the part of the map between them.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const;
 
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
 
     BSONObj toBSON() const;
 
+    /**
+     * Returns the number of blocks of chunks which this map has in common with 'other'.
+     */
+    size_t numSharedBlocks_ForTest(const ChunkMap& other) const;
+
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    ConstIterator _begin() const {
+        return ConstIterator(&_blocks, 0, 0);
+    }
+
+    ConstIterator _end() const {
+        return ConstIterator(&_blocks, _blocks.size(), 0);
+    }
+
+    ConstIterator _findIntersectingChunk(const BSONObj& shardKey,
+                                         bool isMaxInclusive = true) const;
+    std::pair<ConstIterator, ConstIterator> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    /**
+     * Returns the index of the first block whose max key is greater than 'keyString' (or not less
+     * than it if 'isMaxInclusive' is false), or _blocks.size() if there is none. Only considers
+     * the blocks at or after 'from'.
+     */
+    size_t _findFirstBlockAfter(StringData keyString, bool isMaxInclusive, size_t from = 0) const;
+
+    void _appendBlocks(ChunkVector chunks);
 
-    ChunkVector _chunkMap;
+    // Blocks of chunks ordered by max key. None of the blocks is empty.
+    ChunkBlockVector _blocks;
+
+    // Total number of chunks across all blocks
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
@@ -257,6 +396,11 @@ public:
         return _chunkMap.findIntersectingChunk(shardKey);
     }
 
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const {
+        return _chunkMap.findIntersectingChunks(shardKeys);
+    }
+
     /**
      * Returns the ids of all shards on which the collection has any chunks.
      */
@@ -596,6 +740,15 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Same as findIntersectingChunkWithSimpleCollation, but for a batch of shard keys, which are
+     * resolved together. Returns the chunk for each of 'shardKeys' at the same position as the key,
+     * or boost::none for the keys which findIntersectingChunkWithSimpleCollation would have failed
+     * to target with ShardKeyNotFound.
+     */
+    std::vector<boost::optional<Chunk>> findIntersectingChunksWithSimpleCollation(
+        const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
      * collation because shard keys do not support non-simple collations.
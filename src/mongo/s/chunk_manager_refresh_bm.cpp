@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <deque>
 
 #include "mongo/base/init.h"
 #include "mongo/db/s/collection_metadata.h"
@@ -147,7 +148,76 @@ void BM_IncrementalRefreshOfPessimalBalancedDistribution(benchmark::State& state
 BENCHMARK(BM_IncrementalRefreshOfPessimalBalancedDistribution)
     ->Args({2, 50000})
     ->Args({2, 250000})
-    ->Args({2, 500000});
+    ->Args({2, 500000})
+    ->Args({2, 1000000});
+
+void BM_IncrementalRefreshOfOptimalBalancedDistribution(benchmark::State& state) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+    auto metadata = makeChunkManagerWithOptimalBalancedDistribution(nShards, nChunks);
+
+    // Emulates a migration of the chunk at the middle of the key space, which bumps the versions
+    // of the donor and recipient chunks
+    auto postMoveVersion = metadata.getChunkManager()->getVersion();
+    std::vector<ChunkType> newChunks;
+    postMoveVersion.incMajor();
+    newChunks.emplace_back(
+        kNss, getRangeForChunk(nChunks / 2, nChunks), postMoveVersion, ShardId("shard0"));
+    postMoveVersion.incMinor();
+    newChunks.emplace_back(
+        kNss, getRangeForChunk(nChunks / 2 + 1, nChunks), postMoveVersion, ShardId("shard1"));
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(runIncrementalUpdate(metadata, newChunks));
+    }
+}
+
+BENCHMARK(BM_IncrementalRefreshOfOptimalBalancedDistribution)
+    ->Args({2, 50000})
+    ->Args({2, 250000})
+    ->Args({2, 500000})
+    ->Args({2, 1000000});
+
+/**
+ * Applies a series of migrations of randomly chosen chunks, each one on top of the routing table
+ * produced by the previous one, while keeping the last few routing tables alive the same way the
+ * catalog cache and the in-flight operations referencing them would.
+ */
+void BM_SuccessiveIncrementalRefreshes(benchmark::State& state) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+    constexpr size_t kRoutingTablesToKeep = 8;
+
+    std::deque<CollectionMetadata> history;
+    history.push_back(makeChunkManagerWithOptimalBalancedDistribution(nShards, nChunks));
+
+    PseudoRandom rand(12345);
+
+    for (auto keepRunning : state) {
+        const auto& latest = history.back();
+        auto postMoveVersion = latest.getChunkManager()->getVersion();
+        postMoveVersion.incMajor();
+
+        const int chunkToMove = rand.nextInt32(nChunks);
+        std::vector<ChunkType> newChunks;
+        newChunks.emplace_back(kNss,
+                               getRangeForChunk(chunkToMove, nChunks),
+                               postMoveVersion,
+                               ShardId(str::stream() << "shard" << rand.nextInt32(nShards)));
+
+        history.push_back(runIncrementalUpdate(latest, newChunks));
+        if (history.size() > kRoutingTablesToKeep) {
+            history.pop_front();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SuccessiveIncrementalRefreshes)
+    ->Args({2, 50000})
+    ->Args({100, 250000})
+    ->Args({100, 1000000});
 
 template <typename ShardSelectorFn>
 auto BM_FullBuildOfChunkManager(benchmark::State& state, ShardSelectorFn selectShard) {
@@ -284,6 +354,33 @@ void BM_FindIntersectingChunk(benchmark::State& state,
     state.SetItemsProcessed(state.iterations());
 }
 
+template <typename CollectionMetadataBuilderFn>
+void BM_FindIntersectingChunksInBatch(benchmark::State& state,
+                                      CollectionMetadataBuilderFn makeCollectionMetadata) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+    constexpr size_t kBatchSize = 1000;
+
+    auto metadata = makeCollectionMetadata(nShards, nChunks);
+    auto keys = makeKeys(nChunks);
+    auto keysIter = makeCircularIterator(keys);
+
+    std::vector<BSONObj> batch(kBatchSize);
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        for (auto& key : batch) {
+            key = *keysIter++;
+        }
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(
+            metadata.getChunkManager()->findIntersectingChunksWithSimpleCollation(batch));
+    }
+
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
 template <typename CollectionMetadataBuilderFn>
 void BM_GetShardIdsForRange(benchmark::State& state,
                             CollectionMetadataBuilderFn makeCollectionMetadata) {
@@ -384,6 +481,12 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             BM_FindIntersectingChunk, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
             BM_FindIntersectingChunk, Optimal, makeChunkManagerWithOptimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunksInBatch,
+                                   Pessimal,
+                                   makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(BM_FindIntersectingChunksInBatch,
+                                   Optimal,
+                                   makeChunkManagerWithOptimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
             BM_GetShardIdsForRange, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
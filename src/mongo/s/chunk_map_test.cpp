@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/platform/random.h"
 #include "mongo/s/chunk_manager.h"
 #include "mongo/unittest/unittest.h"
 
@@ -45,6 +46,26 @@ public:
         return _shardKeyPattern;
     }
 
+    /**
+     * Returns 'nChunks' contiguous chunks covering the whole shard key space, where chunk i has
+     * bounds [i * 10, (i + 1) * 10) except for the first and last ones which extend to MinKey and
+     * MaxKey respectively.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> makeChunks(int nChunks, const OID& epoch) const {
+        std::vector<std::shared_ptr<ChunkInfo>> chunks;
+        for (int i = 0; i < nChunks; ++i) {
+            const auto min = i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i * 10);
+            const auto max =
+                i + 1 == nChunks ? getShardKeyPattern().globalMax() : BSON("a" << (i + 1) * 10);
+            chunks.push_back(std::make_shared<ChunkInfo>(
+                ChunkType{kNss,
+                          ChunkRange{min, max},
+                          ChunkVersion{1, uint32_t(i), epoch, boost::none /* timestamp */},
+                          kThisShard}));
+        }
+        return chunks;
+    }
+
 private:
     KeyPattern _shardKeyPattern{BSON("a" << 1)};
 };
@@ -165,4 +186,145 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestChunksSpanningMultipleBlocks) {
+    const OID epoch = OID::gen();
+    const int nChunks = 5 * ChunkMap::kMaxChunksPerBlock + 7;
+    auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        makeChunks(nChunks, epoch));
+
+    ASSERT_EQ(chunkMap.size(), nChunks);
+    ASSERT_EQ(chunkMap.getVersion().minorVersion(), nChunks - 1);
+    ASSERT_EQ(chunkMap.constructShardVersionMap().size(), 1);
+
+    int count = 0;
+    chunkMap.forEach([&](const auto& chunk) {
+        const auto expectedMin = count == 0 ? getShardKeyPattern().globalMin()
+                                            : BSON("a" << count * 10);
+        ASSERT_BSONOBJ_EQ(chunk->getMin(), expectedMin);
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, nChunks);
+
+    // Lookups of keys which are the bounds of chunks, including those at the edges of blocks
+    for (int i = 1; i < nChunks - 1; ++i) {
+        auto chunk = chunkMap.findIntersectingChunk(BSON("a" << i * 10));
+        ASSERT_BSONOBJ_EQ(chunk->getMin(), BSON("a" << i * 10));
+    }
+
+    const auto key = int(ChunkMap::kMaxChunksPerBlock) * 10;
+    count = 0;
+    chunkMap.forEachOverlappingChunk(
+        BSON("a" << key - 15), BSON("a" << key + 15), true, [&](const auto& chunk) {
+            count++;
+            return true;
+        });
+    ASSERT_EQ(count, 4);
+
+    count = 0;
+    chunkMap.forEach(
+        [&](const auto& chunk) {
+            count++;
+            return true;
+        },
+        BSON("a" << key - 5));
+    ASSERT_EQ(count, nChunks - ChunkMap::kMaxChunksPerBlock + 1);
+}
+
+TEST_F(ChunkMapTest, TestFindIntersectingChunksInBatch) {
+    const OID epoch = OID::gen();
+    const int nChunks = 3 * ChunkMap::kMaxChunksPerBlock + 11;
+    auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        makeChunks(nChunks, epoch));
+
+    // Unordered keys, including duplicates, chunk bounds and the global min and max
+    std::vector<BSONObj> shardKeys{getShardKeyPattern().globalMax(),
+                                   BSON("a" << 5),
+                                   BSON("a" << nChunks * 10 + 5),
+                                   getShardKeyPattern().globalMin(),
+                                   BSON("a" << 5)};
+    PseudoRandom random(12345);
+    for (int i = 0; i < 1000; ++i) {
+        const auto value = random.nextInt32(nChunks * 10);
+        shardKeys.push_back(BSON("a" << (i % 2 == 0 ? value : value - value % 10)));
+    }
+
+    const auto chunks = chunkMap.findIntersectingChunks(shardKeys);
+    ASSERT_EQ(chunks.size(), shardKeys.size());
+
+    // There is no chunk past the MaxKey
+    ASSERT(!chunks[0]);
+
+    for (size_t i = 1; i < shardKeys.size(); ++i) {
+        ASSERT(chunks[i]) << shardKeys[i];
+        ASSERT_EQ(chunks[i], chunkMap.findIntersectingChunk(shardKeys[i])) << shardKeys[i];
+        ASSERT(chunks[i]->containsKey(shardKeys[i])) << shardKeys[i];
+    }
+}
+
+TEST_F(ChunkMapTest, TestIncrementalUpdateSharesUnchangedBlocks) {
+    const OID epoch = OID::gen();
+    const int nChunks = 8 * ChunkMap::kMaxChunksPerBlock;
+    auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        makeChunks(nChunks, epoch));
+
+    // Move one chunk to another shard and split another one
+    const ShardId otherShard("otherShard");
+    ChunkVersion version{2, 0, epoch, boost::none /* timestamp */};
+    const int splitChunk = 5 * ChunkMap::kMaxChunksPerBlock + 3;
+    auto updatedChunkMap = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss, ChunkRange{BSON("a" << 100), BSON("a" << 110)}, version, otherShard}),
+         std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{BSON("a" << splitChunk * 10), BSON("a" << splitChunk * 10 + 5)},
+                       ChunkVersion{2, 1, epoch, boost::none /* timestamp */},
+                       kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << splitChunk * 10 + 5), BSON("a" << (splitChunk + 1) * 10)},
+             ChunkVersion{2, 2, epoch, boost::none /* timestamp */},
+             kThisShard})});
+
+    ASSERT_EQ(updatedChunkMap.size(), nChunks + 1);
+    ASSERT_EQ(updatedChunkMap.getVersion().majorVersion(), 2);
+    ASSERT_EQ(updatedChunkMap.getVersion().minorVersion(), 2);
+    ASSERT_EQ(updatedChunkMap.numSharedBlocks_ForTest(chunkMap), 6);
+    ASSERT_EQ(updatedChunkMap.constructShardVersionMap().size(), 2);
+
+    ASSERT_EQ(updatedChunkMap.findIntersectingChunk(BSON("a" << 105))->getShardIdAt(boost::none),
+              otherShard);
+    ASSERT_BSONOBJ_EQ(
+        updatedChunkMap.findIntersectingChunk(BSON("a" << splitChunk * 10 + 7))->getMin(),
+        BSON("a" << splitChunk * 10 + 5));
+
+    // The original map is left untouched
+    ASSERT_EQ(chunkMap.size(), nChunks);
+    ASSERT_EQ(chunkMap.findIntersectingChunk(BSON("a" << 105))->getShardIdAt(boost::none),
+              kThisShard);
+}
+
+TEST_F(ChunkMapTest, TestMergeOfChunksAcrossBlockBoundary) {
+    const OID epoch = OID::gen();
+    const int nChunks = 4 * ChunkMap::kMaxChunksPerBlock;
+    auto chunkMap = ChunkMap{epoch, boost::none /* timestamp */}.createMerged(
+        makeChunks(nChunks, epoch));
+
+    // Merge the chunks on both sides of the boundary between the first and second blocks
+    const auto boundary = int(ChunkMap::kMaxChunksPerBlock) * 10;
+    auto updatedChunkMap = chunkMap.createMerged({std::make_shared<ChunkInfo>(
+        ChunkType{kNss,
+                  ChunkRange{BSON("a" << boundary - 50), BSON("a" << boundary + 50)},
+                  ChunkVersion{2, 0, epoch, boost::none /* timestamp */},
+                  kThisShard})});
+
+    ASSERT_EQ(updatedChunkMap.size(), nChunks - 9);
+    ASSERT_EQ(updatedChunkMap.numSharedBlocks_ForTest(chunkMap), 2);
+    ASSERT_EQ(updatedChunkMap.constructShardVersionMap().size(), 1);
+
+    auto mergedChunk = updatedChunkMap.findIntersectingChunk(BSON("a" << boundary));
+    ASSERT_BSONOBJ_EQ(mergedChunk->getMin(), BSON("a" << boundary - 50));
+    ASSERT_BSONOBJ_EQ(mergedChunk->getMax(), BSON("a" << boundary + 50));
+}
+
 }  // namespace mongo
\ No newline at end of file
@@ -46,6 +46,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/stats/wait_events.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -218,6 +219,7 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
     // Block until the command is carried out
     auto executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
     try {
+        ScopedWaitEvent networkWait(opCtx, WaitEvent::kNetwork);
         executor->wait(asyncHandle.handle, opCtx);
     } catch (const DBException& e) {
         // If waiting for the response is interrupted, then we still have a callback out and
@@ -44,6 +44,7 @@
 #include "mongo/db/auth/action_type.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/concurrency/admission_context.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/error_labels.h"
 #include "mongo/db/initialize_api_parameters.h"
@@ -521,6 +522,15 @@ Status ParseAndRunCommand::_prologue() {
     }
 
     Client* client = opCtx->getClient();
+
+    // The priority is only enforced by the shards, which receive it as a generic argument. Validate
+    // it here so that external clients cannot raise it through mongos.
+    if (auto priorityField = request.body[kAdmissionPriorityFieldName]) {
+        const bool isInternalClient =
+            client->session() && client->session()->getTags() & transport::Session::kInternalClient;
+        AdmissionContext::get(opCtx).setPriority(
+            parseAdmissionPriorityField(priorityField, isInternalClient));
+    }
     auto const apiParamsFromClient = initializeAPIParameters(request.body, command);
 
     {
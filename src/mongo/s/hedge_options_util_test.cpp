@@ -94,9 +94,15 @@ protected:
     static inline const std::string kMaxTimeMSForHedgedReadsFieldName = "maxTimeMSForHedgedReads";
     static inline const int kMaxTimeMSForHedgedReadsDefault = 10;
 
+    static inline const std::string kReadHedgingDelayPercentileFieldName =
+        "readHedgingDelayPercentile";
+    static inline const std::string kMaxHedgedReadsPercentFieldName = "maxHedgedReadsPercent";
+
     static inline const BSONObj kDefaultParameters =
         BSON(kReadHedgingModeFieldName << "on" << kMaxTimeMSForHedgedReadsFieldName
-                                       << kMaxTimeMSForHedgedReadsDefault);
+                                       << kMaxTimeMSForHedgedReadsDefault
+                                       << kReadHedgingDelayPercentileFieldName << 95
+                                       << kMaxHedgedReadsPercentFieldName << 100);
 
 private:
     ServiceContext::UniqueServiceContext _serviceCtx = ServiceContext::make();
@@ -113,6 +119,20 @@ TEST_F(HedgeOptionsUtilTestFixture, ExplicitOperationHedging) {
     checkHedgeOptions(parameters, cmdObj, rspObj, true);
 }
 
+TEST_F(HedgeOptionsUtilTestFixture, HedgeDelayAndBudget) {
+    setParameters(BSON(kReadHedgingDelayPercentileFieldName
+                       << 90 << kMaxHedgedReadsPercentFieldName << 5));
+
+    const auto cmdObj = BSON("find" << kCollName);
+    const auto readPref = uassertStatusOK(ReadPreferenceSetting::fromInnerBSON(BSON("mode"
+                                                                                   << "nearest")));
+    auto hedgeOptions = extractHedgeOptions(cmdObj, readPref);
+
+    ASSERT_TRUE(hedgeOptions.has_value());
+    ASSERT_EQ(hedgeOptions->hedgeDelayPercentile, 90);
+    ASSERT_EQ(hedgeOptions->maxHedgedOperationsPercent, 5);
+}
+
 TEST_F(HedgeOptionsUtilTestFixture, ImplicitOperationHedging) {
     const auto parameters = BSONObj();
     const auto cmdObj = BSON("find" << kCollName);
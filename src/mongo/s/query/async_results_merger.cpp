@@ -40,8 +40,10 @@
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/kill_cursors_gen.h"
 #include "mongo/executor/remote_command_request.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/query/async_results_merger_knobs_gen.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -93,6 +95,16 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, rules);
 }
 
+/**
+ * Returns true if the sort keys of the merged results should be encoded as KeyStrings. The
+ * KeyString encoding compares in the same way as compareSortKeys(), but an Ordering can only
+ * describe the direction of a limited number of fields.
+ */
+bool shouldCompareKeyStrings(const AsyncResultsMergerParams& params) {
+    return params.getSort() && internalQueryMergeSortKeysAsKeyStrings.load() &&
+        static_cast<size_t>(params.getSort()->nFields()) <= Ordering::kMaxCompoundIndexKeys;
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -105,8 +117,13 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _compareKeyStrings(shouldCompareKeyStrings(_params)),
+      _sortOrdering(Ordering::make(_compareKeyStrings ? *_params.getSort() : BSONObj())),
+      _mergeQueue(_params.getRemotes().size(),
+                  MergingComparator(_remotes,
+                                    _params.getSort().value_or(BSONObj()),
+                                    _params.getCompareWholeSortKey(),
+                                    _compareKeyStrings)),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -312,7 +329,7 @@ bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
     }
 
     auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
+    const auto& smallestResult = _remotes[smallestRemote].docBuffer.front().result;
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
@@ -364,19 +381,16 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     }
 
     size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
 
     invariant(!_remotes[smallestRemote].docBuffer.empty());
     invariant(_remotes[smallestRemote].status.isOK());
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
+    ClusterQueryResult front = std::move(_remotes[smallestRemote].docBuffer.front().result);
     _remotes[smallestRemote].docBuffer.pop();
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
-    }
+    // Replay the merge with the next result from 'smallestRemote', or take the remote out of the
+    // merge if it has no next result.
+    _mergeQueue.update(smallestRemote, _remotes[smallestRemote].hasNext());
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
@@ -396,7 +410,8 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
         invariant(_remotes[_gettingFromRemote].status.isOK());
 
         if (_remotes[_gettingFromRemote].hasNext()) {
-            ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
+            ClusterQueryResult front =
+                std::move(_remotes[_gettingFromRemote].docBuffer.front().result);
             _remotes[_gettingFromRemote].docBuffer.pop();
 
             if (_tailableMode == TailableModeEnum::kTailable &&
@@ -435,6 +450,20 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
     }
 
+    // Bound the amount of data buffered for this remote by asking for no more documents than are
+    // expected to fit in the budget, given the average size of the documents it returned so far.
+    // This keeps a sorted merge over many remotes from buffering a full 16MB batch from each of
+    // them. Tailable cursors return whatever is available and are left alone.
+    const long long maxBufferedBytes = internalQueryMaxBufferedBytesPerRemoteCursor.load();
+    if (maxBufferedBytes > 0 && remote.fetchedCount > 0 &&
+        _tailableMode == TailableModeEnum::kNormal) {
+        const long long avgObjSize = std::max(1LL, remote.fetchedBytes / remote.fetchedCount);
+        const long long maxBatchSize = std::max(1LL, maxBufferedBytes / avgObjSize);
+        if (!adjustedBatchSize || *adjustedBatchSize > maxBatchSize) {
+            adjustedBatchSize = maxBatchSize;
+        }
+    }
+
     BSONObj cmdObj = GetMoreRequest(remote.cursorNss,
                                     remote.cursorId,
                                     adjustedBatchSize,
@@ -707,10 +736,14 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
     if (_params.getAllowPartialResults() || remote.status == ErrorCodes::ExchangePassthrough) {
         // Clear the results buffer and cursor id, and set 'partialResultsReturned' if appropriate.
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
-        std::queue<ClusterQueryResult> emptyBuffer;
+        std::queue<BufferedResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
+
+        if (_params.getSort()) {
+            _mergeQueue.update(remoteIndex, false);
+        }
     }
 }
 
@@ -783,15 +816,22 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
-        ClusterQueryResult result(obj);
-        remote.docBuffer.push(result);
+        BufferedResult buffered{ClusterQueryResult(obj), std::string()};
+        if (_compareKeyStrings) {
+            KeyString::Builder sortKey(KeyString::Version::kLatestVersion,
+                                       extractSortKey(obj, _params.getCompareWholeSortKey()),
+                                       _sortOrdering);
+            buffered.sortKey.assign(sortKey.getBuffer(), sortKey.getSize());
+        }
+
+        remote.docBuffer.push(std::move(buffered));
         ++remote.fetchedCount;
+        remote.fetchedBytes += obj.objsize();
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
+    // If we're doing a sorted merge, then we have to make sure this remote takes part in the merge.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeQueue.update(remoteIndex, true);
     }
     return true;
 }
@@ -897,13 +937,20 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 // AsyncResultsMerger::MergingComparator
 //
 
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
+int AsyncResultsMerger::MergingComparator::operator()(size_t lhs, size_t rhs) const {
+    const BufferedResult& leftDoc = _remotes[lhs].docBuffer.front();
+    const BufferedResult& rightDoc = _remotes[rhs].docBuffer.front();
+
+    if (_compareKeyStrings) {
+        return KeyString::compare(leftDoc.sortKey.data(),
+                                  rightDoc.sortKey.data(),
+                                  leftDoc.sortKey.size(),
+                                  rightDoc.sortKey.size());
+    }
 
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+    return compareSortKeys(extractSortKey(*leftDoc.result.getResult(), _compareWholeSortKey),
+                           extractSortKey(*rightDoc.result.getResult(), _compareWholeSortKey),
+                           _sort);
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
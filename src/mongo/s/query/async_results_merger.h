@@ -31,15 +31,18 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/query/cluster_query_result.h"
+#include "mongo/s/query/loser_tree.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
@@ -247,6 +250,16 @@ public:
     stdx::shared_future<void> kill(OperationContext* opCtx);
 
 private:
+    /**
+     * A result buffered from a remote, along with its sort key encoded as a KeyString when the
+     * merge compares KeyStrings. The encoding is done once, when the result is buffered, so that
+     * every subsequent comparison during the merge is a memcmp.
+     */
+    struct BufferedResult {
+        ClusterQueryResult result;
+        std::string sortKey;
+    };
+
     /**
      * We instantiate one of these per remote host. It contains the buffer of results we've
      * retrieved from the host but not yet returned, as well as the cursor id, and any error
@@ -304,7 +317,7 @@ private:
         bool partialResultsReturned = false;
 
         // The buffer of results that have been retrieved but not yet returned to the caller.
-        std::queue<ClusterQueryResult> docBuffer;
+        std::queue<BufferedResult> docBuffer;
 
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
@@ -316,16 +329,28 @@ private:
         // Count of fetched docs during ARM processing of the current batch. Used to reduce the
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
+
+        // Total size in bytes of the documents counted in 'fetchedCount'. Used to estimate how many
+        // documents the next batch can hold without exceeding the per-remote buffering budget.
+        long long fetchedBytes = 0;
     };
 
+    /**
+     * Compares the first buffered results of two remotes, returning a negative number, zero or a
+     * positive number if the result of 'lhs' sorts before, the same as or after that of 'rhs'.
+     */
     class MergingComparator {
     public:
         MergingComparator(const std::vector<RemoteCursorData>& remotes,
                           const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+                          bool compareWholeSortKey,
+                          bool compareKeyStrings)
+            : _remotes(remotes),
+              _sort(sort),
+              _compareWholeSortKey(compareWholeSortKey),
+              _compareKeyStrings(compareKeyStrings) {}
 
-        bool operator()(const size_t& lhs, const size_t& rhs);
+        int operator()(size_t lhs, size_t rhs) const;
 
     private:
         const std::vector<RemoteCursorData>& _remotes;
@@ -336,6 +361,10 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // When '_compareKeyStrings' is true, the results are compared by their pre-encoded
+        // 'BufferedResult::sortKey' rather than by their $sortKey BSON values.
+        const bool _compareKeyStrings;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -484,9 +513,14 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // True if the sort keys of buffered results are encoded as KeyStrings using '_sortOrdering'.
+    const bool _compareKeyStrings;
+    const Ordering _sortOrdering;
+
+    // The top of this tree is the index into '_remotes' for the remote host that has the next
+    // document to return, according to the sort order. A remote is active in the tree for as long
+    // as it has buffered results. Used only if there is a sort.
+    LoserTree<MergingComparator> _mergeQueue;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
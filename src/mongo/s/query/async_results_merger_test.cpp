@@ -42,9 +42,11 @@
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
+#include "mongo/s/query/async_results_merger_knobs_gen.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -441,6 +443,55 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortKeysOfMixedTypesMergeTheSameAsKeyStringsAndAsBSON) {
+    ON_BLOCK_EXIT([] { internalQueryMergeSortKeysAsKeyStrings.store(true); });
+
+    const std::vector<BSONObj> expected = {fromjson("{$sortKey: [null, 1]}"),
+                                           fromjson("{$sortKey: [1, 'c']}"),
+                                           fromjson("{$sortKey: [1, 'b']}"),
+                                           fromjson("{$sortKey: [1.0, 'a']}"),
+                                           fromjson("{$sortKey: [2, 'z']}"),
+                                           fromjson("{$sortKey: [2.5, 0]}"),
+                                           fromjson("{$sortKey: ['str', 5]}"),
+                                           fromjson("{$sortKey: [{x: 1}, 0]}")};
+
+    for (bool compareKeyStrings : {true, false}) {
+        internalQueryMergeSortKeysAsKeyStrings.store(compareKeyStrings);
+
+        BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1, b: -1}}");
+        std::vector<RemoteCursor> cursors;
+        cursors.push_back(makeRemoteCursor(
+            kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+        cursors.push_back(makeRemoteCursor(
+            kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+        cursors.push_back(makeRemoteCursor(
+            kTestShardIds[2], kTestShardHosts[2], CursorResponse(kTestNss, 7, {})));
+        auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+        ASSERT_FALSE(arm->ready());
+        auto readyEvent = unittest::assertGet(arm->nextEvent());
+        ASSERT_FALSE(arm->ready());
+
+        std::vector<CursorResponse> responses;
+        std::vector<BSONObj> batch1 = {expected[0], expected[2], expected[5]};
+        responses.emplace_back(kTestNss, CursorId(0), batch1);
+        std::vector<BSONObj> batch2 = {expected[1], expected[3], expected[6]};
+        responses.emplace_back(kTestNss, CursorId(0), batch2);
+        std::vector<BSONObj> batch3 = {expected[4], expected[7]};
+        responses.emplace_back(kTestNss, CursorId(0), batch3);
+        scheduleNetworkResponses(std::move(responses));
+        executor()->waitForEvent(readyEvent);
+
+        for (const auto& obj : expected) {
+            ASSERT_TRUE(arm->ready());
+            ASSERT_BSONOBJ_EQ(obj, *unittest::assertGet(arm->nextReady()).getResult());
+        }
+
+        ASSERT_TRUE(arm->ready());
+        ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+    }
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -1107,6 +1158,53 @@ TEST_F(AsyncResultsMergerTest, GetMoreBatchSizes) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, GetMoreBatchSizeBoundedByBufferedBytes) {
+    const BSONObj doc = BSON("_id" << 1 << "padding" << std::string(100, 'x'));
+    internalQueryMaxBufferedBytesPerRemoteCursor.store(3 * doc.objsize() + 1);
+    ON_BLOCK_EXIT([] { internalQueryMaxBufferedBytesPerRemoteCursor.store(4 * 1024 * 1024); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll'}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 1, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Nothing has been received from the remote yet, so the first getMore is not bounded.
+    ASSERT_FALSE(arm->ready());
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    auto firstRequest =
+        GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+    ASSERT_OK(firstRequest.getStatus());
+    ASSERT_FALSE(firstRequest.getValue().batchSize);
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch = {doc, doc, doc, doc, doc};
+    responses.emplace_back(kTestNss, CursorId(1), batch);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(doc, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_FALSE(arm->ready());
+
+    // Only three more documents of the same size fit in the budget.
+    readyEvent = unittest::assertGet(arm->nextEvent());
+    auto secondRequest =
+        GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+    ASSERT_OK(secondRequest.getStatus());
+    ASSERT_EQ(*secondRequest.getValue().batchSize, 3LL);
+
+    responses.clear();
+    responses.emplace_back(kTestNss, CursorId(0), std::vector<BSONObj>{});
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, AllowPartialResults) {
     BSONObj findCmd = fromjson("{find: 'testcoll', allowPartialResults: true}");
     std::vector<RemoteCursor> cursors;
@@ -0,0 +1,174 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * Tournament tree which repeatedly selects the smallest among a fixed number of sources, such as
+ * the remotes of a sorted merge. Every source is a leaf of the tree, which is either active or
+ * inactive, and every internal node records the loser of the match played at it. When the value
+ * of the winning leaf changes, only the matches on its path to the root need to be replayed, which
+ * takes exactly one comparison per level of the tree, as opposed to up to two per level for a
+ * binary heap.
+ *
+ * 'Compare' is called with the indexes of two active leaves and must return a negative number,
+ * zero or a positive number if the value of the first one sorts before, the same as or after the
+ * value of the second one. Ties are broken in favour of the leaf with the lower index.
+ */
+template <typename Compare>
+class LoserTree {
+public:
+    LoserTree(size_t numLeaves, Compare compare)
+        : _compare(std::move(compare)), _nodes(numLeaves), _active(numLeaves, false) {}
+
+    size_t numLeaves() const {
+        return _active.size();
+    }
+
+    bool isActive(size_t leaf) const {
+        return _active[leaf];
+    }
+
+    /**
+     * Returns true if none of the leaves is active.
+     */
+    bool empty() const {
+        return _numActive == 0;
+    }
+
+    /**
+     * Returns the index of the active leaf whose value sorts first. Must not be called if the tree
+     * is empty.
+     */
+    size_t top() {
+        invariant(!empty());
+
+        if (_needsRebuild) {
+            _rebuild();
+        }
+
+        return _nodes[0];
+    }
+
+    /**
+     * Informs the tree that 'leaf' either became active or inactive, or that its value changed.
+     *
+     * Changes to the current winner are applied by replaying its matches, whereas changes to any
+     * other leaf require all the matches to be played again, which is deferred until the next call
+     * to top().
+     */
+    void update(size_t leaf, bool active) {
+        if (_active[leaf] != active) {
+            _active[leaf] = active;
+            active ? ++_numActive : --_numActive;
+        } else if (!active) {
+            return;
+        }
+
+        if (!_needsRebuild && leaf == _nodes[0]) {
+            _replay(leaf);
+        } else {
+            _needsRebuild = true;
+        }
+    }
+
+private:
+    /**
+     * Returns true if leaf 'lhs' wins the match against leaf 'rhs'. Inactive leaves lose against
+     * every active leaf.
+     */
+    bool _beats(size_t lhs, size_t rhs) {
+        if (!_active[lhs] || !_active[rhs]) {
+            return _active[lhs] || (!_active[rhs] && lhs < rhs);
+        }
+
+        const int cmp = _compare(lhs, rhs);
+        return cmp < 0 || (cmp == 0 && lhs < rhs);
+    }
+
+    /**
+     * Plays all the matches. Leaf 'i' is node 'numLeaves() + i' and the parent of node 'i' is node
+     * 'i / 2', with node 1 being the root.
+     */
+    void _rebuild() {
+        const size_t n = numLeaves();
+
+        std::vector<size_t> winners(2 * n);
+        for (size_t leaf = 0; leaf < n; ++leaf) {
+            winners[n + leaf] = leaf;
+        }
+
+        for (size_t node = n - 1; node > 0; --node) {
+            const size_t left = winners[2 * node];
+            const size_t right = winners[2 * node + 1];
+            const bool leftWins = _beats(left, right);
+            winners[node] = leftWins ? left : right;
+            _nodes[node] = leftWins ? right : left;
+        }
+
+        _nodes[0] = winners[1];
+        _needsRebuild = false;
+    }
+
+    /**
+     * Replays the matches on the path from 'leaf', which must be the current winner, to the root.
+     * Since the winner won every match on its path, the losers recorded along it are the winners
+     * of the sibling subtrees, which is all that is needed to find the new winner.
+     */
+    void _replay(size_t leaf) {
+        size_t winner = leaf;
+        for (size_t node = (numLeaves() + leaf) / 2; node > 0; node /= 2) {
+            if (_beats(_nodes[node], winner)) {
+                std::swap(_nodes[node], winner);
+            }
+        }
+
+        _nodes[0] = winner;
+    }
+
+    Compare _compare;
+
+    // The winner of the tournament is at position 0 and the loser of the match played at internal
+    // node 'i' is at position 'i'.
+    std::vector<size_t> _nodes;
+
+    std::vector<bool> _active;
+    size_t _numActive = 0;
+
+    bool _needsRebuild = true;
+};
+
+}  // namespace mongo
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/platform/random.h"
+#include "mongo/s/query/loser_tree.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Merges the given sorted runs through a LoserTree, in the same way the AsyncResultsMerger
+ * consumes its remotes, and returns the merged sequence.
+ */
+std::vector<int> mergeRuns(const std::vector<std::vector<int>>& runs) {
+    std::vector<size_t> positions(runs.size(), 0);
+    auto compare = [&](size_t lhs, size_t rhs) {
+        const int l = runs[lhs][positions[lhs]];
+        const int r = runs[rhs][positions[rhs]];
+        return l < r ? -1 : (l > r ? 1 : 0);
+    };
+
+    LoserTree<decltype(compare)> tree(runs.size(), compare);
+    for (size_t i = 0; i < runs.size(); ++i) {
+        tree.update(i, !runs[i].empty());
+    }
+
+    std::vector<int> merged;
+    while (!tree.empty()) {
+        const size_t leaf = tree.top();
+        merged.push_back(runs[leaf][positions[leaf]++]);
+        tree.update(leaf, positions[leaf] < runs[leaf].size());
+    }
+
+    return merged;
+}
+
+std::vector<int> sortedConcatenation(const std::vector<std::vector<int>>& runs) {
+    std::vector<int> expected;
+    for (const auto& run : runs) {
+        expected.insert(expected.end(), run.begin(), run.end());
+    }
+    std::sort(expected.begin(), expected.end());
+    return expected;
+}
+
+TEST(LoserTreeTest, EmptyTree) {
+    auto compare = [](size_t, size_t) { return 0; };
+    LoserTree<decltype(compare)> tree(3, compare);
+    ASSERT_TRUE(tree.empty());
+
+    tree.update(1, true);
+    ASSERT_FALSE(tree.empty());
+    ASSERT_EQ(1U, tree.top());
+
+    tree.update(1, false);
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(LoserTreeTest, SingleLeaf) {
+    ASSERT(mergeRuns({{1, 2, 3}}) == std::vector<int>({1, 2, 3}));
+}
+
+TEST(LoserTreeTest, TiesAreBrokenByLeafIndex) {
+    auto compare = [](size_t, size_t) { return 0; };
+    LoserTree<decltype(compare)> tree(5, compare);
+    for (size_t i = 0; i < 5; ++i) {
+        tree.update(i, true);
+    }
+
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(i, tree.top());
+        tree.update(i, false);
+    }
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(LoserTreeTest, MergesRunsOfDifferentLengths) {
+    const std::vector<std::vector<int>> runs{{1, 4, 9}, {}, {2, 3, 5, 6, 7, 8}, {0}, {4, 10}};
+    ASSERT(mergeRuns(runs) == sortedConcatenation(runs));
+}
+
+TEST(LoserTreeTest, MergesRandomRunsForAnyNumberOfLeaves) {
+    PseudoRandom random(12345);
+    for (size_t numLeaves = 1; numLeaves <= 17; ++numLeaves) {
+        std::vector<std::vector<int>> runs(numLeaves);
+        for (auto& run : runs) {
+            const int length = random.nextInt32(20);
+            for (int i = 0; i < length; ++i) {
+                run.push_back(random.nextInt32(50));
+            }
+            std::sort(run.begin(), run.end());
+        }
+
+        ASSERT(mergeRuns(runs) == sortedConcatenation(runs));
+    }
+}
+
+TEST(LoserTreeTest, ReactivatedLeafIsConsideredAgain) {
+    std::vector<int> values{5, 3, 7};
+    auto compare = [&](size_t lhs, size_t rhs) { return values[lhs] - values[rhs]; };
+    LoserTree<decltype(compare)> tree(values.size(), compare);
+    for (size_t i = 0; i < values.size(); ++i) {
+        tree.update(i, true);
+    }
+    ASSERT_EQ(1U, tree.top());
+
+    // Deactivate the winner, as a remote whose buffer ran dry would be.
+    tree.update(1, false);
+    ASSERT_EQ(0U, tree.top());
+
+    // Bring it back with a value which sorts first again.
+    values[1] = 1;
+    tree.update(1, true);
+    ASSERT_EQ(1U, tree.top());
+
+    // Change the value of a leaf which is not the winner.
+    values[2] = 0;
+    tree.update(2, true);
+    ASSERT_EQ(2U, tree.top());
+}
+
+}  // namespace
+}  // namespace mongo
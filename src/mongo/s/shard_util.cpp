@@ -236,5 +236,43 @@ StatusWith<boost::optional<ChunkRange>> splitChunkAtMultiplePoints(
     return boost::optional<ChunkRange>();
 }
 
+Status mergeChunks(OperationContext* opCtx,
+                   const ShardId& shardId,
+                   const NamespaceString& nss,
+                   ChunkVersion collectionVersion,
+                   const ChunkRange& chunkRange) {
+    BSONObjBuilder cmd;
+    cmd.append("mergeChunks", nss.ns());
+    cmd.append("bounds", BSON_ARRAY(chunkRange.getMin() << chunkRange.getMax()));
+    cmd.append("epoch", collectionVersion.epoch());
+
+    BSONObj cmdObj = cmd.obj();
+
+    auto shardStatus = Grid::get(opCtx)->shardRegistry()->getShard(opCtx, shardId);
+    if (!shardStatus.isOK()) {
+        return shardStatus.getStatus();
+    }
+
+    auto cmdStatus = shardStatus.getValue()->runCommandWithFixedRetryAttempts(
+        opCtx,
+        ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+        "admin",
+        cmdObj,
+        Shard::RetryPolicy::kNotIdempotent);
+    auto status = cmdStatus.isOK() ? std::move(cmdStatus.getValue().commandStatus)
+                                   : std::move(cmdStatus.getStatus());
+    if (!status.isOK()) {
+        LOGV2(5986708,
+              "Merge chunks {request} failed: {error}",
+              "Merge chunks request against shard failed",
+              "request"_attr = redact(cmdObj),
+              "shardId"_attr = shardId,
+              "error"_attr = redact(status));
+        return status.withContext("merge failed");
+    }
+
+    return Status::OK();
+}
+
 }  // namespace shardutil
 }  // namespace mongo
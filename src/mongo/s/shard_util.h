@@ -101,5 +101,20 @@ StatusWith<boost::optional<ChunkRange>> splitChunkAtMultiplePoints(
     const ChunkRange& chunkRange,
     const std::vector<BSONObj>& splitPoints);
 
+/**
+ * Asks the specified shard to merge the contiguous chunks, which it owns within 'chunkRange', into
+ * a single chunk.
+ *
+ * shardId The shard, which currently owns the chunks.
+ * nss Namespace, which owns the chunks.
+ * collectionVersion The expected collection version when doing the merge.
+ * chunkRange Bounds of the range to be merged.
+ */
+Status mergeChunks(OperationContext* opCtx,
+                   const ShardId& shardId,
+                   const NamespaceString& nss,
+                   ChunkVersion collectionVersion,
+                   const ChunkRange& chunkRange);
+
 }  // namespace shardutil
 }  // namespace mongo
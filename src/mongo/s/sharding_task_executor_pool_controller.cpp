@@ -159,10 +159,19 @@ public:
     }
 
     void onConfirmedSet(const State& state) noexcept override {
-        stdx::lock_guard lk(_controller->_mutex);
+        std::vector<HostAndPort> members;
+        {
+            stdx::lock_guard lk(_controller->_mutex);
+
+            _controller->_removeGroup(lk, state.connStr.getSetName());
+            _controller->_addGroup(lk, state);
+
+            members = _controller->_groupDatas.at(state.connStr.getSetName())->members;
+        }
 
-        _controller->_removeGroup(lk, state.connStr.getSetName());
-        _controller->_addGroup(lk, state);
+        if (gParameters.warmUpOnTopologyChange.load()) {
+            _controller->_pool->warmUp(std::move(members));
+        }
     }
 
     void onPossibleSet(const State& state) noexcept override {
@@ -216,7 +225,7 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     const size_t maxConns = gParameters.maxConnections.load();
 
     // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    poolData.target = std::max(stats.requests + stats.active, stats.predictedDemand);
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -311,4 +320,8 @@ Milliseconds ShardingTaskExecutorPoolController::toRefreshTimeout() const {
     return Milliseconds{gParameters.toRefreshTimeoutMS.load()};
 }
 
+Milliseconds ShardingTaskExecutorPoolController::demandHalfLife() const {
+    return Milliseconds{gParameters.demandHalfLifeMS.load()};
+}
+
 }  // namespace mongo
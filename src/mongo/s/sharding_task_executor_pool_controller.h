@@ -59,6 +59,10 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * When warmUpOnTopologyChange is set, every confirmed replica set configuration (including the
+ * first one seen at startup) asks the ConnectionPool to create pools for the active members which
+ * don't have one yet, so that their connections are established ahead of the first request.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -86,6 +90,9 @@ public:
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
         AtomicWord<int> toRefreshTimeoutMS;
+        AtomicWord<int> demandHalfLifeMS;
+
+        AtomicWord<bool> warmUpOnTopologyChange;
 
         synchronized_value<std::string> matchingStrategyString;
         AtomicWord<MatchingStrategy> matchingStrategy;
@@ -124,6 +131,7 @@ public:
     Milliseconds hostTimeout() const override;
     Milliseconds pendingTimeout() const override;
     Milliseconds toRefreshTimeout() const override;
+    Milliseconds demandHalfLife() const override;
 
     StringData name() const override {
         return "ShardingTaskExecutorPoolController"_sd;
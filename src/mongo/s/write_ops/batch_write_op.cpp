@@ -66,6 +66,11 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// Inserts are targeted in windows of this many consecutive ready writes, so that the targeter can
+// look up their shard keys together. The window is kept small because targeting an ordered batch
+// stops at the first write which goes to a different shard than the writes before it.
+const size_t kInsertTargetingWindowSize = 64;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -301,6 +306,29 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    const bool isInsert = _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+
+    // Indexes and targeting results of the write ops in the current window of inserts
+    std::vector<size_t> insertWindowOps;
+    std::vector<StatusWith<ShardEndpoint>> insertWindowEndpoints;
+    size_t insertWindowPos = 0;
+
+    const auto targetInsertWindow = [&](size_t firstOp) {
+        std::vector<size_t> windowOps;
+        std::vector<BSONObj> docs;
+        for (size_t j = firstOp; j < numWriteOps && docs.size() < kInsertTargetingWindowSize; ++j) {
+            if (_writeOps[j].getWriteState() != WriteOpState_Ready)
+                continue;
+
+            windowOps.push_back(j);
+            docs.push_back(_writeOps[j].getWriteItem().getDocument());
+        }
+
+        insertWindowEndpoints = targeter.targetInserts(_opCtx, docs);
+        insertWindowOps = std::move(windowOps);
+        insertWindowPos = 0;
+    };
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -318,7 +346,18 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (isInsert) {
+                if (insertWindowPos == insertWindowOps.size()) {
+                    targetInsertWindow(i);
+                }
+
+                invariant(insertWindowOps[insertWindowPos] == i);
+                auto& endpoint = insertWindowEndpoints[insertWindowPos++];
+                writeOp.targetWrites(
+                    _opCtx, targeter, uassertStatusOK(std::move(endpoint)), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
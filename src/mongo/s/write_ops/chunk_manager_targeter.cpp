@@ -379,6 +379,56 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
         _nss.isOnInternalDb() ? boost::optional<DatabaseVersion>() : _cm->dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_cm->isSharded()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints(
+        docs.size(), Status(ErrorCodes::ShardKeyNotFound, "Document was not targeted"));
+
+    // Extract the shard keys of all the documents first, so that their chunks can be looked up
+    // together
+    std::vector<BSONObj> shardKeys;
+    std::vector<size_t> shardKeyDocIndexes;
+    shardKeys.reserve(docs.size());
+    shardKeyDocIndexes.reserve(docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        auto shardKey = _cm->getShardKeyPattern().extractShardKeyFromDoc(docs[i]);
+        if (shardKey.isEmpty()) {
+            endpoints[i] = Status(ErrorCodes::ShardKeyNotFound,
+                                  "Shard key cannot contain array values or array descendants.");
+            continue;
+        }
+
+        shardKeys.push_back(std::move(shardKey));
+        shardKeyDocIndexes.push_back(i);
+    }
+
+    const auto chunks = _cm->findIntersectingChunksWithSimpleCollation(shardKeys);
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto& endpoint = endpoints[shardKeyDocIndexes[i]];
+        if (!chunks[i]) {
+            endpoint = Status(ErrorCodes::ShardKeyNotFound,
+                              str::stream() << "Cannot target single shard using key "
+                                            << shardKeys[i] << " for namespace " << _nss);
+            continue;
+        }
+
+        try {
+            const auto& shardId = chunks[i]->getShardId();
+            endpoint = ShardEndpoint(shardId, _cm->getVersion(shardId), boost::none);
+        } catch (const DBException& ex) {
+            endpoint = ex.toStatus();
+        }
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
@@ -117,6 +117,38 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsAsBatchMatchesTargetInsert) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a.b" << BSONNULL), BSON("a.b" << -100), BSON("a.b" << 0), BSON("a.b" << 100)};
+    auto cmTargeter = prepare(BSON("a.b" << 1 << "c.d"
+                                         << "hashed"),
+                              splitPoints);
+
+    const std::vector<BSONObj> docs{fromjson("{a: {b: 1000}, c: null, d: {}}"),
+                                    fromjson("{a: {b: -111}, c: {d: '1'}}"),
+                                    fromjson("{a: [1,2]}"),
+                                    fromjson("{a: {b: 0}, c: {d: 4}}"),
+                                    BSONObj(),
+                                    fromjson("{a: {b: -10}}"),
+                                    fromjson("{a: {b: -111}, c: {d: '2'}}")};
+
+    const auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (i == 2) {
+            // Arrays along shard key path are not allowed.
+            ASSERT_EQ(endpoints[i].getStatus().code(), ErrorCodes::ShardKeyNotFound);
+            continue;
+        }
+
+        const auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+        ASSERT_OK(endpoints[i].getStatus());
+        ASSERT_EQUALS(endpoints[i].getValue().shardName, expected.shardName);
+        ASSERT_EQUALS(*endpoints[i].getValue().shardVersion, *expected.shardVersion);
+    }
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
@@ -66,6 +66,22 @@ void WriteOp::targetWrites(OperationContext* opCtx,
         MONGO_UNREACHABLE;
     }();
 
+    _createChildWrites(opCtx, targeter, std::move(endpoints), targetedWrites);
+}
+
+void WriteOp::targetWrites(OperationContext* opCtx,
+                           const NSTargeter& targeter,
+                           ShardEndpoint insertEndpoint,
+                           std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+
+    _createChildWrites(opCtx, targeter, std::vector{std::move(insertEndpoint)}, targetedWrites);
+}
+
+void WriteOp::_createChildWrites(OperationContext* opCtx,
+                                 const NSTargeter& targeter,
+                                 std::vector<ShardEndpoint> endpoints,
+                                 std::vector<TargetedWrite*>* targetedWrites) {
     // Unless executing as part of a transaction, if we're targeting more than one endpoint with an
     // update/delete, we have to target everywhere since we cannot currently retry partial results.
     //
@@ -123,6 +123,15 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as above, but for an insert whose endpoint was already resolved by the caller, for
+     * example through NSTargeter::targetInserts().
+     */
+    void targetWrites(OperationContext* opCtx,
+                      const NSTargeter& targeter,
+                      ShardEndpoint insertEndpoint,
+                      std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -161,6 +170,14 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates the child writes for the endpoints to which this write was targeted.
+     */
+    void _createChildWrites(OperationContext* opCtx,
+                            const NSTargeter& targeter,
+                            std::vector<ShardEndpoint> endpoints,
+                            std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
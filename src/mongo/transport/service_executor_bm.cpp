@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/transport/service_executor_fixed.h"
+#include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/util/future.h"
+#include "mongo/util/testing_proctor.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+constexpr auto kNumExecutorThreads = 8;
+constexpr auto kTasksPerSession = 64;
+constexpr auto kMaxSessions = 256;
+constexpr auto kShutdownTimeout = Milliseconds{10000};
+
+/**
+ * Emulates a client session as a chain of short tasks, each of which schedules the next one the
+ * way the ServiceStateMachine schedules the processing of the next request.
+ */
+class SessionChain {
+public:
+    SessionChain(ServiceExecutor* executor, unique_function<void()> onDone)
+        : _executor(executor), _onDone(std::move(onDone)) {}
+
+    void start() {
+        _scheduleNext();
+    }
+
+private:
+    void _scheduleNext() {
+        invariant(_executor->scheduleTask([this] { _step(); }, ServiceExecutor::kEmptyFlags));
+    }
+
+    void _step() {
+        // A little work to stand in for processing a request.
+        for (int i = 0; i < 64; ++i) {
+            benchmark::DoNotOptimize(_checksum += i * _remaining);
+        }
+
+        if (--_remaining == 0) {
+            _onDone();
+            return;
+        }
+        _scheduleNext();
+    }
+
+    ServiceExecutor* const _executor;
+    unique_function<void()> _onDone;
+    int _remaining = kTasksPerSession;
+    uint64_t _checksum = 0;
+};
+
+void runSessions(benchmark::State& state, ServiceExecutor* executor) {
+    const auto numSessions = state.range(0);
+    for (auto _ : state) {
+        auto pf = makePromiseFuture<void>();
+        AtomicWord<int64_t> sessionsLeft{numSessions};
+        auto onDone = [&] {
+            if (sessionsLeft.subtractAndFetch(1) == 0) {
+                pf.promise.emplaceValue();
+            }
+        };
+
+        std::vector<std::unique_ptr<SessionChain>> sessions;
+        for (int64_t i = 0; i < numSessions; ++i) {
+            sessions.push_back(std::make_unique<SessionChain>(executor, onDone));
+        }
+        for (auto& session : sessions) {
+            session->start();
+        }
+        pf.future.get();
+    }
+    state.SetItemsProcessed(state.iterations() * numSessions * kTasksPerSession);
+}
+
+/**
+ * ServiceExecutorFixed expects a TransportLayer to start outside of tests.
+ */
+void enableTestingProctor() {
+    if (!TestingProctor::instance().isInitialized()) {
+        TestingProctor::instance().setEnabled(true);
+    }
+}
+
+std::shared_ptr<ServiceExecutorFixed> makeFixedExecutor(bool useWorkStealing) {
+    enableTestingProctor();
+
+    ThreadPool::Limits limits;
+    limits.minThreads = limits.maxThreads = kNumExecutorThreads;
+    auto executor = std::make_shared<ServiceExecutorFixed>(std::move(limits), useWorkStealing);
+    invariant(executor->start());
+    return executor;
+}
+
+void BM_ServiceExecutorSynchronous(benchmark::State& state) {
+    // Every session runs on a dedicated thread, which exits once the session has no more tasks.
+    ServiceExecutorSynchronous executor(getGlobalServiceContext());
+    invariant(executor.start());
+    runSessions(state, &executor);
+    invariant(executor.shutdown(kShutdownTimeout));
+}
+
+void BM_ServiceExecutorFixed(benchmark::State& state) {
+    auto executor = makeFixedExecutor(false);
+    runSessions(state, executor.get());
+    invariant(executor->shutdown(kShutdownTimeout));
+    executor->join();
+}
+
+void BM_ServiceExecutorFixedWorkStealing(benchmark::State& state) {
+    auto executor = makeFixedExecutor(true);
+    runSessions(state, executor.get());
+    invariant(executor->shutdown(kShutdownTimeout));
+    executor->join();
+}
+
+BENCHMARK(BM_ServiceExecutorSynchronous)->RangeMultiplier(4)->Range(1, kMaxSessions);
+BENCHMARK(BM_ServiceExecutorFixed)->RangeMultiplier(4)->Range(1, kMaxSessions);
+BENCHMARK(BM_ServiceExecutorFixedWorkStealing)->RangeMultiplier(4)->Range(1, kMaxSessions);
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
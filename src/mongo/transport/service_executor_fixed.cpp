@@ -55,6 +55,10 @@ constexpr auto kThreadsRunning = "threadsRunning"_sd;
 constexpr auto kClientsInTotal = "clientsInTotal"_sd;
 constexpr auto kClientsRunning = "clientsRunning"_sd;
 constexpr auto kClientsWaiting = "clientsWaitingForData"_sd;
+constexpr auto kWorkStealing = "workStealing"_sd;
+constexpr auto kThreadsIdle = "threadsIdle"_sd;
+constexpr auto kTasksRunLocally = "tasksRunLocally"_sd;
+constexpr auto kTasksStolen = "tasksStolen"_sd;
 
 struct Handle {
     ~Handle() {
@@ -72,7 +76,8 @@ const auto serviceExecutorFixedRegisterer = ServiceContext::ConstructorActionReg
         auto limits = ThreadPool::Limits{};
         limits.minThreads = 0;
         limits.maxThreads = fixedServiceExecutorThreadLimit;
-        getHandle(ctx).ptr = std::make_shared<ServiceExecutorFixed>(ctx, std::move(limits));
+        getHandle(ctx).ptr = std::make_shared<ServiceExecutorFixed>(
+            ctx, std::move(limits), fixedServiceExecutorUseWorkStealing);
     }};
 }  // namespace
 
@@ -127,17 +132,45 @@ ServiceExecutorFixed::ExecutorThreadContext::~ExecutorThreadContext() {
     }
 }
 
+class ServiceExecutorFixed::AffinityExecutor final : public OutOfLineExecutor {
+public:
+    AffinityExecutor(std::shared_ptr<ServiceExecutorFixed> executor, size_t workerId)
+        : _executor(std::move(executor)), _workerId(workerId) {}
+
+    void schedule(Task task) override {
+        _executor->_schedule(std::move(task), _workerId);
+    }
+
+private:
+    const std::shared_ptr<ServiceExecutorFixed> _executor;
+    const size_t _workerId;
+};
+
 thread_local std::unique_ptr<ServiceExecutorFixed::ExecutorThreadContext>
     ServiceExecutorFixed::_executorContext;
 
-ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits)
+ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx,
+                                           ThreadPool::Limits limits,
+                                           bool useWorkStealing)
     : _svcCtx{ctx}, _options(std::move(limits)) {
     _options.poolName = "ServiceExecutorFixed";
     _options.onCreateThread = [this](const auto&) {
         _executorContext = std::make_unique<ExecutorThreadContext>(this);
     };
 
-    _threadPool = std::make_shared<ThreadPool>(_options);
+    if (!useWorkStealing) {
+        _threadPool = std::make_shared<ThreadPool>(_options);
+        return;
+    }
+
+    WorkStealingThreadPool::Options options;
+    options.poolName = _options.poolName;
+    options.minThreads = _options.minThreads;
+    options.maxThreads = _options.maxThreads;
+    options.onCreateThread = _options.onCreateThread;
+    auto pool = std::make_shared<WorkStealingThreadPool>(std::move(options));
+    _workStealingPool = pool.get();
+    _threadPool = std::move(pool);
 }
 
 ServiceExecutorFixed::~ServiceExecutorFixed() {
@@ -373,18 +406,21 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
 
     hangBeforeSchedulingServiceExecutorFixedTask.pauseWhileSet();
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
-        invariant(status);
+    _scheduleOnPool(
+        [this, task = std::move(task)](Status status) mutable {
+            invariant(status);
 
-        _executorContext->run([&] { task(); });
-    });
+            _executorContext->run([&] { task(); });
+        },
+        _currentWorker());
 
     return Status::OK();
 } catch (DBException& e) {
     return e.toStatus();
 }
 
-void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
+void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task,
+                                     boost::optional<size_t> workerId) noexcept {
     {
         auto lk = stdx::unique_lock(_mutex);
         if (_state != State::kRunning) {
@@ -397,9 +433,29 @@ void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
         _stats.tasksScheduled.fetchAndAdd(1);
     }
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
-        _executorContext->run([&] { task(std::move(status)); });
-    });
+    _scheduleOnPool(
+        [this, task = std::move(task)](Status status) mutable {
+            _executorContext->run([&] { task(std::move(status)); });
+        },
+        workerId);
+}
+
+void ServiceExecutorFixed::_scheduleOnPool(OutOfLineExecutor::Task task,
+                                           boost::optional<size_t> workerId) {
+    if (_workStealingPool) {
+        _workStealingPool->scheduleOnWorker(std::move(task), workerId);
+        return;
+    }
+
+    _threadPool->schedule(std::move(task));
+}
+
+boost::optional<size_t> ServiceExecutorFixed::_currentWorker() const {
+    if (!_workStealingPool || !_executorContext || _executorContext->getRecursionDepth() == 0) {
+        return boost::none;
+    }
+
+    return _workStealingPool->getCurrentWorkerId();
 }
 
 size_t ServiceExecutorFixed::getRunningThreads() const {
@@ -429,8 +485,14 @@ void ServiceExecutorFixed::runOnDataAvailable(const SessionHandle& session,
         _stats.waitersStarted.fetchAndAdd(1);
     }
 
+    // Resume the session on the executor thread that ran it last, if we know which one it is.
+    ExecutorPtr resumeOn = shared_from_this();
+    if (auto workerId = _currentWorker()) {
+        resumeOn = std::make_shared<AffinityExecutor>(shared_from_this(), *workerId);
+    }
+
     session->asyncWaitForData()
-        .thenRunOn(shared_from_this())
+        .thenRunOn(std::move(resumeOn))
         .getAsync([this, anchor = shared_from_this(), it](Status status) mutable {
             Waiter waiter;
             {
@@ -455,6 +517,14 @@ void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
     subbob.append(kClientsInTotal, static_cast<int>(_tasksTotal()));
     subbob.append(kClientsRunning, static_cast<int>(_tasksRunning()));
     subbob.append(kClientsWaiting, static_cast<int>(_tasksWaiting()));
+
+    if (_workStealingPool) {
+        auto stats = _workStealingPool->getStats();
+        BSONObjBuilder wsBob = subbob.subobjStart(kWorkStealing);
+        wsBob.append(kThreadsIdle, static_cast<int>(stats.numIdleThreads));
+        wsBob.append(kTasksRunLocally, static_cast<long long>(stats.numTasksRunLocally));
+        wsBob.append(kTasksStolen, static_cast<long long>(stats.numTasksStolen));
+    }
 }
 
 int ServiceExecutorFixed::getRecursionDepthForExecutorThread() const {
@@ -42,6 +42,7 @@
 #include "mongo/transport/service_executor.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
 #include "mongo/util/future.h"
 #include "mongo/util/hierarchical_acquisition.h"
 
@@ -52,6 +53,10 @@ namespace transport {
  * A service executor that uses a fixed (configurable) number of threads to execute tasks.
  * This executor always yields before executing scheduled tasks, and never yields before scheduling
  * new tasks (i.e., `ScheduleFlags::kMayYieldBeforeSchedule` is a no-op for this executor).
+ *
+ * When constructed with `useWorkStealing`, tasks run on a WorkStealingThreadPool instead of a
+ * ThreadPool. Tasks scheduled from an executor thread, and the tasks that resume a session once
+ * its data is available, are then queued on the executor thread that ran the session last.
  */
 class ServiceExecutorFixed final : public ServiceExecutor,
                                    public std::enable_shared_from_this<ServiceExecutorFixed> {
@@ -61,9 +66,11 @@ class ServiceExecutorFixed final : public ServiceExecutor,
         Status(ErrorCodes::ServiceExecutorInShutdown, "ServiceExecutorFixed is not running");
 
 public:
-    explicit ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits);
-    explicit ServiceExecutorFixed(ThreadPool::Limits limits)
-        : ServiceExecutorFixed(nullptr, std::move(limits)) {}
+    explicit ServiceExecutorFixed(ServiceContext* ctx,
+                                  ThreadPool::Limits limits,
+                                  bool useWorkStealing = false);
+    explicit ServiceExecutorFixed(ThreadPool::Limits limits, bool useWorkStealing = false)
+        : ServiceExecutorFixed(nullptr, std::move(limits), useWorkStealing) {}
     virtual ~ServiceExecutorFixed();
 
     static ServiceExecutorFixed* get(ServiceContext* ctx);
@@ -98,9 +105,20 @@ private:
     // Maintains the execution state (e.g., recursion depth) for executor threads
     class ExecutorThreadContext;
 
+    // Schedules tasks on a fixed worker of the work-stealing pool
+    class AffinityExecutor;
+
     void _checkForShutdown(WithLock);
     void _beginShutdown(WithLock);
-    void _schedule(OutOfLineExecutor::Task task) noexcept;
+    void _schedule(OutOfLineExecutor::Task task,
+                   boost::optional<size_t> workerId = boost::none) noexcept;
+    void _scheduleOnPool(OutOfLineExecutor::Task task, boost::optional<size_t> workerId);
+
+    /**
+     * Returns the work-stealing worker that runs the current task, if any. The executor thread
+     * that runs the reactor never reports a worker, so no session is tied to it.
+     */
+    boost::optional<size_t> _currentWorker() const;
 
     auto _threadsRunning() const {
         auto ended = _stats.threadsEnded.load();
@@ -157,7 +175,10 @@ private:
     bool _isJoined = false;
 
     ThreadPool::Options _options;
-    std::shared_ptr<ThreadPool> _threadPool;
+    std::shared_ptr<ThreadPoolInterface> _threadPool;
+
+    // Set when `_threadPool` is a WorkStealingThreadPool.
+    WorkStealingThreadPool* _workStealingPool = nullptr;
 
     struct Waiter {
         SessionHandle session;
@@ -177,10 +177,10 @@ public:
     public:
         ServiceExecutorHandle(const ServiceExecutorHandle&) = delete;
         ServiceExecutorHandle(ServiceExecutorHandle&&) = delete;
-        ServiceExecutorHandle() {
+        explicit ServiceExecutorHandle(bool useWorkStealing = false) {
             ThreadPool::Limits limits;
             limits.minThreads = limits.maxThreads = kNumExecutorThreads;
-            _executor = std::make_shared<ServiceExecutorFixed>(std::move(limits));
+            _executor = std::make_shared<ServiceExecutorFixed>(std::move(limits), useWorkStealing);
         }
 
         ~ServiceExecutorHandle() {
@@ -380,6 +380,72 @@ TEST_F(ServiceExecutorFixedFixture, RunTaskAfterWaitingForData) {
     ASSERT(ranOnDataAvailable.load());
 }
 
+TEST_F(ServiceExecutorFixedFixture, WorkStealingBasicTaskRuns) {
+    auto executorHandle = ServiceExecutorHandle(true);
+    executorHandle.start();
+
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    ASSERT_OK(executorHandle->scheduleTask([barrier]() mutable { barrier->countDownAndWait(); },
+                                           ServiceExecutor::kEmptyFlags));
+    barrier->countDownAndWait();
+}
+
+TEST_F(ServiceExecutorFixedFixture, WorkStealingFlattenRecursiveScheduledTasks) {
+    auto executorHandle = ServiceExecutorHandle(true);
+    executorHandle.start();
+
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    AtomicWord<int> tasksToSchedule{fixedServiceExecutorRecursionLimit.load() * 3};
+
+    // Tasks scheduled from an executor thread are queued on that thread's own run queue, and must
+    // still run non-recursively.
+    std::function<void()> recursiveTask;
+    recursiveTask = [&, barrier, executor = *executorHandle] {
+        ASSERT_EQ(executor->getRecursionDepthForExecutorThread(), 1);
+        if (tasksToSchedule.fetchAndSubtract(1) > 0) {
+            ASSERT_OK(executor->scheduleTask(recursiveTask, ServiceExecutor::kEmptyFlags));
+        } else {
+            barrier->countDownAndWait();
+        }
+    };
+
+    ASSERT_OK(executorHandle->scheduleTask(recursiveTask, ServiceExecutor::kEmptyFlags));
+    barrier->countDownAndWait();
+
+    BSONObjBuilder bob;
+    executorHandle->appendStats(&bob);
+    auto stats = bob.obj()["fixed"]["workStealing"];
+    ASSERT_EQ(stats.type(), BSONType::Object);
+    ASSERT_GT(stats["tasksRunLocally"].numberLong() + stats["tasksStolen"].numberLong(), 0);
+}
+
+TEST_F(ServiceExecutorFixedFixture, WorkStealingRunTaskAfterWaitingForData) {
+    auto tl = std::make_unique<TransportLayerMock>();
+    auto session = tl->createSession();
+
+    auto executorHandle = ServiceExecutorHandle(true);
+    executorHandle.start();
+
+    // Wait for data from an executor thread, so that the session is tied to that thread.
+    const auto mainThreadId = stdx::this_thread::get_id();
+    auto waiting = std::make_shared<unittest::Barrier>(2);
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    ASSERT_OK(executorHandle->scheduleTask(
+        [&, waiting, barrier, executor = *executorHandle] {
+            executor->runOnDataAvailable(session, [mainThreadId, barrier](Status status) {
+                ASSERT_OK(status);
+                ASSERT(stdx::this_thread::get_id() != mainThreadId);
+                barrier->countDownAndWait();
+            });
+            waiting->countDownAndWait();
+        },
+        ServiceExecutor::kEmptyFlags));
+
+    waiting->countDownAndWait();
+    reinterpret_cast<MockSession*>(session.get())->signalAvailableData();
+    barrier->countDownAndWait();
+}
+
 TEST_F(ServiceExecutorFixedFixture, StartAndShutdownAreDeterministic) {
     auto handle = ServiceExecutorHandle();
 
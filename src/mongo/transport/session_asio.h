@@ -38,6 +38,7 @@
 #include "mongo/transport/baton.h"
 #include "mongo/transport/ssl_connection_context.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -182,6 +183,10 @@ public:
 
     Status waitForData() override {
         ensureSync();
+        if (hasReadAheadData()) {
+            return Status::OK();
+        }
+
         asio::error_code ec;
         getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
         return errorCodeToStatus(ec);
@@ -189,6 +194,11 @@ public:
 
     Future<void> asyncWaitForData() override {
         ensureAsync();
+        if (hasReadAheadData()) {
+            // The socket may never become readable again if the next message is already buffered.
+            return Future<void>::makeReady();
+        }
+
         return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
     }
 
@@ -420,8 +430,12 @@ private:
         return _socket;
     }
 
+    static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
-        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+        if (canReadAhead()) {
+            return sourceMessageWithReadAhead(baton);
+        }
 
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
@@ -432,19 +446,8 @@ private:
                 }
 
                 const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
-                if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
-                    StringBuilder sb;
-                    sb << "recv(): message msgLen " << msgLen << " is invalid. "
-                       << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
-                    const auto str = sb.str();
-                    LOGV2(4615638,
-                          "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
-                          "recv(): message mstLen is invalid.",
-                          "msgLen"_attr = msgLen,
-                          "min"_attr = kHeaderSize,
-                          "max"_attr = MaxMessageSizeBytes);
-
-                    return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+                if (auto status = checkMessageLength(msgLen); !status.isOK()) {
+                    return Future<Message>::makeReady(std::move(status));
                 }
 
                 if (msgLen == kHeaderSize) {
@@ -469,6 +472,125 @@ private:
             });
     }
 
+    Status checkMessageLength(size_t msgLen) {
+        if (msgLen >= kHeaderSize && msgLen <= MaxMessageSizeBytes) {
+            return Status::OK();
+        }
+
+        StringBuilder sb;
+        sb << "recv(): message msgLen " << msgLen << " is invalid. "
+           << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+        const auto str = sb.str();
+        LOGV2(4615638,
+              "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+              "recv(): message mstLen is invalid.",
+              "msgLen"_attr = msgLen,
+              "min"_attr = kHeaderSize,
+              "max"_attr = MaxMessageSizeBytes);
+
+        return Status(ErrorCodes::ProtocolError, str);
+    }
+
+    /**
+     * Read-ahead is only used for plain-text ingress sessions, once the first message has ruled
+     * out a TLS handshake. TLS streams do their own buffering, and the handshake detection must
+     * not consume bytes past the first header.
+     */
+    bool canReadAhead() const {
+        if (!_isIngressSession || gIngressReadAheadBufferSizeBytes <= 0) {
+            return false;
+        }
+#ifdef MONGO_CONFIG_SSL
+        if (_sslSocket || !_ranHandshake) {
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    bool hasReadAheadData() const {
+        return _readAheadEnd > _readAheadBegin;
+    }
+
+    /**
+     * Sources a message by reading whatever the socket has available, up to the size of the
+     * read-ahead buffer, instead of reading the header and the body with separate calls. Small
+     * messages then cost a single recv(). Bytes past the end of the message, e.g., pipelined
+     * requests, are kept for the next call.
+     */
+    Future<Message> sourceMessageWithReadAhead(const BatonHandle& baton) {
+        const auto buffered = _readAheadEnd - _readAheadBegin;
+        if (buffered >= kHeaderSize) {
+            return consumeReadAhead(baton);
+        }
+
+        if (!_readAheadBuffer) {
+            _readAheadBuffer = SharedBuffer::allocate(
+                std::max<size_t>(gIngressReadAheadBufferSizeBytes, kHeaderSize));
+        } else if (_readAheadBegin > 0) {
+            // Move the partial header to the front so that the rest of the buffer is free.
+            memmove(_readAheadBuffer.get(), _readAheadBuffer.get() + _readAheadBegin, buffered);
+            _readAheadBegin = 0;
+            _readAheadEnd = buffered;
+        }
+
+        auto ptr = _readAheadBuffer.get() + _readAheadEnd;
+        auto space = _readAheadBuffer.capacity() - _readAheadEnd;
+        return opportunisticReadSome(
+                   _socket, asio::buffer(ptr, space), kHeaderSize - buffered, baton)
+            .then([this, baton](size_t size) {
+                _readAheadEnd += size;
+                return consumeReadAhead(baton);
+            });
+    }
+
+    Future<Message> consumeReadAhead(const BatonHandle& baton) {
+        const char* begin = _readAheadBuffer.get() + _readAheadBegin;
+        const auto buffered = _readAheadEnd - _readAheadBegin;
+        invariant(buffered >= kHeaderSize);
+
+        if (checkForHTTPRequest(asio::buffer(begin, kHeaderSize))) {
+            return sendHTTPResponse(baton);
+        }
+
+        const auto msgLen = size_t(MSGHEADER::ConstView(begin).getMessageLength());
+        if (auto status = checkMessageLength(msgLen); !status.isOK()) {
+            return Future<Message>::makeReady(std::move(status));
+        }
+
+        if (buffered >= msgLen) {
+            SharedBuffer buffer;
+            if (_readAheadBegin == 0 && buffered == msgLen) {
+                // The socket held exactly one message, so it can keep the read-ahead buffer.
+                buffer = std::exchange(_readAheadBuffer, {});
+                buffer.realloc(msgLen);
+            } else {
+                buffer = SharedBuffer::allocate(msgLen);
+                memcpy(buffer.get(), begin, msgLen);
+            }
+
+            _readAheadBegin += msgLen;
+            if (_readAheadBegin == _readAheadEnd) {
+                _readAheadBegin = _readAheadEnd = 0;
+            }
+
+            networkCounter.hitPhysicalIn(msgLen);
+            return Future<Message>::makeReady(Message(std::move(buffer)));
+        }
+
+        // Only part of the message has arrived. Read the rest of it straight into its buffer.
+        auto buffer = SharedBuffer::allocate(msgLen);
+        memcpy(buffer.get(), begin, buffered);
+        _readAheadBegin = _readAheadEnd = 0;
+
+        auto ptr = buffer.get() + buffered;
+        return read(asio::buffer(ptr, msgLen - buffered), baton)
+            .then([buffer = std::move(buffer), msgLen]() mutable {
+                networkCounter.hitPhysicalIn(msgLen);
+                return Message(std::move(buffer));
+            });
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancelation here.
@@ -581,6 +703,66 @@ private:
         }
     }
 
+    /**
+     * Like opportunisticRead(), but returns once at least "minBytes" bytes have been read rather
+     * than once "buffer" is full. Returns the number of bytes read.
+     */
+    template <typename Stream>
+    Future<size_t> opportunisticReadSome(Stream& stream,
+                                         asio::mutable_buffer buffer,
+                                         size_t minBytes,
+                                         const BatonHandle& baton = nullptr) {
+        std::error_code ec;
+        size_t size;
+
+        if (MONGO_unlikely(transportLayerASIOshortOpportunisticReadWrite.shouldFail()) &&
+            _blockingMode == Async) {
+            do {
+                size = asio::read(stream, asio::buffer(buffer.data(), 1), ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+            if (!ec && size < minBytes) {
+                ec = asio::error::would_block;
+            }
+        } else {
+            do {
+                size = asio::read(stream, buffer, asio::transfer_at_least(minBytes), ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+        }
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            // Some bytes may have been read already. Ask for the rest of "minBytes" and add what
+            // we have to the eventual count.
+            auto asyncBuffer = buffer + size;
+            auto asyncMinBytes = minBytes - size;
+            auto addBytesRead = [size](size_t moreBytes) { return size + moreBytes; };
+
+            if (auto networkingBaton = baton ? baton->networking() : nullptr;
+                networkingBaton && networkingBaton->canWait()) {
+                return networkingBaton->addSession(*this, NetworkingBaton::Type::In)
+                    .onError([](Status error) {
+                        if (ErrorCodes::isShutdownError(error)) {
+                            // See opportunisticRead().
+                            return Status::OK();
+                        }
+
+                        return error;
+                    })
+                    .then([&stream, asyncBuffer, asyncMinBytes, baton, this] {
+                        return opportunisticReadSome(stream, asyncBuffer, asyncMinBytes, baton);
+                    })
+                    .then(addBytesRead);
+            }
+
+            return asio::async_read(
+                       stream, asyncBuffer, asio::transfer_at_least(asyncMinBytes), UseFuture{})
+                .then(addBytesRead);
+        } else {
+            return futurize(ec, size);
+        }
+    }
+
     /**
      * moreToSend checks the ssl socket after an opportunisticWrite.  If there are still bytes to
      * send, we manually send them off the underlying socket.  Then we hook that up with a future
@@ -835,6 +1017,12 @@ private:
     std::shared_ptr<const SSLConnectionContext> _sslContext;
 #endif
 
+    // Bytes read from the socket past the end of the last sourced message. Only the range
+    // [_readAheadBegin, _readAheadEnd) holds data. See sourceMessageWithReadAhead().
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
@@ -36,9 +36,11 @@
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/transport/service_entry_point.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/net/sock.h"
+#include "mongo/util/scopeguard.h"
 
 #include "asio.hpp"
 
@@ -273,6 +275,13 @@ public:
     }
 
     void sendMessage() {
+        sendMessages(1);
+    }
+
+    /**
+     * Sends "count" messages back to back with a single write.
+     */
+    void sendMessages(int count) {
         OpMsgBuilder builder;
         builder.setBody(BSON("ping" << 1));
         Message msg = builder.finish();
@@ -280,8 +289,13 @@ public:
         msg.header().setId(0);
         OpMsg::appendChecksum(&msg);
 
+        std::string bytes;
+        for (int i = 0; i < count; ++i) {
+            bytes.append(msg.buf(), msg.size());
+        }
+
         std::error_code ec;
-        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
+        asio::write(_sock, asio::buffer(bytes), ec);
         ASSERT_FALSE(ec);
     }
 
@@ -382,5 +396,54 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that messages which arrive together are still sourced one at a time */
+class PipelinedMessagesSEP : public TimeoutSEP {
+public:
+    static constexpr int kNumPipelinedMessages = 3;
+
+    void startSession(transport::SessionHandle session) override {
+        LOGV2(5986200, "Accepted connection", "remote"_attr = session->remote());
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            auto sourcePing = [&] {
+                // Messages that were read ahead must not leave waitForData() blocked.
+                ASSERT_OK(session->waitForData());
+                auto swMessage = session->sourceMessage();
+                ASSERT_OK(swMessage.getStatus());
+                ASSERT_EQ(OpMsg::parse(swMessage.getValue()).body.firstElementFieldNameStringData(),
+                          "ping"_sd);
+            };
+
+            // The first message also decides whether the connection uses TLS.
+            sourcePing();
+            notifyComplete();
+
+            for (int i = 0; i < kNumPipelinedMessages; ++i) {
+                sourcePing();
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+};
+
+TEST(TransportLayerASIO, SourcePipelinedMessages) {
+    // Read-ahead is off by default.
+    const auto readAheadBufferSize = transport::gIngressReadAheadBufferSizeBytes;
+    transport::gIngressReadAheadBufferSizeBytes = 4096;
+    ON_BLOCK_EXIT([&] { transport::gIngressReadAheadBufferSizeBytes = readAheadBufferSize; });
+
+    PipelinedMessagesSEP sep;
+    auto tla = makeAndStartTL(&sep);
+
+    TimeoutConnector connector(tla->listenerPort(), true);
+    ASSERT_TRUE(sep.waitForTimeout());
+
+    connector.sendMessages(PipelinedMessagesSEP::kNumPipelinedMessages);
+    ASSERT_TRUE(sep.waitForTimeout());
+
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/adaptive_ticket_controller.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+AdaptiveTicketController::AdaptiveTicketController(Options options)
+    : _options(std::move(options)) {}
+
+void AdaptiveTicketController::setOptions(Options options) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _options = std::move(options);
+}
+
+int AdaptiveTicketController::update(const Sample& sample, int currentTickets) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    const auto clamp = [&](int tickets) {
+        return std::max(_options.minTickets, std::min(_options.maxTickets, tickets));
+    };
+
+    // Without a previous sample, or when less than a microsecond has passed since it was taken,
+    // there is no throughput to compare against yet.
+    const auto elapsed = _lastSample ? sample.now - _lastSample->now : Microseconds(0);
+    if (durationCount<Microseconds>(elapsed) <= 0) {
+        if (!_lastSample || sample.now < _lastSample->now) {
+            _lastSample = sample;
+            _lastTickets = currentTickets;
+        }
+        return clamp(currentTickets);
+    }
+
+    const auto finished = sample.finishedProcessing - _lastSample->finishedProcessing;
+    const auto dequeued = sample.removedFromQueue - _lastSample->removedFromQueue;
+    const auto timeQueued = sample.totalTimeQueued - _lastSample->totalTimeQueued;
+
+    const double lastThroughput = _throughput;
+    _throughput = finished * 1000000.0 / durationCount<Microseconds>(elapsed);
+    _averageQueueDelay = dequeued > 0 ? timeQueued / dequeued : Microseconds(0);
+    _cachePressure = sample.cachePressure;
+
+    const bool increasedLastTime = currentTickets > _lastTickets;
+    _lastSample = sample;
+    _lastTickets = currentTickets;
+
+    int tickets = currentTickets;
+    const auto decrease = [&] {
+        return std::min(currentTickets - 1,
+                        static_cast<int>(currentTickets * _options.multiplicativeDecrease));
+    };
+
+    if (_cachePressure >= _options.cachePressureThreshold) {
+        tickets = decrease();
+        _lastReason = "cachePressure"_sd;
+    } else if (increasedLastTime &&
+               _throughput < lastThroughput * (1 - _options.throughputDropTolerance)) {
+        tickets = decrease();
+        _lastReason = "throughputDrop"_sd;
+    } else if (_averageQueueDelay >= _options.queueDelayThreshold) {
+        tickets = currentTickets + _options.additiveIncrease;
+        _lastReason = "queueing"_sd;
+    } else {
+        _lastReason = "steady"_sd;
+    }
+
+    tickets = clamp(tickets);
+    if (tickets > currentTickets) {
+        _increases++;
+    } else if (tickets < currentTickets) {
+        _decreases++;
+    }
+    return tickets;
+}
+
+void AdaptiveTicketController::appendStats(BSONObjBuilder& b) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    b.append("lastDecisionReason", _lastReason);
+    b.append("increases", _increases);
+    b.append("decreases", _decreases);
+    b.append("throughputPerSec", _throughput);
+    b.append("averageQueueDelayMicros", durationCount<Microseconds>(_averageQueueDelay));
+    b.append("cachePressure", _cachePressure);
+    b.append("minTickets", _options.minTickets);
+    b.append("maxTickets", _options.maxTickets);
+}
+
+}  // namespace mongo
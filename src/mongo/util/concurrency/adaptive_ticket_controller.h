@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * Decides how many tickets a TicketHolder should hand out, following an additive-increase,
+ * multiplicative-decrease policy. It is fed periodic samples of the holder's cumulative
+ * throughput and queueing delay, and of how full the storage engine cache is:
+ *
+ *  - When the cache is under eviction pressure, admitting more operations only makes them
+ *    compete for the same pages, so the number of tickets is cut multiplicatively.
+ *  - When the last increase made throughput drop, the extra concurrency is thrashing and the
+ *    number of tickets is cut as well.
+ *  - When operations spend a significant time queued for a ticket, tickets are added one step
+ *    at a time.
+ *
+ * The result is always kept within [minTickets, maxTickets]. Thread-safe.
+ */
+class AdaptiveTicketController {
+    AdaptiveTicketController(const AdaptiveTicketController&) = delete;
+    AdaptiveTicketController& operator=(const AdaptiveTicketController&) = delete;
+
+public:
+    struct Options {
+        int minTickets = 8;
+        int maxTickets = 512;
+
+        // Number of tickets added when operations are queueing.
+        int additiveIncrease = 4;
+
+        // Factor applied to the number of tickets when backing off.
+        double multiplicativeDecrease = 0.75;
+
+        // Fraction of the cache in use above which the number of tickets is reduced.
+        double cachePressureThreshold = 0.95;
+
+        // Average time spent queued for a ticket above which the number of tickets is increased.
+        Microseconds queueDelayThreshold = Milliseconds(1);
+
+        // Relative drop in throughput after an increase which is considered thrashing.
+        double throughputDropTolerance = 0.1;
+    };
+
+    /**
+     * Cumulative counters read from the ticket holder and the storage engine at a point in time.
+     */
+    struct Sample {
+        // When the sample was taken, in microseconds since an arbitrary epoch.
+        Microseconds now{0};
+
+        // Number of operations which released their ticket.
+        long long finishedProcessing = 0;
+
+        // Number of operations which were granted a ticket after queueing, and the total time
+        // they spent in the queue.
+        long long removedFromQueue = 0;
+        Microseconds totalTimeQueued{0};
+
+        // Fraction of the storage engine cache in use, between 0 and 1.
+        double cachePressure = 0;
+    };
+
+    explicit AdaptiveTicketController(Options options);
+
+    void setOptions(Options options);
+
+    /**
+     * Consumes the next sample and returns the number of tickets to use until the next one.
+     * 'currentTickets' is the number of tickets in effect since the previous sample.
+     */
+    int update(const Sample& sample, int currentTickets);
+
+    /**
+     * Reports the last decision and the measurements it was based on.
+     */
+    void appendStats(BSONObjBuilder& b) const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AdaptiveTicketController::_mutex");
+
+    Options _options;
+
+    boost::optional<Sample> _lastSample;
+    int _lastTickets = 0;
+
+    // Measurements taken over the last interval.
+    double _throughput = 0;
+    Microseconds _averageQueueDelay{0};
+    double _cachePressure = 0;
+
+    StringData _lastReason = "none"_sd;
+    long long _increases = 0;
+    long long _decreases = 0;
+};
+
+}  // namespace mongo
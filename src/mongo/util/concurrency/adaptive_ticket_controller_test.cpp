@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/adaptive_ticket_controller.h"
+
+namespace mongo {
+namespace {
+
+class AdaptiveTicketControllerTest : public unittest::Test {
+protected:
+    AdaptiveTicketController::Sample nextSample(long long finished,
+                                                long long queued,
+                                                Microseconds timeQueued,
+                                                double cachePressure = 0) {
+        _now += Seconds(1);
+        _finished += finished;
+        _queued += queued;
+        _timeQueued += timeQueued;
+
+        AdaptiveTicketController::Sample sample;
+        sample.now = _now;
+        sample.finishedProcessing = _finished;
+        sample.removedFromQueue = _queued;
+        sample.totalTimeQueued = _timeQueued;
+        sample.cachePressure = cachePressure;
+        return sample;
+    }
+
+    AdaptiveTicketController::Options options() {
+        AdaptiveTicketController::Options options;
+        options.minTickets = 4;
+        options.maxTickets = 32;
+        options.additiveIncrease = 2;
+        options.multiplicativeDecrease = 0.5;
+        return options;
+    }
+
+private:
+    Microseconds _now = Seconds(100);
+    long long _finished = 0;
+    long long _queued = 0;
+    Microseconds _timeQueued{0};
+};
+
+TEST_F(AdaptiveTicketControllerTest, FirstSampleOnlyClamps) {
+    AdaptiveTicketController controller(options());
+    ASSERT_EQ(controller.update(nextSample(100, 100, Seconds(1)), 16), 16);
+
+    AdaptiveTicketController other(options());
+    ASSERT_EQ(other.update(nextSample(0, 0, Microseconds(0)), 128), 32);
+}
+
+TEST_F(AdaptiveTicketControllerTest, IncreasesWhileQueueing) {
+    AdaptiveTicketController controller(options());
+    controller.update(nextSample(0, 0, Microseconds(0)), 8);
+
+    // 100 operations waited 10ms each on average.
+    ASSERT_EQ(controller.update(nextSample(1000, 100, Seconds(1)), 8), 10);
+    ASSERT_EQ(controller.update(nextSample(1200, 100, Seconds(1)), 10), 12);
+}
+
+TEST_F(AdaptiveTicketControllerTest, HoldsWithoutQueueing) {
+    AdaptiveTicketController controller(options());
+    controller.update(nextSample(0, 0, Microseconds(0)), 8);
+    ASSERT_EQ(controller.update(nextSample(1000, 0, Microseconds(0)), 8), 8);
+    ASSERT_EQ(controller.update(nextSample(1000, 10, Microseconds(10)), 8), 8);
+}
+
+TEST_F(AdaptiveTicketControllerTest, BacksOffOnCachePressure) {
+    AdaptiveTicketController controller(options());
+    controller.update(nextSample(0, 0, Microseconds(0)), 16);
+    ASSERT_EQ(controller.update(nextSample(1000, 100, Seconds(1), 0.97), 16), 8);
+    ASSERT_EQ(controller.update(nextSample(1000, 100, Seconds(1), 0.97), 8), 4);
+    ASSERT_EQ(controller.update(nextSample(1000, 100, Seconds(1), 0.97), 4), 4);
+}
+
+TEST_F(AdaptiveTicketControllerTest, BacksOffWhenIncreaseReducesThroughput) {
+    AdaptiveTicketController controller(options());
+    controller.update(nextSample(0, 0, Microseconds(0)), 8);
+    ASSERT_EQ(controller.update(nextSample(1000, 100, Seconds(1)), 8), 10);
+
+    // Throughput dropped by half after adding tickets.
+    ASSERT_EQ(controller.update(nextSample(500, 100, Seconds(1)), 10), 5);
+}
+
+TEST_F(AdaptiveTicketControllerTest, SkipsSamplesTakenTooCloseTogether) {
+    AdaptiveTicketController controller(options());
+    auto sample = nextSample(0, 0, Microseconds(0));
+    controller.update(sample, 8);
+
+    // A second sample within the same microsecond has no measurable throughput.
+    sample.finishedProcessing += 100;
+    sample.removedFromQueue += 100;
+    sample.totalTimeQueued += Seconds(1);
+    ASSERT_EQ(controller.update(sample, 8), 8);
+
+    // The next sample is still compared against the first one.
+    sample.now += Microseconds(500);
+    ASSERT_EQ(controller.update(sample, 8), 10);
+}
+
+TEST_F(AdaptiveTicketControllerTest, AppendStats) {
+    AdaptiveTicketController controller(options());
+    controller.update(nextSample(0, 0, Microseconds(0)), 8);
+    controller.update(nextSample(1000, 100, Seconds(1)), 8);
+
+    BSONObjBuilder bob;
+    controller.appendStats(bob);
+    auto stats = bob.obj();
+    ASSERT_EQ(stats["lastDecisionReason"].str(), "queueing");
+    ASSERT_EQ(stats["increases"].numberLong(), 1);
+    ASSERT_EQ(stats["decreases"].numberLong(), 0);
+    ASSERT_EQ(stats["throughputPerSec"].numberDouble(), 1000);
+    ASSERT_EQ(stats["averageQueueDelayMicros"].numberLong(), 10000);
+}
+
+}  // namespace
+}  // namespace mongo
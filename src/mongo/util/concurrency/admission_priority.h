@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * Priority lane in which an operation waits for a ticket. Queueing TicketHolders serve the lanes
+ * with weighted round-robin, so that higher priority operations get most of the tickets released
+ * under contention while lower priority ones still make progress.
+ */
+enum class AdmissionPriority {
+    // Background work which can tolerate delays, such as TTL deletions and range deletion.
+    kLow = 0,
+    kNormal,
+    // Work the node's availability depends on, such as secondary oplog application and the
+    // writes of a stepping up primary.
+    kHigh,
+};
+
+constexpr int kNumAdmissionPriorities = static_cast<int>(AdmissionPriority::kHigh) + 1;
+
+inline StringData toString(AdmissionPriority priority) {
+    switch (priority) {
+        case AdmissionPriority::kLow:
+            return "low"_sd;
+        case AdmissionPriority::kNormal:
+            return "normal"_sd;
+        case AdmissionPriority::kHigh:
+            return "high"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace mongo
@@ -33,13 +33,21 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
+void TicketHolder::appendStats(BSONObjBuilder& b) const {
+    b.append("out", used());
+    b.append("available", available());
+    b.append("totalTickets", outof());
+}
+
 #if defined(__linux__)
 namespace {
 
@@ -71,15 +79,15 @@ void tsFromDate(const Date_t& deadline, struct timespec& ts) {
 }
 }  // namespace
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
+SemaphoreTicketHolder::SemaphoreTicketHolder(int num) : _outof(num) {
     check(sem_init(&_sem, 0, num));
 }
 
-TicketHolder::~TicketHolder() {
+SemaphoreTicketHolder::~SemaphoreTicketHolder() {
     check(sem_destroy(&_sem));
 }
 
-bool TicketHolder::tryAcquire() {
+bool SemaphoreTicketHolder::tryAcquire() {
     while (0 != sem_trywait(&_sem)) {
         if (errno == EAGAIN)
             return false;
@@ -89,11 +97,11 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
+void SemaphoreTicketHolder::waitForTicket(OperationContext* opCtx) {
     waitForTicketUntil(opCtx, Date_t::max());
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool SemaphoreTicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
     if (sem_trywait(&_sem) == 0) {
         return true;
@@ -129,11 +137,11 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     return true;
 }
 
-void TicketHolder::release() {
+void SemaphoreTicketHolder::release() {
     check(sem_post(&_sem));
 }
 
-Status TicketHolder::resize(int newSize) {
+Status SemaphoreTicketHolder::resize(int newSize) {
     stdx::lock_guard<Latch> lk(_resizeMutex);
 
     if (newSize < 5)
@@ -159,32 +167,32 @@ Status TicketHolder::resize(int newSize) {
     return Status::OK();
 }
 
-int TicketHolder::available() const {
+int SemaphoreTicketHolder::available() const {
     int val = 0;
     check(sem_getvalue(&_sem, &val));
     return val;
 }
 
-int TicketHolder::used() const {
+int SemaphoreTicketHolder::used() const {
     return outof() - available();
 }
 
-int TicketHolder::outof() const {
+int SemaphoreTicketHolder::outof() const {
     return _outof.load();
 }
 
 #else
 
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
+SemaphoreTicketHolder::SemaphoreTicketHolder(int num) : _outof(num), _num(num) {}
 
-TicketHolder::~TicketHolder() = default;
+SemaphoreTicketHolder::~SemaphoreTicketHolder() = default;
 
-bool TicketHolder::tryAcquire() {
+bool SemaphoreTicketHolder::tryAcquire() {
     stdx::lock_guard<Latch> lk(_mutex);
     return _tryAcquire();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
+void SemaphoreTicketHolder::waitForTicket(OperationContext* opCtx) {
     stdx::unique_lock<Latch> lk(_mutex);
 
     if (opCtx) {
@@ -194,7 +202,7 @@ void TicketHolder::waitForTicket(OperationContext* opCtx) {
     }
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+bool SemaphoreTicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     stdx::unique_lock<Latch> lk(_mutex);
 
     if (opCtx) {
@@ -206,7 +214,7 @@ bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
     }
 }
 
-void TicketHolder::release() {
+void SemaphoreTicketHolder::release() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _num++;
@@ -214,7 +222,7 @@ void TicketHolder::release() {
     _newTicket.notify_one();
 }
 
-Status TicketHolder::resize(int newSize) {
+Status SemaphoreTicketHolder::resize(int newSize) {
     stdx::lock_guard<Latch> lk(_mutex);
 
     int used = _outof.load() - _num;
@@ -236,19 +244,19 @@ Status TicketHolder::resize(int newSize) {
     return Status::OK();
 }
 
-int TicketHolder::available() const {
+int SemaphoreTicketHolder::available() const {
     return _num;
 }
 
-int TicketHolder::used() const {
+int SemaphoreTicketHolder::used() const {
     return outof() - _num;
 }
 
-int TicketHolder::outof() const {
+int SemaphoreTicketHolder::outof() const {
     return _outof.load();
 }
 
-bool TicketHolder::_tryAcquire() {
+bool SemaphoreTicketHolder::_tryAcquire() {
     if (_num <= 0) {
         if (_num < 0) {
             std::cerr << "DISASTER! in TicketHolder" << std::endl;
@@ -259,4 +267,209 @@ bool TicketHolder::_tryAcquire() {
     return true;
 }
 #endif
+
+namespace {
+
+// Relative share of the released tickets each priority lane gets when all lanes have waiters.
+constexpr std::array<int, kNumAdmissionPriorities> kLaneWeights = {1, 4, 16};
+
+}  // namespace
+
+FifoTicketHolder::FifoTicketHolder(int num) : _outof(num), _credits(kLaneWeights) {}
+
+FifoTicketHolder::~FifoTicketHolder() {
+    invariant(_queuesEmpty(WithLock::withoutLock()));
+}
+
+bool FifoTicketHolder::tryAcquire() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Do not let operations skip ahead of those already waiting in the queue.
+    if (!_queuesEmpty(lk) || _used >= _outof) {
+        return false;
+    }
+    _used++;
+    _startedProcessing++;
+    return true;
+}
+
+void FifoTicketHolder::waitForTicket(OperationContext* opCtx) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max()));
+}
+
+bool FifoTicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
+    return waitForTicketUntil(opCtx, AdmissionPriority::kNormal, until);
+}
+
+bool FifoTicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                          AdmissionPriority priority,
+                                          Date_t until) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    if (_queuesEmpty(lk) && _used < _outof) {
+        _used++;
+        _startedProcessing++;
+        return true;
+    }
+
+    WaitingElement element;
+    auto& queue = _queues[static_cast<int>(priority)];
+    auto it = queue.insert(queue.end(), &element);
+    _addedToQueue++;
+    const auto queuedAt = Date_t::now();
+
+    // If the wait is interrupted after a ticket was already granted, pass it on to the next waiter
+    // before rethrowing. Otherwise just leave the queue.
+    auto cancelWait = makeGuard([&] {
+        _canceled++;
+        if (element.granted) {
+            _used--;
+            _startedProcessing--;
+            _dequeueWaiters(lk);
+        } else {
+            queue.erase(it);
+        }
+    });
+
+    const auto granted = [&] { return element.granted; };
+    bool acquired;
+    if (opCtx) {
+        acquired = opCtx->waitForConditionOrInterruptUntil(element.signaler, lk, until, granted);
+    } else if (until == Date_t::max()) {
+        element.signaler.wait(lk, granted);
+        acquired = true;
+    } else {
+        acquired = element.signaler.wait_until(lk, until.toSystemTimePoint(), granted);
+    }
+
+    if (!acquired) {
+        return false;
+    }
+
+    cancelWait.dismiss();
+    _removedFromQueue++;
+    _totalTimeQueued += Date_t::now() - queuedAt;
+    return true;
+}
+
+void FifoTicketHolder::release() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    invariant(_used > 0);
+    _used--;
+    _finishedProcessing++;
+    _dequeueWaiters(lk);
+}
+
+Status FifoTicketHolder::resize(int newSize) {
+    if (newSize <= 0) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Number of tickets must be positive; given " << newSize);
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _outof = newSize;
+    _dequeueWaiters(lk);
+    return Status::OK();
+}
+
+int FifoTicketHolder::available() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return std::max(_outof - _used, 0);
+}
+
+int FifoTicketHolder::used() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _used;
+}
+
+int FifoTicketHolder::outof() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _outof;
+}
+
+void FifoTicketHolder::appendStats(BSONObjBuilder& b) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    b.append("out", _used);
+    b.append("available", std::max(_outof - _used, 0));
+    b.append("totalTickets", _outof);
+    b.append("queueLength", _queueLength(lk));
+    {
+        BSONObjBuilder lanes(b.subobjStart("queueLengthByPriority"));
+        for (int lane = 0; lane < kNumAdmissionPriorities; lane++) {
+            lanes.append(toString(static_cast<AdmissionPriority>(lane)),
+                         static_cast<int>(_queues[lane].size()));
+        }
+    }
+    b.append("addedToQueue", _addedToQueue);
+    b.append("removedFromQueue", _removedFromQueue);
+    b.append("canceled", _canceled);
+    b.append("startedProcessing", _startedProcessing);
+    b.append("finishedProcessing", _finishedProcessing);
+    b.append("totalTimeQueuedMicros", durationCount<Microseconds>(_totalTimeQueued));
+}
+
+long long FifoTicketHolder::finishedProcessing() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _finishedProcessing;
+}
+
+long long FifoTicketHolder::removedFromQueue() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _removedFromQueue;
+}
+
+Microseconds FifoTicketHolder::totalTimeQueued() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _totalTimeQueued;
+}
+
+int FifoTicketHolder::queueLength() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _queueLength(lk);
+}
+
+void FifoTicketHolder::_dequeueWaiters(WithLock lk) {
+    while (_used < _outof) {
+        auto queue = _nextQueue(lk);
+        if (!queue) {
+            return;
+        }
+        auto element = queue->front();
+        queue->pop_front();
+        element->granted = true;
+        _used++;
+        _startedProcessing++;
+        element->signaler.notify_one();
+    }
+}
+
+FifoTicketHolder::Queue* FifoTicketHolder::_nextQueue(WithLock lk) {
+    if (_queuesEmpty(lk)) {
+        return nullptr;
+    }
+
+    while (true) {
+        for (int lane = kNumAdmissionPriorities - 1; lane >= 0; lane--) {
+            if (!_queues[lane].empty() && _credits[lane] > 0) {
+                _credits[lane]--;
+                return &_queues[lane];
+            }
+        }
+
+        // Every lane with waiters used up its share of this round, start a new one.
+        _credits = kLaneWeights;
+    }
+}
+
+bool FifoTicketHolder::_queuesEmpty(WithLock) const {
+    return std::all_of(
+        _queues.begin(), _queues.end(), [](const Queue& queue) { return queue.empty(); });
+}
+
+int FifoTicketHolder::_queueLength(WithLock) const {
+    int length = 0;
+    for (const auto& queue : _queues) {
+        length += queue.size();
+    }
+    return length;
+}
+
 }  // namespace mongo
@@ -28,35 +28,45 @@
  */
 #pragma once
 
+#include <array>
+#include <list>
+
 #if defined(__linux__)
 #include <semaphore.h>
 #endif
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+/**
+ * Limits the number of concurrently running operations to a configurable number of tickets.
+ * Operations acquire a ticket before running and release it when done.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
 
 public:
-    explicit TicketHolder(int num);
-    ~TicketHolder();
+    TicketHolder() = default;
+    virtual ~TicketHolder() = default;
 
-    bool tryAcquire();
+    virtual bool tryAcquire() = 0;
 
     /**
      * Attempts to acquire a ticket. Blocks until a ticket is acquired or the OperationContext
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    virtual void waitForTicket(OperationContext* opCtx) = 0;
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,19 +78,64 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    virtual bool waitForTicketUntil(OperationContext* opCtx, Date_t until) = 0;
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
-    void release();
 
-    Status resize(int newSize);
+    /**
+     * Same as above, but waits in the lane of the given 'priority' rather than in the normal one.
+     * The Locker passes the priority of the operation here, which also applies when the wait is
+     * not interruptible. Only implementations which queue waiters take the priority into account.
+     */
+    virtual bool waitForTicketUntil(OperationContext* opCtx,
+                                    AdmissionPriority priority,
+                                    Date_t until) {
+        return waitForTicketUntil(opCtx, until);
+    }
+
+    virtual void release() = 0;
+
+    virtual Status resize(int newSize) = 0;
+
+    virtual int available() const = 0;
+
+    virtual int used() const = 0;
+
+    virtual int outof() const = 0;
+
+    /**
+     * Appends the ticket usage statistics reported in serverStatus.
+     */
+    virtual void appendStats(BSONObjBuilder& b) const;
+};
+
+/**
+ * A TicketHolder backed by a counting semaphore. Waiters are woken up in no particular order.
+ */
+class SemaphoreTicketHolder final : public TicketHolder {
+public:
+    explicit SemaphoreTicketHolder(int num);
+    ~SemaphoreTicketHolder() override;
+
+    using TicketHolder::waitForTicket;
+    using TicketHolder::waitForTicketUntil;
+
+    bool tryAcquire() override;
+
+    void waitForTicket(OperationContext* opCtx) override;
 
-    int available() const;
+    bool waitForTicketUntil(OperationContext* opCtx, Date_t until) override;
 
-    int used() const;
+    void release() override;
 
-    int outof() const;
+    Status resize(int newSize) override;
+
+    int available() const override;
+
+    int used() const override;
+
+    int outof() const override;
 
 private:
 #if defined(__linux__)
@@ -89,17 +144,122 @@ private:
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SemaphoreTicketHolder::_resizeMutex");
 #else
     bool _tryAcquire();
 
     AtomicWord<int> _outof;
     int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
+    Mutex _mutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SemaphoreTicketHolder::_mutex");
     stdx::condition_variable _newTicket;
 #endif
 };
 
+/**
+ * A TicketHolder which queues waiters in one lane per AdmissionPriority, taken from the waiting
+ * operation. Within a lane, tickets are granted in the order in which operations started waiting.
+ * Across lanes, released tickets are handed out by weighted round-robin, so that no lane starves.
+ * When all operations share the same priority, this is a plain FIFO queue.
+ *
+ * Keeps track of how long operations were queued. Resizing never blocks: shrinking below the
+ * number of tickets in use only stops new tickets from being handed out until enough have been
+ * released.
+ */
+class FifoTicketHolder final : public TicketHolder {
+public:
+    explicit FifoTicketHolder(int num);
+    ~FifoTicketHolder() override;
+
+    using TicketHolder::waitForTicket;
+    using TicketHolder::waitForTicketUntil;
+
+    bool tryAcquire() override;
+
+    void waitForTicket(OperationContext* opCtx) override;
+
+    bool waitForTicketUntil(OperationContext* opCtx, Date_t until) override;
+
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            AdmissionPriority priority,
+                            Date_t until) override;
+
+    void release() override;
+
+    Status resize(int newSize) override;
+
+    int available() const override;
+
+    int used() const override;
+
+    int outof() const override;
+
+    /**
+     * Appends the queueing statistics in addition to the ticket usage.
+     */
+    void appendStats(BSONObjBuilder& b) const override;
+
+    /**
+     * Returns the number of times a ticket was released, i.e. the number of operations which
+     * finished running.
+     */
+    long long finishedProcessing() const;
+
+    /**
+     * Returns the number of operations which waited in the queue and were granted a ticket, and
+     * the cumulative time they spent waiting.
+     */
+    long long removedFromQueue() const;
+    Microseconds totalTimeQueued() const;
+
+    /**
+     * Returns the number of operations currently waiting for a ticket.
+     */
+    int queueLength() const;
+
+private:
+    struct WaitingElement {
+        stdx::condition_variable signaler;
+        bool granted = false;
+    };
+
+    using Queue = std::list<WaitingElement*>;
+
+    /**
+     * Hands out available tickets to the waiters at the front of the queues.
+     */
+    void _dequeueWaiters(WithLock);
+
+    /**
+     * Returns the next lane to grant a ticket to, or nullptr if no operation is waiting.
+     */
+    Queue* _nextQueue(WithLock);
+
+    bool _queuesEmpty(WithLock) const;
+    int _queueLength(WithLock) const;
+
+    mutable Mutex _mutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "FifoTicketHolder::_mutex");
+
+    // One queue per AdmissionPriority. Waiters are enqueued at the back and are granted tickets
+    // from the front. Elements are owned by the waiting threads and only referenced here while
+    // they wait.
+    std::array<Queue, kNumAdmissionPriorities> _queues;
+
+    // Number of tickets each lane may still be granted in the current round-robin round.
+    std::array<int, kNumAdmissionPriorities> _credits{};
+
+    int _outof;
+    int _used = 0;
+
+    long long _addedToQueue = 0;
+    long long _removedFromQueue = 0;
+    long long _canceled = 0;
+    long long _startedProcessing = 0;
+    long long _finishedProcessing = 0;
+    Microseconds _totalTimeQueued{0};
+};
+
 class ScopedTicket {
 public:
     ScopedTicket(TicketHolder* holder) : _holder(holder) {
@@ -32,14 +32,18 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
 namespace {
 using namespace mongo;
 
-TEST(TicketholderTest, BasicTimeout) {
-    TicketHolder holder(1);
+template <class H>
+void basicTimeout() {
+    H holder(1);
     ASSERT_EQ(holder.used(), 0);
     ASSERT_EQ(holder.available(), 1);
     ASSERT_EQ(holder.outof(), 1);
@@ -72,4 +76,160 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, BasicTimeout) {
+    basicTimeout<SemaphoreTicketHolder>();
+}
+
+TEST(TicketholderTest, FifoBasicTimeout) {
+    basicTimeout<FifoTicketHolder>();
+}
+
+TEST(TicketholderTest, FifoGrantsInArrivalOrder) {
+    FifoTicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    Mutex mutex = MONGO_MAKE_LATCH("FifoGrantsInArrivalOrder::mutex");
+    std::vector<int> order;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 3; i++) {
+        threads.emplace_back([&, i] {
+            holder.waitForTicket();
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                order.push_back(i);
+            }
+            holder.release();
+        });
+
+        // Wait for the thread to be queued before starting the next one.
+        while (holder.queueLength() != i + 1) {
+            sleepmillis(1);
+        }
+    }
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT(order == std::vector<int>({0, 1, 2}));
+    ASSERT_EQ(holder.used(), 0);
+    ASSERT_EQ(holder.removedFromQueue(), 3);
+    ASSERT_EQ(holder.finishedProcessing(), 4);
+}
+
+/**
+ * Starts a thread per priority in 'priorities', in order, each of which waits for a ticket from
+ * 'holder' and records its index once granted. Releases the ticket held by the caller once all
+ * threads are queued and returns the order in which they were granted tickets.
+ */
+std::vector<int> grantOrder(FifoTicketHolder& holder,
+                            const std::vector<AdmissionPriority>& priorities) {
+    Mutex mutex = MONGO_MAKE_LATCH("grantOrder::mutex");
+    std::vector<int> order;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < priorities.size(); i++) {
+        threads.emplace_back([&, i] {
+            ASSERT(holder.waitForTicketUntil(nullptr, priorities[i], Date_t::max()));
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                order.push_back(i);
+            }
+            holder.release();
+        });
+
+        while (holder.queueLength() != static_cast<int>(i + 1)) {
+            sleepmillis(1);
+        }
+    }
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return order;
+}
+
+TEST(TicketholderTest, FifoServesHigherPriorityFirst) {
+    FifoTicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto order = grantOrder(holder,
+                            {AdmissionPriority::kLow,
+                             AdmissionPriority::kNormal,
+                             AdmissionPriority::kLow,
+                             AdmissionPriority::kHigh});
+    ASSERT(order == std::vector<int>({3, 1, 0, 2}));
+}
+
+TEST(TicketholderTest, FifoDoesNotStarveLowPriority) {
+    FifoTicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    std::vector<AdmissionPriority> priorities{AdmissionPriority::kLow};
+    priorities.insert(priorities.end(), 20, AdmissionPriority::kHigh);
+    auto order = grantOrder(holder, priorities);
+
+    // The low priority waiter gets its share of tickets before all high priority ones are served.
+    auto lowPosition = std::find(order.begin(), order.end(), 0) - order.begin();
+    ASSERT_LT(lowPosition, 20);
+}
+
+TEST(TicketholderTest, FifoResizeGrantsQueuedWaiters) {
+    FifoTicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    stdx::thread waiter([&] {
+        holder.waitForTicket();
+        holder.release();
+    });
+    while (holder.queueLength() != 1) {
+        sleepmillis(1);
+    }
+
+    // Making room for one more ticket hands it to the queued waiter.
+    ASSERT_OK(holder.resize(2));
+    waiter.join();
+    ASSERT(holder.tryAcquire());
+    ASSERT_EQ(holder.used(), 2);
+    holder.release();
+    holder.release();
+}
+
+TEST(TicketholderTest, FifoResizeDoesNotBlock) {
+    FifoTicketHolder holder(3);
+    ASSERT(holder.tryAcquire());
+    ASSERT(holder.tryAcquire());
+
+    // Shrinking below the number of tickets in use takes effect as tickets are released.
+    ASSERT_OK(holder.resize(1));
+    ASSERT_EQ(holder.outof(), 1);
+    ASSERT_EQ(holder.available(), 0);
+    ASSERT_FALSE(holder.tryAcquire());
+
+    holder.release();
+    ASSERT_FALSE(holder.tryAcquire());
+    holder.release();
+    ASSERT(holder.tryAcquire());
+    holder.release();
+
+    ASSERT_NOT_OK(holder.resize(0));
+}
+
+TEST(TicketholderTest, FifoAppendStats) {
+    FifoTicketHolder holder(2);
+    ASSERT(holder.tryAcquire());
+
+    BSONObjBuilder bob;
+    holder.appendStats(bob);
+    auto stats = bob.obj();
+    ASSERT_EQ(stats["out"].numberInt(), 1);
+    ASSERT_EQ(stats["available"].numberInt(), 1);
+    ASSERT_EQ(stats["totalTickets"].numberInt(), 2);
+    ASSERT_EQ(stats["queueLength"].numberInt(), 0);
+    ASSERT_EQ(stats["startedProcessing"].numberLong(), 1);
+    ASSERT_EQ(stats["finishedProcessing"].numberLong(), 0);
+    holder.release();
+}
 }  // namespace
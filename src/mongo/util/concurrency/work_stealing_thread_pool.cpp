@@ -0,0 +1,339 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+
+#include <fmt/format.h>
+
+#include "mongo/base/status.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_name.h"
+
+namespace mongo {
+
+namespace {
+
+using namespace fmt::literals;
+
+// Counter used to assign unique names to otherwise-unnamed thread pools.
+AtomicWord<int> nextUnnamedWorkStealingThreadPoolId{1};
+
+// A worker looks at the other queues before its own after this many consecutive local tasks.
+constexpr size_t kLocalTasksBetweenSteals = 61;
+
+// Identifies the pool and worker that the current thread runs for, if any.
+thread_local const WorkStealingThreadPool* currentPool = nullptr;
+thread_local size_t currentWorkerId = 0;
+
+WorkStealingThreadPool::Options cleanUpOptions(WorkStealingThreadPool::Options&& options) {
+    if (options.poolName.empty()) {
+        options.poolName =
+            "WorkStealingThreadPool{}"_format(nextUnnamedWorkStealingThreadPoolId.fetchAndAdd(1));
+    }
+    if (options.threadNamePrefix.empty()) {
+        options.threadNamePrefix = "{}-"_format(options.poolName);
+    }
+    if (options.maxThreads < 1) {
+        LOGV2_FATAL(5986100,
+                    "Cannot create pool with maximum number of threads less than 1",
+                    "poolName"_attr = options.poolName,
+                    "maxThreads"_attr = options.maxThreads);
+    }
+    if (options.minThreads > options.maxThreads) {
+        LOGV2_FATAL(5986101,
+                    "Cannot create pool with minimum number of threads larger than the "
+                    "configured maximum",
+                    "poolName"_attr = options.poolName,
+                    "minThreads"_attr = options.minThreads,
+                    "maxThreads"_attr = options.maxThreads);
+    }
+    return {std::move(options)};
+}
+
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(Options options)
+    : _options(cleanUpOptions(std::move(options))),
+      _workers(std::make_unique<Worker[]>(_options.maxThreads)) {}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    shutdown();
+
+    bool needsJoin;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        needsJoin = _state == State::kJoinRequired;
+    }
+    if (needsJoin) {
+        join();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_state != State::kShutdownComplete) {
+        LOGV2_FATAL(5986102,
+                    "Failed to shutdown pool during destruction",
+                    "poolName"_attr = _options.poolName);
+    }
+    invariant(_numPendingTasks.load() == 0);
+}
+
+void WorkStealingThreadPool::startup() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_state != State::kPreStart) {
+        LOGV2_FATAL(5986103,
+                    "Attempted to start pool that has already started",
+                    "poolName"_attr = _options.poolName);
+    }
+    _setState(lk, State::kRunning);
+
+    const auto numToStart = std::max<size_t>(_options.minThreads, 1);
+    for (size_t i = 0; i < numToStart; ++i) {
+        _startWorker(lk);
+    }
+}
+
+void WorkStealingThreadPool::shutdown() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _acceptingTasks.store(false);
+    if (_state == State::kPreStart || _state == State::kRunning) {
+        _setState(lk, State::kJoinRequired);
+    }
+    _workAvailable.notify_all();
+}
+
+void WorkStealingThreadPool::join() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _stateChange.wait(lk, [&] { return _state != State::kPreStart && _state != State::kRunning; });
+    if (_state != State::kJoinRequired) {
+        LOGV2_FATAL(5986104,
+                    "Attempted to join pool more than once",
+                    "poolName"_attr = _options.poolName);
+    }
+    _setState(lk, State::kJoining);
+
+    // Tasks that were scheduled before startup() still have to run, and they cannot run inline
+    // because they may create an OperationContext and the caller may already have one.
+    if (_numWorkers.load() == 0 && _numPendingTasks.load() > 0) {
+        _startWorker(lk);
+    }
+    _workAvailable.notify_all();
+
+    const auto numWorkers = _numWorkers.load();
+    lk.unlock();
+    for (size_t i = 0; i < numWorkers; ++i) {
+        _workers[i].thread.join();
+    }
+    lk.lock();
+
+    invariant(_numPendingTasks.load() == 0);
+    _setState(lk, State::kShutdownComplete);
+}
+
+void WorkStealingThreadPool::schedule(Task task) {
+    scheduleOnWorker(std::move(task), boost::none);
+}
+
+void WorkStealingThreadPool::scheduleOnWorker(Task task, boost::optional<size_t> workerId) {
+    // Count the task before checking for shutdown so that a worker cannot exit between our check
+    // and the push below. Workers only exit once there are no pending tasks.
+    const auto numPending = _numPendingTasks.addAndFetch(1);
+    if (!_acceptingTasks.load()) {
+        _numPendingTasks.subtractAndFetch(1);
+        task(Status(ErrorCodes::ShutdownInProgress,
+                    "Shutdown of thread pool {} in progress"_format(_options.poolName)));
+        return;
+    }
+
+    // Tasks scheduled before startup() are placed on the first worker, which is always started.
+    const auto numWorkers = std::max<size_t>(_numWorkers.load(), 1);
+    const auto target = (workerId && *workerId < numWorkers)
+        ? *workerId
+        : _nextWorker.fetchAndAdd(1) % numWorkers;
+    {
+        auto& worker = _workers[target];
+        stdx::lock_guard<SpinLock> lk(worker.mutex);
+        worker.queue.emplace_back(std::move(task));
+    }
+
+    // Wake an idle worker, which either owns the queue we just pushed to or will steal from it.
+    // Grow the pool when there is more queued work than idle workers to run it, since the
+    // running workers may all be blocked.
+    const auto numIdle = _numIdleWorkers.load();
+    const bool shouldGrow = numIdle < numPending && _numWorkers.load() < _options.maxThreads;
+    if (numIdle == 0 && !shouldGrow) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (shouldGrow && _state == State::kRunning && _numWorkers.load() < _options.maxThreads) {
+        _startWorker(lk);
+    }
+    _workAvailable.notify_one();
+}
+
+boost::optional<size_t> WorkStealingThreadPool::getCurrentWorkerId() const {
+    if (currentPool != this) {
+        return boost::none;
+    }
+    return currentWorkerId;
+}
+
+WorkStealingThreadPool::Stats WorkStealingThreadPool::getStats() const {
+    Stats stats;
+    stats.numThreads = _numWorkers.load();
+    stats.numIdleThreads = _numIdleWorkers.load();
+    stats.numPendingTasks = _numPendingTasks.load();
+    stats.numTasksRunLocally = _numTasksRunLocally.load();
+    stats.numTasksStolen = _numTasksStolen.load();
+    return stats;
+}
+
+void WorkStealingThreadPool::_setState(WithLock, State newState) {
+    if (_state == newState) {
+        return;
+    }
+    _state = newState;
+    _stateChange.notify_all();
+}
+
+void WorkStealingThreadPool::_startWorker(WithLock) {
+    const auto id = _numWorkers.load();
+    invariant(id < _options.maxThreads);
+
+    auto threadName = "{}{}"_format(_options.threadNamePrefix, id);
+    _workers[id].thread = stdx::thread([this, id, threadName = std::move(threadName)]() mutable {
+        _workerBody(id, std::move(threadName));
+    });
+
+    // Publish the worker only once its thread exists, so join() never sees an unstarted thread.
+    _numWorkers.store(id + 1);
+}
+
+void WorkStealingThreadPool::_workerBody(size_t id, std::string threadName) noexcept {
+    setThreadName(threadName);
+    currentPool = this;
+    currentWorkerId = id;
+    if (_options.onCreateThread)
+        _options.onCreateThread(threadName);
+    LOGV2_DEBUG(5986105,
+                1,
+                "Starting thread",
+                "threadName"_attr = threadName,
+                "poolName"_attr = _options.poolName);
+
+    size_t localTasksSinceSteal = 0;
+    while (true) {
+        Task task;
+        const bool preferSteal = localTasksSinceSteal >= kLocalTasksBetweenSteals;
+        if (_tryGetTask(id, preferSteal, &task)) {
+            localTasksSinceSteal = preferSteal ? 0 : localTasksSinceSteal + 1;
+
+            // Reset the task so that its destructor runs before we look for the next one.
+            task(Status::OK());
+            task = {};
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        const auto shuttingDown = [&] {
+            return _state != State::kPreStart && _state != State::kRunning;
+        };
+
+        // Register as idle before checking for work, so that a concurrent schedule() either sees
+        // us idle and wakes us, or its task is visible to the predicate below.
+        _numIdleWorkers.addAndFetch(1);
+        _workAvailable.wait(lk, [&] { return _numPendingTasks.load() > 0 || shuttingDown(); });
+        _numIdleWorkers.subtractAndFetch(1);
+
+        if (shuttingDown() && _numPendingTasks.load() == 0) {
+            break;
+        }
+    }
+
+    LOGV2_DEBUG(5986106,
+                1,
+                "Shutting down thread",
+                "threadName"_attr = threadName,
+                "poolName"_attr = _options.poolName);
+    currentPool = nullptr;
+}
+
+bool WorkStealingThreadPool::_tryGetTask(size_t id, bool preferSteal, Task* task) {
+    if (preferSteal) {
+        return _trySteal(id, task) || _tryPopLocal(id, task);
+    }
+    return _tryPopLocal(id, task) || _trySteal(id, task);
+}
+
+bool WorkStealingThreadPool::_tryPopLocal(size_t id, Task* task) {
+    auto& worker = _workers[id];
+    {
+        stdx::lock_guard<SpinLock> lk(worker.mutex);
+        if (worker.queue.empty()) {
+            return false;
+        }
+        *task = std::move(worker.queue.front());
+        worker.queue.pop_front();
+    }
+
+    _numPendingTasks.subtractAndFetch(1);
+    _numTasksRunLocally.addAndFetch(1);
+    return true;
+}
+
+bool WorkStealingThreadPool::_trySteal(size_t id, Task* task) {
+    const auto numWorkers = std::max<size_t>(_numWorkers.load(), 1);
+    for (size_t i = 1; i <= numWorkers; ++i) {
+        const auto victimId = (id + i) % numWorkers;
+        if (victimId == id) {
+            continue;
+        }
+
+        auto& victim = _workers[victimId];
+        stdx::lock_guard<SpinLock> lk(victim.mutex);
+        if (victim.queue.empty()) {
+            continue;
+        }
+        *task = std::move(victim.queue.back());
+        victim.queue.pop_back();
+
+        _numPendingTasks.subtractAndFetch(1);
+        _numTasksStolen.addAndFetch(1);
+        return true;
+    }
+    return false;
+}
+
+}  // namespace mongo
@@ -0,0 +1,188 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/new.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/concurrency/thread_pool_interface.h"
+#include "mongo/util/concurrency/with_lock.h"
+
+namespace mongo {
+
+/**
+ * A thread pool that gives every worker thread its own run queue instead of sharing a single
+ * queue between all of them.
+ *
+ * Tasks are placed on the queue of a specific worker, either the one named by the caller (see
+ * scheduleOnWorker()) or one picked round-robin. A worker first drains its own queue, oldest task
+ * first, and only when that is empty does it steal the newest task from another worker's queue.
+ * This keeps the common path off of any pool-wide lock and lets callers keep related tasks (e.g.,
+ * the tasks of one client session) on the thread whose caches they have already warmed up.
+ *
+ * Like ThreadPool, the pool starts "minThreads" workers and grows up to "maxThreads" workers when
+ * tasks are queued and no worker is idle, so that tasks which block do not starve the rest of
+ * the queued work. Workers are not reaped until shutdown.
+ */
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+public:
+    struct Options {
+        Options() = default;
+
+        explicit Options(const ThreadPool::Limits& limits)
+            : minThreads(limits.minThreads), maxThreads(limits.maxThreads) {}
+
+        // Name of the thread pool. If this string is empty, the pool will be assigned a name
+        // unique to the current process.
+        std::string poolName;
+
+        // Prefix used to name worker threads. Defaults to the pool name followed by a hyphen.
+        std::string threadNamePrefix;
+
+        // Number of workers started by startup(). At least one worker is always started.
+        size_t minThreads = 1;
+
+        // The pool will never grow to contain more than this many workers.
+        size_t maxThreads = 8;
+
+        /** If callable, called before each worker thread begins consuming tasks. */
+        std::function<void(const std::string&)> onCreateThread;
+    };
+
+    /**
+     * Structure used to return information about the thread pool via getStats().
+     */
+    struct Stats {
+        // The number of workers currently in the pool, idle or active.
+        size_t numThreads;
+
+        // The number of workers currently waiting for work.
+        size_t numIdleThreads;
+
+        // The number of tasks that are queued but have not started running.
+        size_t numPendingTasks;
+
+        // The number of tasks that ran on the worker whose queue they were placed on.
+        size_t numTasksRunLocally;
+
+        // The number of tasks that were stolen from the queue of another worker.
+        size_t numTasksStolen;
+    };
+
+    explicit WorkStealingThreadPool(Options options);
+    ~WorkStealingThreadPool() override;
+
+    void startup() override;
+    void shutdown() override;
+    void join() override;
+
+    /**
+     * Schedules "task" on a worker picked round-robin.
+     */
+    void schedule(Task task) override;
+
+    /**
+     * Schedules "task" on the queue of the worker identified by "workerId" if it names one of the
+     * running workers, and on a worker picked round-robin otherwise. Worker ids are obtained
+     * through getCurrentWorkerId().
+     */
+    void scheduleOnWorker(Task task, boost::optional<size_t> workerId);
+
+    /**
+     * Returns the id of the worker running the calling thread, or boost::none if the calling
+     * thread does not belong to this pool.
+     */
+    boost::optional<size_t> getCurrentWorkerId() const;
+
+    Stats getStats() const;
+
+private:
+    /**
+     * The per-worker run queue. The owner pops from the front and thieves take from the back, so
+     * each queue runs its own tasks in FIFO order while stealing tends to move the work that has
+     * waited the least.
+     */
+    struct alignas(stdx::hardware_destructive_interference_size) Worker {
+        SpinLock mutex;
+        std::deque<Task> queue;
+        stdx::thread thread;
+    };
+
+    enum class State { kPreStart, kRunning, kJoinRequired, kJoining, kShutdownComplete };
+
+    void _setState(WithLock, State newState);
+    void _startWorker(WithLock);
+    void _workerBody(size_t id, std::string threadName) noexcept;
+
+    // Takes the next task for worker "id", from its own queue or by stealing. Returns false if
+    // no task is queued anywhere.
+    // "preferSteal" makes the worker look at other queues first, which keeps the queue of a
+    // worker that is blocked in a long-running task from starving.
+    bool _tryGetTask(size_t id, bool preferSteal, Task* task);
+    bool _tryPopLocal(size_t id, Task* task);
+    bool _trySteal(size_t id, Task* task);
+
+    Options _options;
+
+    // Storage for every worker the pool may ever start, so that thieves can walk the workers
+    // without synchronizing with pool growth. Only the first "_numWorkers" entries are started.
+    std::unique_ptr<Worker[]> _workers;
+    AtomicWord<size_t> _numWorkers{0};
+
+    AtomicWord<size_t> _nextWorker{0};
+    AtomicWord<size_t> _numPendingTasks{0};
+    AtomicWord<size_t> _numIdleWorkers{0};
+    AtomicWord<size_t> _numTasksRunLocally{0};
+    AtomicWord<size_t> _numTasksStolen{0};
+
+    // Cleared by shutdown(). Checked by schedule() without taking "_mutex".
+    AtomicWord<bool> _acceptingTasks{true};
+
+    // Protects "_state" and worker creation, and pairs with "_workAvailable" to park idle
+    // workers.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WorkStealingThreadPool::_mutex");
+    stdx::condition_variable _workAvailable;
+    stdx::condition_variable _stateChange;
+    State _state = State::kPreStart;
+};
+
+}  // namespace mongo
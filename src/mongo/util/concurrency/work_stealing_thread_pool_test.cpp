@@ -0,0 +1,146 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kTest
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/unittest/barrier.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/thread_pool_test_common.h"
+#include "mongo/util/concurrency/work_stealing_thread_pool.h"
+#include "mongo/util/future.h"
+
+namespace {
+using namespace mongo;
+
+MONGO_INITIALIZER(WorkStealingThreadPoolCommonTests)(InitializerContext*) {
+    addTestsForThreadPool("WorkStealingThreadPoolCommon", []() {
+        return std::make_unique<WorkStealingThreadPool>(WorkStealingThreadPool::Options());
+    });
+}
+
+WorkStealingThreadPool::Options makeOptions(size_t minThreads, size_t maxThreads) {
+    WorkStealingThreadPool::Options options;
+    options.poolName = "WorkStealingThreadPoolTest";
+    options.minThreads = minThreads;
+    options.maxThreads = maxThreads;
+    return options;
+}
+
+TEST(WorkStealingThreadPoolTest, CurrentWorkerIdIsOnlySetOnWorkers) {
+    WorkStealingThreadPool pool(makeOptions(2, 2));
+    pool.startup();
+    ASSERT_FALSE(pool.getCurrentWorkerId());
+
+    auto pf = makePromiseFuture<boost::optional<size_t>>();
+    pool.schedule([&](Status status) {
+        ASSERT_OK(status);
+        pf.promise.emplaceValue(pool.getCurrentWorkerId());
+    });
+    auto workerId = pf.future.get();
+    ASSERT_TRUE(workerId);
+    ASSERT_LT(*workerId, 2U);
+
+    pool.shutdown();
+    pool.join();
+}
+
+TEST(WorkStealingThreadPoolTest, IdleWorkerStealsFromBlockedWorker) {
+    WorkStealingThreadPool pool(makeOptions(2, 2));
+    pool.startup();
+
+    auto blockedOn = makePromiseFuture<size_t>();
+    auto unblock = makePromiseFuture<void>();
+    pool.schedule([&, unblockFuture = std::move(unblock.future)](Status status) mutable {
+        ASSERT_OK(status);
+        blockedOn.promise.emplaceValue(*pool.getCurrentWorkerId());
+        unblockFuture.get();
+    });
+    const auto blockedWorker = blockedOn.future.get();
+
+    // The task is queued on the blocked worker, so only the other worker can run it.
+    auto ranOn = makePromiseFuture<size_t>();
+    pool.scheduleOnWorker(
+        [&](Status status) {
+            ASSERT_OK(status);
+            ranOn.promise.emplaceValue(*pool.getCurrentWorkerId());
+        },
+        blockedWorker);
+    ASSERT_NE(ranOn.future.get(), blockedWorker);
+    ASSERT_GTE(pool.getStats().numTasksStolen, 1U);
+
+    unblock.promise.emplaceValue();
+    pool.shutdown();
+    pool.join();
+}
+
+TEST(WorkStealingThreadPoolTest, GrowsWhenAllWorkersAreBlocked) {
+    WorkStealingThreadPool pool(makeOptions(1, 2));
+    pool.startup();
+    ASSERT_EQ(pool.getStats().numThreads, 1U);
+
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    pool.schedule([barrier](Status status) {
+        ASSERT_OK(status);
+        barrier->countDownAndWait();
+    });
+
+    // The only worker is blocked on the barrier until this task runs on a new worker.
+    pool.schedule([barrier](Status status) {
+        ASSERT_OK(status);
+        barrier->countDownAndWait();
+    });
+
+    pool.shutdown();
+    pool.join();
+    ASSERT_EQ(pool.getStats().numThreads, 2U);
+}
+
+TEST(WorkStealingThreadPoolTest, ScheduleOnUnknownWorkerFallsBackToAnyWorker) {
+    WorkStealingThreadPool pool(makeOptions(1, 1));
+    pool.startup();
+
+    auto pf = makePromiseFuture<void>();
+    pool.scheduleOnWorker(
+        [&](Status status) {
+            ASSERT_OK(status);
+            pf.promise.emplaceValue();
+        },
+        size_t{42});
+    pf.future.get();
+
+    pool.shutdown();
+    pool.join();
+    ASSERT_EQ(pool.getStats().numTasksRunLocally, 1U);
+}
+
+}  // namespace
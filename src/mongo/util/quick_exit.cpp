@@ -37,6 +37,8 @@
 #include <unistd.h>
 #endif
 
+#include <atomic>
+
 // This will probably get us _exit on non-unistd platforms like Windows.
 #include <cstdlib>
 
@@ -71,8 +73,19 @@ namespace mongo {
 
 namespace {
 stdx::mutex* const quickExitMutex = new stdx::mutex;
+std::atomic<void (*)()> quickExitFlushHook{nullptr};  // NOLINT
 }  // namespace
 
+void setQuickExitFlushHook(void (*hook)()) {
+    quickExitFlushHook.store(hook);
+}
+
+void runQuickExitFlushHook() {
+    if (auto hook = quickExitFlushHook.load()) {
+        hook();
+    }
+}
+
 void quickExitWithoutLogging(int code) {
     // Ensure that only one thread invokes the last rites here. No
     // RAII here - we never want to unlock this.
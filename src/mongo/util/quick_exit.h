@@ -48,11 +48,24 @@ namespace mongo {
  */
 MONGO_COMPILER_NORETURN void quickExitWithoutLogging(int);
 
+/**
+ * Sets a function for quickExit to call before exiting, which writes out what the process still
+ * buffers in memory, such as log records waiting for a background writer. The function must not
+ * log. quickExitWithoutLogging does not call it.
+ */
+void setQuickExitFlushHook(void (*hook)());
+
+/**
+ * Calls the function set with setQuickExitFlushHook, if any.
+ */
+void runQuickExitFlushHook();
+
 MONGO_COMPILER_NORETURN inline void quickExit(int code) {
     warnIfTripwireAssertionsOccurred();
     if (code == EXIT_CLEAN) {
         TestingProctor::instance().exitAbruptlyIfDeferredErrors(false);
     }
+    runQuickExitFlushHook();
     quickExitWithoutLogging(code);
 }
 
@@ -68,6 +68,11 @@ public:
         return true;
     }
 
+    Milliseconds updateInterval() const override {
+        // Queries a few dozen allocator properties, some of which walk the page heap.
+        return Milliseconds(500);
+    }
+
     BSONObj generateSection(OperationContext* opCtx,
                             const BSONElement& configElement) const override {
         long long verbosity = 1;